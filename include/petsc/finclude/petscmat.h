@@ -98,6 +98,9 @@
 #define MATAIJSELL         'aijsell'
 #define MATSEQAIJSELL      'seqaijsell'
 #define MATMPIAIJSELL      'mpiaijsell'
+#define MATAIJDELTA        'aijdelta'
+#define MATSEQAIJDELTA     'seqaijdelta'
+#define MATMPIAIJDELTA     'mpiaijdelta'
 #define MATAIJMKL          'aijmkl'
 #define MATSEQAIJMKL       'seqaijmkl'
 #define MATMPIAIJMKL       'mpiaijmkl'
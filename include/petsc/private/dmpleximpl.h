@@ -197,6 +197,7 @@ typedef struct {
   char                *triangleOpts;
   PetscPartitioner     partitioner;
   PetscBool            partitionBalance;  /* Evenly divide partition overlap when distributing */
+  char                *reorderType;       /* Ordering applied to the mesh after distribution, or NULL */
   PetscBool            remeshBd;
 
   /* Submesh */
@@ -108,6 +108,10 @@ PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_7(MatScalar*,PetscReal,
 PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_9(MatScalar*,PetscReal,PetscBool,PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscKernel_A_gets_inverse_A_15(MatScalar*,PetscInt*,MatScalar*,PetscReal,PetscBool,PetscBool*);
 
+/* inverts many blocks of the same size 2 <= bs <= PETSC_KERNEL_BATCH_MAXBS at once, see dgebatch.c */
+#define PETSC_KERNEL_BATCH_MAXBS 8
+PETSC_INTERN PetscErrorCode PetscKernel_A_gets_inverse_A_Batched(PetscInt,PetscInt,MatScalar*,PetscReal,PetscBool,PetscBool*);
+
 /*
     A = inv(A)    A_gets_inverse_A
 
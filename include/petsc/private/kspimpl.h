@@ -75,6 +75,7 @@ struct _p_KSP {
   PetscBool       dmActive;     /* KSP should use DM for computing operators */
   /*------------------------- User parameters--------------------------*/
   PetscInt        max_it;                     /* maximum number of iterations */
+  PetscInt        nmax;                       /* maximum number of right-hand sides treated simultaneously by KSPMatSolve() */
   KSPGuess        guess;
   PetscBool       guess_zero,                  /* flag for whether initial guess is 0 */
                   calc_sings,                  /* calculate extreme Singular Values */
@@ -187,6 +188,7 @@ PETSC_STATIC_INLINE PetscErrorCode KSPLogResidualHistory(KSP ksp,PetscReal norm)
 }
 
 PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP,PetscBool,KSPNormType*,PCSide*);
+PETSC_INTERN PetscErrorCode KSPMatSolveColumns_Private(KSP,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP,PetscInt,const PetscReal*,const PetscReal*);
 
@@ -289,6 +291,16 @@ PETSC_STATIC_INLINE PetscErrorCode KSP_PCApply(KSP ksp,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+PETSC_STATIC_INLINE PetscErrorCode KSP_PCMatApply(KSP ksp,Mat X,Mat Y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ksp->transpose_solve) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Cannot apply the transpose of the preconditioner to a block of vectors");
+  ierr = PCMatApply(ksp->pc,X,Y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_STATIC_INLINE PetscErrorCode KSP_PCApplyTranspose(KSP ksp,Vec x,Vec y)
 {
   PetscErrorCode ierr;
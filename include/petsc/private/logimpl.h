@@ -86,6 +86,14 @@ PETSC_EXTERN PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent, int, Petsc
 PETSC_EXTERN PetscErrorCode PetscLogEventEndComplete(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventBeginTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventEndTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventBeginBuffered(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventEndBuffered(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_INTERN PetscErrorCode PetscLogBufferedFlush(void);
+PETSC_INTERN PetscErrorCode PetscLogBufferedDestroy(void);
+PETSC_INTERN PetscErrorCode PetscLogCountersInitialize(void);
+PETSC_INTERN PetscErrorCode PetscLogCountersGet(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogCountersGetError(const char**);
+PETSC_INTERN PetscErrorCode PetscLogCountersFinalize(void);
 
 /* Creation and destruction functions */
 PETSC_EXTERN PetscErrorCode PetscClassRegLogCreate(PetscClassRegLog *);
@@ -5,6 +5,7 @@
 #include <petscmat.h>
 #include <petscmatcoarsen.h>
 #include <petsc/private/petscimpl.h>
+#include <petsc/private/hashmapijv.h>
 
 PETSC_EXTERN PetscBool MatRegisterAllCalled;
 PETSC_EXTERN PetscBool MatSeqAIJRegisterAllCalled;
@@ -353,10 +354,26 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used for frozen-pattern communication, see MAT_FROZEN_OFF_PROC_ENTRIES */
+  PetscBool      frozen_record;           /* Record the communication pattern during this assembly */
+  PetscBool      frozen_setup;            /* The pattern has been recorded, only values are communicated */
+  PetscInt       frozen_n;                /* Number of stashed entries in the recorded assembly */
+  PetscInt       *frozen_idx,*frozen_idy; /* Stashed rows and columns in the recorded assembly, in the order they were set */
+  PetscInt       *frozen_map;             /* Offset in frozen_sendbuf of the block receiving each stashed entry */
+  PetscMPIInt    frozen_nsendranks;
+  PetscMPIInt    frozen_nrecvranks;
+  PetscMPIInt    *frozen_recvranks;
+  PetscInt       *frozen_sendoffset;      /* Scalar offsets of the messages in frozen_sendbuf */
+  PetscInt       *frozen_recvoffset;      /* Block offsets of the messages in frozen_recvrows and frozen_recvcols */
+  PetscInt       *frozen_recvrows,*frozen_recvcols;
+  PetscScalar    *frozen_sendbuf,*frozen_recvbuf;
+  MPI_Request    *frozen_reqs;            /* Persistent requests, receives followed by sends */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
 PETSC_INTERN PetscErrorCode MatStashScatterDestroy_BTS(MatStash*);
+PETSC_INTERN PetscErrorCode MatStashFrozenDestroy_Private(MatStash*);
 #endif
 PETSC_INTERN PetscErrorCode MatStashCreate_Private(MPI_Comm,PetscInt,MatStash*);
 PETSC_INTERN PetscErrorCode MatStashDestroy_Private(MatStash*);
@@ -437,6 +454,7 @@ struct _p_Mat {
   PetscBool              symmetric_eternal;
   PetscBool              nooffprocentries,nooffproczerorows;
   PetscBool              assembly_subset;  /* set by MAT_SUBSET_OFF_PROC_ENTRIES */
+  PetscBool              assembly_frozen;  /* set by MAT_FROZEN_OFF_PROC_ENTRIES */
   PetscBool              submat_singleis;  /* for efficient PCSetUp_ASM() */
   PetscBool              structure_only;
   PetscBool              sortedfull;       /* full, sorted rows are inserted */
@@ -447,6 +465,10 @@ struct _p_Mat {
   void                   *spptr;          /* pointer for special library like SuperLU */
   char                   *solvertype;
   PetscBool              checksymmetryonassembly,checknullspaceonassembly;
+  PetscBool              autotune;          /* select the fastest format at the first assembly */
+  PetscBool              hash_assembly;     /* MAT_USE_HASH_TABLE for AIJ, insert into a hash table instead of a preallocation */
+  PetscHMapIJV           hash_table;        /* the entries inserted before the first final assembly */
+  struct _MatOps         *hash_ops;         /* the operations replaced while hash_table is in use */
   PetscReal              checksymmetrytol;
   Mat                    schur;             /* Schur complement matrix */
   MatFactorSchurStatus   schur_status;      /* status of the Schur complement matrix */
@@ -1701,6 +1723,7 @@ PETSC_EXTERN PetscLogEvent MAT_ILUFactorSymbolic;
 PETSC_EXTERN PetscLogEvent MAT_ICCFactorSymbolic;
 PETSC_EXTERN PetscLogEvent MAT_Copy;
 PETSC_EXTERN PetscLogEvent MAT_Convert;
+PETSC_EXTERN PetscLogEvent MAT_Autotune;
 PETSC_EXTERN PetscLogEvent MAT_Scale;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyEnd;
@@ -1758,6 +1781,8 @@ PETSC_EXTERN PetscLogEvent MATMFFD_Mult;
 PETSC_EXTERN PetscLogEvent MAT_GetMultiProcBlock;
 PETSC_EXTERN PetscLogEvent MAT_CUSPARSECopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_SetValuesBatch;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MAT_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyFromGPU;
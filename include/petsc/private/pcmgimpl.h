@@ -17,6 +17,10 @@ typedef struct {
   Vec      b;                                  /* Right hand side */
   Vec      x;                                  /* Solution */
   Vec      r;                                  /* Residual */
+  Mat      B;                                  /* Blocks of right hand sides, solutions, and residuals used by PCMatApply() */
+  Mat      X;
+  Mat      R;
+  Mat      W;                                  /* Block of interpolated coarse corrections */
 
   PetscErrorCode (*residual)(Mat,Vec,Vec,Vec);
 
@@ -47,6 +47,8 @@ struct _p_PetscDS {
   PetscPointFunc       *obj;           /* Scalar integral (like an objective function) */
   PetscPointFunc       *f;             /* Weak form integrands for F, f_0, f_1 */
   PetscPointJac        *g;             /* Weak form integrands for J = dF/du, g_0, g_1, g_2, g_3 */
+  PetscPointFuncBatch  *fB;            /* Weak form integrands for F evaluated on batches of points, f_0, f_1 */
+  PetscPointJacBatch   *gB;            /* Weak form integrands for J evaluated on batches of points, g_0, g_1, g_2, g_3 */
   PetscPointJac        *gp;            /* Weak form integrands for preconditioner for J, g_0, g_1, g_2, g_3 */
   PetscPointJac        *gt;            /* Weak form integrands for dF/du_t, g_0, g_1, g_2, g_3 */
   PetscBdPointFunc     *fBd;           /* Weak form boundary integrands F_bd, f_0, f_1 */
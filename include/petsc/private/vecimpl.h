@@ -180,6 +180,7 @@ PETSC_EXTERN PetscLogEvent VEC_Swap;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent VEC_DotNorm2;
 PETSC_EXTERN PetscLogEvent VEC_AXPBYPCZ;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYMDot;
 PETSC_EXTERN PetscLogEvent VEC_Ops;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyFromGPU;
@@ -182,10 +182,15 @@ M*/
 typedef struct {PetscScalar x,y,z;} DMDACoor3d;
 
 PETSC_EXTERN PetscErrorCode DMDAGetLocalInfo(DM,DMDALocalInfo*);
+PETSC_EXTERN PetscErrorCode DMDAGetInteriorLocalInfo(DM,DMDALocalInfo*,PetscInt*,DMDALocalInfo[]);
 
 PETSC_EXTERN PetscErrorCode MatRegisterDAAD(void);
 PETSC_EXTERN PetscErrorCode MatCreateDAAD(DM,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateSeqUSFFT(Vec,DM,Mat*);
+PETSC_EXTERN PetscErrorCode MatCreateDAStencil(DM,Mat*);
+PETSC_EXTERN PetscErrorCode MatDAStencilSetCoefficients(Mat,const PetscScalar[]);
+PETSC_EXTERN PetscErrorCode MatDAStencilSetVariableCoefficients(Mat,Vec);
+PETSC_EXTERN PetscErrorCode MatDAStencilGetStencilSize(Mat,PetscInt*);
 
 PETSC_EXTERN PetscErrorCode DMDASetGetMatrix(DM,PetscErrorCode (*)(DM, Mat *));
 PETSC_EXTERN PetscErrorCode DMDASetBlockFills(DM,const PetscInt*,const PetscInt*);
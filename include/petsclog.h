@@ -171,6 +171,9 @@ typedef struct {
   PetscLogDouble mallocIncrease;/* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;   /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent;  /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  PetscLogDouble cycles;        /* The processor cycles counted by the hardware in this event */
+  PetscLogDouble instructions;  /* The instructions counted by the hardware in this event */
+  PetscLogDouble cacheMissBytes;/* The last level cache misses times the cache line size in this event */
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -351,6 +354,8 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogBufferedBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogChromeTraceBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble,PetscLogDouble*);
@@ -361,6 +366,7 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogChromeTraceDump(const char[]);
 
 /* Stage functions */
 PETSC_EXTERN PetscErrorCode PetscLogStageRegister(const char[],PetscLogStage*);
@@ -405,6 +411,7 @@ PETSC_EXTERN PetscLogDouble petsc_wait_all_ct;
 PETSC_EXTERN PetscLogDouble petsc_sum_of_waits_ct;
 
 PETSC_EXTERN PetscBool      PetscLogMemory;
+PETSC_EXTERN PetscBool      PetscLogCounters;
 
 PETSC_EXTERN PetscBool PetscLogSyncOn;  /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -603,6 +610,7 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #else  /* ---Logging is turned off --------------------------------------------*/
 
 #define PetscLogMemory                     PETSC_FALSE
+#define PetscLogCounters                   PETSC_FALSE
 
 #define PetscLogFlops(n)                   0
 #define PetscGetFlops(a)                   (*(a) = 0.0,0)
@@ -644,6 +652,8 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogAllBegin()                 0
 #define PetscLogNestedBegin()              0
 #define PetscLogTraceBegin(file)           0
+#define PetscLogBufferedBegin()            0
+#define PetscLogChromeTraceBegin()         0
 #define PetscLogActions(a)                 0
 #define PetscLogObjects(a)                 0
 #define PetscLogSetThreshold(a,b)          0
@@ -652,6 +662,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogView(viewer)               0
 #define PetscLogViewFromOptions()          0
 #define PetscLogDump(c)                    0
+#define PetscLogChromeTraceDump(c)         0
 
 #define PetscLogEventSync(e,comm)          0
 #define PetscLogEventBegin(e,o1,o2,o3,o4)  0
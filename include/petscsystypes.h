@@ -636,6 +636,15 @@ typedef struct _n_PetscOmpCtrl* PetscOmpCtrl;
 S*/
 typedef struct _n_PetscSegBuffer *PetscSegBuffer;
 
+/*S
+   PetscMallocArena - a region of memory from which PetscMalloc() allocates while it is pushed, released in a single call
+
+   Level: developer
+
+.seealso: PetscMallocArenaCreate(), PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocArenaDestroy()
+S*/
+typedef struct _n_PetscMallocArena *PetscMallocArena;
+
 typedef struct _n_PetscOptionsHelpPrinted *PetscOptionsHelpPrinted;
 
 #endif
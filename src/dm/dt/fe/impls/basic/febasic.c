@@ -165,8 +165,8 @@ PetscErrorCode PetscFECreateTabulation_Basic(PetscFE fem, PetscInt npoints, cons
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
-                                             const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
+PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                      const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
 {
   const PetscInt     debug = 0;
   PetscFE            fe;
@@ -255,9 +255,9 @@ static PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscIn
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
-                                               PetscBdPointFunc obj_func,
-                                               PetscInt Ne, PetscFEGeom *fgeom, const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
+PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
+                                        PetscBdPointFunc obj_func,
+                                        PetscInt Ne, PetscFEGeom *fgeom, const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
 {
   const PetscInt     debug = 0;
   PetscFE            fe;
@@ -363,6 +363,173 @@ static PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
   PetscFunctionReturn(0);
 }
 
+/* The geometry at quadrature point q of cell e, as in the loops over the quadrature points below */
+PETSC_STATIC_INLINE void PetscFEGetBatchPointGeometry_Private(PetscFEGeom *cgeom, PetscInt e, PetscInt q, const PetscReal quadPoints[], PetscReal x[], PetscFEGeom *fegeom)
+{
+  const PetscInt Np = cgeom->numPoints, dim = cgeom->dim, dE = cgeom->dimEmbed;
+
+  fegeom->dim      = dim;
+  fegeom->dimEmbed = dE;
+  if (cgeom->isAffine) {
+    fegeom->v    = x;
+    fegeom->xi   = cgeom->xi;
+    fegeom->J    = &cgeom->J[e*Np*dE*dE];
+    fegeom->invJ = &cgeom->invJ[e*Np*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e*Np];
+    CoordinatesRefToReal(dE, dim, fegeom->xi, &cgeom->v[e*Np*dE], fegeom->J, &quadPoints[q*dim], x);
+  } else {
+    fegeom->v    = &cgeom->v[(e*Np+q)*dE];
+    fegeom->J    = &cgeom->J[(e*Np+q)*dE*dE];
+    fegeom->invJ = &cgeom->invJ[(e*Np+q)*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e*Np+q];
+  }
+}
+
+/* The fields and coordinates at a batch of quadrature points, in which entry i for point l is at i*PETSCDS_BATCH_SIZE+l */
+typedef struct {
+  PetscDS          ds, dsAux;
+  PetscTabulation *T, *TAux;
+  PetscScalar     *u, *u_t, *u_x, *a, *a_x;  /* The evaluations at a single point */
+  PetscReal       *x;
+  PetscInt         Nf, NfAux, totDim, totDimAux;
+  PetscInt        *uOff, *uOff_x, *aOff, *aOff_x;
+  PetscScalar     *uB, *u_tB, *u_xB, *aB, *a_xB;
+  PetscReal       *xB, wB[PETSCDS_BATCH_SIZE];
+  PetscFEGeom      fegeom;                   /* The geometry of the last point packed */
+} PetscFEBatch_Private;
+
+static PetscErrorCode PetscFEBatchCreate_Private(PetscDS ds, PetscDS dsAux, PetscBool useTime, PetscInt dE, PetscFEBatch_Private *b)
+{
+  const PetscInt W = PETSCDS_BATCH_SIZE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(b, sizeof(PetscFEBatch_Private));CHKERRQ(ierr);
+  b->ds    = ds;
+  b->dsAux = dsAux;
+  ierr = PetscDSGetNumFields(ds, &b->Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &b->totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &b->uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &b->uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(ds, &b->u, useTime ? &b->u_t : NULL, &b->u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &b->x, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &b->T);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &b->NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &b->totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &b->aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &b->aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(dsAux, &b->a, NULL, &b->a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &b->TAux);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc6(W*b->uOff[b->Nf], &b->uB, useTime ? W*b->uOff[b->Nf] : 0, &b->u_tB, W*b->uOff_x[b->Nf], &b->u_xB,
+                      dsAux ? W*b->aOff[b->NfAux] : 0, &b->aB, dsAux ? W*b->aOff_x[b->NfAux] : 0, &b->a_xB, W*dE, &b->xB);CHKERRQ(ierr);
+  if (!useTime) b->u_tB = NULL;
+  if (!dsAux)   b->aB = b->a_xB = NULL;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEBatchDestroy_Private(PetscFEBatch_Private *b)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree6(b->uB, b->u_tB, b->u_xB, b->aB, b->a_xB, b->xB);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Evaluates the fields at quadrature point q of cell e, and stores them with the coordinates of the point as point l of
+  the batch. If q < 0, the previous point is stored again, which fills the batch past its last point.
+*/
+static PetscErrorCode PetscFEBatchPack_Private(PetscFEBatch_Private *b, PetscFEGeom *cgeom, PetscInt e, PetscInt q, PetscInt l, const PetscReal quadPoints[], const PetscReal quadWeights[],
+                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], const PetscScalar coefficientsAux[])
+{
+  const PetscInt W = PETSCDS_BATCH_SIZE;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (q >= 0) {
+    PetscFEGetBatchPointGeometry_Private(cgeom, e, q, quadPoints, b->x, &b->fegeom);
+    b->wB[l] = b->fegeom.detJ[0]*quadWeights[q];
+    if (coefficients) {ierr = PetscFEEvaluateFieldJets_Internal(b->ds, b->Nf, 0, q, b->T, &b->fegeom, &coefficients[e*b->totDim], b->u_t ? &coefficients_t[e*b->totDim] : NULL, b->u, b->u_x, b->u_t);CHKERRQ(ierr);}
+    if (b->dsAux)     {ierr = PetscFEEvaluateFieldJets_Internal(b->dsAux, b->NfAux, 0, q, b->TAux, &b->fegeom, &coefficientsAux[e*b->totDimAux], NULL, b->a, b->a_x, NULL);CHKERRQ(ierr);}
+  }
+  for (i = 0; i < b->uOff[b->Nf]; ++i) b->uB[i*W+l] = b->u[i];
+  if (b->u_t) for (i = 0; i < b->uOff[b->Nf]; ++i) b->u_tB[i*W+l] = b->u_t[i];
+  for (i = 0; i < b->uOff_x[b->Nf]; ++i) b->u_xB[i*W+l] = b->u_x[i];
+  if (b->dsAux) {
+    for (i = 0; i < b->aOff[b->NfAux]; ++i)   b->aB[i*W+l]   = b->a[i];
+    for (i = 0; i < b->aOff_x[b->NfAux]; ++i) b->a_xB[i*W+l] = b->a_x[i];
+  }
+  for (i = 0; i < cgeom->dimEmbed; ++i) b->xB[i*W+l] = b->fegeom.v[i];
+  PetscFunctionReturn(0);
+}
+
+/*
+  Integrates the residual with the batched pointwise functions. The cells are taken PETSCDS_BATCH_SIZE at a time, and
+  their quadrature points are handed to the pointwise functions PETSCDS_BATCH_SIZE at a time, so that a batch holds
+  points of several cells when there are few quadrature points.
+*/
+static PetscErrorCode PetscFEIntegrateResidualBatch_Basic_Private(PetscDS ds, PetscInt field, PetscPointFuncBatch f0_func, PetscPointFuncBatch f1_func, PetscInt Ne, PetscFEGeom *cgeom,
+                                                                 const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  const PetscInt        W = PETSCDS_BATCH_SIZE;
+  PetscFE               fe;
+  PetscQuadrature       quad;
+  PetscFEBatch_Private  b;
+  PetscScalar          *f0B, *f1B, *f0, *f1, *basisReal, *basisDerReal;
+  const PetscScalar    *constants;
+  const PetscReal      *quadPoints, *quadWeights;
+  PetscInt              dim, numConstants, Nc, fOffset, qNc, Nq, eb;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, NULL, &basisReal, &basisDerReal, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  ierr = PetscFEBatchCreate_Private(ds, dsAux, coefficients_t ? PETSC_TRUE : PETSC_FALSE, cgeom->dimEmbed, &b);CHKERRQ(ierr);
+  Nc   = b.T[field]->Nc;
+  /* The integrands at a batch of points, and at all the quadrature points of a batch of cells */
+  ierr = PetscMalloc4(W*Nc, &f0B, W*Nc*dim, &f1B, W*Nq*Nc, &f0, W*Nq*Nc*dim, &f1);CHKERRQ(ierr);
+  for (eb = 0; eb < Ne; eb += W) {
+    const PetscInt Neb = PetscMin(W, Ne-eb);
+    PetscFEGeom    fegeom;
+    PetscInt       pb, e;
+
+    for (pb = 0; pb < Neb*Nq; pb += W) {
+      const PetscInt Np = PetscMin(W, Neb*Nq-pb);
+      PetscInt       l, c;
+
+      for (l = 0; l < W; ++l) {
+        ierr = PetscFEBatchPack_Private(&b, cgeom, eb+(pb+l)/Nq, l < Np ? (pb+l)%Nq : -1, l, quadPoints, quadWeights, coefficients, coefficients_t, coefficientsAux);CHKERRQ(ierr);
+      }
+      ierr = PetscArrayzero(f0B, W*Nc);CHKERRQ(ierr);
+      ierr = PetscArrayzero(f1B, W*Nc*dim);CHKERRQ(ierr);
+      if (f0_func) f0_func(dim, b.Nf, b.NfAux, Np, b.uOff, b.uOff_x, b.uB, b.u_tB, b.u_xB, b.aOff, b.aOff_x, b.aB, NULL, b.a_xB, t, b.xB, numConstants, constants, f0B);
+      if (f1_func) f1_func(dim, b.Nf, b.NfAux, Np, b.uOff, b.uOff_x, b.uB, b.u_tB, b.u_xB, b.aOff, b.aOff_x, b.aB, NULL, b.a_xB, t, b.xB, numConstants, constants, f1B);
+      for (l = 0; l < Np; ++l) {
+        for (c = 0; c < Nc; ++c)     f0[(pb+l)*Nc+c]     = f0B[c*W+l]*b.wB[l];
+        for (c = 0; c < Nc*dim; ++c) f1[(pb+l)*Nc*dim+c] = f1B[c*W+l]*b.wB[l];
+      }
+    }
+    for (e = 0; e < Neb; ++e) {
+      /* The test functions are pushed forward with the geometry of the last quadrature point, as in PetscFEIntegrateResidual_Basic() */
+      PetscFEGetBatchPointGeometry_Private(cgeom, eb+e, Nq-1, quadPoints, b.x, &fegeom);
+      ierr = PetscFEUpdateElementVec_Internal(fe, b.T[field], 0, basisReal, basisDerReal, &fegeom, &f0[e*Nq*Nc], &f1[e*Nq*Nc*dim], &elemVec[(eb+e)*b.totDim+fOffset]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree4(f0B, f1B, f0, f1);CHKERRQ(ierr);
+  ierr = PetscFEBatchDestroy_Private(&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
@@ -370,6 +537,7 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscI
   PetscFE            fe;
   PetscPointFunc     f0_func;
   PetscPointFunc     f1_func;
+  PetscPointFuncBatch f0B_func, f1B_func;
   PetscQuadrature    quad;
   PetscTabulation   *T, *TAux = NULL;
   PetscScalar       *f0, *f1, *u, *u_t = NULL, *u_x, *a, *a_x, *basisReal, *basisDerReal;
@@ -392,6 +560,11 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscI
   ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
   ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
   ierr = PetscDSGetResidual(ds, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetResidualBatch(ds, field, &f0B_func, &f1B_func);CHKERRQ(ierr);
+  if (f0B_func || f1B_func) {
+    ierr = PetscFEIntegrateResidualBatch_Basic_Private(ds, field, f0B_func, f1B_func, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
   ierr = PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, NULL, NULL);CHKERRQ(ierr);
   ierr = PetscDSGetWeakFormArrays(ds, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
@@ -592,8 +765,8 @@ PetscErrorCode PetscFEIntegrateBdResidual_Basic(PetscDS ds, PetscInt field, Pets
     2) We need to assume that the orientation is 0 for both
     3) TODO We need to use a non-square Jacobian for the derivative maps, meaning the embedding dimension has to go to EvaluateFieldJets() and UpdateElementVec()
 */
-static PetscErrorCode PetscFEIntegrateHybridResidual_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *fgeom,
-                                                           const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+PetscErrorCode PetscFEIntegrateHybridResidual_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *fgeom,
+                                                    const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
   const PetscInt     debug = 0;
   PetscFE            fe;
@@ -705,12 +878,84 @@ static PetscErrorCode PetscFEIntegrateHybridResidual_Basic(PetscDS ds, PetscInt
   PetscFunctionReturn(0);
 }
 
+/*
+  Integrates the Jacobian with the batched pointwise functions, with the batches of PetscFEIntegrateResidualBatch_Basic_Private().
+  The integrands at each point of a batch are then added to the element matrix of its cell.
+*/
+static PetscErrorCode PetscFEIntegrateJacobianBatch_Basic_Private(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscPointJacBatch g_func[], PetscInt Ne, PetscFEGeom *cgeom,
+                                                                 const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  const PetscInt        W = PETSCDS_BATCH_SIZE;
+  PetscFE               feI, feJ;
+  PetscQuadrature       quad;
+  PetscFEBatch_Private  b;
+  PetscScalar          *gB[4], *g[4], *basisReal, *basisDerReal, *testReal, *testDerReal;
+  const PetscScalar    *constants;
+  const PetscReal      *quadPoints, *quadWeights;
+  PetscInt              dim, numConstants, NcI, NcJ, Ng[4], offsetI, offsetJ, qNc, Nq, eb, k;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, fieldI, (PetscObject *) &feI);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(ds, fieldJ, (PetscObject *) &feJ);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(feI, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(feI, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldJ, &offsetJ);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, NULL, &basisReal, &basisDerReal, &testReal, &testDerReal);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, NULL, NULL, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  ierr = PetscFEBatchCreate_Private(ds, dsAux, coefficients_t ? PETSC_TRUE : PETSC_FALSE, cgeom->dimEmbed, &b);CHKERRQ(ierr);
+  NcI   = b.T[fieldI]->Nc;
+  NcJ   = b.T[fieldJ]->Nc;
+  Ng[0] = NcI*NcJ;
+  Ng[1] = Ng[2] = NcI*NcJ*dim;
+  Ng[3] = NcI*NcJ*dim*dim;
+  ierr = PetscMalloc4(W*Ng[0], &gB[0], W*Ng[1], &gB[1], W*Ng[2], &gB[2], W*Ng[3], &gB[3]);CHKERRQ(ierr);
+  for (k = 0; k < 4; ++k) {ierr = PetscArrayzero(g[k], Ng[k]);CHKERRQ(ierr);}
+  for (eb = 0; eb < Ne; eb += W) {
+    const PetscInt Neb = PetscMin(W, Ne-eb);
+    PetscInt       pb;
+
+    for (pb = 0; pb < Neb*Nq; pb += W) {
+      const PetscInt Np = PetscMin(W, Neb*Nq-pb);
+      PetscInt       l, c;
+
+      for (l = 0; l < W; ++l) {
+        ierr = PetscFEBatchPack_Private(&b, cgeom, eb+(pb+l)/Nq, l < Np ? (pb+l)%Nq : -1, l, quadPoints, quadWeights, coefficients, coefficients_t, coefficientsAux);CHKERRQ(ierr);
+      }
+      for (k = 0; k < 4; ++k) {
+        if (!g_func[k]) continue;
+        ierr = PetscArrayzero(gB[k], W*Ng[k]);CHKERRQ(ierr);
+        g_func[k](dim, b.Nf, b.NfAux, Np, b.uOff, b.uOff_x, b.uB, b.u_tB, b.u_xB, b.aOff, b.aOff_x, b.aB, NULL, b.a_xB, t, u_tshift, b.xB, numConstants, constants, gB[k]);
+      }
+      for (l = 0; l < Np; ++l) {
+        const PetscInt e = eb+(pb+l)/Nq, q = (pb+l)%Nq;
+        PetscFEGeom    fegeom;
+
+        for (k = 0; k < 4; ++k) {
+          if (!g_func[k]) continue;
+          for (c = 0; c < Ng[k]; ++c) g[k][c] = gB[k][c*W+l]*b.wB[l];
+        }
+        PetscFEGetBatchPointGeometry_Private(cgeom, e, q, quadPoints, b.x, &fegeom);
+        ierr = PetscFEUpdateElementMat_Internal(feI, feJ, 0, q, b.T[fieldI], basisReal, basisDerReal, b.T[fieldJ], testReal, testDerReal, &fegeom, g[0], g[1], g[2], g[3], e*b.totDim*b.totDim, b.totDim, offsetI, offsetJ, elemMat);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscFree4(gB[0], gB[1], gB[2], gB[3]);CHKERRQ(ierr);
+  ierr = PetscFEBatchDestroy_Private(&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *cgeom,
                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
 {
   const PetscInt     debug      = 0;
   PetscFE            feI, feJ;
   PetscPointJac      g0_func, g1_func, g2_func, g3_func;
+  PetscPointJacBatch gB_func[4] = {NULL, NULL, NULL, NULL};
   PetscInt           cOffset    = 0; /* Offset into coefficients[] for element e */
   PetscInt           cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
   PetscInt           eOffset    = 0; /* Offset into elemMat[] for element e */
@@ -742,7 +987,14 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   switch(jtype) {
   case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
   case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
-  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:
+    ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+    ierr = PetscDSGetJacobianBatch(ds, fieldI, fieldJ, &gB_func[0], &gB_func[1], &gB_func[2], &gB_func[3]);CHKERRQ(ierr);
+    break;
+  }
+  if (gB_func[0] || gB_func[1] || gB_func[2] || gB_func[3]) {
+    ierr = PetscFEIntegrateJacobianBatch_Basic_Private(ds, fieldI, fieldJ, gB_func, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, u_tshift, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
   }
   if (!g0_func && !g1_func && !g2_func && !g3_func) PetscFunctionReturn(0);
   ierr = PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
@@ -847,8 +1099,8 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *fgeom,
-                                                       const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *fgeom,
+                                                const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
 {
   const PetscInt     debug      = 0;
   PetscFE            feI, feJ;
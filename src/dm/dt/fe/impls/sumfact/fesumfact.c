@@ -0,0 +1,992 @@
+#include <petsc/private/petscfeimpl.h> /*I "petscfe.h" I*/
+
+/*
+     Integration by sum factorization for tensor product elements.
+
+     When the basis of a Lagrange element is the tensor product of 1D Lagrange polynomials and the quadrature is the
+   tensor product of a 1D quadrature, the values and gradients of a field at the quadrature points are computed by
+   applying the 1D tabulations in one direction at a time, and the test functions are integrated by applying their
+   transposes. With p+1 nodes in each direction, this costs O(p^{dim+1}) operations for each element instead of the
+   O(p^{2 dim}) of the full tabulations. The element matrices are computed one column at a time in this way, and the
+   action of the Jacobian on a vector is integrated without forming them.
+*/
+
+PETSC_EXTERN PetscErrorCode PetscFESetUp_Basic(PetscFE);
+PETSC_EXTERN PetscErrorCode PetscFECreateTabulation_Basic(PetscFE, PetscInt, const PetscReal [], PetscInt, PetscTabulation);
+
+static PetscErrorCode PetscFESumFactReset_Private(PetscFE_SumFact *sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscQuadratureDestroy(&sf->quad);CHKERRQ(ierr);
+  ierr = PetscFree4(sf->B, sf->D, sf->dofs, sf->qpts);CHKERRQ(ierr);
+  ierr = PetscFree(sf->work);CHKERRQ(ierr);
+  sf->tensor = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEDestroy_SumFact(PetscFE fem)
+{
+  PetscFE_SumFact *sf = (PetscFE_SumFact *) fem->data;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFESumFactReset_Private(sf);CHKERRQ(ierr);
+  ierr = PetscFree(sf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Returns the index of y in the first n entries of x, or -1 */
+static PetscInt PetscFESumFactFindCoordinate_Private(PetscInt n, const PetscReal x[], PetscReal y)
+{
+  PetscInt i;
+
+  for (i = 0; i < n; ++i) if (PetscAbsReal(x[i] - y) < PETSC_SMALL) return i;
+  return -1;
+}
+
+/* Collects the distinct values of the coordinates of the points in x, sorted, and fails if there are more than nmax */
+static PetscErrorCode PetscFESumFactCollectCoordinates_Private(PetscInt Np, PetscInt dim, const PetscReal points[], PetscInt nmax, PetscInt *n, PetscReal x[], PetscBool *ok)
+{
+  PetscInt       p, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *n  = 0;
+  *ok = PETSC_FALSE;
+  for (p = 0; p < Np*dim; ++p) {
+    if (PetscFESumFactFindCoordinate_Private(*n, x, points[p]) >= 0) continue;
+    if (*n == nmax) PetscFunctionReturn(0);
+    x[(*n)++] = points[p];
+  }
+  ierr = PetscSortReal(*n, x);CHKERRQ(ierr);
+  /* every point must lie on the grid of these coordinates */
+  for (p = 0; p < Np; ++p) {
+    for (d = 0; d < dim; ++d) if (PetscFESumFactFindCoordinate_Private(*n, x, points[p*dim+d]) < 0) PetscFunctionReturn(0);
+  }
+  *ok = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* The tensor product index of a point of the grid x, with the first direction varying slowest */
+static PetscInt PetscFESumFactTensorIndex_Private(PetscInt dim, PetscInt n, const PetscReal x[], const PetscReal point[])
+{
+  PetscInt d, t = 0;
+
+  for (d = 0; d < dim; ++d) t = t*n + PetscFESumFactFindCoordinate_Private(n, x, point[d]);
+  return t;
+}
+
+/*
+  Detects the tensor product structure of the basis and the quadrature. The nodes of the dual space must be single
+  point evaluations on a tensor product grid, and the quadrature points a tensor product grid as well; the resulting 1D
+  tabulations are checked against the full tabulation, so that any other element is integrated with the basic kernels.
+*/
+static PetscErrorCode PetscFESumFactSetUpTensor_Private(PetscFE fem)
+{
+  PetscFE_SumFact *sf = (PetscFE_SumFact *) fem->data;
+  DM               dm;
+  PetscTabulation  T;
+  PetscQuadrature  f;
+  const PetscReal *points, *weights;
+  PetscReal       *xq = NULL, *xn = NULL, *nodes = NULL, scale = 0.0;
+  PetscInt        *comp = NULL;
+  PetscInt         dim, form, k, Nc, pdim, qdim, qNc, Nq, fNc, fNq, n, nq, Ns, Nt, s, t, c, cc, d, j, i, a, b, m;
+  PetscBool        ok;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (sf->quad && sf->quad == fem->quadrature) PetscFunctionReturn(0);
+  ierr = PetscFESumFactReset_Private(sf);CHKERRQ(ierr);
+  if (!fem->quadrature) PetscFunctionReturn(0);
+  ierr = PetscObjectReference((PetscObject) fem->quadrature);CHKERRQ(ierr);
+  sf->quad = fem->quadrature;
+  ierr = PetscDualSpaceGetDM(fem->dualSpace, &dm);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = PetscDualSpaceGetDeRahm(fem->dualSpace, &form);CHKERRQ(ierr);
+  ierr = PetscDualSpaceGetDimension(fem->dualSpace, &pdim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fem, &Nc);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(sf->quad, &qdim, &qNc, &Nq, &points, &weights);CHKERRQ(ierr);
+  if (form || dim < 1 || dim > 3 || qdim != dim || qNc != 1) PetscFunctionReturn(0);
+  for (nq = 1; PetscPowInt(nq, dim) < Nq; ++nq);
+  if (PetscPowInt(nq, dim) != Nq) PetscFunctionReturn(0);
+  /* The quadrature points */
+  ierr = PetscMalloc4(nq, &xq, pdim, &xn, pdim*dim, &nodes, pdim, &comp);CHKERRQ(ierr);
+  ierr = PetscFESumFactCollectCoordinates_Private(Nq, dim, points, nq, &m, xq, &ok);CHKERRQ(ierr);
+  if (!ok || m != nq) goto cleanup;
+  /* The nodes of the basis, which are point evaluations of a single component */
+  for (j = 0; j < pdim; ++j) {
+    const PetscReal *fpoints, *fweights;
+
+    ierr = PetscDualSpaceGetFunctional(fem->dualSpace, j, &f);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(f, NULL, &fNc, &fNq, &fpoints, &fweights);CHKERRQ(ierr);
+    if (fNq != 1 || fNc != Nc) goto cleanup;
+    for (c = 0, comp[j] = -1; c < Nc; ++c) {
+      if (fweights[c] == 0.0) continue;
+      if (comp[j] >= 0 || PetscAbsReal(fweights[c] - 1.0) > PETSC_SMALL) goto cleanup;
+      comp[j] = c;
+    }
+    if (comp[j] < 0) goto cleanup;
+    for (d = 0; d < dim; ++d) nodes[j*dim+d] = fpoints[d];
+  }
+  ierr = PetscFESumFactCollectCoordinates_Private(pdim, dim, nodes, pdim, &n, xn, &ok);CHKERRQ(ierr);
+  if (!ok || PetscPowInt(n, dim)*Nc != pdim) goto cleanup;
+  Ns = PetscPowInt(n, dim);
+  Nt = Nq;
+  ierr = PetscMalloc4(nq*n, &sf->B, nq*n, &sf->D, pdim, &sf->dofs, Nt, &sf->qpts);CHKERRQ(ierr);
+  for (j = 0; j < pdim; ++j) sf->dofs[j] = -1;
+  for (t = 0; t < Nt; ++t) sf->qpts[t] = -1;
+  for (j = 0; j < pdim; ++j) {
+    s = PetscFESumFactTensorIndex_Private(dim, n, xn, &nodes[j*dim]);
+    if (sf->dofs[s*Nc+comp[j]] >= 0) goto cleanup;
+    sf->dofs[s*Nc+comp[j]] = j;
+  }
+  for (i = 0; i < Nq; ++i) {
+    t = PetscFESumFactTensorIndex_Private(dim, nq, xq, &points[i*dim]);
+    if (sf->qpts[t] >= 0) goto cleanup;
+    sf->qpts[t] = i;
+  }
+  /* The 1D Lagrange polynomials on the nodes and their derivatives at the quadrature points */
+  for (i = 0; i < nq; ++i) {
+    for (a = 0; a < n; ++a) {
+      PetscReal L = 1.0, dL = 0.0;
+
+      for (b = 0; b < n; ++b) {
+        PetscReal p = 1.0;
+
+        if (b == a) continue;
+        L *= (xq[i] - xn[b])/(xn[a] - xn[b]);
+        for (m = 0; m < n; ++m) if (m != a && m != b) p *= (xq[i] - xn[m])/(xn[a] - xn[m]);
+        dL += p/(xn[a] - xn[b]);
+      }
+      sf->B[i*n+a] = L;
+      sf->D[i*n+a] = dL;
+    }
+  }
+  /* Check the tensor products against the tabulation of the element */
+  ierr = PetscFEGetCellTabulation(fem, &T);CHKERRQ(ierr);
+  for (j = 0; j < Nq*pdim*Nc*dim; ++j) scale = PetscMax(scale, PetscAbsReal(T->T[1][j]));
+  for (j = 0; j < Nq*pdim*Nc; ++j) scale = PetscMax(scale, PetscAbsReal(T->T[0][j]));
+  for (t = 0; t < Nt; ++t) {
+    for (s = 0; s < Ns; ++s) {
+      PetscReal val = 1.0, der[3] = {1.0, 1.0, 1.0};
+      PetscInt  tt = t, ss = s;
+
+      for (d = dim-1; d >= 0; --d) {
+        const PetscInt id = tt % nq, ad = ss % n;
+
+        val *= sf->B[id*n+ad];
+        for (k = 0; k < dim; ++k) der[k] *= (k == d ? sf->D[id*n+ad] : sf->B[id*n+ad]);
+        tt /= nq;
+        ss /= n;
+      }
+      for (c = 0; c < Nc; ++c) {
+        const PetscInt q = sf->qpts[t], dof = sf->dofs[s*Nc+c];
+
+        for (cc = 0; cc < Nc; ++cc) {
+          const PetscReal *Tq = &T->T[0][(q*pdim+dof)*Nc+cc];
+          const PetscReal *Dq = &T->T[1][((q*pdim+dof)*Nc+cc)*dim];
+
+          if (PetscAbsReal(Tq[0] - (cc == c ? val : 0.0)) > PETSC_SMALL*scale) goto cleanup;
+          for (k = 0; k < dim; ++k) if (PetscAbsReal(Dq[k] - (cc == c ? der[k] : 0.0)) > PETSC_SMALL*scale) goto cleanup;
+        }
+      }
+    }
+  }
+  ierr = PetscMalloc1(3*PetscPowInt(PetscMax(n, nq), dim), &sf->work);CHKERRQ(ierr);
+  sf->dim    = dim;
+  sf->Nc     = Nc;
+  sf->n      = n;
+  sf->nq     = nq;
+  sf->tensor = PETSC_TRUE;
+  cleanup:
+  ierr = PetscFree4(xq, xn, nodes, comp);CHKERRQ(ierr);
+  if (!sf->tensor) {ierr = PetscFree4(sf->B, sf->D, sf->dofs, sf->qpts);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* Applies the 1D operator M (nq x ldm), or its transpose, in direction k of the tensor in[] of sizes sz[], giving m entries in that direction */
+static void PetscFESumFactApplyDirection_Private(PetscInt dim, const PetscInt sz[], PetscInt k, const PetscReal M[], PetscInt ldm, PetscBool trans, PetscInt m, const PetscScalar in[], PetscScalar out[])
+{
+  const PetscInt nk = sz[k];
+  PetscInt       pre = 1, post = 1, p, i, a, r, d;
+
+  for (d = 0; d < k; ++d) pre *= sz[d];
+  for (d = k+1; d < dim; ++d) post *= sz[d];
+  for (p = 0; p < pre; ++p) {
+    for (i = 0; i < m; ++i) {
+      PetscScalar *o = &out[(p*m+i)*post];
+
+      for (r = 0; r < post; ++r) o[r] = 0.0;
+      for (a = 0; a < nk; ++a) {
+        const PetscReal    mia = trans ? M[a*ldm+i] : M[i*ldm+a];
+        const PetscScalar *v   = &in[(p*nk+a)*post];
+
+        for (r = 0; r < post; ++r) o[r] += mia*v[r];
+      }
+    }
+  }
+}
+
+/*
+  Applies ops[d] in each direction d, from the nodes to the quadrature points, or back if trans is set. The result is
+  in one of the last two work arrays, the first being left for the input.
+*/
+static PetscErrorCode PetscFESumFactApply_Private(PetscFE_SumFact *sf, const PetscReal *ops[], PetscBool trans, const PetscScalar in[], PetscScalar **out)
+{
+  const PetscInt     size = PetscPowInt(PetscMax(sf->n, sf->nq), sf->dim);
+  const PetscInt     nin  = trans ? sf->nq : sf->n, nout = trans ? sf->n : sf->nq;
+  const PetscScalar *src  = in;
+  PetscScalar       *dst  = NULL;
+  PetscInt           sz[3], d;
+  PetscLogDouble     flops = 0.0;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  for (d = 0; d < sf->dim; ++d) sz[d] = nin;
+  for (d = 0; d < sf->dim; ++d) {
+    dst = &sf->work[(1 + d%2)*size];
+    PetscFESumFactApplyDirection_Private(sf->dim, sz, d, ops[d], sf->n, trans, nout, src, dst);
+    flops += 2.0*PetscPowInt(nin, sf->dim-d)*PetscPowInt(nout, d+1);
+    sz[d]  = nout;
+    src    = dst;
+  }
+  *out = dst;
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Evaluates a field and its reference gradient at the quadrature points, u[q*ldu+c] and u_x[(q*ldu+c)*dim+k] */
+static PetscErrorCode PetscFESumFactEvaluate_Private(PetscFE fe, const PetscScalar coef[], PetscInt ldu, PetscScalar u[], PetscScalar u_x[])
+{
+  PetscFE_SumFact *sf  = (PetscFE_SumFact *) fe->data;
+  const PetscInt   dim = sf->dim, Nc = sf->Nc, Ns = PetscPowInt(sf->n, dim), Nt = PetscPowInt(sf->nq, dim);
+  const PetscReal *ops[3];
+  PetscScalar     *U = sf->work, *res;
+  PetscInt         s, t, c, d, k;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  for (c = 0; c < Nc; ++c) {
+    for (s = 0; s < Ns; ++s) U[s] = coef[sf->dofs[s*Nc+c]];
+    if (u) {
+      for (d = 0; d < dim; ++d) ops[d] = sf->B;
+      ierr = PetscFESumFactApply_Private(sf, ops, PETSC_FALSE, U, &res);CHKERRQ(ierr);
+      for (t = 0; t < Nt; ++t) u[sf->qpts[t]*ldu+c] = res[t];
+    }
+    if (u_x) {
+      for (k = 0; k < dim; ++k) {
+        for (d = 0; d < dim; ++d) ops[d] = d == k ? sf->D : sf->B;
+        ierr = PetscFESumFactApply_Private(sf, ops, PETSC_FALSE, U, &res);CHKERRQ(ierr);
+        for (t = 0; t < Nt; ++t) u_x[(sf->qpts[t]*ldu+c)*dim+k] = res[t];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Adds to elemVec the integrals of the test functions against f0[q*ldf+c] and of their reference gradients against f1[(q*ldf+c)*dim+k] */
+static PetscErrorCode PetscFESumFactIntegrate_Private(PetscFE fe, PetscInt ldf, const PetscScalar f0[], const PetscScalar f1[], PetscScalar elemVec[])
+{
+  PetscFE_SumFact *sf  = (PetscFE_SumFact *) fe->data;
+  const PetscInt   dim = sf->dim, Nc = sf->Nc, Ns = PetscPowInt(sf->n, dim), Nt = PetscPowInt(sf->nq, dim);
+  const PetscReal *ops[3];
+  PetscScalar     *G = sf->work, *res;
+  PetscInt         s, t, c, d, k;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  for (c = 0; c < Nc; ++c) {
+    if (f0) {
+      for (t = 0; t < Nt; ++t) G[t] = f0[sf->qpts[t]*ldf+c];
+      for (d = 0; d < dim; ++d) ops[d] = sf->B;
+      ierr = PetscFESumFactApply_Private(sf, ops, PETSC_TRUE, G, &res);CHKERRQ(ierr);
+      for (s = 0; s < Ns; ++s) elemVec[sf->dofs[s*Nc+c]] += res[s];
+    }
+    if (f1) {
+      for (k = 0; k < dim; ++k) {
+        for (t = 0; t < Nt; ++t) G[t] = f1[(sf->qpts[t]*ldf+c)*dim+k];
+        for (d = 0; d < dim; ++d) ops[d] = d == k ? sf->D : sf->B;
+        ierr = PetscFESumFactApply_Private(sf, ops, PETSC_TRUE, G, &res);CHKERRQ(ierr);
+        for (s = 0; s < Ns; ++s) elemVec[sf->dofs[s*Nc+c]] += res[s];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Whether fe is a tensor product element of this type */
+static PetscErrorCode PetscFESumFactIsTensor_Private(PetscFE fe, PetscBool *tensor)
+{
+  PetscBool      match;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *tensor = PETSC_FALSE;
+  ierr = PetscObjectTypeCompare((PetscObject) fe, PETSCFESUMFACT, &match);CHKERRQ(ierr);
+  if (!match) PetscFunctionReturn(0);
+  ierr = PetscFESumFactSetUpTensor_Private(fe);CHKERRQ(ierr);
+  *tensor = ((PetscFE_SumFact *) fe->data)->tensor;
+  PetscFunctionReturn(0);
+}
+
+/*
+  The sum factorization kernels are used when the test field, and the basis field if given, are tensor product
+  elements, the cells are not embedded in a higher dimension, and all fields, including the auxiliary ones, are finite
+  elements using the same quadrature points. The fields that are not tensor product elements are evaluated with their
+  tabulations.
+*/
+static PetscErrorCode PetscFESumFactUsable_Private(PetscDS ds, PetscDS dsAux, PetscFE feI, PetscFE feJ, PetscFEGeom *cgeom, PetscBool *usable)
+{
+  PetscDS          dss[2];
+  PetscQuadrature  quad;
+  const PetscReal *points;
+  PetscInt         dim, Nq, s, f, Nf;
+  PetscBool        tensor;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  *usable = PETSC_FALSE;
+  ierr = PetscFESumFactIsTensor_Private(feI, &tensor);CHKERRQ(ierr);
+  if (!tensor) PetscFunctionReturn(0);
+  if (feJ) {
+    ierr = PetscFESumFactIsTensor_Private(feJ, &tensor);CHKERRQ(ierr);
+    if (!tensor) PetscFunctionReturn(0);
+  }
+  if (cgeom->dim != cgeom->dimEmbed || cgeom->dim != ((PetscFE_SumFact *) feI->data)->dim) PetscFunctionReturn(0);
+  ierr = PetscFEGetQuadrature(feI, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, &dim, NULL, &Nq, &points, NULL);CHKERRQ(ierr);
+  if (cgeom->numPoints != 1 && cgeom->numPoints != Nq) PetscFunctionReturn(0);
+  dss[0] = ds;
+  dss[1] = dsAux;
+  for (s = 0; s < 2; ++s) {
+    if (!dss[s]) continue;
+    ierr = PetscDSGetNumFields(dss[s], &Nf);CHKERRQ(ierr);
+    for (f = 0; f < Nf; ++f) {
+      PetscObject      obj;
+      PetscClassId     id;
+      PetscQuadrature  fquad;
+      const PetscReal *fpoints;
+      PetscInt         fdim, fNq;
+      PetscBool        same;
+
+      ierr = PetscDSGetDiscretization(dss[s], f, &obj);CHKERRQ(ierr);
+      if (!obj) PetscFunctionReturn(0);
+      ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+      if (id != PETSCFE_CLASSID) PetscFunctionReturn(0);
+      ierr = PetscFEGetQuadrature((PetscFE) obj, &fquad);CHKERRQ(ierr);
+      if (fquad == quad) continue;
+      ierr = PetscQuadratureGetData(fquad, &fdim, NULL, &fNq, &fpoints, NULL);CHKERRQ(ierr);
+      if (fdim != dim || fNq != Nq) PetscFunctionReturn(0);
+      ierr = PetscArraycmp(points, fpoints, Nq*dim, &same);CHKERRQ(ierr);
+      if (!same) PetscFunctionReturn(0);
+    }
+  }
+  *usable = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* The batched pointwise functions are integrated by PETSCFEBASIC, the residual being given by fieldJ < 0 */
+static PetscErrorCode PetscFESumFactHasBatch_Private(PetscDS ds, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscBool *hasBatch)
+{
+  PetscPointFuncBatch f0, f1;
+  PetscPointJacBatch  g0, g1, g2, g3;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  *hasBatch = PETSC_FALSE;
+  if (fieldJ < 0) {
+    ierr = PetscDSGetResidualBatch(ds, fieldI, &f0, &f1);CHKERRQ(ierr);
+    if (f0 || f1) *hasBatch = PETSC_TRUE;
+  } else if (jtype == PETSCFE_JACOBIAN) {
+    ierr = PetscDSGetJacobianBatch(ds, fieldI, fieldJ, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
+    if (g0 || g1 || g2 || g3) *hasBatch = PETSC_TRUE;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Evaluates all fields of ds and their reference gradients at the quadrature points for one element, u[q*Nc+c] and u_x[(q*Nc+c)*dim+k] where Nc is the total number of components */
+static PetscErrorCode PetscFESumFactEvaluateFields_Private(PetscDS ds, PetscInt Nq, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt      *uOff;
+  PetscInt       Nf, NcT, f, fOff = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscFE        fe;
+    PetscTabulation T;
+    PetscInt       Nb, Nc, dim, q, b, c, d;
+    PetscBool      tensor;
+
+    ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
+    ierr = PetscFESumFactIsTensor_Private(fe, &tensor);CHKERRQ(ierr);
+    if (tensor) {
+      const PetscInt dim = ((PetscFE_SumFact *) fe->data)->dim;
+
+      ierr = PetscFESumFactEvaluate_Private(fe, &coefficients[fOff], NcT, &u[uOff[f]], &u_x[uOff[f]*dim]);CHKERRQ(ierr);
+      if (u_t) {ierr = PetscFESumFactEvaluate_Private(fe, &coefficients_t[fOff], NcT, &u_t[uOff[f]], NULL);CHKERRQ(ierr);}
+    } else {
+      ierr = PetscFEGetCellTabulation(fe, &T);CHKERRQ(ierr);
+      Nc  = T->Nc;
+      dim = T->cdim;
+      for (q = 0; q < Nq; ++q) {
+        const PetscReal *Bq = &T->T[0][q*Nb*Nc], *Dq = &T->T[1][q*Nb*Nc*dim];
+
+        for (c = 0; c < Nc; ++c) {
+          u[q*NcT+uOff[f]+c] = 0.0;
+          if (u_t) u_t[q*NcT+uOff[f]+c] = 0.0;
+          for (d = 0; d < dim; ++d) u_x[(q*NcT+uOff[f]+c)*dim+d] = 0.0;
+        }
+        for (b = 0; b < Nb; ++b) {
+          for (c = 0; c < Nc; ++c) {
+            u[q*NcT+uOff[f]+c] += Bq[b*Nc+c]*coefficients[fOff+b];
+            if (u_t) u_t[q*NcT+uOff[f]+c] += Bq[b*Nc+c]*coefficients_t[fOff+b];
+            for (d = 0; d < dim; ++d) u_x[(q*NcT+uOff[f]+c)*dim+d] += Dq[(b*Nc+c)*dim+d]*coefficients[fOff+b];
+          }
+        }
+      }
+    }
+    fOff += Nb;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Sets the geometry of the quadrature point q of element e, as in the basic kernels */
+static void PetscFESumFactGetPointGeometry_Private(PetscFEGeom *cgeom, PetscInt e, PetscInt q, const PetscReal quadPoints[], PetscReal x[], PetscFEGeom *fegeom)
+{
+  const PetscInt Np = cgeom->numPoints, dE = cgeom->dimEmbed, dim = cgeom->dim;
+
+  fegeom->dim      = cgeom->dim;
+  fegeom->dimEmbed = cgeom->dimEmbed;
+  if (cgeom->isAffine) {
+    fegeom->v    = x;
+    fegeom->xi   = cgeom->xi;
+    fegeom->J    = &cgeom->J[e*Np*dE*dE];
+    fegeom->invJ = &cgeom->invJ[e*Np*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e*Np];
+    CoordinatesRefToReal(dE, dim, fegeom->xi, &cgeom->v[e*Np*dE], fegeom->J, &quadPoints[q*dim], x);
+  } else {
+    fegeom->v    = &cgeom->v[(e*Np+q)*dE];
+    fegeom->J    = &cgeom->J[(e*Np+q)*dE*dE];
+    fegeom->invJ = &cgeom->invJ[(e*Np+q)*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e*Np+q];
+  }
+}
+
+/* Maps the reference values and gradients of all fields of ds at one point to real space */
+static PetscErrorCode PetscFESumFactPushforward_Private(PetscDS ds, PetscFEGeom *fegeom, PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt      *uOff, *uOff_x;
+  PetscInt       Nf, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscFE fe;
+
+    ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEPushforward(fe, fegeom, 1, &u[uOff[f]]);CHKERRQ(ierr);
+    ierr = PetscFEPushforwardGradient(fe, fegeom, 1, &u_x[uOff_x[f]]);CHKERRQ(ierr);
+    if (u_t) {ierr = PetscFEPushforward(fe, fegeom, 1, &u_t[uOff[f]]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Scales the real gradient terms f1[c*dim+d] by w and maps them to the reference gradients of the test functions */
+PETSC_STATIC_INLINE void PetscFESumFactPullback_Private(PetscInt dim, PetscInt Nc, const PetscReal invJ[], PetscReal w, PetscScalar f1[])
+{
+  PetscScalar tmp[3];
+  PetscInt    c, d, k;
+
+  for (c = 0; c < Nc; ++c) {
+    for (d = 0; d < dim; ++d) tmp[d] = f1[c*dim+d];
+    for (k = 0; k < dim; ++k) {
+      f1[c*dim+k] = 0.0;
+      for (d = 0; d < dim; ++d) f1[c*dim+k] += invJ[k*dim+d]*tmp[d];
+      f1[c*dim+k] *= w;
+    }
+  }
+}
+
+static PetscErrorCode PetscFEIntegrateResidual_SumFact(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                                       const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscFE            fe;
+  PetscPointFunc     f0_func, f1_func;
+  PetscQuadrature    quad;
+  PetscScalar       *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *f0, *f1;
+  const PetscScalar *constants;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscReal          x[3];
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, NcT, NcTAux = 0, Nc, Nb, totDim, totDimAux = 0, cOffset = 0, cOffsetAux = 0, fOffset, Nq, e, q, b, c;
+  PetscBool          usable, hasBatch;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFESumFactUsable_Private(ds, dsAux, fe, NULL, cgeom, &usable);CHKERRQ(ierr);
+  if (usable) {
+    ierr = PetscFESumFactHasBatch_Private(ds, PETSCFE_JACOBIAN, field, -1, &hasBatch);CHKERRQ(ierr);
+    usable = hasBatch ? PETSC_FALSE : PETSC_TRUE;
+  }
+  if (!usable) {
+    ierr = PetscFEIntegrateResidual_Basic(ds, field, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscDSGetResidual(ds, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  if (!f0_func && !f1_func) PetscFunctionReturn(0);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &NcTAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc4(Nq*NcT, &u, Nq*NcT*dim, &u_x, Nq*Nc, &f0, Nq*Nc*dim, &f1);CHKERRQ(ierr);
+  if (coefficients_t) {ierr = PetscMalloc1(Nq*NcT, &u_t);CHKERRQ(ierr);}
+  if (dsAux) {ierr = PetscMalloc2(Nq*NcTAux, &a, Nq*NcTAux*dim, &a_x);CHKERRQ(ierr);}
+  for (e = 0; e < Ne; ++e) {
+    ierr = PetscFESumFactEvaluateFields_Private(ds, Nq, &coefficients[cOffset], coefficients_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);
+    if (dsAux) {ierr = PetscFESumFactEvaluateFields_Private(dsAux, Nq, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);}
+    ierr = PetscArrayzero(f0, Nq*Nc);CHKERRQ(ierr);
+    ierr = PetscArrayzero(f1, Nq*Nc*dim);CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      PetscFEGeom fegeom;
+      PetscReal   w;
+
+      PetscFESumFactGetPointGeometry_Private(cgeom, e, q, quadPoints, x, &fegeom);
+      w    = fegeom.detJ[0]*quadWeights[q];
+      ierr = PetscFESumFactPushforward_Private(ds, &fegeom, &u[q*NcT], &u_x[q*NcT*dim], u_t ? &u_t[q*NcT] : NULL);CHKERRQ(ierr);
+      if (dsAux) {ierr = PetscFESumFactPushforward_Private(dsAux, &fegeom, &a[q*NcTAux], &a_x[q*NcTAux*dim], NULL);CHKERRQ(ierr);}
+      if (f0_func) {
+        f0_func(dim, Nf, NfAux, uOff, uOff_x, &u[q*NcT], u_t ? &u_t[q*NcT] : NULL, &u_x[q*NcT*dim], aOff, aOff_x, a ? &a[q*NcTAux] : NULL, NULL, a_x ? &a_x[q*NcTAux*dim] : NULL, t, fegeom.v, numConstants, constants, &f0[q*Nc]);
+        for (c = 0; c < Nc; ++c) f0[q*Nc+c] *= w;
+      }
+      if (f1_func) {
+        f1_func(dim, Nf, NfAux, uOff, uOff_x, &u[q*NcT], u_t ? &u_t[q*NcT] : NULL, &u_x[q*NcT*dim], aOff, aOff_x, a ? &a[q*NcTAux] : NULL, NULL, a_x ? &a_x[q*NcTAux*dim] : NULL, t, fegeom.v, numConstants, constants, &f1[q*Nc*dim]);
+        PetscFESumFactPullback_Private(dim, Nc, fegeom.invJ, w, &f1[q*Nc*dim]);
+      }
+    }
+    for (b = 0; b < Nb; ++b) elemVec[cOffset+fOffset+b] = 0.0;
+    ierr = PetscFESumFactIntegrate_Private(fe, Nc, f0_func ? f0 : NULL, f1_func ? f1 : NULL, &elemVec[cOffset+fOffset]);CHKERRQ(ierr);
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+  }
+  ierr = PetscFree4(u, u_x, f0, f1);CHKERRQ(ierr);
+  ierr = PetscFree(u_t);CHKERRQ(ierr);
+  ierr = PetscFree2(a, a_x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The pointwise Jacobian functions of the given type */
+static PetscErrorCode PetscFESumFactGetJacobian_Private(PetscDS ds, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscPointJac *g0, PetscPointJac *g1, PetscPointJac *g2, PetscPointJac *g3)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  switch (jtype) {
+  case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(ds, fieldI, fieldJ, g0, g1, g2, g3);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(ds, fieldI, fieldJ, g0, g1, g2, g3);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, g0, g1, g2, g3);CHKERRQ(ierr);break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  Computes the weighted pointwise Jacobian at every quadrature point of element e, with the derivatives taken with respect
+  to the reference coordinates: g0[(q*NcI+fc)*NcJ+gc], g1 and g2 with a trailing index k < dim, and g3 with two
+*/
+static PetscErrorCode PetscFESumFactComputePointJacobian_Private(PetscDS ds, PetscDS dsAux, PetscPointJac g_func[], PetscFEGeom *cgeom, PetscInt e, PetscInt Nq, const PetscReal quadPoints[], const PetscReal quadWeights[],
+                                                                 PetscInt NcI, PetscInt NcJ, PetscScalar u[], PetscScalar u_t[], PetscScalar u_x[], PetscScalar a[], PetscScalar a_x[], PetscReal t, PetscReal u_tshift,
+                                                                 PetscScalar g0[], PetscScalar g1[], PetscScalar g2[], PetscScalar g3[])
+{
+  const PetscScalar *constants;
+  PetscScalar       *tmp;
+  PetscReal          x[3];
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim = cgeom->dim, numConstants, Nf, NfAux = 0, NcT, NcTAux = 0, q, i, k, l, d, m;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &NcTAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(NcI*NcJ*dim*dim, &tmp);CHKERRQ(ierr);
+  for (q = 0; q < Nq; ++q) {
+    const PetscInt n = NcI*NcJ;
+    PetscFEGeom    fegeom;
+    PetscReal      w;
+
+    PetscFESumFactGetPointGeometry_Private(cgeom, e, q, quadPoints, x, &fegeom);
+    w = fegeom.detJ[0]*quadWeights[q];
+    if (u) {ierr = PetscFESumFactPushforward_Private(ds, &fegeom, &u[q*NcT], &u_x[q*NcT*dim], u_t ? &u_t[q*NcT] : NULL);CHKERRQ(ierr);}
+    if (dsAux) {ierr = PetscFESumFactPushforward_Private(dsAux, &fegeom, &a[q*NcTAux], &a_x[q*NcTAux*dim], NULL);CHKERRQ(ierr);}
+#define PetscFESumFactCallPointJac(g) g(dim, Nf, NfAux, uOff, uOff_x, u ? &u[q*NcT] : NULL, u_t ? &u_t[q*NcT] : NULL, u ? &u_x[q*NcT*dim] : NULL, aOff, aOff_x, a ? &a[q*NcTAux] : NULL, NULL, a_x ? &a_x[q*NcTAux*dim] : NULL, t, u_tshift, fegeom.v, numConstants, constants, tmp)
+    if (g_func[0]) {
+      ierr = PetscArrayzero(tmp, n);CHKERRQ(ierr);
+      PetscFESumFactCallPointJac(g_func[0]);
+      for (i = 0; i < n; ++i) g0[q*n+i] = w*tmp[i];
+    }
+    if (g_func[1] || g_func[2]) {
+      for (m = 1; m < 3; ++m) {
+        PetscScalar *g = m == 1 ? g1 : g2;
+
+        if (!g_func[m]) continue;
+        ierr = PetscArrayzero(tmp, n*dim);CHKERRQ(ierr);
+        PetscFESumFactCallPointJac(g_func[m]);
+        for (i = 0; i < n; ++i) {
+          for (k = 0; k < dim; ++k) {
+            g[(q*n+i)*dim+k] = 0.0;
+            for (d = 0; d < dim; ++d) g[(q*n+i)*dim+k] += tmp[i*dim+d]*fegeom.invJ[k*dim+d];
+            g[(q*n+i)*dim+k] *= w;
+          }
+        }
+      }
+    }
+    if (g_func[3]) {
+      ierr = PetscArrayzero(tmp, n*dim*dim);CHKERRQ(ierr);
+      PetscFESumFactCallPointJac(g_func[3]);
+      for (i = 0; i < n; ++i) {
+        for (k = 0; k < dim; ++k) {
+          for (l = 0; l < dim; ++l) {
+            PetscScalar v = 0.0;
+
+            for (d = 0; d < dim; ++d) for (m = 0; m < dim; ++m) v += fegeom.invJ[k*dim+d]*tmp[(i*dim+d)*dim+m]*fegeom.invJ[l*dim+m];
+            g3[((q*n+i)*dim+k)*dim+l] = w*v;
+          }
+        }
+      }
+    }
+#undef PetscFESumFactCallPointJac
+  }
+  ierr = PetscFree(tmp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Forms the integrands for the test functions, f0[q*NcI+fc] and f1[(q*NcI+fc)*dim+k], from the reference value and
+  gradient of a basis function of component gc, or of a field if gc < 0, at the quadrature points
+*/
+static void PetscFESumFactContract_Private(PetscInt dim, PetscInt Nq, PetscInt NcI, PetscInt NcJ, PetscInt gc, PetscPointJac g_func[], const PetscScalar g0[], const PetscScalar g1[], const PetscScalar g2[], const PetscScalar g3[],
+                                           const PetscScalar v[], const PetscScalar v_x[], PetscScalar f0[], PetscScalar f1[])
+{
+  const PetscInt gStart = gc < 0 ? 0 : gc, gEnd = gc < 0 ? NcJ : gc+1;
+  PetscInt       q, fc, c, k, l;
+
+  for (q = 0; q < Nq; ++q) {
+    for (fc = 0; fc < NcI; ++fc) {
+      PetscScalar s0 = 0.0;
+
+      for (c = gStart; c < gEnd; ++c) {
+        const PetscInt    i   = (q*NcI+fc)*NcJ+c;
+        const PetscScalar val = gc < 0 ? v[q*NcJ+c] : v[q];
+        const PetscScalar *dv = gc < 0 ? &v_x[(q*NcJ+c)*dim] : &v_x[q*dim];
+
+        if (g_func[0]) s0 += g0[i]*val;
+        if (g_func[1]) for (k = 0; k < dim; ++k) s0 += g1[i*dim+k]*dv[k];
+        for (k = 0; k < dim; ++k) {
+          PetscScalar s1 = 0.0;
+
+          if (g_func[2]) s1 += g2[i*dim+k]*val;
+          if (g_func[3]) for (l = 0; l < dim; ++l) s1 += g3[(i*dim+k)*dim+l]*dv[l];
+          f1[(q*NcI+fc)*dim+k] += s1;
+        }
+      }
+      f0[q*NcI+fc] += s0;
+    }
+  }
+}
+
+static PetscErrorCode PetscFEIntegrateJacobian_SumFact(PetscDS ds, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *cgeom,
+                                                       const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  PetscFE            feI, feJ;
+  PetscFE_SumFact   *sfJ;
+  PetscPointJac      g_func[4];
+  PetscQuadrature    quad;
+  PetscScalar       *u = NULL, *u_t = NULL, *u_x = NULL, *a = NULL, *a_x = NULL, *g0, *g1, *g2, *g3, *phi, *phi_x, *f0, *f1, *col;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           dim, NcT, NcTAux = 0, NcI, NcJ, NbI, totDim, totDimAux = 0, offsetI, offsetJ, Nq, nJ, NsJ, e, s, tq, gc, b, d, k;
+  PetscInt           cOffset = 0, cOffsetAux = 0, eOffset = 0;
+  PetscBool          usable, hasBatch;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, fieldI, (PetscObject *) &feI);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(ds, fieldJ, (PetscObject *) &feJ);CHKERRQ(ierr);
+  ierr = PetscFESumFactUsable_Private(ds, dsAux, feI, feJ, cgeom, &usable);CHKERRQ(ierr);
+  if (usable) {
+    ierr = PetscFESumFactHasBatch_Private(ds, jtype, fieldI, fieldJ, &hasBatch);CHKERRQ(ierr);
+    usable = hasBatch ? PETSC_FALSE : PETSC_TRUE;
+  }
+  if (!usable) {
+    ierr = PetscFEIntegrateJacobian_Basic(ds, jtype, fieldI, fieldJ, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, u_tshift, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscFESumFactGetJacobian_Private(ds, jtype, fieldI, fieldJ, &g_func[0], &g_func[1], &g_func[2], &g_func[3]);CHKERRQ(ierr);
+  if (!g_func[0] && !g_func[1] && !g_func[2] && !g_func[3]) PetscFunctionReturn(0);
+  sfJ = (PetscFE_SumFact *) feJ->data;
+  ierr = PetscFEGetSpatialDimension(feI, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(feI, &NcI);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(feJ, &NcJ);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(feI, &NbI);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(feI, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldJ, &offsetJ);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &NcTAux);CHKERRQ(ierr);
+  }
+  nJ  = sfJ->n;
+  NsJ = PetscPowInt(nJ, dim);
+  if (coefficients) {ierr = PetscMalloc2(Nq*NcT, &u, Nq*NcT*dim, &u_x);CHKERRQ(ierr);}
+  if (coefficients && coefficients_t) {ierr = PetscMalloc1(Nq*NcT, &u_t);CHKERRQ(ierr);}
+  if (dsAux) {ierr = PetscMalloc2(Nq*NcTAux, &a, Nq*NcTAux*dim, &a_x);CHKERRQ(ierr);}
+  ierr = PetscMalloc4(Nq*NcI*NcJ, &g0, Nq*NcI*NcJ*dim, &g1, Nq*NcI*NcJ*dim, &g2, Nq*NcI*NcJ*dim*dim, &g3);CHKERRQ(ierr);
+  ierr = PetscMalloc5(Nq, &phi, Nq*dim, &phi_x, Nq*NcI, &f0, Nq*NcI*dim, &f1, NbI, &col);CHKERRQ(ierr);
+  for (e = 0; e < Ne; ++e) {
+    if (coefficients) {ierr = PetscFESumFactEvaluateFields_Private(ds, Nq, &coefficients[cOffset], u_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);}
+    if (dsAux) {ierr = PetscFESumFactEvaluateFields_Private(dsAux, Nq, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);}
+    ierr = PetscFESumFactComputePointJacobian_Private(ds, dsAux, g_func, cgeom, e, Nq, quadPoints, quadWeights, NcI, NcJ, u, u_t, u_x, a, a_x, t, u_tshift, g0, g1, g2, g3);CHKERRQ(ierr);
+    /* Each column is the integral of the test functions against the integrands of a basis function, which is a product of 1D ones */
+    for (s = 0; s < NsJ; ++s) {
+      for (tq = 0; tq < Nq; ++tq) {
+        const PetscInt q = sfJ->qpts[tq];
+        PetscInt       tt = tq, ss = s;
+
+        phi[q] = 1.0;
+        for (k = 0; k < dim; ++k) phi_x[q*dim+k] = 1.0;
+        for (d = dim-1; d >= 0; --d) {
+          const PetscInt id = tt % sfJ->nq, ad = ss % nJ;
+
+          phi[q] *= sfJ->B[id*nJ+ad];
+          for (k = 0; k < dim; ++k) phi_x[q*dim+k] *= (k == d ? sfJ->D[id*nJ+ad] : sfJ->B[id*nJ+ad]);
+          tt /= sfJ->nq;
+          ss /= nJ;
+        }
+      }
+      for (gc = 0; gc < NcJ; ++gc) {
+        const PetscInt j = offsetJ + sfJ->dofs[s*NcJ+gc];
+
+        ierr = PetscArrayzero(f0, Nq*NcI);CHKERRQ(ierr);
+        ierr = PetscArrayzero(f1, Nq*NcI*dim);CHKERRQ(ierr);
+        ierr = PetscArrayzero(col, NbI);CHKERRQ(ierr);
+        PetscFESumFactContract_Private(dim, Nq, NcI, NcJ, gc, g_func, g0, g1, g2, g3, phi, phi_x, f0, f1);
+        ierr = PetscFESumFactIntegrate_Private(feI, NcI, g_func[0] || g_func[1] ? f0 : NULL, g_func[2] || g_func[3] ? f1 : NULL, col);CHKERRQ(ierr);
+        for (b = 0; b < NbI; ++b) elemMat[eOffset+(offsetI+b)*totDim+j] += col[b];
+      }
+    }
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+    eOffset    += PetscSqr(totDim);
+  }
+  ierr = PetscFree2(u, u_x);CHKERRQ(ierr);
+  ierr = PetscFree(u_t);CHKERRQ(ierr);
+  ierr = PetscFree2(a, a_x);CHKERRQ(ierr);
+  ierr = PetscFree4(g0, g1, g2, g3);CHKERRQ(ierr);
+  ierr = PetscFree5(phi, phi_x, f0, f1, col);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateJacobianAction_SumFact(PetscDS ds, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *cgeom,
+                                                             const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift,
+                                                             const PetscScalar y[], PetscScalar elemVec[])
+{
+  PetscFE            feI, feJ;
+  PetscPointJac      g_func[4];
+  PetscQuadrature    quad;
+  PetscScalar       *u = NULL, *u_t = NULL, *u_x = NULL, *a = NULL, *a_x = NULL, *g0, *g1, *g2, *g3, *v, *v_x, *f0, *f1;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           dim, NcT, NcTAux = 0, NcI, NcJ, totDim, totDimAux = 0, offsetI, offsetJ, Nq, e;
+  PetscInt           cOffset = 0, cOffsetAux = 0;
+  PetscBool          usable, hasBatch;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, fieldI, (PetscObject *) &feI);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(ds, fieldJ, (PetscObject *) &feJ);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldJ, &offsetJ);CHKERRQ(ierr);
+  if (dsAux) {ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);}
+  ierr = PetscFESumFactUsable_Private(ds, dsAux, feI, feJ, cgeom, &usable);CHKERRQ(ierr);
+  if (usable) {
+    ierr = PetscFESumFactHasBatch_Private(ds, jtype, fieldI, fieldJ, &hasBatch);CHKERRQ(ierr);
+    usable = hasBatch ? PETSC_FALSE : PETSC_TRUE;
+  }
+  if (!usable) {
+    PetscScalar *elemMat;
+    PetscFEGeom *chunkGeom;
+    PetscInt     i, j;
+
+    /* Form and apply the element matrices one at a time */
+    ierr = PetscMalloc1(totDim*totDim, &elemMat);CHKERRQ(ierr);
+    for (e = 0; e < Ne; ++e) {
+      ierr = PetscArrayzero(elemMat, totDim*totDim);CHKERRQ(ierr);
+      ierr = PetscFEGeomGetChunk(cgeom, e, e+1, &chunkGeom);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobian_Basic(ds, jtype, fieldI, fieldJ, 1, chunkGeom, &coefficients[e*totDim], coefficients_t ? &coefficients_t[e*totDim] : NULL, dsAux, dsAux ? &coefficientsAux[e*totDimAux] : NULL, t, u_tshift, elemMat);CHKERRQ(ierr);
+      ierr = PetscFEGeomRestoreChunk(cgeom, e, e+1, &chunkGeom);CHKERRQ(ierr);
+      for (i = 0; i < totDim; ++i) for (j = 0; j < totDim; ++j) elemVec[e*totDim+i] += elemMat[i*totDim+j]*y[e*totDim+j];
+    }
+    ierr = PetscFree(elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscFESumFactGetJacobian_Private(ds, jtype, fieldI, fieldJ, &g_func[0], &g_func[1], &g_func[2], &g_func[3]);CHKERRQ(ierr);
+  if (!g_func[0] && !g_func[1] && !g_func[2] && !g_func[3]) PetscFunctionReturn(0);
+  ierr = PetscFEGetSpatialDimension(feI, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(feI, &NcI);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(feJ, &NcJ);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(feI, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &NcT);CHKERRQ(ierr);
+  if (dsAux) {ierr = PetscDSGetTotalComponents(dsAux, &NcTAux);CHKERRQ(ierr);}
+  if (coefficients) {ierr = PetscMalloc2(Nq*NcT, &u, Nq*NcT*dim, &u_x);CHKERRQ(ierr);}
+  if (coefficients && coefficients_t) {ierr = PetscMalloc1(Nq*NcT, &u_t);CHKERRQ(ierr);}
+  if (dsAux) {ierr = PetscMalloc2(Nq*NcTAux, &a, Nq*NcTAux*dim, &a_x);CHKERRQ(ierr);}
+  ierr = PetscMalloc4(Nq*NcI*NcJ, &g0, Nq*NcI*NcJ*dim, &g1, Nq*NcI*NcJ*dim, &g2, Nq*NcI*NcJ*dim*dim, &g3);CHKERRQ(ierr);
+  ierr = PetscMalloc4(Nq*NcJ, &v, Nq*NcJ*dim, &v_x, Nq*NcI, &f0, Nq*NcI*dim, &f1);CHKERRQ(ierr);
+  for (e = 0; e < Ne; ++e) {
+    if (coefficients) {ierr = PetscFESumFactEvaluateFields_Private(ds, Nq, &coefficients[cOffset], u_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);}
+    if (dsAux) {ierr = PetscFESumFactEvaluateFields_Private(dsAux, Nq, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);}
+    ierr = PetscFESumFactComputePointJacobian_Private(ds, dsAux, g_func, cgeom, e, Nq, quadPoints, quadWeights, NcI, NcJ, u, u_t, u_x, a, a_x, t, u_tshift, g0, g1, g2, g3);CHKERRQ(ierr);
+    /* The reference gradient of the input is contracted with the reference gradients in g1 and g3 */
+    ierr = PetscFESumFactEvaluate_Private(feJ, &y[cOffset+offsetJ], NcJ, v, v_x);CHKERRQ(ierr);
+    ierr = PetscArrayzero(f0, Nq*NcI);CHKERRQ(ierr);
+    ierr = PetscArrayzero(f1, Nq*NcI*dim);CHKERRQ(ierr);
+    PetscFESumFactContract_Private(dim, Nq, NcI, NcJ, -1, g_func, g0, g1, g2, g3, v, v_x, f0, f1);
+    ierr = PetscFESumFactIntegrate_Private(feI, NcI, g_func[0] || g_func[1] ? f0 : NULL, g_func[2] || g_func[3] ? f1 : NULL, &elemVec[cOffset+offsetI]);CHKERRQ(ierr);
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+  }
+  ierr = PetscFree2(u, u_x);CHKERRQ(ierr);
+  ierr = PetscFree(u_t);CHKERRQ(ierr);
+  ierr = PetscFree2(a, a_x);CHKERRQ(ierr);
+  ierr = PetscFree4(g0, g1, g2, g3);CHKERRQ(ierr);
+  ierr = PetscFree4(v, v_x, f0, f1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEView_SumFact_Ascii(PetscFE fe, PetscViewer v)
+{
+  PetscFE_SumFact *sf = (PetscFE_SumFact *) fe->data;
+  PetscInt         dim, Nc;
+  PetscSpace       basis = NULL;
+  PetscDualSpace   dual = NULL;
+  PetscQuadrature  quad = NULL;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetBasisSpace(fe, &basis);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe, &dual);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  if (fe->setupcalled) {ierr = PetscFESumFactSetUpTensor_Private(fe);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPushTab(v);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(v, "Sum factorization Finite Element in %D dimensions with %D components\n", dim, Nc);CHKERRQ(ierr);
+  if (sf->tensor) {ierr = PetscViewerASCIIPrintf(v, "Tensor product basis with %D nodes and %D quadrature points in each direction\n", sf->n, sf->nq);CHKERRQ(ierr);}
+  else            {ierr = PetscViewerASCIIPrintf(v, "Not a tensor product basis and quadrature, integrated with the basic kernels\n");CHKERRQ(ierr);}
+  if (basis) {ierr = PetscSpaceView(basis, v);CHKERRQ(ierr);}
+  if (dual)  {ierr = PetscDualSpaceView(dual, v);CHKERRQ(ierr);}
+  if (quad)  {ierr = PetscQuadratureView(quad, v);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPopTab(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEView_SumFact(PetscFE fe, PetscViewer v)
+{
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject) v, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {ierr = PetscFEView_SumFact_Ascii(fe, v);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEInitialize_SumFact(PetscFE fem)
+{
+  PetscFunctionBegin;
+  fem->ops->setfromoptions          = NULL;
+  fem->ops->setup                   = PetscFESetUp_Basic;
+  fem->ops->view                    = PetscFEView_SumFact;
+  fem->ops->destroy                 = PetscFEDestroy_SumFact;
+  fem->ops->getdimension            = PetscFEGetDimension_Basic;
+  fem->ops->createtabulation        = PetscFECreateTabulation_Basic;
+  fem->ops->integrate               = PetscFEIntegrate_Basic;
+  fem->ops->integratebd             = PetscFEIntegrateBd_Basic;
+  fem->ops->integrateresidual       = PetscFEIntegrateResidual_SumFact;
+  fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
+  fem->ops->integratehybridresidual = PetscFEIntegrateHybridResidual_Basic;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_SumFact;
+  fem->ops->integratejacobian       = PetscFEIntegrateJacobian_SumFact;
+  fem->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
+  fem->ops->integratehybridjacobian = PetscFEIntegrateHybridJacobian_Basic;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCFESUMFACT = "sumfact" - A PetscFE object that integrates tensor product elements by sum factorization
+
+  Notes:
+  When the element is a Lagrange element on a tensor product cell whose basis is the tensor product of 1D Lagrange
+  polynomials, and its quadrature is a tensor product as well, the values and gradients of the fields at the
+  quadrature points are computed, and the test functions integrated, one direction at a time. For Q_p elements this
+  costs O(p^{d+1}) operations per element instead of O(p^{2d}). Element matrices are computed one column at a time,
+  and PetscFEIntegrateJacobianAction() applies the Jacobian without forming them, which DMSNESCreateJacobianMF() uses
+  for a matrix-free operator. Other elements, and boundary integrals, are integrated as with PETSCFEBASIC.
+
+  Options Database:
+. -petscfe_type sumfact - selects this type
+
+  Level: intermediate
+
+.seealso: PetscFEType, PetscFECreate(), PetscFESetType(), PETSCFEBASIC, PetscFEIntegrateJacobianAction(), DMSNESCreateJacobianMF()
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscFECreate_SumFact(PetscFE fem)
+{
+  PetscFE_SumFact *sf;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  ierr      = PetscNewLog(fem, &sf);CHKERRQ(ierr);
+  fem->data = sf;
+
+  ierr = PetscFEInitialize_SumFact(fem);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
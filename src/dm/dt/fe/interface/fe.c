@@ -1558,6 +1558,51 @@ PetscErrorCode PetscFEIntegrateJacobian(PetscDS prob, PetscFEJacobianType jtype,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscFEIntegrateJacobianAction - Apply the element Jacobian for a chunk of elements to element vectors by quadrature integration
+
+  Not collective
+
+  Input Parameters:
++ prob         - The PetscDS specifying the discretizations and continuum functions
+. jtype        - The type of matrix pointwise functions that should be used
+. fieldI       - The test field being integrated
+. fieldJ       - The basis field being integrated
+. Ne           - The number of elements in the chunk
+. cgeom        - The cell geometry for each cell in the chunk
+. coefficients - The array of FEM basis coefficients for the elements for the Jacobian evaluation point
+. coefficients_t - The array of FEM basis time derivative coefficients for the elements
+. probAux      - The PetscDS specifying the auxiliary discretizations
+. coefficientsAux - The array of FEM auxiliary basis coefficients for the elements
+. t            - The time
+. u_tShift     - A multiplier for the dF/du_t term (as opposed to the dF/du term)
+- y            - The array of FEM basis coefficients for the elements of the vector the Jacobian is applied to
+
+  Output Parameter:
+. elemVec      - the element vectors, to which the action of the (fieldI, fieldJ) block of the element Jacobian on y is added
+
+  Note: The element matrices are not formed when the PetscFE type supports it, such as PETSCFESUMFACT, so that high
+  order operators can be applied without assembly.
+
+  Level: intermediate
+
+.seealso: PetscFEIntegrateJacobian(), DMSNESCreateJacobianMF()
+@*/
+PetscErrorCode PetscFEIntegrateJacobianAction(PetscDS prob, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *cgeom,
+                                              const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift,
+                                              const PetscScalar y[], PetscScalar elemVec[])
+{
+  PetscFE        fe;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  ierr = PetscDSGetDiscretization(prob, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
+  if (!fe->ops->integratejacobianaction) SETERRQ1(PetscObjectComm((PetscObject) fe), PETSC_ERR_SUP, "PetscFE type %s does not support the Jacobian action", ((PetscObject) fe)->type_name);
+  ierr = (*fe->ops->integratejacobianaction)(prob, jtype, fieldI, fieldJ, Ne, cgeom, coefficients, coefficients_t, probAux, coefficientsAux, t, u_tshift, y, elemVec);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscFEIntegrateBdJacobian - Produce the boundary element Jacobian for a chunk of elements by quadrature integration
 
@@ -0,0 +1,665 @@
+static const char help[] = "Tests the sum factorization integration of PETSCFESUMFACT against PETSCFEBASIC on tensor product cells,\n\
+and the integration of batched pointwise functions against the integration of pointwise functions.\n\n";
+
+#include <petscdmplex.h>
+#include <petscsnes.h>
+#include <petscds.h>
+#include <petsc/private/petscfeimpl.h>
+
+typedef struct {
+  PetscInt  dim;     /* The topological dimension */
+  PetscBool simplex; /* Flag for simplices */
+  PetscInt  Nf;      /* The number of fields */
+  PetscBool aux;     /* Use an auxiliary coefficient */
+  PetscReal distort; /* The amplitude of the distortion of the mesh */
+  PetscBool batch;   /* Compare batched pointwise functions instead of sum factorization */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim     = 2;
+  options->simplex = PETSC_FALSE;
+  options->Nf      = 1;
+  options->aux     = PETSC_FALSE;
+  options->distort = 0.0;
+  options->batch   = PETSC_FALSE;
+
+  ierr = PetscOptionsBegin(comm, "", "Sum Factorization Options", "PETSCFE");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological dimension", "ex2.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Flag for simplices", "ex2.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_fields", "The number of fields, a scalar and a vector field", "ex2.c", options->Nf, &options->Nf, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-aux", "Use an auxiliary coefficient", "ex2.c", options->aux, &options->aux, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-distort", "The amplitude of the distortion of the mesh", "ex2.c", options->distort, &options->distort, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-use_batch", "Compare batched pointwise functions instead of sum factorization", "ex2.c", options->batch, &options->batch, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  if (options->simplex && !options->batch) SETERRQ(comm, PETSC_ERR_SUP, "Sum factorization needs tensor product cells");
+  PetscFunctionReturn(0);
+}
+
+/*
+  A nonlinear system coupling a scalar u to a vector w, with a coefficient kappa that is an auxiliary field if given,
+
+    u^3 - x + w.grad u - div(kappa (1 + u^2) grad u + w) = 0
+    w + u grad u - div(grad w + u I)                      = 0
+*/
+static void f0_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt d;
+
+  f0[0] = PetscPowScalarInt(u[0], 3) - x[0];
+  if (Nf > 1) for (d = 0; d < dim; ++d) f0[0] += u[uOff[1]+d]*u_x[d];
+}
+
+static void f1_u(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  const PetscScalar kappa = NfAux ? a[0] : 1.0;
+  PetscInt          d;
+
+  for (d = 0; d < dim; ++d) f1[d] = kappa*(1.0 + PetscSqr(u[0]))*u_x[d] + (Nf > 1 ? u[uOff[1]+d] : 0.0);
+}
+
+static void f0_w(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) f0[c] = u[uOff[1]+c] + u[0]*u_x[c];
+}
+
+static void f1_w(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                 const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                 const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                 PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) f1[c*dim+d] = u_x[uOff_x[1]+c*dim+d] + (c == d ? u[0] : 0.0);
+}
+
+static void g0_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  g0[0] = 3.0*PetscSqr(u[0]);
+}
+
+static void g1_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt d;
+
+  for (d = 0; d < dim; ++d) g1[d] = u[uOff[1]+d];
+}
+
+static void g2_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  const PetscScalar kappa = NfAux ? a[0] : 1.0;
+  PetscInt          d;
+
+  for (d = 0; d < dim; ++d) g2[d] = 2.0*kappa*u[0]*u_x[d];
+}
+
+static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  const PetscScalar kappa = NfAux ? a[0] : 1.0;
+  PetscInt          d;
+
+  for (d = 0; d < dim; ++d) g3[d*dim+d] = kappa*(1.0 + PetscSqr(u[0]));
+}
+
+static void g0_uw(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g0[c] = u_x[c];
+}
+
+static void g2_uw(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g2[c*dim+c] = 1.0;
+}
+
+static void g0_wu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g0[c] = u_x[c];
+}
+
+static void g1_wu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g1[c*dim+c] = u[0];
+}
+
+static void g2_wu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g2[c*dim+c] = 1.0;
+}
+
+static void g0_ww(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c;
+
+  for (c = 0; c < dim; ++c) g0[c*dim+c] = 1.0;
+}
+
+static void g3_ww(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                  const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                  const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                  PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) g3[((c*dim+c)*dim+d)*dim+d] = 1.0;
+}
+
+/* The same functions on batches of points, in which entry i of an array for point p is at i*PETSCDS_BATCH_SIZE+p */
+#define W PETSCDS_BATCH_SIZE
+
+static void f0_u_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt d, p;
+
+  for (p = 0; p < W; ++p) f0[p] = u[p]*u[p]*u[p] - x[p];
+  if (Nf > 1) for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) f0[p] += u[(uOff[1]+d)*W+p]*u_x[d*W+p];
+}
+
+static void f1_u_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d, p;
+
+  for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) f1[d*W+p] = (NfAux ? a[p] : 1.0)*(1.0 + u[p]*u[p])*u_x[d*W+p] + (Nf > 1 ? u[(uOff[1]+d)*W+p] : 0.0);
+}
+
+static void f0_w_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) f0[c*W+p] = u[(uOff[1]+c)*W+p] + u[p]*u_x[c*W+p];
+}
+
+static void f1_w_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt c, d, p;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) f1[(c*dim+d)*W+p] = u_x[(uOff_x[1]+c*dim+d)*W+p] + (c == d ? u[p] : 0.0);
+}
+
+static void g0_uu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt p;
+
+  for (p = 0; p < W; ++p) g0[p] = 3.0*u[p]*u[p];
+}
+
+static void g1_uu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt d, p;
+
+  for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) g1[d*W+p] = u[(uOff[1]+d)*W+p];
+}
+
+static void g2_uu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt d, p;
+
+  for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) g2[d*W+p] = 2.0*(NfAux ? a[p] : 1.0)*u[p]*u_x[d*W+p];
+}
+
+static void g3_uu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt d, p;
+
+  for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) g3[(d*dim+d)*W+p] = (NfAux ? a[p] : 1.0)*(1.0 + u[p]*u[p]);
+}
+
+static void g0_uw_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g0[c*W+p] = u_x[c*W+p];
+}
+
+static void g2_uw_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g2[(c*dim+c)*W+p] = 1.0;
+}
+
+static void g0_wu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g0[c*W+p] = u_x[c*W+p];
+}
+
+static void g1_wu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g1[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g1[(c*dim+c)*W+p] = u[p];
+}
+
+static void g2_wu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g2[(c*dim+c)*W+p] = 1.0;
+}
+
+static void g0_ww_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+{
+  PetscInt c, p;
+
+  for (c = 0; c < dim; ++c) for (p = 0; p < W; ++p) g0[(c*dim+c)*W+p] = 1.0;
+}
+
+static void g3_ww_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt c, d, p;
+
+  for (c = 0; c < dim; ++c) for (d = 0; d < dim; ++d) for (p = 0; p < W; ++p) g3[(((c*dim+c)*dim+d)*dim+d)*W+p] = 1.0;
+}
+
+static PetscErrorCode kappa(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = 1.0 + x[0]*x[dim-1];
+  return 0;
+}
+
+/* The distortion vanishes on the boundary of the unit box, and makes the tensor product cells non-affine */
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM             dmDist = NULL;
+  Vec            coordinates[2];
+  PetscScalar   *coords;
+  PetscReal      bump;
+  PetscInt       n, i, d, v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  if (user->simplex) {ierr = DMPlexCreateReferenceCell(comm, user->dim, PETSC_TRUE, dm);CHKERRQ(ierr);}
+  else               {ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  /* Both the global and the local coordinates are moved, since the coordinate field may already refer to the latter */
+  ierr = DMGetCoordinates(*dm, &coordinates[0]);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(*dm, &coordinates[1]);CHKERRQ(ierr);
+  for (v = 0; v < 2; ++v) {
+    ierr = VecGetLocalSize(coordinates[v], &n);CHKERRQ(ierr);
+    ierr = VecGetArray(coordinates[v], &coords);CHKERRQ(ierr);
+    for (i = 0; i < n; i += user->dim) {
+      for (d = 0, bump = user->distort; d < user->dim; ++d) bump *= PetscSinReal(PETSC_PI*PetscRealPart(coords[i+d]));
+      for (d = 0; d < user->dim; ++d) coords[i+d] += (d+1)*bump;
+    }
+    ierr = VecRestoreArray(coordinates[v], &coords);CHKERRQ(ierr);
+  }
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The same element, of the given type */
+static PetscErrorCode CreateFE(PetscFE fe, PetscFEType type, PetscFE *newfe)
+{
+  PetscSpace      sp;
+  PetscDualSpace  dsp;
+  PetscQuadrature q;
+  PetscInt        Nc;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscFEGetBasisSpace(fe, &sp);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe, &dsp);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &q);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &Nc);CHKERRQ(ierr);
+  ierr = PetscFECreate(PetscObjectComm((PetscObject) fe), newfe);CHKERRQ(ierr);
+  ierr = PetscFESetType(*newfe, type);CHKERRQ(ierr);
+  ierr = PetscFESetBasisSpace(*newfe, sp);CHKERRQ(ierr);
+  ierr = PetscFESetDualSpace(*newfe, dsp);CHKERRQ(ierr);
+  ierr = PetscFESetNumComponents(*newfe, Nc);CHKERRQ(ierr);
+  ierr = PetscFESetQuadrature(*newfe, q);CHKERRQ(ierr);
+  ierr = PetscFESetUp(*newfe);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SetupAuxDM(DM dm, PetscFE feAux)
+{
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {kappa};
+  DM             dmAux, coordDM;
+  Vec            a;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetCoordinateDM(dm, &coordDM);CHKERRQ(ierr);
+  ierr = DMClone(dm, &dmAux);CHKERRQ(ierr);
+  ierr = DMSetCoordinateDM(dmAux, coordDM);CHKERRQ(ierr);
+  ierr = DMSetField(dmAux, 0, NULL, (PetscObject) feAux);CHKERRQ(ierr);
+  ierr = DMCreateDS(dmAux);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject) dm, "dmAux", (PetscObject) dmAux);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dmAux, &a);CHKERRQ(ierr);
+  ierr = DMProjectFunctionLocal(dmAux, 0.0, funcs, NULL, INSERT_ALL_VALUES, a);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject) dm, "A", (PetscObject) a);CHKERRQ(ierr);
+  ierr = VecDestroy(&a);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmAux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The first DM gets PETSCFEBASIC with the pointwise functions, and the second either PETSCFESUMFACT or the batched functions */
+static PetscErrorCode SetupDiscretization(DM dm, DM dmSF, AppCtx *user)
+{
+  DM             dms[2];
+  PetscFE        fe[2], fesf, feAux = NULL;
+  PetscDS        ds;
+  PetscInt       f, s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, 1, user->simplex, "u_", -1, &fe[0]);CHKERRQ(ierr);
+  if (user->Nf > 1) {
+    /* The fields must share the quadrature to be integrated by sum factorization */
+    ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, user->dim, user->simplex, "w_", -1, &fe[1]);CHKERRQ(ierr);
+    ierr = PetscFECopyQuadrature(fe[0], fe[1]);CHKERRQ(ierr);
+  }
+  if (user->aux) {
+    ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, 1, user->simplex, "kappa_", -1, &feAux);CHKERRQ(ierr);
+    ierr = PetscFECopyQuadrature(fe[0], feAux);CHKERRQ(ierr);
+  }
+  dms[0] = dm;
+  dms[1] = dmSF;
+  for (s = 0; s < 2; ++s) {
+    for (f = 0; f < user->Nf; ++f) {
+      ierr = CreateFE(fe[f], s && !user->batch ? PETSCFESUMFACT : PETSCFEBASIC, &fesf);CHKERRQ(ierr);
+      ierr = DMSetField(dms[s], f, NULL, (PetscObject) fesf);CHKERRQ(ierr);
+      ierr = PetscFEDestroy(&fesf);CHKERRQ(ierr);
+    }
+    ierr = DMCreateDS(dms[s]);CHKERRQ(ierr);
+    ierr = DMGetDS(dms[s], &ds);CHKERRQ(ierr);
+    if (s && user->batch) {
+      ierr = PetscDSSetResidualBatch(ds, 0, f0_u_batch, f1_u_batch);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianBatch(ds, 0, 0, g0_uu_batch, user->Nf > 1 ? g1_uu_batch : NULL, g2_uu_batch, g3_uu_batch);CHKERRQ(ierr);
+      if (user->Nf > 1) {
+        ierr = PetscDSSetResidualBatch(ds, 1, f0_w_batch, f1_w_batch);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobianBatch(ds, 0, 1, g0_uw_batch, NULL, g2_uw_batch, NULL);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobianBatch(ds, 1, 0, g0_wu_batch, g1_wu_batch, g2_wu_batch, NULL);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobianBatch(ds, 1, 1, g0_ww_batch, NULL, NULL, g3_ww_batch);CHKERRQ(ierr);
+      }
+    } else {
+      ierr = PetscDSSetResidual(ds, 0, f0_u, f1_u);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobian(ds, 0, 0, g0_uu, user->Nf > 1 ? g1_uu : NULL, g2_uu, g3_uu);CHKERRQ(ierr);
+      if (user->Nf > 1) {
+        ierr = PetscDSSetResidual(ds, 1, f0_w, f1_w);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobian(ds, 0, 1, g0_uw, NULL, g2_uw, NULL);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobian(ds, 1, 0, g0_wu, g1_wu, g2_wu, NULL);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobian(ds, 1, 1, g0_ww, NULL, NULL, g3_ww);CHKERRQ(ierr);
+      }
+    }
+    if (feAux) {ierr = SetupAuxDM(dms[s], feAux);CHKERRQ(ierr);}
+    ierr = DMPlexSetSNESLocalFEM(dms[s], user, user, user);CHKERRQ(ierr);
+  }
+  for (f = 0; f < user->Nf; ++f) {ierr = PetscFEDestroy(&fe[f]);CHKERRQ(ierr);}
+  ierr = PetscFEDestroy(&feAux);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckDifference(const char name[], Vec x, Vec y)
+{
+  Vec            d;
+  PetscReal      norm, dnorm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecDuplicate(x, &d);CHKERRQ(ierr);
+  ierr = VecWAXPY(d, -1.0, x, y);CHKERRQ(ierr);
+  ierr = VecNorm(x, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  ierr = VecNorm(d, NORM_INFINITY, &dnorm);CHKERRQ(ierr);
+  if (dnorm > 1.0e-10*PetscMax(norm, 1.0)) {ierr = PetscPrintf(PetscObjectComm((PetscObject) x), "The %s differ by %g relative to %g\n", name, (double) dnorm, (double) norm);CHKERRQ(ierr);}
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Compares the residuals and the Jacobians, and with sum factorization the Jacobian actions and one Newton step with the
+  matrix-free Jacobian. The
+  residuals with sum factorization are only compared on affine cells, since PETSCFEBASIC pushes the gradients of the
+  test functions forward with the geometry of a single quadrature point.
+*/
+static PetscErrorCode CompareIntegration(DM dm, DM dmSF, AppCtx *user)
+{
+  SNES           snes[2], snesMF = NULL;
+  PetscRandom    rand;
+  Vec            X, Y, F[2], Z[2], S[2];
+  Mat            J[2], Jmf = NULL;
+  PetscReal      norm, dnorm;
+  PetscInt       f, s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscRandomCreate(PetscObjectComm((PetscObject) dm), &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &X);CHKERRQ(ierr);
+  ierr = VecDuplicate(X, &Y);CHKERRQ(ierr);
+  ierr = VecSetRandom(X, rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(Y, rand);CHKERRQ(ierr);
+  for (s = 0; s < 2; ++s) {
+    DM sdm = s ? dmSF : dm;
+
+    ierr = SNESCreate(PetscObjectComm((PetscObject) dm), &snes[s]);CHKERRQ(ierr);
+    ierr = SNESSetDM(snes[s], sdm);CHKERRQ(ierr);
+    ierr = VecDuplicate(X, &F[s]);CHKERRQ(ierr);
+    ierr = VecDuplicate(X, &Z[s]);CHKERRQ(ierr);
+    ierr = VecDuplicate(X, &S[s]);CHKERRQ(ierr);
+    ierr = DMCreateMatrix(sdm, &J[s]);CHKERRQ(ierr);
+    ierr = SNESComputeFunction(snes[s], X, F[s]);CHKERRQ(ierr);
+    ierr = SNESComputeJacobian(snes[s], X, J[s], J[s]);CHKERRQ(ierr);
+  }
+  if (user->batch || user->distort == 0.0) {ierr = CheckDifference("residuals", F[0], F[1]);CHKERRQ(ierr);}
+  ierr = MatAXPY(J[1], -1.0, J[0], SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(J[0], NORM_INFINITY, &norm);CHKERRQ(ierr);
+  ierr = MatNorm(J[1], NORM_INFINITY, &dnorm);CHKERRQ(ierr);
+  if (dnorm > 1.0e-10*norm) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "The Jacobians differ by %g relative to %g\n", (double) dnorm, (double) norm);CHKERRQ(ierr);}
+
+  /* The matrix-free Jacobian is only checked with PETSCFESUMFACT, which integrates its action directly */
+  if (!user->batch) {
+    ierr = DMSNESCreateJacobianMF(dmSF, X, user, &Jmf);CHKERRQ(ierr);
+    ierr = MatMult(J[0], Y, Z[0]);CHKERRQ(ierr);
+    ierr = MatMult(Jmf, Y, Z[1]);CHKERRQ(ierr);
+    ierr = CheckDifference("Jacobian actions", Z[0], Z[1]);CHKERRQ(ierr);
+
+    /* A Newton step with the matrix-free Jacobian, preconditioned by the assembled one, is the same as the assembled step */
+    ierr = SNESCreate(PetscObjectComm((PetscObject) dm), &snesMF);CHKERRQ(ierr);
+    ierr = SNESSetDM(snesMF, dmSF);CHKERRQ(ierr);
+    ierr = SNESSetJacobian(snesMF, Jmf, J[1], NULL, NULL);CHKERRQ(ierr);
+    ierr = SNESSetJacobian(snes[1], J[1], J[1], NULL, NULL);CHKERRQ(ierr);
+    for (s = 0; s < 2; ++s) {
+      SNES sn = s ? snesMF : snes[1];
+      KSP  ksp;
+
+      ierr = SNESSetType(sn, SNESKSPONLY);CHKERRQ(ierr);
+      ierr = SNESGetKSP(sn, &ksp);CHKERRQ(ierr);
+      ierr = KSPSetTolerances(ksp, 1.0e-12, 1.0e-50, PETSC_DEFAULT, 1000);CHKERRQ(ierr);
+      ierr = VecCopy(X, S[s]);CHKERRQ(ierr);
+      ierr = SNESSolve(sn, NULL, S[s]);CHKERRQ(ierr);
+    }
+    ierr = CheckDifference("Newton steps", S[0], S[1]);CHKERRQ(ierr);
+
+    for (f = 0; f < user->Nf; ++f) {
+      PetscFE fe;
+
+      ierr = DMGetField(dmSF, f, NULL, (PetscObject *) &fe);CHKERRQ(ierr);
+      ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Field %D: %s\n", f, ((PetscFE_SumFact *) fe->data)->tensor ? "sum factorization" : "full tabulation");CHKERRQ(ierr);
+    }
+  }
+  for (s = 0; s < 2; ++s) {
+    ierr = SNESDestroy(&snes[s]);CHKERRQ(ierr);
+    ierr = VecDestroy(&F[s]);CHKERRQ(ierr);
+    ierr = VecDestroy(&Z[s]);CHKERRQ(ierr);
+    ierr = VecDestroy(&S[s]);CHKERRQ(ierr);
+    ierr = MatDestroy(&J[s]);CHKERRQ(ierr);
+  }
+  ierr = SNESDestroy(&snesMF);CHKERRQ(ierr);
+  ierr = MatDestroy(&Jmf);CHKERRQ(ierr);
+  ierr = VecDestroy(&X);CHKERRQ(ierr);
+  ierr = VecDestroy(&Y);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, dmSF;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = DMClone(dm, &dmSF);CHKERRQ(ierr);
+  ierr = SetupDiscretization(dm, dmSF, &user);CHKERRQ(ierr);
+  ierr = CompareIntegration(dm, dmSF, &user);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmSF);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: q
+    nsize: {{1 2}}
+    output_file: output/ex2_1.out
+    args: -dm_plex_box_faces 3,3 -u_petscspace_degree {{1 2 4}} -distort {{0.0 0.1}}
+
+  test:
+    suffix: q_2_fields
+    nsize: {{1 2}}
+    output_file: output/ex2_2.out
+    args: -dm_plex_box_faces 3,3 -num_fields 2 -u_petscspace_degree 3 -w_petscspace_degree {{2 3}} -distort 0.1
+
+  test:
+    suffix: hex
+    output_file: output/ex2_1.out
+    args: -dim 3 -dm_plex_box_faces 2,2,2 -u_petscspace_degree {{2 3}} -distort {{0.0 0.1}}
+
+  test:
+    suffix: hex_2_fields
+    output_file: output/ex2_2.out
+    args: -dim 3 -dm_plex_box_faces 2,2,2 -num_fields 2 -u_petscspace_degree 2 -w_petscspace_degree 2 -distort 0.1
+
+  test:
+    suffix: batch_p
+    nsize: {{1 2}}
+    output_file: output/ex2_3.out
+    args: -use_batch -simplex -dm_refine 2 -u_petscspace_degree {{1 2}}
+
+  test:
+    suffix: batch_p_2_fields
+    nsize: {{1 2}}
+    output_file: output/ex2_3.out
+    args: -use_batch -simplex -dm_refine 2 -num_fields 2 -u_petscspace_degree 2 -w_petscspace_degree 1 -aux -kappa_petscspace_degree 1
+
+  test:
+    suffix: batch_q_2_fields
+    output_file: output/ex2_3.out
+    args: -use_batch -dm_plex_box_faces 3,3 -num_fields 2 -u_petscspace_degree {{1 2}} -w_petscspace_degree 1 -aux -kappa_petscspace_degree 1 -distort 0.1
+
+  test:
+    suffix: batch_hex
+    output_file: output/ex2_3.out
+    args: -use_batch -dim 3 -dm_plex_box_faces 2,2,2 -num_fields 2 -u_petscspace_degree {{1 2}} -w_petscspace_degree 1 -distort 0.1
+
+TEST*/
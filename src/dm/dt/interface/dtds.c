@@ -455,6 +455,8 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   PetscBool        *tmpi;
   PetscPointFunc   *tmpobj, *tmpf, *tmpup;
   PetscPointJac    *tmpg, *tmpgp, *tmpgt;
+  PetscPointFuncBatch *tmpfB;
+  PetscPointJacBatch  *tmpgB;
   PetscBdPointFunc *tmpfbd;
   PetscBdPointJac  *tmpgbd, *tmpgpbd;
   PetscRiemannFunc *tmpr;
@@ -502,6 +504,12 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   prob->r   = tmpr;
   prob->update = tmpup;
   prob->ctx = tmpctx;
+  ierr = PetscCalloc2(NfNew*2, &tmpfB, NfNew*NfNew*4, &tmpgB);CHKERRQ(ierr);
+  for (f = 0; f < Nf*2; ++f) tmpfB[f] = prob->fB[f];
+  for (f = 0; f < Nf*Nf*4; ++f) tmpgB[f] = prob->gB[f];
+  ierr = PetscFree2(prob->fB, prob->gB);CHKERRQ(ierr);
+  prob->fB = tmpfB;
+  prob->gB = tmpgB;
   ierr = PetscCalloc5(NfNew*2, &tmpfbd, NfNew*NfNew*4, &tmpgbd, NfNew*NfNew*4, &tmpgpbd, NfNew, &tmpexactSol, NfNew, &tmpexactCtx);CHKERRQ(ierr);
   for (f = 0; f < Nf*2; ++f) tmpfbd[f] = prob->fBd[f];
   for (f = 0; f < Nf*Nf*4; ++f) tmpgbd[f] = prob->gBd[f];
@@ -560,6 +568,7 @@ PetscErrorCode PetscDSDestroy(PetscDS *prob)
   ierr = PetscFree2((*prob)->disc, (*prob)->implicit);CHKERRQ(ierr);
   ierr = PetscFree7((*prob)->obj,(*prob)->f,(*prob)->g,(*prob)->gp,(*prob)->gt,(*prob)->r,(*prob)->ctx);CHKERRQ(ierr);
   ierr = PetscFree((*prob)->update);CHKERRQ(ierr);
+  ierr = PetscFree2((*prob)->fB,(*prob)->gB);CHKERRQ(ierr);
   ierr = PetscFree5((*prob)->fBd,(*prob)->gBd,(*prob)->gpBd,(*prob)->exactSol,(*prob)->exactCtx);CHKERRQ(ierr);
   if ((*prob)->ops->destroy) {ierr = (*(*prob)->ops->destroy)(*prob);CHKERRQ(ierr);}
   next = (*prob)->boundary;
@@ -1154,6 +1163,97 @@ PetscErrorCode PetscDSSetResidual(PetscDS prob, PetscInt f,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetResidualBatch - Get the batched pointwise residual function for a given test field
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+- f    - The test field number
+
+  Output Parameters:
++ f0 - integrand for the test function term, evaluated on a batch of points
+- f1 - integrand for the test function gradient term, evaluated on a batch of points
+
+  Level: intermediate
+
+.seealso: PetscDSSetResidualBatch(), PetscDSGetResidual()
+@*/
+PetscErrorCode PetscDSGetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch *f0, PetscPointFuncBatch *f1)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if (f0) {PetscValidPointer(f0, 3); *f0 = prob->fB[f*2+0];}
+  if (f1) {PetscValidPointer(f1, 4); *f1 = prob->fB[f*2+1];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetResidualBatch - Set the pointwise residual function for a given test field, evaluated on batches of points
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. f0 - integrand for the test function term
+- f1 - integrand for the test function gradient term
+
+  Note: The functions are the same as those of PetscDSSetResidual(), but each call evaluates them at Np <= PETSCDS_BATCH_SIZE
+  quadrature points, which may belong to several cells. Every entry of the arrays of the pointwise functions is replaced
+  by PETSCDS_BATCH_SIZE consecutive values, one for each point, so that entry i for point p of u[] is u[i*PETSCDS_BATCH_SIZE+p],
+  and entry (c,d) of f1 is f1[(c*dim+d)*PETSCDS_BATCH_SIZE+p]. The values for the points p >= Np repeat those of point Np-1,
+  so that the functions may loop over all PETSCDS_BATCH_SIZE points, which the compiler can vectorize. When set, these
+  functions are used instead of those of PetscDSSetResidual() for this field.
+
+The calling sequence for the callbacks f0 and f1 is given by:
+
+$ f0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+
++ dim - the spatial dimension
+. Nf - the number of fields
+. NfAux - the number of auxiliary fields
+. Np - the number of points in the batch
+. uOff - the offset into u[] and u_t[] for each field, in entries
+. uOff_x - the offset into u_x[] for each field, in entries
+. u - each field evaluated at the points
+. u_t - the time derivative of each field evaluated at the points
+. u_x - the gradient of each field evaluated at the points
+. aOff - the offset into a[] and a_t[] for each auxiliary field, in entries
+. aOff_x - the offset into a_x[] for each auxiliary field, in entries
+. a - each auxiliary field evaluated at the points
+. a_t - the time derivative of each auxiliary field evaluated at the points
+. a_x - the gradient of auxiliary each field evaluated at the points
+. t - current time
+. x - coordinates of the points
+. numConstants - number of constant parameters
+. constants - constant parameters
+- f0 - output values at the points
+
+  Level: intermediate
+
+.seealso: PetscDSGetResidualBatch(), PetscDSSetResidual(), PetscDSSetJacobianBatch()
+@*/
+PetscErrorCode PetscDSSetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch f0, PetscPointFuncBatch f1)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (f0) PetscValidFunction(f0, 3);
+  if (f1) PetscValidFunction(f1, 4);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  ierr = PetscDSEnlarge_Static(prob, f+1);CHKERRQ(ierr);
+  prob->fB[f*2+0] = f0;
+  prob->fB[f*2+1] = f1;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSHasJacobian - Signals that Jacobian functions have been set
 
@@ -1179,7 +1279,7 @@ PetscErrorCode PetscDSHasJacobian(PetscDS prob, PetscBool *hasJac)
   for (f = 0; f < prob->Nf; ++f) {
     for (g = 0; g < prob->Nf; ++g) {
       for (h = 0; h < 4; ++h) {
-        if (prob->g[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
+        if (prob->g[(f*prob->Nf + g)*4+h] || prob->gB[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
       }
     }
   }
@@ -1349,6 +1449,93 @@ PetscErrorCode PetscDSSetJacobian(PetscDS prob, PetscInt f, PetscInt g,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetJacobianBatch - Get the batched pointwise Jacobian function for given test and basis field
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+- g    - The field number
+
+  Output Parameters:
++ g0 - integrand for the test and basis function term, evaluated on a batch of points
+. g1 - integrand for the test function and basis function gradient term, evaluated on a batch of points
+. g2 - integrand for the test function gradient and basis function term, evaluated on a batch of points
+- g3 - integrand for the test function gradient and basis function gradient term, evaluated on a batch of points
+
+  Level: intermediate
+
+.seealso: PetscDSSetJacobianBatch(), PetscDSGetJacobian()
+@*/
+PetscErrorCode PetscDSGetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch *g0, PetscPointJacBatch *g1, PetscPointJacBatch *g2, PetscPointJacBatch *g3)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if ((g < 0) || (g >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", g, prob->Nf);
+  if (g0) {PetscValidPointer(g0, 4); *g0 = prob->gB[(f*prob->Nf + g)*4+0];}
+  if (g1) {PetscValidPointer(g1, 5); *g1 = prob->gB[(f*prob->Nf + g)*4+1];}
+  if (g2) {PetscValidPointer(g2, 6); *g2 = prob->gB[(f*prob->Nf + g)*4+2];}
+  if (g3) {PetscValidPointer(g3, 7); *g3 = prob->gB[(f*prob->Nf + g)*4+3];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetJacobianBatch - Set the pointwise Jacobian function for given test and basis fields, evaluated on batches of points
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. g    - The field number
+. g0 - integrand for the test and basis function term
+. g1 - integrand for the test function and basis function gradient term
+. g2 - integrand for the test function gradient and basis function term
+- g3 - integrand for the test function gradient and basis function gradient term
+
+  Note: The functions are the same as those of PetscDSSetJacobian(), with the layout of the batches of points described
+  in PetscDSSetResidualBatch(), so that entry (fc,gc,df,dg) of g3 for point p is g3[(((fc*Nc+gc)*dim+df)*dim+dg)*PETSCDS_BATCH_SIZE+p].
+  When set, these functions are used instead of those of PetscDSSetJacobian() for this pair of fields. They are not used
+  for the Jacobian preconditioner or the time derivative Jacobian.
+
+The calling sequence for the callbacks g0, g1, g2 and g3 is given by:
+
+$ g0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+
+  with the arguments of PetscDSSetResidualBatch(), and
+
+. u_tShift - the multiplier a for dF/dU_t
+
+  Level: intermediate
+
+.seealso: PetscDSGetJacobianBatch(), PetscDSSetJacobian(), PetscDSSetResidualBatch()
+@*/
+PetscErrorCode PetscDSSetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch g0, PetscPointJacBatch g1, PetscPointJacBatch g2, PetscPointJacBatch g3)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (g0) PetscValidFunction(g0, 4);
+  if (g1) PetscValidFunction(g1, 5);
+  if (g2) PetscValidFunction(g2, 6);
+  if (g3) PetscValidFunction(g3, 7);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  if (g < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", g);
+  ierr = PetscDSEnlarge_Static(prob, PetscMax(f, g)+1);CHKERRQ(ierr);
+  prob->gB[(f*prob->Nf + g)*4+0] = g0;
+  prob->gB[(f*prob->Nf + g)*4+1] = g1;
+  prob->gB[(f*prob->Nf + g)*4+2] = g2;
+  prob->gB[(f*prob->Nf + g)*4+3] = g3;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSUseJacobianPreconditioner - Whether to construct a Jacobian preconditioner
 
@@ -3280,29 +3467,35 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
     const PetscInt   f = fields ? fields[fn] : fn;
     PetscPointFunc   obj;
     PetscPointFunc   f0, f1;
+    PetscPointFuncBatch f0B, f1B;
     PetscBdPointFunc f0Bd, f1Bd;
     PetscRiemannFunc r;
 
     if (f >= Nf) continue;
     ierr = PetscDSGetObjective(prob, f, &obj);CHKERRQ(ierr);
     ierr = PetscDSGetResidual(prob, f, &f0, &f1);CHKERRQ(ierr);
+    ierr = PetscDSGetResidualBatch(prob, f, &f0B, &f1B);CHKERRQ(ierr);
     ierr = PetscDSGetBdResidual(prob, f, &f0Bd, &f1Bd);CHKERRQ(ierr);
     ierr = PetscDSGetRiemannSolver(prob, f, &r);CHKERRQ(ierr);
     ierr = PetscDSSetObjective(newprob, fn, obj);CHKERRQ(ierr);
     ierr = PetscDSSetResidual(newprob, fn, f0, f1);CHKERRQ(ierr);
+    ierr = PetscDSSetResidualBatch(newprob, fn, f0B, f1B);CHKERRQ(ierr);
     ierr = PetscDSSetBdResidual(newprob, fn, f0Bd, f1Bd);CHKERRQ(ierr);
     ierr = PetscDSSetRiemannSolver(newprob, fn, r);CHKERRQ(ierr);
     for (gn = 0; gn < numFields; ++gn) {
       const PetscInt  g = fields ? fields[gn] : gn;
       PetscPointJac   g0, g1, g2, g3;
       PetscPointJac   g0p, g1p, g2p, g3p;
+      PetscPointJacBatch g0B, g1B, g2B, g3B;
       PetscBdPointJac g0Bd, g1Bd, g2Bd, g3Bd;
 
       if (g >= Nf) continue;
       ierr = PetscDSGetJacobian(prob, f, g, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
+      ierr = PetscDSGetJacobianBatch(prob, f, g, &g0B, &g1B, &g2B, &g3B);CHKERRQ(ierr);
       ierr = PetscDSGetJacobianPreconditioner(prob, f, g, &g0p, &g1p, &g2p, &g3p);CHKERRQ(ierr);
       ierr = PetscDSGetBdJacobian(prob, f, g, &g0Bd, &g1Bd, &g2Bd, &g3Bd);CHKERRQ(ierr);
       ierr = PetscDSSetJacobian(newprob, fn, gn, g0, g1, g2, g3);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianBatch(newprob, fn, gn, g0B, g1B, g2B, g3B);CHKERRQ(ierr);
       ierr = PetscDSSetJacobianPreconditioner(prob, fn, gn, g0p, g1p, g2p, g3p);CHKERRQ(ierr);
       ierr = PetscDSSetBdJacobian(newprob, fn, gn, g0Bd, g1Bd, g2Bd, g3Bd);CHKERRQ(ierr);
     }
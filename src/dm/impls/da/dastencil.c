@@ -0,0 +1,597 @@
+/*
+   The MATDASTENCIL matrix class, which applies a 3, 5, 7, 9 or 27-point stencil with constant or variable
+   coefficients directly on the ghosted local arrays of a DMDA, without storing a sparse matrix.
+*/
+#include <petsc/private/matimpl.h>
+#include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#define MAT_DASTENCIL_MAXENTRIES 27
+
+/*
+   The stencil entries are ordered with the i offset varying fastest, then j, then k. Entry s of the owned point p,
+   numbered in the natural ordering of the owned points, couples it to the point at off[s] from it in the ghosted
+   local array, with the coefficient coef[s] or, if they vary, vcoef[s*npoints+p].
+*/
+typedef struct {
+  DM             da;
+  PetscInt       dim,ns,center,ncolors;
+  PetscBool      star;
+  PetscInt       di[MAT_DASTENCIL_MAXENTRIES],dj[MAT_DASTENCIL_MAXENTRIES],dk[MAT_DASTENCIL_MAXENTRIES];
+  PetscInt       off[MAT_DASTENCIL_MAXENTRIES];
+  PetscScalar    coef[MAT_DASTENCIL_MAXENTRIES];
+  PetscScalar    *vcoef;              /* variable coefficients, or NULL */
+  PetscBool      coefset;
+  PetscInt       M,N,P,xs,ys,zs,xm,ym,zm,gxs,gys,gzs,gxm,gym,gzm,npoints;
+  DMBoundaryType bx,by,bz;
+  PetscInt       tile;                /* rows in the j direction of the tiles swept plane by plane in k */
+  Vec            xl;                  /* ghosted work vector */
+  PetscScalar    *work;               /* a row per thread for MatSOR() */
+} Mat_DAStencil;
+
+/*
+   Computes the range lo[s] <= i < hi[s] of the points of the row (j,k), numbered from xs, whose neighbor in entry
+   s exists; the neighbors outside a non-periodic domain are dropped, as in the matrices of DMCreateMatrix()
+*/
+static void MatDAStencilRowRanges_Private(const Mat_DAStencil *st,PetscInt j,PetscInt k,PetscInt lo[],PetscInt hi[])
+{
+  PetscInt s,jj,kk;
+
+  for (s=0; s<st->ns; s++) {
+    jj    = j + st->dj[s];
+    kk    = k + st->dk[s];
+    lo[s] = 0;
+    hi[s] = st->xm;
+    if ((st->by != DM_BOUNDARY_PERIODIC && (jj < 0 || jj >= st->N)) || (st->bz != DM_BOUNDARY_PERIODIC && (kk < 0 || kk >= st->P))) {
+      hi[s] = 0;
+      continue;
+    }
+    if (st->bx != DM_BOUNDARY_PERIODIC) {
+      if (st->di[s] < 0 && st->xs == 0)              lo[s] = 1;
+      if (st->di[s] > 0 && st->xs + st->xm == st->M) hi[s] = st->xm - 1;
+    }
+  }
+}
+
+/*
+   y[i] += sum_s c_s x[i+off[s]] over the points of a row; xrow and y point to the first owned point of the row in
+   the ghosted local array and in the owned points, which is point p0. Each entry is a unit stride loop that the
+   compiler vectorizes.
+*/
+static void MatDAStencilMultRow_Private(const Mat_DAStencil *st,PetscInt p0,const PetscInt lo[],const PetscInt hi[],const PetscScalar *xrow,PetscScalar *y)
+{
+  const PetscScalar *xs,*c;
+  PetscScalar       cs;
+  PetscInt          s,i;
+
+  for (s=0; s<st->ns; s++) {
+    xs = xrow + st->off[s];
+    if (st->vcoef) {
+      c = st->vcoef + s*st->npoints + p0;
+      for (i=lo[s]; i<hi[s]; i++) y[i] += c[i]*xs[i];
+    } else {
+      cs = st->coef[s];
+      for (i=lo[s]; i<hi[s]; i++) y[i] += cs*xs[i];
+    }
+  }
+}
+
+/* Returns the offset in the ghosted local array of the first owned point of the row (j,k) */
+PETSC_STATIC_INLINE PetscInt MatDAStencilLocalRow_Private(const Mat_DAStencil *st,PetscInt j,PetscInt k)
+{
+  return ((k - st->gzs)*st->gym + (j - st->gys))*st->gxm + (st->xs - st->gxs);
+}
+
+/* Returns the index of the first point of the row (j,k) in the owned points */
+PETSC_STATIC_INLINE PetscInt MatDAStencilRow_Private(const Mat_DAStencil *st,PetscInt j,PetscInt k)
+{
+  return ((k - st->zs)*st->ym + (j - st->ys))*st->xm;
+}
+
+/*
+   z = y + A x, or z = A x if y is NULL. The rows are swept in tiles of st->tile rows in the j direction, plane by
+   plane in k, so that the three planes of the tile that the stencil touches stay in cache; with OpenMP the tiles
+   are distributed among the threads.
+*/
+static PetscErrorCode MatMultAdd_DAStencil_Private(Mat A,Vec x,Vec y,Vec z)
+{
+  Mat_DAStencil     *st = (Mat_DAStencil*)A->data;
+  const PetscScalar *xa;
+  PetscScalar       *za;
+  PetscInt          t,ntiles = (st->ym + st->tile - 1)/st->tile;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!st->coefset) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Set the coefficients with MatDAStencilSetCoefficients() or MatDAStencilSetVariableCoefficients()");
+  ierr = DMGlobalToLocalBegin(st->da,x,INSERT_VALUES,st->xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(st->da,x,INSERT_VALUES,st->xl);CHKERRQ(ierr);
+  if (y) {
+    if (y != z) {ierr = VecCopy(y,z);CHKERRQ(ierr);}
+  } else {
+    ierr = VecSet(z,0.0);CHKERRQ(ierr);
+  }
+  ierr = VecGetArrayRead(st->xl,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(z,&za);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (t=0; t<ntiles; t++) {
+    PetscInt lo[MAT_DASTENCIL_MAXENTRIES],hi[MAT_DASTENCIL_MAXENTRIES],j,k,p0;
+
+    for (k=st->zs; k<st->zs+st->zm; k++) {
+      for (j=st->ys+t*st->tile; j<PetscMin(st->ys+(t+1)*st->tile,st->ys+st->ym); j++) {
+        MatDAStencilRowRanges_Private(st,j,k,lo,hi);
+        p0 = MatDAStencilRow_Private(st,j,k);
+        MatDAStencilMultRow_Private(st,p0,lo,hi,xa+MatDAStencilLocalRow_Private(st,j,k),za+p0);
+      }
+    }
+  }
+  ierr = VecRestoreArray(z,&za);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(st->xl,&xa);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*st->ns*st->npoints);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DAStencil(Mat A,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_DAStencil_Private(A,x,NULL,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_DAStencil(Mat A,Vec x,Vec y,Vec z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_DAStencil_Private(A,x,y,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_DAStencil(Mat A,Vec d)
+{
+  Mat_DAStencil  *st = (Mat_DAStencil*)A->data;
+  PetscScalar    *da;
+  PetscInt       p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!st->coefset) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Set the coefficients with MatDAStencilSetCoefficients() or MatDAStencilSetVariableCoefficients()");
+  ierr = VecGetArray(d,&da);CHKERRQ(ierr);
+  if (st->vcoef) {
+    ierr = PetscArraycpy(da,st->vcoef+st->center*st->npoints,st->npoints);CHKERRQ(ierr);
+  } else {
+    for (p=0; p<st->npoints; p++) da[p] = st->coef[st->center];
+  }
+  ierr = VecRestoreArray(d,&da);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Relaxes the points of the given color in the row (j,k), which are every other point starting from i0: w gathers
+   b minus the couplings to the other points one entry at a time, then the points are updated in x
+*/
+static void MatDAStencilSORRow_Private(const Mat_DAStencil *st,PetscInt p0,PetscInt i0,const PetscInt lo[],const PetscInt hi[],const PetscScalar *xrow,const PetscScalar *b,PetscReal omega,PetscReal fshift,PetscScalar *w,PetscScalar *x)
+{
+  const PetscScalar *xs,*c;
+  PetscScalar       cs,diag;
+  PetscInt          s,i,first;
+
+  for (i=i0; i<st->xm; i+=2) w[i] = b[i];
+  for (s=0; s<st->ns; s++) {
+    if (s == st->center) continue;
+    xs    = xrow + st->off[s];
+    first = PetscMax(lo[s],i0);
+    if ((first - i0) % 2) first++;
+    if (st->vcoef) {
+      c = st->vcoef + s*st->npoints + p0;
+      for (i=first; i<hi[s]; i+=2) w[i] -= c[i]*xs[i];
+    } else {
+      cs = st->coef[s];
+      for (i=first; i<hi[s]; i+=2) w[i] -= cs*xs[i];
+    }
+  }
+  if (st->vcoef) {
+    c = st->vcoef + st->center*st->npoints + p0;
+    for (i=i0; i<st->xm; i+=2) x[i] = (1.0 - omega)*x[i] + omega*w[i]/(c[i] + fshift);
+  } else {
+    diag = st->coef[st->center] + fshift;
+    for (i=i0; i<st->xm; i+=2) x[i] = (1.0 - omega)*x[i] + omega*w[i]/diag;
+  }
+}
+
+/*
+   Updates the owned points of one color from the values of the other colors in the ghosted local array. With the
+   star stencils the points are colored red and black by the parity of i+j+k, with the box stencils by the parities
+   of i, j and k, so that no two points of the same color are coupled. This needs an even number of points in the
+   periodic directions, which MatSOR_DAStencil() checks.
+*/
+static PetscErrorCode MatSORColor_DAStencil_Private(Mat A,PetscInt color,const PetscScalar *ba,PetscReal omega,PetscReal fshift,PetscScalar *xa)
+{
+  Mat_DAStencil     *st = (Mat_DAStencil*)A->data;
+  const PetscScalar *xla;
+  PetscInt          t,ntiles = (st->ym + st->tile - 1)/st->tile;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(st->xl,&xla);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (t=0; t<ntiles; t++) {
+    PetscInt    lo[MAT_DASTENCIL_MAXENTRIES],hi[MAT_DASTENCIL_MAXENTRIES],j,k,p0,parity;
+    PetscScalar *w = st->work;
+
+#if defined(PETSC_HAVE_OPENMP)
+    w += omp_get_thread_num()*st->xm;
+#endif
+    for (k=st->zs; k<st->zs+st->zm; k++) {
+      for (j=st->ys+t*st->tile; j<PetscMin(st->ys+(t+1)*st->tile,st->ys+st->ym); j++) {
+        if (st->star) parity = (color + j + k) % 2;
+        else {
+          if ((j % 2) != ((color >> 1) & 1) || (k % 2) != ((color >> 2) & 1)) continue;
+          parity = color & 1;
+        }
+        MatDAStencilRowRanges_Private(st,j,k,lo,hi);
+        p0 = MatDAStencilRow_Private(st,j,k);
+        MatDAStencilSORRow_Private(st,p0,(parity + st->xs) % 2,lo,hi,xla+MatDAStencilLocalRow_Private(st,j,k),ba+p0,omega,fshift,w,xa+p0);
+      }
+    }
+  }
+  ierr = VecRestoreArrayRead(st->xl,&xla);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   All the sweeps are multicolor Gauss-Seidel sweeps over the whole grid, with the ghost values exchanged before
+   each color, so the local and global sweeps are the same and the result does not depend on the number of processes
+*/
+static PetscErrorCode MatSOR_DAStencil(Mat A,Vec b,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec x)
+{
+  Mat_DAStencil     *st = (Mat_DAStencil*)A->data;
+  const PetscScalar *ba;
+  PetscScalar       *xa;
+  PetscInt          it,c;
+  PetscBool         forward,backward;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!st->coefset) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Set the coefficients with MatDAStencilSetCoefficients() or MatDAStencilSetVariableCoefficients()");
+  if (flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"MATDASTENCIL only supports the forward, backward and symmetric sweeps");
+  /* across the boundary of a periodic direction with an odd number of points, points of the same parity are coupled */
+  if ((st->bx == DM_BOUNDARY_PERIODIC && st->M % 2) || (st->dim > 1 && st->by == DM_BOUNDARY_PERIODIC && st->N % 2) || (st->dim > 2 && st->bz == DM_BOUNDARY_PERIODIC && st->P % 2)) SETERRQ3(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"The multicolor SOR of MATDASTENCIL needs an even number of points in the periodic directions, not %D x %D x %D",st->M,st->N,st->P);
+  forward  = (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+  backward = (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = VecSet(x,0.0);CHKERRQ(ierr);}
+  for (it=0; it<its*lits; it++) {
+    for (c=0; c<2*st->ncolors; c++) {
+      if ((c < st->ncolors && !forward) || (c >= st->ncolors && !backward)) continue;
+      ierr = DMGlobalToLocalBegin(st->da,x,INSERT_VALUES,st->xl);CHKERRQ(ierr);
+      ierr = DMGlobalToLocalEnd(st->da,x,INSERT_VALUES,st->xl);CHKERRQ(ierr);
+      ierr = VecGetArrayRead(b,&ba);CHKERRQ(ierr);
+      ierr = VecGetArray(x,&xa);CHKERRQ(ierr);
+      ierr = MatSORColor_DAStencil_Private(A,c < st->ncolors ? c : 2*st->ncolors-1-c,ba,omega,fshift,xa);CHKERRQ(ierr);
+      ierr = VecRestoreArray(x,&xa);CHKERRQ(ierr);
+      ierr = VecRestoreArrayRead(b,&ba);CHKERRQ(ierr);
+    }
+    ierr = PetscLogFlops(((forward ? 1 : 0) + (backward ? 1 : 0))*(2.0*st->ns + 3.0)*st->npoints);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_DAStencil(Mat A,PetscViewer viewer)
+{
+  Mat_DAStencil  *st = (Mat_DAStencil*)A->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"%D-point %s stencil with %s coefficients, %D colors for SOR\n",st->ns,st->star ? "star" : "box",st->vcoef ? "variable" : "constant",st->ncolors);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"tiles of %D rows\n",st->tile);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetFromOptions_DAStencil(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_DAStencil  *st = (Mat_DAStencil*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"DAStencil options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_dastencil_tile","Rows in the second dimension of the tiles swept plane by plane, 0 for the default","None",st->tile,&st->tile,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetUp_DAStencil(Mat A)
+{
+  Mat_DAStencil   *st = (Mat_DAStencil*)A->data;
+  DM              da;
+  PetscInt        dof,sw,di,dj,dk,nthreads = 1;
+  DMDAStencilType stype;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetDM(A,&da);CHKERRQ(ierr);
+  if (!da) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"A MATDASTENCIL needs a DMDA, use MatCreateDAStencil() or MatSetDM()");
+  ierr   = PetscObjectReference((PetscObject)da);CHKERRQ(ierr);
+  ierr   = DMDestroy(&st->da);CHKERRQ(ierr);
+  st->da = da;
+  ierr   = DMDAGetInfo(da,&st->dim,&st->M,&st->N,&st->P,NULL,NULL,NULL,&dof,&sw,&st->bx,&st->by,&st->bz,&stype);CHKERRQ(ierr);
+  if (dof != 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"MATDASTENCIL only supports one degree of freedom per point, not %D",dof);
+  if (sw < 1) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONG,"MATDASTENCIL needs a DMDA with a stencil width of at least one");
+  ierr = DMDAGetCorners(da,&st->xs,&st->ys,&st->zs,&st->xm,&st->ym,&st->zm);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&st->gxs,&st->gys,&st->gzs,&st->gxm,&st->gym,&st->gzm);CHKERRQ(ierr);
+  st->npoints = st->xm*st->ym*st->zm;
+  st->star    = (PetscBool)(stype == DMDA_STENCIL_STAR);
+
+  st->ns = 0;
+  for (dk=(st->dim > 2 ? -1 : 0); dk<=(st->dim > 2 ? 1 : 0); dk++) {
+    for (dj=(st->dim > 1 ? -1 : 0); dj<=(st->dim > 1 ? 1 : 0); dj++) {
+      for (di=-1; di<=1; di++) {
+        if (st->star && (di != 0) + (dj != 0) + (dk != 0) > 1) continue;
+        if (!di && !dj && !dk) st->center = st->ns;
+        st->di[st->ns]  = di;
+        st->dj[st->ns]  = dj;
+        st->dk[st->ns]  = dk;
+        st->off[st->ns] = (dk*st->gym + dj)*st->gxm + di;
+        st->ns++;
+      }
+    }
+  }
+  st->ncolors = st->star ? 2 : 1 << st->dim;
+  if (st->tile <= 0) st->tile = PetscMax(1,8192/st->gxm);
+
+  ierr = MatSetSizes(A,st->npoints,st->npoints,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = VecDestroy(&st->xl);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(da,&st->xl);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  nthreads = omp_get_max_threads();
+#endif
+  ierr = PetscFree(st->work);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nthreads*st->xm,&st->work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DAStencil(Mat A)
+{
+  Mat_DAStencil  *st = (Mat_DAStencil*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(st->vcoef);CHKERRQ(ierr);
+  ierr = PetscFree(st->work);CHKERRQ(ierr);
+  ierr = VecDestroy(&st->xl);CHKERRQ(ierr);
+  ierr = DMDestroy(&st->da);CHKERRQ(ierr);
+  ierr = PetscFree(A->data);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilSetCoefficients_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilSetVariableCoefficients_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilGetStencilSize_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDAStencilSetCoefficients_DAStencil(Mat A,const PetscScalar coef[])
+{
+  Mat_DAStencil  *st = (Mat_DAStencil*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr        = PetscFree(st->vcoef);CHKERRQ(ierr);
+  ierr        = PetscArraycpy(st->coef,coef,st->ns);CHKERRQ(ierr);
+  st->coefset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDAStencilSetVariableCoefficients_DAStencil(Mat A,Vec coef)
+{
+  Mat_DAStencil     *st = (Mat_DAStencil*)A->data;
+  const PetscScalar *ca;
+  PetscInt          n,s,p;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(coef,&n);CHKERRQ(ierr);
+  if (n != st->ns*st->npoints) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"The coefficients have local size %D instead of %D entries for each of the %D points",n,st->ns,st->npoints);
+  if (!st->vcoef) {ierr = PetscMalloc1(st->ns*st->npoints,&st->vcoef);CHKERRQ(ierr);}
+  /* the entries are interlaced in the vector and stored one after the other, so that the kernels access them with unit stride */
+  ierr = VecGetArrayRead(coef,&ca);CHKERRQ(ierr);
+  for (s=0; s<st->ns; s++) {
+    for (p=0; p<st->npoints; p++) st->vcoef[s*st->npoints+p] = ca[p*st->ns+s];
+  }
+  ierr = VecRestoreArrayRead(coef,&ca);CHKERRQ(ierr);
+  st->coefset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDAStencilGetStencilSize_DAStencil(Mat A,PetscInt *ns)
+{
+  Mat_DAStencil *st = (Mat_DAStencil*)A->data;
+
+  PetscFunctionBegin;
+  *ns = st->ns;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatDAStencilSetCoefficients - Sets the same coefficients of the stencil at all the points of a MATDASTENCIL matrix
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+-  coef - the coefficients of the stencil entries, see MatDAStencilGetStencilSize()
+
+   Notes:
+   The entries of the stencil are the points (i+di,j+dj,k+dk) with di, dj, dk in {-1,0,1}, or those with a single
+   nonzero offset for a DMDA_STENCIL_STAR DMDA, in the order where di varies fastest, then dj, then dk. The
+   couplings to the points outside a non-periodic domain are dropped.
+
+   The matrix is assembled by this call, so the solvers that use it are set up again.
+
+   Level: intermediate
+
+.seealso: MATDASTENCIL, MatCreateDAStencil(), MatDAStencilSetVariableCoefficients(), MatDAStencilGetStencilSize()
+@*/
+PetscErrorCode MatDAStencilSetCoefficients(Mat A,const PetscScalar coef[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidScalarPointer(coef,2);
+  MatCheckPreallocated(A,1);
+  ierr = PetscUseMethod(A,"MatDAStencilSetCoefficients_C",(Mat,const PetscScalar[]),(A,coef));CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatDAStencilSetVariableCoefficients - Sets the coefficients of the stencil at each point of a MATDASTENCIL matrix
+
+   Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+-  coef - the coefficients, a global vector of a DMDA like the one of the matrix with one degree of freedom for each
+          entry of the stencil, for example created from DMDACreateCompatibleDMDA()
+
+   Notes:
+   The entries of the stencil are ordered as in MatDAStencilSetCoefficients(). The coefficients are copied, so this
+   must be called again after they change.
+
+   Level: intermediate
+
+.seealso: MATDASTENCIL, MatCreateDAStencil(), MatDAStencilSetCoefficients(), MatDAStencilGetStencilSize()
+@*/
+PetscErrorCode MatDAStencilSetVariableCoefficients(Mat A,Vec coef)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(coef,VEC_CLASSID,2);
+  MatCheckPreallocated(A,1);
+  ierr = PetscUseMethod(A,"MatDAStencilSetVariableCoefficients_C",(Mat,Vec),(A,coef));CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatDAStencilGetStencilSize - Gets the number of entries of the stencil of a MATDASTENCIL matrix
+
+   Not Collective
+
+   Input Parameter:
+.  A - the matrix
+
+   Output Parameter:
+.  ns - the number of entries, 3 in one dimension, 5 or 9 in two and 7 or 27 in three for the star and box stencils
+
+   Level: intermediate
+
+.seealso: MATDASTENCIL, MatDAStencilSetCoefficients(), MatDAStencilSetVariableCoefficients()
+@*/
+PetscErrorCode MatDAStencilGetStencilSize(Mat A,PetscInt *ns)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidIntPointer(ns,2);
+  MatCheckPreallocated(A,1);
+  ierr = PetscUseMethod(A,"MatDAStencilGetStencilSize_C",(Mat,PetscInt*),(A,ns));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatCreateDAStencil - Creates a MATDASTENCIL matrix that applies the stencil of a DMDA without storing a sparse matrix
+
+   Collective on DM
+
+   Input Parameter:
+.  da - the DMDA, with one degree of freedom per point and a stencil width of at least one
+
+   Output Parameter:
+.  A - the matrix, whose coefficients must be set with MatDAStencilSetCoefficients() or
+       MatDAStencilSetVariableCoefficients()
+
+   Options Database Keys:
+.  -mat_dastencil_tile <rows> - rows in the second dimension of the tiles swept plane by plane in the third
+
+   Notes:
+   A matrix with this type is also created by DMCreateMatrix() after DMSetMatType(da,MATDASTENCIL) or with
+   -dm_mat_type dastencil.
+
+   Level: intermediate
+
+.seealso: MATDASTENCIL, MatDAStencilSetCoefficients(), MatDAStencilSetVariableCoefficients(), DMCreateMatrix()
+@*/
+PetscErrorCode MatCreateDAStencil(DM da,Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidPointer(A,2);
+  ierr = MatCreate(PetscObjectComm((PetscObject)da),A);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATDASTENCIL);CHKERRQ(ierr);
+  ierr = MatSetDM(*A,da);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatSetUp(*A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATDASTENCIL - MATDASTENCIL = "dastencil" - A matrix that applies the 3-point stencil of a one-dimensional DMDA, the
+   5 or 9-point stencil of a two-dimensional one or the 7 or 27-point stencil of a three-dimensional one, for the star
+   and box stencil types, directly on the ghosted local arrays. The coefficients are the same at all the points or
+   stored for each point, but the column indices are never stored, so that MatMult() moves much less memory than with
+   MATAIJ.
+
+   It supports MatMult(), MatMultAdd(), MatGetDiagonal() and MatSOR(), whose sweeps are multicolor (red-black for
+   the star stencils) Gauss-Seidel sweeps over the whole grid, so that it can be the operator of the smoothers of
+   PCMG and of PCJACOBI. The colors are the parities of the grid indices, so MatSOR() needs an even number of points
+   in the periodic directions. With DMSetMatType(da,MATDASTENCIL) the DMDAs obtained from DMCoarsen() create MATDASTENCIL
+   matrices too, so the coarse solver of PCMG must then be iterative, for example -mg_coarse_pc_type sor. The rows are swept in tiles that keep the planes of the stencil in cache, and the tiles are
+   distributed among the threads when PETSc is configured --with-openmp.
+
+   Level: intermediate
+
+.seealso: MatCreateDAStencil(), MatDAStencilSetCoefficients(), MatDAStencilSetVariableCoefficients(), DMSetMatType()
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_DAStencil(Mat A)
+{
+  Mat_DAStencil  *st;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscNewLog(A,&st);CHKERRQ(ierr);
+  A->data = (void*)st;
+
+  A->ops->mult           = MatMult_DAStencil;
+  A->ops->multadd        = MatMultAdd_DAStencil;
+  A->ops->getdiagonal    = MatGetDiagonal_DAStencil;
+  A->ops->sor            = MatSOR_DAStencil;
+  A->ops->view           = MatView_DAStencil;
+  A->ops->setfromoptions = MatSetFromOptions_DAStencil;
+  A->ops->setup          = MatSetUp_DAStencil;
+  A->ops->destroy        = MatDestroy_DAStencil;
+  A->assembled           = PETSC_FALSE;
+
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilSetCoefficients_C",MatDAStencilSetCoefficients_DAStencil);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilSetVariableCoefficients_C",MatDAStencilSetVariableCoefficients_DAStencil);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatDAStencilGetStencilSize_C",MatDAStencilGetStencilSize_DAStencil);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATDASTENCIL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -233,3 +233,72 @@ PetscErrorCode  DMDAGetLocalInfo(DM da,DMDALocalInfo *info)
   info->gzm = (dd->Ze - dd->Zs);
   PetscFunctionReturn(0);
 }
+
+/*@C
+   DMDAGetInteriorLocalInfo - Splits the points owned by this process into the interior ones, whose stencil only
+   contains owned points, and boundary strips, whose stencil contains ghost points
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameters:
++  interior - the information of DMDAGetLocalInfo() with xs, xm, ys, ym, zs and zm restricted to the interior points
+.  nbdry - the number of boundary strips, at most 2 times the dimension
+-  bdry - the information of the boundary strips, an array of length 6
+
+   Notes:
+   The strips and the interior are disjoint and cover all the owned points. The ghosted ranges gxs, gxm... are
+   unchanged, so that the arrays of DMDAVecGetArray() can be passed with any of them to a function that loops over
+   the owned points of a DMDALocalInfo, such as the local functions of DMDASNESSetFunctionLocal(). The interior
+   points can be computed from the owned values of a local vector before the ghost values arrive, see
+   DMDASNESSetFunctionLocalSplit().
+
+   At a boundary of the domain with DM_BOUNDARY_NONE there are no ghost points, so the interior extends to it. The
+   interior is empty if the owned points are too few in some direction.
+
+   Level: intermediate
+
+.seealso: DMDAGetLocalInfo(), DMDASNESSetFunctionLocalSplit(), DMGlobalToLocalBegin()
+@*/
+PetscErrorCode DMDAGetInteriorLocalInfo(DM da,DMDALocalInfo *interior,PetscInt *nbdry,DMDALocalInfo bdry[])
+{
+  DMDALocalInfo  info;
+  PetscInt       xe,ye,ze,ilo,ihi,jlo,jhi,klo,khi,n = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(interior,2);
+  PetscValidIntPointer(nbdry,3);
+  PetscValidPointer(bdry,4);
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  xe  = info.xs + info.xm;
+  ye  = info.ys + info.ym;
+  ze  = info.zs + info.zm;
+  /* the points at least as far from the ghost points as there are ghost points on each side */
+  ilo = PetscMin(info.xs + (info.xs - info.gxs),xe);
+  ihi = PetscMax(xe - (info.gxs + info.gxm - xe),ilo);
+  jlo = PetscMin(info.ys + (info.ys - info.gys),ye);
+  jhi = PetscMax(ye - (info.gys + info.gym - ye),jlo);
+  klo = PetscMin(info.zs + (info.zs - info.gzs),ze);
+  khi = PetscMax(ze - (info.gzs + info.gzm - ze),klo);
+
+  *interior    = info;
+  interior->xs = ilo; interior->xm = ihi - ilo;
+  interior->ys = jlo; interior->ym = jhi - jlo;
+  interior->zs = klo; interior->zm = khi - klo;
+  /* the slabs below and above the interior in z, the strips before and after it in y between them, then in x */
+  if (klo > info.zs) {bdry[n] = info; bdry[n].zm = klo - info.zs; n++;}
+  if (ze > khi)      {bdry[n] = info; bdry[n].zs = khi; bdry[n].zm = ze - khi; n++;}
+  if (khi > klo) {
+    if (jlo > info.ys) {bdry[n] = info; bdry[n].zs = klo; bdry[n].zm = khi - klo; bdry[n].ym = jlo - info.ys; n++;}
+    if (ye > jhi)      {bdry[n] = info; bdry[n].zs = klo; bdry[n].zm = khi - klo; bdry[n].ys = jhi; bdry[n].ym = ye - jhi; n++;}
+    if (jhi > jlo) {
+      if (ilo > info.xs) {bdry[n] = *interior; bdry[n].xs = info.xs; bdry[n].xm = ilo - info.xs; n++;}
+      if (xe > ihi)      {bdry[n] = *interior; bdry[n].xs = ihi; bdry[n].xm = xe - ihi; n++;}
+    }
+  }
+  *nbdry = n;
+  PetscFunctionReturn(0);
+}
@@ -1578,9 +1578,12 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   The user can control the definition of adjacency for the mesh using DMSetAdjacency(). They should choose the combination appropriate for the function
   representation on the mesh.
 
+  If an ordering was set with DMPlexSetReorderType(), the distributed mesh is renumbered with it. On one process the mesh is not
+  distributed, but it is still renumbered, so dmParallel is the permuted mesh and sf maps the original points to it.
+
   Level: intermediate
 
-.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexGetOverlap()
+.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexGetOverlap(), DMPlexSetReorderType()
 @*/
 PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmParallel)
 {
@@ -1591,6 +1594,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   DM                     dmCoord;
   DMLabel                lblPartition, lblMigration;
   PetscSF                sfMigration, sfStratified, sfPoint;
+  MatOrderingType        otype;
   PetscBool              flg, balance;
   PetscMPIInt            rank, size;
   PetscErrorCode         ierr;
@@ -1606,7 +1610,43 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
-  if (size == 1) PetscFunctionReturn(0);
+  if (size == 1) {
+    DM                 dmPerm;
+    IS                 perm;
+    PetscSF            sfPerm;
+    const PetscInt    *pperm;
+    PetscSFNode       *remotes;
+    PetscInt          *leaves, pStart, pEnd, p;
+
+    ierr = DMPlexGetReorderType(dm, &otype);CHKERRQ(ierr);
+    if (!otype) PetscFunctionReturn(0);
+    if (((DM_Plex *) dm->data)->parentSection) SETERRQ(comm, PETSC_ERR_SUP, "Reordering of meshes with a tree is not supported");
+    ierr = PetscLogEventBegin(DMPLEX_Distribute,dm,0,0,0);CHKERRQ(ierr);
+    ierr = DMPlexGetOrdering(dm, otype, NULL, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(dm, perm, &dmPerm);CHKERRQ(ierr);
+    ierr = DMPlexSetReorderType(dmPerm, otype);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject) dmPerm, "Parallel Mesh");CHKERRQ(ierr);
+    ierr = DMCopyBoundary(dm, dmPerm);CHKERRQ(ierr);
+    if (sf) {
+      ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = PetscMalloc1(pEnd-pStart, &leaves);CHKERRQ(ierr);
+      ierr = PetscMalloc1(pEnd-pStart, &remotes);CHKERRQ(ierr);
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      for (p = pStart; p < pEnd; ++p) {
+        leaves[p-pStart]        = pperm[p-pStart];
+        remotes[p-pStart].rank  = 0;
+        remotes[p-pStart].index = p;
+      }
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSFCreate(comm, &sfPerm);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfPerm, pEnd-pStart, pEnd-pStart, leaves, PETSC_OWN_POINTER, remotes, PETSC_OWN_POINTER);CHKERRQ(ierr);
+      *sf  = sfPerm;
+    }
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    *dmParallel = dmPerm;
+    ierr = PetscLogEventEnd(DMPLEX_Distribute,dm,0,0,0);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   ierr = PetscLogEventBegin(DMPLEX_Distribute,dm,0,0,0);CHKERRQ(ierr);
   /* Create cell partition */
@@ -1674,6 +1714,8 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   /* Build the point SF without overlap */
   ierr = DMPlexGetPartitionBalance(dm, &balance);CHKERRQ(ierr);
   ierr = DMPlexSetPartitionBalance(*dmParallel, balance);CHKERRQ(ierr);
+  ierr = DMPlexGetReorderType(dm, &otype);CHKERRQ(ierr);
+  ierr = DMPlexSetReorderType(*dmParallel, otype);CHKERRQ(ierr);
   ierr = DMPlexCreatePointSF(*dmParallel, sfMigration, PETSC_TRUE, &sfPoint);CHKERRQ(ierr);
   ierr = DMSetPointSF(*dmParallel, sfPoint);CHKERRQ(ierr);
   ierr = DMGetCoordinateDM(*dmParallel, &dmCoord);CHKERRQ(ierr);
@@ -1718,6 +1760,39 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
     ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
     sfMigration = sfOverlapPoint;
   }
+  /* Renumber the parallel mesh, and the leaves of the migration SF with it */
+  ierr = DMPlexGetReorderType(dm, &otype);CHKERRQ(ierr);
+  if (otype) {
+    DM                 dmPerm;
+    IS                 perm;
+    PetscSF            sfPerm;
+    const PetscInt    *pperm, *leaves;
+    const PetscSFNode *remotes;
+    PetscSFNode       *remotesNew;
+    PetscInt          *leavesNew, nroots, nleaves, l;
+
+    if (((DM_Plex *) (*dmParallel)->data)->parentSection) SETERRQ(comm, PETSC_ERR_SUP, "Reordering of meshes with a tree is not supported");
+    ierr = DMPlexGetOrdering(*dmParallel, otype, NULL, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(*dmParallel, perm, &dmPerm);CHKERRQ(ierr);
+    ierr = DMPlexSetReorderType(dmPerm, otype);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject) dmPerm, "Parallel Mesh");CHKERRQ(ierr);
+    ierr = DMDestroy(dmParallel);CHKERRQ(ierr);
+    *dmParallel = dmPerm;
+    ierr = PetscSFGetGraph(sfMigration, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &leavesNew);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves, &remotesNew);CHKERRQ(ierr);
+    ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+    for (l = 0; l < nleaves; ++l) {
+      leavesNew[l]  = pperm[leaves ? leaves[l] : l];
+      remotesNew[l] = remotes[l];
+    }
+    ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfPerm);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sfPerm, nroots, nleaves, leavesNew, PETSC_OWN_POINTER, remotesNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
+    sfMigration = sfPerm;
+  }
   /* Cleanup Partition */
   ierr = DMLabelDestroy(&lblPartition);CHKERRQ(ierr);
   ierr = DMLabelDestroy(&lblMigration);CHKERRQ(ierr);
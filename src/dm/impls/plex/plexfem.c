@@ -3192,7 +3192,7 @@ PetscErrorCode DMPlexGetCellFields(DM dm, IS cellIS, Vec locX, Vec locX_t, Vec l
   PetscSection    section, sectionAux;
   PetscDS         prob;
   const PetscInt *cells;
-  PetscInt        cStart, cEnd, numCells, totDim, totDimAux, c;
+  PetscInt        cStart, cEnd, numCells, totDim, totDimAux, clSize = -1, clSizeAux = -1, c;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -3223,21 +3223,31 @@ PetscErrorCode DMPlexGetCellFields(DM dm, IS cellIS, Vec locX, Vec locX_t, Vec l
   ierr = DMGetWorkArray(dm, numCells*totDim, MPIU_SCALAR, u);CHKERRQ(ierr);
   if (locX_t) {ierr = DMGetWorkArray(dm, numCells*totDim, MPIU_SCALAR, u_t);CHKERRQ(ierr);} else {*u_t = NULL;}
   if (locA)   {ierr = DMGetWorkArray(dm, numCells*totDimAux, MPIU_SCALAR, a);CHKERRQ(ierr);} else {*a = NULL;}
+  /* A contiguous range of cells with closures of the expected size is gathered in one pass */
+  if (!cells) {ierr = DMPlexGetClosureDofMapSize(plex, section, cStart, cEnd, &clSize);CHKERRQ(ierr);}
+  if (clSize == totDim) {
+    ierr = DMPlexVecGetClosureBatch(plex, section, locX, cStart, cEnd, totDim, *u);CHKERRQ(ierr);
+    if (locX_t) {ierr = DMPlexVecGetClosureBatch(plex, section, locX_t, cStart, cEnd, totDim, *u_t);CHKERRQ(ierr);}
+  }
+  if (locA && !cells && encAux == DM_ENC_EQUALITY) {ierr = DMPlexGetClosureDofMapSize(plexA, sectionAux, cStart, cEnd, &clSizeAux);CHKERRQ(ierr);}
+  if (locA && clSizeAux == totDimAux) {ierr = DMPlexVecGetClosureBatch(plexA, sectionAux, locA, cStart, cEnd, totDimAux, *a);CHKERRQ(ierr);}
   for (c = cStart; c < cEnd; ++c) {
     const PetscInt cell = cells ? cells[c] : c;
     const PetscInt cind = c - cStart;
     PetscScalar   *x = NULL, *x_t = NULL, *ul = *u, *ul_t = *u_t, *al = *a;
     PetscInt       i;
 
-    ierr = DMPlexVecGetClosure(plex, section, locX, cell, NULL, &x);CHKERRQ(ierr);
-    for (i = 0; i < totDim; ++i) ul[cind*totDim+i] = x[i];
-    ierr = DMPlexVecRestoreClosure(plex, section, locX, cell, NULL, &x);CHKERRQ(ierr);
-    if (locX_t) {
+    if (clSize != totDim) {
+      ierr = DMPlexVecGetClosure(plex, section, locX, cell, NULL, &x);CHKERRQ(ierr);
+      for (i = 0; i < totDim; ++i) ul[cind*totDim+i] = x[i];
+      ierr = DMPlexVecRestoreClosure(plex, section, locX, cell, NULL, &x);CHKERRQ(ierr);
+    }
+    if (locX_t && clSize != totDim) {
       ierr = DMPlexVecGetClosure(plex, section, locX_t, cell, NULL, &x_t);CHKERRQ(ierr);
       for (i = 0; i < totDim; ++i) ul_t[cind*totDim+i] = x_t[i];
       ierr = DMPlexVecRestoreClosure(plex, section, locX_t, cell, NULL, &x_t);CHKERRQ(ierr);
     }
-    if (locA) {
+    if (locA && clSizeAux != totDimAux) {
       PetscInt subcell;
       ierr = DMGetEnclosurePoint(plexA, dm, encAux, cell, &subcell);CHKERRQ(ierr);
       ierr = DMPlexVecGetClosure(plexA, sectionAux, locA, subcell, NULL, &x);CHKERRQ(ierr);
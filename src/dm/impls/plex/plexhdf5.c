@@ -2,6 +2,7 @@
 #include <petsc/private/isimpl.h>
 #include <petsc/private/vecimpl.h>
 #include <petsc/private/viewerhdf5impl.h>
+#include <petsc/private/hashmapi.h>
 #include <petsclayouthdf5.h>
 
 PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
@@ -816,8 +817,39 @@ typedef struct {
   DM          dm;
   PetscViewer viewer;
   DMLabel     label;
+  PetscLayout layout; /* The slabs of stored points, or NULL if everything is read onto proc 0 */
+  PetscSF     sf;     /* Maps the local points to the slabs */
 } LabelCtx;
 
+/* The stratum points are marked in their slabs, and the marks are then pulled to the local points */
+static PetscErrorCode SetLabelStratum_Private(LabelCtx *ctx, IS stratumIS, PetscInt value)
+{
+  PetscSF         sf;
+  const PetscInt *ind;
+  PetscInt       *ones, *marks, *local, n, nroots, nleaves, i;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = ISGetLocalSize(stratumIS, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(stratumIS, &ind);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(ctx->layout, &nroots);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(ctx->sf, NULL, &nleaves, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(n, &ones, nroots, &marks, nleaves, &local);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i)      ones[i]  = 1;
+  for (i = 0; i < nroots; ++i) marks[i] = 0;
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject) ctx->sf), &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, ctx->layout, n, NULL, PETSC_OWN_POINTER, ind);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, marks, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, marks, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(stratumIS, &ind);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(ctx->sf, MPIU_INT, marks, local);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(ctx->sf, MPIU_INT, marks, local);CHKERRQ(ierr);
+  for (i = 0; i < nleaves; ++i) if (local[i]) {ierr = DMLabelSetValue(ctx->label, i, value);CHKERRQ(ierr);}
+  ierr = PetscFree3(ones, marks, local);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5L_info_t *info, void *op_data)
 {
   PetscViewer     viewer = ((LabelCtx *) op_data)->viewer;
@@ -835,7 +867,7 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   ierr = PetscObjectGetName((PetscObject) label, &lname);
   ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s/%s", lname, name);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
-  {
+  if (!((LabelCtx *) op_data)->sf) {
     /* Force serial load */
     ierr = PetscViewerHDF5ReadSizes(viewer, "indices", NULL, &N);CHKERRQ(ierr);
     ierr = PetscLayoutSetLocalSize(stratumIS->map, !((LabelCtx *) op_data)->rank ? N : 0);CHKERRQ(ierr);
@@ -843,6 +875,11 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   }
   ierr = ISLoad(stratumIS, viewer);
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  if (((LabelCtx *) op_data)->sf) {
+    ierr = SetLabelStratum_Private((LabelCtx *) op_data, stratumIS, value);if (ierr) return (herr_t) ierr;
+    ierr = ISDestroy(&stratumIS);
+    return 0;
+  }
   ierr = ISGetLocalSize(stratumIS, &N);
   ierr = ISGetIndices(stratumIS, &ind);
   for (i = 0; i < N; ++i) {ierr = DMLabelSetValue(label, ind[i], value);}
@@ -864,7 +901,7 @@ static herr_t ReadLabelHDF5_Static(hid_t g_id, const char *name, const H5L_info_
   return err;
 }
 
-PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+static PetscErrorCode DMPlexLoadLabels_HDF5_Static(DM dm, PetscViewer viewer, PetscLayout layout, PetscSF sf)
 {
   LabelCtx        ctx;
   hid_t           fileId, groupId;
@@ -875,6 +912,8 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &ctx.rank);CHKERRQ(ierr);
   ctx.dm     = dm;
   ctx.viewer = viewer;
+  ctx.layout = layout;
+  ctx.sf     = sf;
   ierr = PetscViewerHDF5PushGroup(viewer, "/labels");CHKERRQ(ierr);
   ierr = PetscViewerHDF5OpenGroup(viewer, &fileId, &groupId);CHKERRQ(ierr);
   PetscStackCallHDF5(H5Literate,(groupId, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ReadLabelHDF5_Static, &ctx));
@@ -883,8 +922,370 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
-/* The first version will read everything onto proc 0, letting the user distribute
-   The next will create a naive partition, and then rebalance after reading
+PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexLoadLabels_HDF5_Static(dm, viewer, NULL, NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Cells are the points in no cone. They are dealt out evenly, so that the slabs holding lower dimensional points do not starve */
+static PetscErrorCode GatherCells_Private(PetscLayout layout, const PetscInt coneSizes[], const PetscInt coneOff[], const PetscInt conePoints[], PetscInt *numCells, PetscInt **cellPoints)
+{
+  MPI_Comm       comm;
+  PetscLayout    slabCellLayout, cellLayout;
+  PetscSF        sf;
+  PetscInt      *ones, *support, *cellIdx, *slabCells;
+  PetscInt       n, rStart, cStart, Nc, nc = 0, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  comm = layout->comm;
+  ierr = PetscLayoutGetLocalSize(layout, &n);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(layout, &rStart, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(coneOff[n], &ones, n, &support);CHKERRQ(ierr);
+  for (i = 0; i < coneOff[n]; ++i) ones[i] = 1;
+  for (i = 0; i < n; ++i) support[i] = 0;
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, layout, coneOff[n], NULL, PETSC_OWN_POINTER, conePoints);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, support, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, support, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) if (!support[i] && coneSizes[i]) ++nc;
+  ierr = PetscLayoutCreate(comm, &slabCellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(slabCellLayout, nc);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(slabCellLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(slabCellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(slabCellLayout, &cStart, NULL);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(slabCellLayout, &Nc);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cellLayout, Nc);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(cellLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(cellLayout, numCells);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nc, &cellIdx, nc, &slabCells);CHKERRQ(ierr);
+  for (i = 0, nc = 0; i < n; ++i) {
+    if (!support[i] && coneSizes[i]) {cellIdx[nc] = cStart+nc; slabCells[nc] = rStart+i; ++nc;}
+  }
+  ierr = PetscMalloc1(*numCells, cellPoints);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, cellLayout, nc, NULL, PETSC_OWN_POINTER, cellIdx);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, slabCells, *cellPoints, MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, slabCells, *cellPoints, MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(cellIdx, slabCells);CHKERRQ(ierr);
+  ierr = PetscFree2(ones, support);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&slabCellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&cellLayout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The closures of the cells are pulled from the slabs one level at a time. Points are returned in order of discovery, with their cones */
+static PetscErrorCode GatherClosures_Private(PetscLayout layout, const PetscInt coneSizes[], const PetscInt coneOff[], const PetscInt conePoints[], const PetscInt coneOrnts[], PetscInt numCells, const PetscInt cellPoints[], PetscHMapI pointMap, PetscInt *numPoints, PetscInt **points, PetscInt **sizes, PetscInt **cones, PetscInt **ornts)
+{
+  MPI_Comm       comm;
+  PetscSegBuffer pointBuf, sizeBuf, coneBuf, orntBuf;
+  PetscSF        sf;
+  PetscInt      *rootInfo, *frontier, *pslot, n, nf = numCells, Np = 0, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  comm = layout->comm;
+  ierr = PetscLayoutGetLocalSize(layout, &n);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*n, &rootInfo);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {rootInfo[i*2+0] = coneSizes[i]; rootInfo[i*2+1] = coneOff[i];}
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &pointBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &sizeBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &coneBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &orntBuf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCells, &frontier);CHKERRQ(ierr);
+  ierr = PetscSegBufferGetInts(pointBuf, numCells, &pslot);CHKERRQ(ierr);
+  for (i = 0; i < numCells; ++i) {
+    frontier[i] = pslot[i] = cellPoints[i];
+    ierr = PetscHMapISet(pointMap, cellPoints[i], Np++);CHKERRQ(ierr);
+  }
+  while (PETSC_TRUE) {
+    PetscSFNode *remote;
+    PetscInt    *info, *next, *fsizes, *fcones, *fornts, gnf, nfc = 0, nn = 0, f, c, k;
+
+    ierr = MPIU_Allreduce(&nf, &gnf, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    if (!gnf) break;
+    /* Fetch the cone size and slab offset of each frontier point */
+    ierr = PetscMalloc1(2*nf, &info);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf, layout, nf, NULL, PETSC_OWN_POINTER, frontier);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, MPIU_2INT, rootInfo, info);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_2INT, rootInfo, info);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    /* Fetch the cones themselves */
+    for (f = 0; f < nf; ++f) nfc += info[f*2+0];
+    ierr = PetscMalloc1(nfc, &remote);CHKERRQ(ierr);
+    for (f = 0, c = 0; f < nf; ++f) {
+      PetscMPIInt owner;
+
+      ierr = PetscLayoutFindOwner(layout, frontier[f], &owner);CHKERRQ(ierr);
+      for (k = 0; k < info[f*2+0]; ++k, ++c) {remote[c].rank = owner; remote[c].index = info[f*2+1]+k;}
+    }
+    ierr = PetscSegBufferGetInts(sizeBuf, nf, &fsizes);CHKERRQ(ierr);
+    ierr = PetscSegBufferGetInts(coneBuf, nfc, &fcones);CHKERRQ(ierr);
+    ierr = PetscSegBufferGetInts(orntBuf, nfc, &fornts);CHKERRQ(ierr);
+    for (f = 0; f < nf; ++f) fsizes[f] = info[f*2+0];
+    ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sf, coneOff[n], nfc, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, conePoints, fcones);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, conePoints, fcones);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, coneOrnts, fornts);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, coneOrnts, fornts);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    /* Unseen cone points form the next frontier */
+    ierr = PetscMalloc1(nfc, &next);CHKERRQ(ierr);
+    for (c = 0; c < nfc; ++c) {
+      PetscInt idx;
+
+      ierr = PetscHMapIGet(pointMap, fcones[c], &idx);CHKERRQ(ierr);
+      if (idx < 0) {
+        ierr = PetscHMapISet(pointMap, fcones[c], Np++);CHKERRQ(ierr);
+        next[nn++] = fcones[c];
+      }
+    }
+    ierr = PetscSegBufferGetInts(pointBuf, nn, &pslot);CHKERRQ(ierr);
+    for (c = 0; c < nn; ++c) pslot[c] = next[c];
+    ierr = PetscFree(info);CHKERRQ(ierr);
+    ierr = PetscFree(frontier);CHKERRQ(ierr);
+    frontier = next;
+    nf       = nn;
+  }
+  ierr = PetscFree(frontier);CHKERRQ(ierr);
+  ierr = PetscFree(rootInfo);CHKERRQ(ierr);
+  *numPoints = Np;
+  ierr = PetscSegBufferExtractAlloc(pointBuf, points);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(sizeBuf, sizes);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(coneBuf, cones);CHKERRQ(ierr);
+  ierr = PetscSegBufferExtractAlloc(orntBuf, ornts);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&pointBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&sizeBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&coneBuf);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&orntBuf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Each process reads a contiguous slab of the stored points, which stays the home of their cones, and then gathers
+  the closures of its share of the cells from the slabs. No process ever holds more than its share of the mesh, and
+  the naive partition can be rebalanced with DMPlexDistribute(). The returned SF maps the local points to the slabs.
+*/
+static PetscErrorCode DMPlexLoad_HDF5_Parallel_Static(DM dm, PetscViewer viewer, PetscLayout *pointLayout, PetscSF *pointSF)
+{
+  MPI_Comm           comm;
+  PetscLayout        layout, vertexLayout, coordLayout;
+  PetscSF            sfPoint, sfVert;
+  PetscHMapI         pointMap;
+  PetscSFNode       *ownerLocal, *ownerRoot, *remote;
+  IS                 orderIS, conesIS, cellsIS, orntsIS;
+  Vec                coordinates;
+  const PetscInt    *order, *coneSizes, *conePoints, *coneOrnts;
+  const PetscScalar *coords;
+  PetscReal         *rcoords, lengthScale;
+  PetscInt          *coneOff, *cellPoints, *points, *sizes, *cones, *ornts, *off, *coneIdx, *depth, *keyOff, *perm, *tmp, *newPoint, *vnum, *ghosts, *cone, *ornt;
+  PetscInt           dim, spatialDim, N, n, rStart, vStart, Nv, numCells, Np = 0, numVertices, numV, maxDepth = 0, maxConeSize = 0, numGhosts = 0, i, p, q, c, k;
+  PetscBool          inOrder = PETSC_TRUE, gInOrder, changed;
+  PetscMPIInt        rank;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  /* Read topology slabs */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orderIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orderIS, "order");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &conesIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) conesIS, "cones");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &cellsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) cellsIS, "cells");CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orntsIS);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) orntsIS, "orientation");CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadObjectAttribute(viewer, (PetscObject) cellsIS, "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
+  ierr = DMSetDimension(dm, dim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadSizes(viewer, "order", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(layout, N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(layout, &n);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(layout, &rStart, NULL);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(orderIS->map, n);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(orderIS->map, N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(conesIS->map, n);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(conesIS->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(orderIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(conesIS, viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISGetIndices(conesIS, &coneSizes);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n+1, &coneOff);CHKERRQ(ierr);
+  for (i = 0, coneOff[0] = 0; i < n; ++i) {
+    if (order[i] != rStart+i) inOrder = PETSC_FALSE;
+    coneOff[i+1] = coneOff[i] + coneSizes[i];
+  }
+  ierr = MPIU_Allreduce(&inOrder, &gInOrder, 1, MPIU_BOOL, MPI_LAND, comm);CHKERRQ(ierr);
+  if (!gInOrder) SETERRQ(comm, PETSC_ERR_FILE_UNEXPECTED, "Parallel loading needs the points stored in the order of their numbers, as written by DMView()");
+  ierr = ISRestoreIndices(orderIS, &order);CHKERRQ(ierr);
+  ierr = ISDestroy(&orderIS);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadSizes(viewer, "cells", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(cellsIS->map, coneOff[n]);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cellsIS->map, N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(orntsIS->map, coneOff[n]);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(orntsIS->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(cellsIS, viewer);CHKERRQ(ierr);
+  ierr = ISLoad(orntsIS, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellsIS, &conePoints);CHKERRQ(ierr);
+  ierr = ISGetIndices(orntsIS, &coneOrnts);CHKERRQ(ierr);
+  /* Gather the closures of our cells */
+  ierr = GatherCells_Private(layout, coneSizes, coneOff, conePoints, &numCells, &cellPoints);CHKERRQ(ierr);
+  ierr = PetscHMapICreate(&pointMap);CHKERRQ(ierr);
+  ierr = GatherClosures_Private(layout, coneSizes, coneOff, conePoints, coneOrnts, numCells, cellPoints, pointMap, &Np, &points, &sizes, &cones, &ornts);CHKERRQ(ierr);
+  ierr = PetscFree(cellPoints);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(cellsIS, &conePoints);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(orntsIS, &coneOrnts);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellsIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&orntsIS);CHKERRQ(ierr);
+  /* Order the local points as cells, vertices, and then the remaining strata by decreasing depth */
+  ierr = PetscMalloc3(Np+1, &off, Np, &depth, Np, &newPoint);CHKERRQ(ierr);
+  for (p = 0, off[0] = 0; p < Np; ++p) {off[p+1] = off[p] + sizes[p]; depth[p] = sizes[p] ? -1 : 0; maxConeSize = PetscMax(maxConeSize, sizes[p]);}
+  ierr = PetscMalloc1(off[Np], &coneIdx);CHKERRQ(ierr);
+  for (c = 0; c < off[Np]; ++c) {ierr = PetscHMapIGet(pointMap, cones[c], &coneIdx[c]);CHKERRQ(ierr);}
+  ierr = PetscHMapIDestroy(&pointMap);CHKERRQ(ierr);
+  do {
+    changed = PETSC_FALSE;
+    for (p = 0; p < Np; ++p) {
+      PetscInt d = 0;
+
+      if (depth[p] >= 0) continue;
+      for (c = off[p]; c < off[p+1]; ++c) {
+        if (depth[coneIdx[c]] < 0) break;
+        d = PetscMax(d, depth[coneIdx[c]]+1);
+      }
+      if (c < off[p+1]) continue;
+      depth[p] = d;
+      maxDepth = PetscMax(maxDepth, d);
+      changed  = PETSC_TRUE;
+    }
+  } while (changed);
+  ierr = PetscCalloc1(maxDepth+3, &keyOff);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Np, &perm, Np, &tmp);CHKERRQ(ierr);
+  for (p = 0; p < Np; ++p) {
+    if (depth[p] < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Point %D has a cycle in its closure", points[p]);
+    depth[p] = p < numCells ? 0 : (!depth[p] ? 1 : 2 + maxDepth - depth[p]);
+    ++keyOff[depth[p]+1];
+  }
+  for (k = 0; k < maxDepth+2; ++k) keyOff[k+1] += keyOff[k];
+  for (p = 0; p < Np; ++p) perm[keyOff[depth[p]]++] = p;
+  for (k = maxDepth+1; k > 0; --k) keyOff[k] = keyOff[k-1];
+  keyOff[0] = 0;
+  for (q = 0; q < Np; ++q) tmp[q] = points[perm[q]];
+  for (k = 0; k < maxDepth+2; ++k) {ierr = PetscSortIntWithArray(keyOff[k+1]-keyOff[k], &tmp[keyOff[k]], &perm[keyOff[k]]);CHKERRQ(ierr);}
+  for (q = 0; q < Np; ++q) newPoint[perm[q]] = q;
+  numVertices = keyOff[2] - keyOff[1];
+  /* Create Plex */
+  ierr = DMPlexSetChart(dm, 0, Np);CHKERRQ(ierr);
+  for (q = 0; q < Np; ++q) {ierr = DMPlexSetConeSize(dm, q, sizes[perm[q]]);CHKERRQ(ierr);}
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(maxConeSize, &cone, maxConeSize, &ornt);CHKERRQ(ierr);
+  for (q = 0; q < Np; ++q) {
+    const PetscInt p = perm[q];
+
+    for (c = off[p]; c < off[p+1]; ++c) {cone[c-off[p]] = newPoint[coneIdx[c]]; ornt[c-off[p]] = ornts[c];}
+    ierr = DMPlexSetCone(dm, q, cone);CHKERRQ(ierr);
+    ierr = DMPlexSetConeOrientation(dm, q, ornt);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(cone, ornt);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  ierr = PetscFree(keyOff);CHKERRQ(ierr);
+  ierr = PetscFree3(off, depth, newPoint);CHKERRQ(ierr);
+  ierr = PetscFree(coneIdx);CHKERRQ(ierr);
+  ierr = PetscFree(sizes);CHKERRQ(ierr);
+  ierr = PetscFree(cones);CHKERRQ(ierr);
+  ierr = PetscFree(ornts);CHKERRQ(ierr);
+  ierr = PetscFree(points);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, pointSF);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(*pointSF, layout, Np, NULL, PETSC_OWN_POINTER, tmp);CHKERRQ(ierr);
+  ierr = PetscFree2(perm, tmp);CHKERRQ(ierr);
+  /* Shared points are owned by the highest rank holding them */
+  ierr = PetscMalloc2(Np, &ownerLocal, n, &ownerRoot);CHKERRQ(ierr);
+  for (q = 0; q < Np; ++q) {ownerLocal[q].rank = rank; ownerLocal[q].index = q;}
+  for (i = 0; i < n; ++i)  {ownerRoot[i].rank = -1;    ownerRoot[i].index = -1;}
+  ierr = PetscSFReduceBegin(*pointSF, MPIU_2INT, ownerLocal, ownerRoot, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(*pointSF, MPIU_2INT, ownerLocal, ownerRoot, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(*pointSF, MPIU_2INT, ownerRoot, ownerLocal);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*pointSF, MPIU_2INT, ownerRoot, ownerLocal);CHKERRQ(ierr);
+  for (q = 0; q < Np; ++q) if (ownerLocal[q].rank != rank) ++numGhosts;
+  ierr = PetscMalloc1(numGhosts, &ghosts);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numGhosts, &remote);CHKERRQ(ierr);
+  for (q = 0, k = 0; q < Np; ++q) {
+    if (ownerLocal[q].rank != rank) {ghosts[k] = q; remote[k] = ownerLocal[q]; ++k;}
+  }
+  ierr = PetscFree2(ownerLocal, ownerRoot);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sfPoint, "point SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, Np, numGhosts, ghosts, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Vertices are numbered in the order of the stored points, which is the order of the stored coordinates */
+  ierr = PetscMalloc2(n, &vnum, Np, &tmp);CHKERRQ(ierr);
+  for (i = 0, k = 0; i < n; ++i) if (!coneSizes[i]) ++k;
+  ierr = PetscLayoutCreate(comm, &vertexLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vertexLayout, k);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vertexLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vertexLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(vertexLayout, &vStart, NULL);CHKERRQ(ierr);
+  ierr = PetscLayoutGetSize(vertexLayout, &Nv);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vertexLayout);CHKERRQ(ierr);
+  for (i = 0, k = 0; i < n; ++i) vnum[i] = coneSizes[i] ? -1 : vStart + k++;
+  ierr = PetscSFBcastBegin(*pointSF, MPIU_INT, vnum, tmp);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*pointSF, MPIU_INT, vnum, tmp);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(conesIS, &coneSizes);CHKERRQ(ierr);
+  ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
+  ierr = PetscFree(coneOff);CHKERRQ(ierr);
+  /* Read geometry slab */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = VecCreate(comm, &coordinates);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "vertices");CHKERRQ(ierr);
+  ierr = VecLoad(coordinates, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(coordinates, &spatialDim);CHKERRQ(ierr);
+  ierr = VecGetSize(coordinates, &N);CHKERRQ(ierr);
+  if (N != Nv*spatialDim) SETERRQ2(comm, PETSC_ERR_FILE_UNEXPECTED, "Number of coordinates loaded %D does not match number of vertices %D", N/spatialDim, Nv);
+  ierr = VecGetLocalSize(coordinates, &numV);CHKERRQ(ierr);
+  numV /= spatialDim;
+  ierr = PetscLayoutCreate(comm, &coordLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(coordLayout, numV);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(coordLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(coordLayout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfVert);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfVert, coordLayout, numVertices, NULL, PETSC_OWN_POINTER, &tmp[numCells]);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&coordLayout);CHKERRQ(ierr);
+  ierr = PetscFree2(vnum, tmp);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  if (PetscDefined(USE_COMPLEX)) {
+    ierr = PetscMalloc1(numV*spatialDim, &rcoords);CHKERRQ(ierr);
+    for (i = 0; i < numV*spatialDim; ++i) rcoords[i] = PetscRealPart(coords[i]);
+  } else rcoords = (PetscReal *) coords;
+  ierr = DMPlexBuildCoordinates_Parallel_Internal(dm, spatialDim, numCells, numV, sfVert, rcoords);CHKERRQ(ierr);
+  if (PetscDefined(USE_COMPLEX)) {ierr = PetscFree(rcoords);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
+  ierr = DMGetCoordinates(dm, &coordinates);CHKERRQ(ierr);
+  ierr = VecScale(coordinates, 1.0/lengthScale);CHKERRQ(ierr);
+  *pointLayout = layout;
+  PetscFunctionReturn(0);
+}
+
+/* By default everything is read onto proc 0, letting the user distribute
+   With -dm_plex_hdf5_parallel_load each process reads a naive partition, which DMPlexDistribute() rebalances
 */
 PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
 {
@@ -896,9 +1297,23 @@ PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
   PetscInt       *cone, *ornt;
   PetscInt        dim, spatialDim, N, numVertices, vStart, vEnd, v, pEnd, p, q, maxConeSize = 0, c;
   PetscMPIInt     rank;
+  PetscBool       parallel = PETSC_FALSE;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)dm),((PetscObject)dm)->prefix,"DMPlex HDF5 Loader Options","PetscViewer");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-dm_plex_hdf5_parallel_load","read the mesh in slabs on all processes",NULL,parallel,&parallel,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (parallel) {
+    PetscLayout layout;
+    PetscSF     sf;
+
+    ierr = DMPlexLoad_HDF5_Parallel_Static(dm, viewer, &layout, &sf);CHKERRQ(ierr);
+    ierr = DMPlexLoadLabels_HDF5_Static(dm, viewer, layout, sf);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRQ(ierr);
   /* Read toplogy */
   ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
@@ -73,3 +73,470 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* The dof indices of the closures of the cells, in the order of the values of DMPlexVecGetClosure() */
+typedef struct {
+  PetscObjectId    id;        /* The DM the map was built for, which also keys the closure permutation of the section */
+  PetscObjectState meshState; /* The state of the cone section of the DM */
+  PetscObjectState state;     /* The state of the section, which changes with its layout, constraints, symmetries and closure permutation */
+  PetscInt         pStart;    /* The cells in the map */
+  PetscInt         pEnd;
+  PetscInt        *off;       /* The closure of cell p starts at off[p-pStart] */
+  PetscInt        *lidx;      /* The index of each closure dof in the local vector */
+  PetscBool       *bc;        /* Whether each closure dof is constrained, or NULL if none is */
+  PetscScalar     *flip;      /* The sign flip of each closure dof, or NULL if there is none */
+  PetscSection     gSection;  /* The global section of gidx */
+  PetscObjectState gState;    /* The state of gSection when gidx was computed */
+  PetscInt        *gidx;      /* The global indices, as given by DMPlexGetClosureIndices() */
+} DMPlexClosureDofMap;
+
+/* The map is valid if neither the DM, its topology, nor the section changed since it was built */
+static PetscErrorCode DMPlexClosureDofMapKey_Private(DM dm, PetscSection section, PetscObjectId *id, PetscObjectState *meshState, PetscObjectState *state)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject) dm, id);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) mesh->coneSection, meshState);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) section, state);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexClosureDofMapDestroy_Private(void *ctx)
+{
+  DMPlexClosureDofMap *map = (DMPlexClosureDofMap *) ctx;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(map->off);CHKERRQ(ierr);
+  ierr = PetscFree(map->lidx);CHKERRQ(ierr);
+  ierr = PetscFree(map->bc);CHKERRQ(ierr);
+  ierr = PetscFree(map->flip);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&map->gSection);CHKERRQ(ierr);
+  ierr = PetscFree(map->gidx);CHKERRQ(ierr);
+  ierr = PetscFree(map);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexCreateClosureDofMap - Calculate the local dof indices of the closures of the cells for the given PetscSection
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+- section - The section describing the layout in the local vector, or NULL to use the default section
+
+  Notes:
+  The map holds, for each cell, the position in the local vector of each value of DMPlexVecGetClosure(), with the
+  closure permutation and the orientations of the points already applied, and the sign flips of the values. It is
+  attached to the section and used by DMPlexVecGetClosureBatch(), DMPlexVecSetClosureBatch() and
+  DMPlexMatSetClosureBatch(), which create it again when the DM, its topology, or the layout, constraints, symmetries
+  or closure permutation of the section have changed.
+
+  Level: intermediate
+
+.seealso DMPlexGetClosureDofMapSize(), DMPlexVecGetClosureBatch(), DMPlexCreateClosureIndex()
+@*/
+PetscErrorCode DMPlexCreateClosureDofMap(DM dm, PetscSection section)
+{
+  DMPlexClosureDofMap *map;
+  PetscContainer       container;
+  const PetscInt      *clperm = NULL;
+  PetscInt             pStart, pEnd, p, Nf, f, n, k;
+  PetscBool            hasbc = PETSC_FALSE, hasflip = PETSC_FALSE;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  if (Nf > 31) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", Nf);
+  ierr = DMPlexGetHeightStratum(dm, 0, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &clperm);CHKERRQ(ierr);
+  ierr = PetscNew(&map);CHKERRQ(ierr);
+  ierr = DMPlexClosureDofMapKey_Private(dm, section, &map->id, &map->meshState, &map->state);CHKERRQ(ierr);
+  map->pStart = pStart;
+  map->pEnd   = pEnd;
+  ierr = PetscMalloc1(pEnd-pStart+1, &map->off);CHKERRQ(ierr);
+  map->off[0] = 0;
+  for (p = pStart; p < pEnd; ++p) {
+    PetscSection    clSection;
+    IS              clPoints;
+    const PetscInt *clp;
+    PetscInt       *points = NULL, numPoints, q, dof, size = 0;
+
+    ierr = DMPlexGetCompressedClosure(dm, section, p, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    for (q = 0; q < numPoints*2; q += 2) {
+      ierr  = PetscSectionGetDof(section, points[q], &dof);CHKERRQ(ierr);
+      size += dof;
+    }
+    ierr = DMPlexRestoreCompressedClosure(dm, section, p, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    map->off[p-pStart+1] = map->off[p-pStart] + size;
+  }
+  n    = map->off[pEnd-pStart];
+  ierr = PetscMalloc1(n, &map->lidx);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, &map->bc);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, &map->flip);CHKERRQ(ierr);
+  for (k = 0; k < n; ++k) map->flip[k] = 1.0;
+  /* The indices and flips are placed as DMPlexVecGetClosure() places the values */
+  for (p = pStart; p < pEnd; ++p) {
+    PetscSection       clSection;
+    IS                 clPoints;
+    const PetscInt    *clp;
+    PetscInt          *points = NULL, numPoints, q, dof, off;
+    PetscInt          *lidx = &map->lidx[map->off[p-pStart]];
+    PetscScalar       *flip = &map->flip[map->off[p-pStart]];
+
+    ierr = DMPlexGetCompressedClosure(dm, section, p, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    if (Nf) {
+      const PetscInt    **perms[32] = {NULL};
+      const PetscScalar **flips[32] = {NULL};
+      PetscInt            foffs[32], fdof;
+
+      for (f = 0; f < Nf; ++f) {
+        ierr = PetscSectionGetFieldPointSyms(section, f, numPoints, points, &perms[f], &flips[f]);CHKERRQ(ierr);
+      }
+      for (f = 0, k = 0; f < Nf; ++f) {
+        foffs[f] = k;
+        for (q = 0; q < numPoints; ++q) {
+          const PetscScalar *fl = flips[f] ? flips[f][q] : NULL;
+          PetscInt           b;
+
+          ierr = PetscSectionGetFieldDof(section, points[2*q], f, &fdof);CHKERRQ(ierr);
+          if (fl) {
+            for (b = 0; b < fdof; ++b) flip[clperm ? clperm[k+b] : k+b] = fl[b];
+            hasflip = PETSC_TRUE;
+          }
+          k += fdof;
+        }
+      }
+      for (q = 0; q < numPoints; ++q) {
+        ierr = PetscSectionGetOffset(section, points[2*q], &off);CHKERRQ(ierr);
+        ierr = DMPlexGetIndicesPointFields_Internal(section, PETSC_TRUE, points[2*q], off, foffs, PETSC_FALSE, perms, q, clperm, lidx);CHKERRQ(ierr);
+      }
+      for (f = 0; f < Nf; ++f) {
+        ierr = PetscSectionRestoreFieldPointSyms(section, f, numPoints, points, &perms[f], &flips[f]);CHKERRQ(ierr);
+      }
+    } else {
+      const PetscInt    **perms = NULL;
+      const PetscScalar **flips = NULL;
+      PetscInt            loff  = 0, d;
+
+      ierr = PetscSectionGetPointSyms(section, numPoints, points, &perms, &flips);CHKERRQ(ierr);
+      for (q = 0; q < numPoints; ++q) {
+        const PetscScalar *fl = flips ? flips[q] : NULL;
+
+        ierr = PetscSectionGetDof(section, points[2*q], &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(section, points[2*q], &off);CHKERRQ(ierr);
+        if (fl) {
+          for (d = 0; d < dof; ++d) flip[clperm ? clperm[loff+d] : loff+d] = fl[d];
+          hasflip = PETSC_TRUE;
+        }
+        ierr = DMPlexGetIndicesPoint_Internal(section, PETSC_TRUE, points[2*q], off, &loff, PETSC_FALSE, perms ? perms[q] : NULL, clperm, lidx);CHKERRQ(ierr);
+      }
+      ierr = PetscSectionRestorePointSyms(section, numPoints, points, &perms, &flips);CHKERRQ(ierr);
+    }
+    ierr = DMPlexRestoreCompressedClosure(dm, section, p, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+  }
+  /* The constrained dofs come with the involution -(i+1) of their local index */
+  for (k = 0; k < n; ++k) {
+    map->bc[k] = map->lidx[k] < 0 ? PETSC_TRUE : PETSC_FALSE;
+    if (map->bc[k]) {map->lidx[k] = -(map->lidx[k]+1); hasbc = PETSC_TRUE;}
+  }
+  if (!hasbc)   {ierr = PetscFree(map->bc);CHKERRQ(ierr);}
+  if (!hasflip) {ierr = PetscFree(map->flip);CHKERRQ(ierr);}
+  ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container, map);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container, DMPlexClosureDofMapDestroy_Private);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject) section, "DMPlexClosureDofMap", (PetscObject) container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexGetClosureDofMap_Private(DM dm, PetscSection section, DMPlexClosureDofMap **map)
+{
+  PetscContainer   container;
+  PetscObjectId    id;
+  PetscObjectState meshState, state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject) section, "DMPlexClosureDofMap", (PetscObject *) &container);CHKERRQ(ierr);
+  if (container) {
+    ierr = PetscContainerGetPointer(container, (void **) map);CHKERRQ(ierr);
+    ierr = DMPlexClosureDofMapKey_Private(dm, section, &id, &meshState, &state);CHKERRQ(ierr);
+    if ((*map)->id == id && (*map)->meshState == meshState && (*map)->state == state) PetscFunctionReturn(0);
+  }
+  ierr = DMPlexCreateClosureDofMap(dm, section);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) section, "DMPlexClosureDofMap", (PetscObject *) &container);CHKERRQ(ierr);
+  ierr = PetscContainerGetPointer(container, (void **) map);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexClosureDofMapCheckSize_Private(DMPlexClosureDofMap *map, PetscInt pStart, PetscInt pEnd, PetscInt csize)
+{
+  PetscInt p;
+
+  PetscFunctionBegin;
+  if (pStart < map->pStart || pEnd > map->pEnd) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Points [%D, %D) are not cells [%D, %D)", pStart, pEnd, map->pStart, map->pEnd);
+  for (p = pStart; p < pEnd; ++p) {
+    const PetscInt size = map->off[p-map->pStart+1] - map->off[p-map->pStart];
+
+    if (size != csize) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Closure size %D of point %D is not %D", size, p, csize);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetClosureDofMapSize - Get the number of values in the closure of each of a range of cells
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in the local vector, or NULL to use the default section
+. pStart - The first cell
+- pEnd - One past the last cell
+
+  Output Parameter:
+. clSize - The number of values in the closure of each cell, or -1 if it varies or the points are not all cells
+
+  Note:
+  This creates the map of DMPlexCreateClosureDofMap() if it does not exist.
+
+  Level: intermediate
+
+.seealso DMPlexCreateClosureDofMap(), DMPlexVecGetClosureBatch()
+@*/
+PetscErrorCode DMPlexGetClosureDofMapSize(DM dm, PetscSection section, PetscInt pStart, PetscInt pEnd, PetscInt *clSize)
+{
+  DMPlexClosureDofMap *map;
+  PetscInt             p, size;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidIntPointer(clSize, 5);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  ierr = DMPlexGetClosureDofMap_Private(dm, section, &map);CHKERRQ(ierr);
+  *clSize = -1;
+  if (pStart < map->pStart || pEnd > map->pEnd) PetscFunctionReturn(0);
+  if (pStart >= pEnd) {*clSize = 0; PetscFunctionReturn(0);}
+  size = map->off[pStart-map->pStart+1] - map->off[pStart-map->pStart];
+  for (p = pStart+1; p < pEnd; ++p) {
+    if (map->off[p-map->pStart+1] - map->off[p-map->pStart] != size) PetscFunctionReturn(0);
+  }
+  *clSize = size;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexVecGetClosureBatch - Get the values on the closures of a range of cells
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. v - The local vector
+. pStart - The first cell
+. pEnd - One past the last cell
+- csize - The number of values in the closure of each cell, see DMPlexGetClosureDofMapSize()
+
+  Output Parameter:
+. values - The values, those of the closure of cell p starting at values[(p-pStart)*csize] in the order of DMPlexVecGetClosure()
+
+  Note:
+  The values are gathered with the map of DMPlexCreateClosureDofMap(), which is created if it does not exist.
+
+  Level: intermediate
+
+.seealso DMPlexVecGetClosure(), DMPlexVecSetClosureBatch(), DMPlexMatSetClosureBatch(), DMPlexCreateClosureDofMap()
+@*/
+PetscErrorCode DMPlexVecGetClosureBatch(DM dm, PetscSection section, Vec v, PetscInt pStart, PetscInt pEnd, PetscInt csize, PetscScalar values[])
+{
+  DMPlexClosureDofMap *map;
+  const PetscScalar   *array, *flip;
+  const PetscInt      *lidx;
+  PetscInt             n, i;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBeginHot;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  ierr = DMPlexGetClosureDofMap_Private(dm, section, &map);CHKERRQ(ierr);
+  ierr = DMPlexClosureDofMapCheckSize_Private(map, pStart, pEnd, csize);CHKERRQ(ierr);
+  n    = (pEnd-pStart)*csize;
+  lidx = &map->lidx[map->off[pStart-map->pStart]];
+  flip = map->flip ? &map->flip[map->off[pStart-map->pStart]] : NULL;
+  ierr = VecGetArrayRead(v, &array);CHKERRQ(ierr);
+  if (flip) {for (i = 0; i < n; ++i) values[i] = array[lidx[i]]*flip[i];}
+  else      {for (i = 0; i < n; ++i) values[i] = array[lidx[i]];}
+  ierr = VecRestoreArrayRead(v, &array);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexVecSetClosureBatch - Set the values on the closures of a range of cells
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. v - The local vector
+. pStart - The first cell
+. pEnd - One past the last cell
+. csize - The number of values in the closure of each cell, see DMPlexGetClosureDofMapSize()
+. values - The values, those of the closure of cell p starting at values[(p-pStart)*csize] in the order of DMPlexVecGetClosure()
+- mode - The insert mode. One of INSERT_ALL_VALUES, ADD_ALL_VALUES, INSERT_VALUES, ADD_VALUES, INSERT_BC_VALUES, and ADD_BC_VALUES,
+  where INSERT_ALL_VALUES and ADD_ALL_VALUES also overwrite boundary conditions and INSERT_BC_VALUES and ADD_BC_VALUES only overwrite boundary conditions
+
+  Note:
+  The cells are processed in order, so that the result is that of DMPlexVecSetClosure() on each cell.
+
+  Level: intermediate
+
+.seealso DMPlexVecSetClosure(), DMPlexVecGetClosureBatch(), DMPlexMatSetClosureBatch(), DMPlexCreateClosureDofMap()
+@*/
+PetscErrorCode DMPlexVecSetClosureBatch(DM dm, PetscSection section, Vec v, PetscInt pStart, PetscInt pEnd, PetscInt csize, const PetscScalar values[], InsertMode mode)
+{
+  DMPlexClosureDofMap *map;
+  PetscScalar         *array;
+  const PetscScalar   *flip;
+  const PetscInt      *lidx;
+  const PetscBool     *bc;
+  PetscBool            add, all, onlybc;
+  PetscInt             n, i;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBeginHot;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  switch (mode) {
+  case INSERT_VALUES:     add = PETSC_FALSE; all = PETSC_FALSE; onlybc = PETSC_FALSE; break;
+  case INSERT_ALL_VALUES: add = PETSC_FALSE; all = PETSC_TRUE;  onlybc = PETSC_FALSE; break;
+  case INSERT_BC_VALUES:  add = PETSC_FALSE; all = PETSC_FALSE; onlybc = PETSC_TRUE;  break;
+  case ADD_VALUES:        add = PETSC_TRUE;  all = PETSC_FALSE; onlybc = PETSC_FALSE; break;
+  case ADD_ALL_VALUES:    add = PETSC_TRUE;  all = PETSC_TRUE;  onlybc = PETSC_FALSE; break;
+  case ADD_BC_VALUES:     add = PETSC_TRUE;  all = PETSC_FALSE; onlybc = PETSC_TRUE;  break;
+  default: SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+  }
+  ierr = DMPlexGetClosureDofMap_Private(dm, section, &map);CHKERRQ(ierr);
+  ierr = DMPlexClosureDofMapCheckSize_Private(map, pStart, pEnd, csize);CHKERRQ(ierr);
+  if (onlybc && !map->bc) PetscFunctionReturn(0);
+  n    = (pEnd-pStart)*csize;
+  lidx = &map->lidx[map->off[pStart-map->pStart]];
+  flip = map->flip ? &map->flip[map->off[pStart-map->pStart]] : NULL;
+  bc   = map->bc && !all ? &map->bc[map->off[pStart-map->pStart]] : NULL;
+  ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+  if (!flip && !bc) {
+    if (add) {for (i = 0; i < n; ++i) array[lidx[i]] += values[i];}
+    else     {for (i = 0; i < n; ++i) array[lidx[i]]  = values[i];}
+  } else {
+    for (i = 0; i < n; ++i) {
+      const PetscScalar val = flip ? values[i]*flip[i] : values[i];
+
+      if (bc && bc[i] != onlybc) continue;
+      if (add) array[lidx[i]] += val;
+      else     array[lidx[i]]  = val;
+    }
+  }
+  ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexMatSetClosureBatch - Set the element matrices of a range of cells
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout, or NULL to use the default section
+. globalSection - The section describing the layout in A, or NULL to use the default global section
+. A - The matrix
+. pStart - The first cell
+. pEnd - One past the last cell
+. csize - The number of values in the closure of each cell, see DMPlexGetClosureDofMapSize()
+. values - The element matrices, that of cell p starting at values[(p-pStart)*csize*csize]
+- mode - The insert mode, where INSERT_ALL_VALUES and ADD_ALL_VALUES also overwrite boundary conditions
+
+  Notes:
+  This is DMPlexMatSetClosure() on each cell, with the global indices of the closures computed once and kept with the map
+  of DMPlexCreateClosureDofMap() for the last global section used. With anchors, DMPlexMatSetClosure() is called on each cell.
+
+  Level: intermediate
+
+.seealso DMPlexMatSetClosure(), DMPlexVecGetClosureBatch(), DMPlexCreateClosureDofMap()
+@*/
+PetscErrorCode DMPlexMatSetClosureBatch(DM dm, PetscSection section, PetscSection globalSection, Mat A, PetscInt pStart, PetscInt pEnd, PetscInt csize, const PetscScalar values[], InsertMode mode)
+{
+  DM_Plex             *mesh = (DM_Plex *) dm->data;
+  DMPlexClosureDofMap *map;
+  PetscSection         aSec;
+  PetscScalar         *work = NULL;
+  PetscObjectState     gState;
+  PetscInt             p, i, j;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!globalSection) {ierr = DMGetGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
+  ierr = DMPlexGetAnchors(dm, &aSec, NULL);CHKERRQ(ierr);
+  if (aSec || mesh->printSetValues || mesh->printFEM > 1) {
+    for (p = pStart; p < pEnd; ++p) {
+      ierr = DMPlexMatSetClosure(dm, section, globalSection, A, p, &values[(p-pStart)*csize*csize], mode);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexGetClosureDofMap_Private(dm, section, &map);CHKERRQ(ierr);
+  ierr = DMPlexClosureDofMapCheckSize_Private(map, pStart, pEnd, csize);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) globalSection, &gState);CHKERRQ(ierr);
+  if (map->gSection != globalSection || map->gState != gState) {
+    ierr = PetscFree(map->gidx);CHKERRQ(ierr);
+    ierr = PetscMalloc1(map->off[map->pEnd-map->pStart], &map->gidx);CHKERRQ(ierr);
+    for (p = map->pStart; p < map->pEnd; ++p) {
+      PetscInt *indices, numIndices;
+
+      ierr = DMPlexGetClosureIndices(dm, section, globalSection, p, PETSC_TRUE, &numIndices, &indices, NULL, NULL);CHKERRQ(ierr);
+      if (numIndices != map->off[p-map->pStart+1] - map->off[p-map->pStart]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of indices %D of point %D is not the closure size %D", numIndices, p, map->off[p-map->pStart+1] - map->off[p-map->pStart]);
+      ierr = PetscArraycpy(&map->gidx[map->off[p-map->pStart]], indices, numIndices);CHKERRQ(ierr);
+      ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, p, PETSC_TRUE, &numIndices, &indices, NULL, NULL);CHKERRQ(ierr);
+    }
+    ierr = PetscObjectReference((PetscObject) globalSection);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&map->gSection);CHKERRQ(ierr);
+    map->gSection = globalSection;
+    map->gState   = gState;
+  }
+  if (map->flip) {ierr = DMGetWorkArray(dm, csize*csize, MPIU_SCALAR, &work);CHKERRQ(ierr);}
+  for (p = pStart; p < pEnd; ++p) {
+    const PetscInt     off   = map->off[p-map->pStart];
+    const PetscInt    *gidx  = &map->gidx[off];
+    const PetscScalar *elMat = &values[(p-pStart)*csize*csize];
+
+    if (map->flip) {
+      const PetscScalar *flip = &map->flip[off];
+
+      for (i = 0; i < csize; ++i) {
+        for (j = 0; j < csize; ++j) work[i*csize+j] = elMat[i*csize+j]*flip[i]*flip[j];
+      }
+      elMat = work;
+    }
+    ierr = MatSetValues(A, csize, gidx, csize, gidx, elMat, mode);CHKERRQ(ierr);
+  }
+  if (map->flip) {ierr = DMRestoreWorkArray(dm, csize*csize, MPIU_SCALAR, &work);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
@@ -45,6 +45,113 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+typedef struct {
+  PetscInt64 key;
+  PetscInt   cell;
+} DMPlexCurveKey;
+
+static int DMPlexCompareCurveKey_Static(const void *a, const void *b)
+{
+  const DMPlexCurveKey *ka = (const DMPlexCurveKey *) a;
+  const DMPlexCurveKey *kb = (const DMPlexCurveKey *) b;
+
+  if (ka->key < kb->key) return -1;
+  if (ka->key > kb->key) return 1;
+  return ka->cell < kb->cell ? -1 : (ka->cell > kb->cell ? 1 : 0);
+}
+
+/* The index of the point with integer coordinates x[] of b bits along the Hilbert curve, from the transpose algorithm of Skilling, which overwrites x[] */
+static PetscInt64 DMPlexHilbertIndex_Static(PetscInt dim, PetscInt b, PetscInt64 x[])
+{
+  const PetscInt64 M = ((PetscInt64) 1) << (b-1);
+  PetscInt64       P, Q, t, key = 0;
+  PetscInt         d, i;
+
+  /* Inverse undo excess work */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q-1;
+    for (d = 0; d < dim; ++d) {
+      if (x[d] & Q) x[0] ^= P;
+      else {
+        t     = (x[0] ^ x[d]) & P;
+        x[0] ^= t;
+        x[d] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (d = 1; d < dim; ++d) x[d] ^= x[d-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) if (x[dim-1] & Q) t ^= Q-1;
+  for (d = 0; d < dim; ++d) x[d] ^= t;
+  /* Interleave the transposed index */
+  for (i = b-1; i >= 0; --i) for (d = 0; d < dim; ++d) key = (key << 1) | ((x[d] >> i) & 1);
+  return key;
+}
+
+static PetscInt64 DMPlexMortonIndex_Static(PetscInt dim, PetscInt b, const PetscInt64 x[])
+{
+  PetscInt64 key = 0;
+  PetscInt   d, i;
+
+  for (i = b-1; i >= 0; --i) for (d = 0; d < dim; ++d) key = (key << 1) | ((x[d] >> i) & 1);
+  return key;
+}
+
+/*
+  The cells are sorted by the position of their centroid, the average of the coordinates in their closure, along the curve.
+  The centroids are quantized in the local bounding box with as many bits per direction as fit in a 63 bit index.
+*/
+static PetscErrorCode DMPlexGetCurveOrdering_Static(DM dm, PetscBool hilbert, PetscInt cStart, PetscInt cEnd, PetscInt cperm[])
+{
+  DM              cdm;
+  PetscSection    csection;
+  Vec             coordinates;
+  DMPlexCurveKey *keys;
+  PetscReal      *centroids, lower[3], upper[3], scale[3];
+  PetscScalar    *coords = NULL;
+  PetscInt64      x[3], xmax;
+  PetscInt        cdim, numCells = cEnd - cStart, b, csize, c, d, v;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim > 3) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Space filling curve ordering not supported for coordinate dimension %D > 3", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  if (!coordinates) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Space filling curve ordering requires the mesh coordinates");
+  ierr = PetscMalloc2(numCells*cdim, &centroids, numCells, &keys);CHKERRQ(ierr);
+  for (d = 0; d < cdim; ++d) {lower[d] = PETSC_MAX_REAL; upper[d] = PETSC_MIN_REAL;}
+  for (c = cStart; c < cEnd; ++c) {
+    PetscReal *centroid = &centroids[(c-cStart)*cdim];
+    PetscInt   nv;
+
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    nv   = csize/cdim;
+    for (d = 0; d < cdim; ++d) centroid[d] = 0.0;
+    for (v = 0; v < nv; ++v) for (d = 0; d < cdim; ++d) centroid[d] += PetscRealPart(coords[v*cdim+d]);
+    for (d = 0; d < cdim; ++d) {
+      centroid[d] /= PetscMax(nv, 1);
+      lower[d]     = PetscMin(lower[d], centroid[d]);
+      upper[d]     = PetscMax(upper[d], centroid[d]);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+  }
+  b    = PetscMin(63/cdim, 31);
+  xmax = (((PetscInt64) 1) << b) - 1;
+  for (d = 0; d < cdim; ++d) scale[d] = upper[d] > lower[d] ? ((PetscReal) xmax)/(upper[d] - lower[d]) : 0.0;
+  for (c = 0; c < numCells; ++c) {
+    for (d = 0; d < cdim; ++d) x[d] = PetscMin((PetscInt64) ((centroids[c*cdim+d] - lower[d])*scale[d]), xmax);
+    keys[c].key  = hilbert ? DMPlexHilbertIndex_Static(cdim, b, x) : DMPlexMortonIndex_Static(cdim, b, x);
+    keys[c].cell = c + cStart;
+  }
+  qsort(keys, numCells, sizeof(DMPlexCurveKey), DMPlexCompareCurveKey_Static);
+  for (c = 0; c < numCells; ++c) cperm[c] = keys[c].cell;
+  ierr = PetscFree2(centroids, keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -58,40 +165,60 @@ $     MATORDERINGND - Nested Dissection
 $     MATORDERING1WD - One-way Dissection
 $     MATORDERINGRCM - Reverse Cuthill-McKee
 $     MATORDERINGQMD - Quotient Minimum Degree
+$     DMPLEXORDERINGHILBERT - Hilbert curve through the cell centroids
+$     DMPLEXORDERINGMORTON - Morton (Z) curve through the cell centroids
 - label - [Optional] Label used to segregate ordering into sets, or NULL
 
 
   Output Parameter:
 . perm - The point permutation as an IS, perm[old point number] = new point number
 
-  Note: The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
+  Notes:
+  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
   has different types of cells, and then loop over each set of reordered cells for assembly.
 
+  The space filling curve orderings sort the cells by the position of their centroid along the curve, which keeps cells
+  that are close in space close in memory, and need only the coordinates of the mesh. The other types order the cells
+  by reverse Cuthill-McKee on the cell adjacency graph. In all cases, the faces, edges and vertices are numbered in the
+  order of their first appearance in the closures of the reordered cells.
+
   Level: intermediate
 
-.seealso: MatGetOrdering()
+.seealso: MatGetOrdering(), DMPlexPermute(), DMPlexSetReorderType()
 @*/
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
 {
   PetscInt       numCells = 0;
-  PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, cStart, cEnd, c, i;
+  PetscBool      hilbert, morton;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
-  ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
-  ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
+  ierr = PetscStrcmp(otype, DMPLEXORDERINGHILBERT, &hilbert);CHKERRQ(ierr);
+  ierr = PetscStrcmp(otype, DMPLEXORDERINGMORTON, &morton);CHKERRQ(ierr);
+  if (hilbert || morton) {
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    numCells = cEnd - cStart;
+    ierr = PetscMalloc1(numCells, &cperm);CHKERRQ(ierr);
+    ierr = DMPlexGetCurveOrdering_Static(dm, hilbert, cStart, cEnd, cperm);CHKERRQ(ierr);
+  } else {
+    ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
+    ierr = PetscMalloc1(numCells, &cperm);CHKERRQ(ierr);
+    ierr = PetscMalloc2(numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
+    if (numCells) {
+      /* Shift for Fortran numbering */
+      for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
+      for (i = 0; i <= numCells; ++i)       ++start[i];
+      ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(start);CHKERRQ(ierr);
+    ierr = PetscFree(adjacency);CHKERRQ(ierr);
+    ierr = PetscFree2(mask,xls);CHKERRQ(ierr);
     /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    for (c = 0; c < numCells; ++c) --cperm[c];
   }
-  ierr = PetscFree(start);CHKERRQ(ierr);
-  ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -130,7 +257,7 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   }
   /* Construct closure */
   ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
-  ierr = PetscFree3(cperm,mask,xls);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
   ierr = PetscFree(clperm);CHKERRQ(ierr);
   /* Invert permutation */
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
@@ -150,9 +277,12 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   Output Parameter:
 . pdm - The permuted DM
 
+  Note: The point SF of a distributed mesh is renumbered along with the points, so that the permutation must be given on every process.
+  The labels, coordinates, anchors, and basic adjacency are carried over to the permuted mesh.
+
   Level: intermediate
 
-.seealso: MatPermute()
+.seealso: MatPermute(), DMPlexGetOrdering()
 @*/
 PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
 {
@@ -170,16 +300,73 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
   ierr = DMSetDimension(*pdm, dim);CHKERRQ(ierr);
   ierr = DMCopyDisc(dm, *pdm);CHKERRQ(ierr);
-  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  /* Only an existing layout is permuted, so that one is created for the fields added to the permuted mesh */
+  section = dm->localSection;
   if (section) {
     ierr = PetscSectionPermute(section, perm, &sectionNew);CHKERRQ(ierr);
     ierr = DMSetLocalSection(*pdm, sectionNew);CHKERRQ(ierr);
     ierr = PetscSectionDestroy(&sectionNew);CHKERRQ(ierr);
   }
   plexNew = (DM_Plex *) (*pdm)->data;
+  plexNew->overlap          = plex->overlap;
+  plexNew->partitionBalance = plex->partitionBalance;
+  ierr = DMPlexSetReorderType(*pdm, plex->reorderType);CHKERRQ(ierr);
+  {
+    PetscBool             isper;
+    const PetscReal      *maxCell, *L;
+    const DMBoundaryType *bd;
+
+    ierr = DMGetPeriodicity(dm, &isper, &maxCell, &L, &bd);CHKERRQ(ierr);
+    ierr = DMSetPeriodicity(*pdm, isper, maxCell, L, bd);CHKERRQ(ierr);
+  }
+  {
+    PetscBool useCone, useClosure;
+
+    ierr = DMGetBasicAdjacency(dm, &useCone, &useClosure);CHKERRQ(ierr);
+    ierr = DMSetBasicAdjacency(*pdm, useCone, useClosure);CHKERRQ(ierr);
+  }
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, sectionSF */
+  /* Ignore sectionSF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
+  /* Reorder the point SF: the leaves are renumbered locally, and the remote points by their owners */
+  {
+    PetscSF            sf, sfNew;
+    const PetscInt    *leaves, *pperm;
+    const PetscSFNode *remotes;
+    PetscSFNode       *remotesNew, *premotes;
+    PetscInt          *leavesNew, *rperm, nroots, nleaves, l, p, n = 0;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscMalloc2(nroots, &rperm, nroots, &premotes);CHKERRQ(ierr);
+      for (p = 0; p < nroots; ++p) premotes[p].rank = -1;
+      ierr = PetscSFBcastBegin(sf, MPIU_INT, pperm, rperm);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf, MPIU_INT, pperm, rperm);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt leaf = leaves ? leaves[l] : l;
+
+        premotes[pperm[leaf]].rank  = remotes[l].rank;
+        premotes[pperm[leaf]].index = rperm[leaf];
+      }
+      /* The leaves are kept sorted */
+      ierr = PetscMalloc1(nleaves, &leavesNew);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nleaves, &remotesNew);CHKERRQ(ierr);
+      for (p = 0; p < nroots; ++p) {
+        if (premotes[p].rank < 0) continue;
+        leavesNew[n]  = p;
+        remotesNew[n] = premotes[p];
+        ++n;
+      }
+      ierr = PetscFree2(rperm, premotes);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSFCreate(PetscObjectComm((PetscObject) dm), &sfNew);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfNew, nroots, nleaves, leavesNew, PETSC_OWN_POINTER, remotesNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+    }
+  }
   /* Reorder labels */
   {
     PetscInt numLabels, l;
@@ -272,10 +459,111 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     ierr = VecRestoreArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
     ierr = DMGetCoordinateDM(*pdm, &cdmNew);CHKERRQ(ierr);
     ierr = DMSetLocalSection(cdmNew, csectionNew);CHKERRQ(ierr);
+    ierr = DMSetPointSF(cdmNew, (*pdm)->sf);CHKERRQ(ierr);
     ierr = DMSetCoordinatesLocal(*pdm, coordinatesNew);CHKERRQ(ierr);
     ierr = PetscSectionDestroy(&csectionNew);CHKERRQ(ierr);
     ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
   }
+  /* Reorder anchors: the constrained points and their anchors are both renumbered */
+  {
+    PetscSection    anchorSection, anchorSectionNew;
+    IS              anchorIS, anchorISNew;
+    const PetscInt *anchors, *pperm;
+    PetscInt       *anchorsNew, aStart, aEnd, pStart, pEnd, n, p;
+
+    ierr = DMPlexGetAnchors(dm, &anchorSection, &anchorIS);CHKERRQ(ierr);
+    if (anchorSection && anchorIS) {
+      ierr = DMPlexGetChart(*pdm, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = PetscSectionGetChart(anchorSection, &aStart, &aEnd);CHKERRQ(ierr);
+      ierr = PetscSectionCreate(PETSC_COMM_SELF, &anchorSectionNew);CHKERRQ(ierr);
+      ierr = PetscSectionSetChart(anchorSectionNew, pStart, pEnd);CHKERRQ(ierr);
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      for (p = aStart; p < aEnd; ++p) {
+        PetscInt dof;
+
+        ierr = PetscSectionGetDof(anchorSection, p, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionSetDof(anchorSectionNew, pperm[p], dof);CHKERRQ(ierr);
+      }
+      ierr = PetscSectionSetUp(anchorSectionNew);CHKERRQ(ierr);
+      ierr = ISGetLocalSize(anchorIS, &n);CHKERRQ(ierr);
+      ierr = PetscMalloc1(n, &anchorsNew);CHKERRQ(ierr);
+      ierr = ISGetIndices(anchorIS, &anchors);CHKERRQ(ierr);
+      for (p = aStart; p < aEnd; ++p) {
+        PetscInt dof, off, offNew, d;
+
+        ierr = PetscSectionGetDof(anchorSection, p, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(anchorSection, p, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(anchorSectionNew, pperm[p], &offNew);CHKERRQ(ierr);
+        for (d = 0; d < dof; ++d) anchorsNew[offNew+d] = pperm[anchors[off+d]];
+      }
+      ierr = ISRestoreIndices(anchorIS, &anchors);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = ISCreateGeneral(PETSC_COMM_SELF, n, anchorsNew, PETSC_OWN_POINTER, &anchorISNew);CHKERRQ(ierr);
+      ierr = DMPlexSetAnchors(*pdm, anchorSectionNew, anchorISNew);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&anchorSectionNew);CHKERRQ(ierr);
+      ierr = ISDestroy(&anchorISNew);CHKERRQ(ierr);
+    }
+  }
   (*pdm)->setupcalled = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
+
+/*@C
+  DMPlexSetReorderType - Set the ordering applied to the mesh by DMPlexDistribute()
+
+  Logically collective on dm
+
+  Input Parameters:
++ dm    - The DMPlex object
+- otype - The ordering type, such as DMPLEXORDERINGHILBERT, or NULL to keep the numbering of the distribution
+
+  Options Database:
+. -dm_plex_reorder <otype> - The ordering applied after distribution
+
+  Note: The distributed mesh is permuted with DMPlexPermute(), so that the cells, and the dofs and matrix rows of the
+  sections created on the mesh afterwards, follow the ordering. The migration SF returned by DMPlexDistribute() refers
+  to the reordered points. On one process DMPlexDistribute() only permutes the mesh.
+
+  Level: intermediate
+
+.seealso: DMPlexGetReorderType(), DMPlexGetOrdering(), DMPlexPermute(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexSetReorderType(DM dm, MatOrderingType otype)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  char          *rtype = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (otype && otype[0]) {ierr = PetscStrallocpy(otype, &rtype);CHKERRQ(ierr);}
+  ierr = PetscFree(mesh->reorderType);CHKERRQ(ierr);
+  mesh->reorderType = rtype;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  DMPlexGetReorderType - Get the ordering applied to the mesh by DMPlexDistribute()
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. otype - The ordering type, or NULL if the mesh is not reordered
+
+  Level: intermediate
+
+.seealso: DMPlexSetReorderType(), DMPlexGetOrdering(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexGetReorderType(DM dm, MatOrderingType *otype)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(otype, 2);
+  *otype = mesh->reorderType;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,210 @@
+static char help[] = "Tests the batched closure operations of DMPlex against the closure operations on each cell.\n\n";
+
+#include <petscdmplex.h>
+#include <petscds.h>
+
+typedef struct {
+  PetscInt  dim;       /* The topological dimension */
+  PetscBool simplex;   /* Flag for simplices */
+  PetscInt  Nf;        /* The number of fields */
+  PetscBool bc;        /* Constrain the boundary */
+  PetscBool tensor;    /* Check again after setting the tensor closure permutation */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim     = 2;
+  options->simplex = PETSC_TRUE;
+  options->Nf      = 1;
+  options->bc      = PETSC_TRUE;
+  options->tensor  = PETSC_FALSE;
+
+  ierr = PetscOptionsBegin(comm, "", "Batched Closure Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological dimension", "ex41.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Flag for simplices", "ex41.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_fields", "The number of fields", "ex41.c", options->Nf, &options->Nf, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-bc", "Constrain the boundary", "ex41.c", options->bc, &options->bc, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-tensor", "Check again after setting the tensor closure permutation", "ex41.c", options->tensor, &options->tensor, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode zero(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt c;
+  for (c = 0; c < Nc; ++c) u[c] = 0.0;
+  return 0;
+}
+
+static PetscErrorCode CreateDiscretization(DM dm, AppCtx *user)
+{
+  PetscFE        fe;
+  PetscInt       f, id = 1;
+  char           prefix[PETSC_MAX_PATH_LEN];
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  for (f = 0; f < user->Nf; ++f) {
+    ierr = PetscSNPrintf(prefix, sizeof(prefix), "f%D_", f);CHKERRQ(ierr);
+    ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, f ? user->dim : 1, user->simplex, prefix, -1, &fe);CHKERRQ(ierr);
+    ierr = DMSetField(dm, f, NULL, (PetscObject) fe);CHKERRQ(ierr);
+    ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  }
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  if (user->bc) {
+    ierr = DMAddBoundary(dm, DM_BC_ESSENTIAL, "wall", "marker", 0, 0, NULL, (void (*)(void)) zero, 1, &id, NULL);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The closures of the cells are gathered, scattered in each insert mode, and assembled into a matrix both ways */
+static PetscErrorCode CheckClosures(DM dm)
+{
+  const InsertMode modes[] = {INSERT_VALUES, INSERT_ALL_VALUES, INSERT_BC_VALUES, ADD_VALUES, ADD_ALL_VALUES, ADD_BC_VALUES};
+  PetscSection     section, gsection;
+  PetscRandom      rand;
+  Vec              locX, locY, locZ;
+  Mat              A, B;
+  PetscScalar     *u, *elemMat, *x;
+  PetscInt         cStart, cEnd, c, clSize, i, m;
+  PetscReal        norm;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetGlobalSection(dm, &gsection);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetClosureDofMapSize(dm, section, cStart, cEnd, &clSize);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD, "Closure size %D\n", clSize);CHKERRQ(ierr);
+  if (clSize <= 0) PetscFunctionReturn(0);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locY);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locZ);CHKERRQ(ierr);
+  ierr = PetscMalloc2((cEnd-cStart)*clSize, &u, (cEnd-cStart)*clSize*clSize, &elemMat);CHKERRQ(ierr);
+
+  ierr = VecSetRandom(locX, rand);CHKERRQ(ierr);
+  ierr = DMPlexVecGetClosureBatch(dm, section, locX, cStart, cEnd, clSize, u);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    x    = NULL;
+    ierr = DMPlexVecGetClosure(dm, section, locX, c, NULL, &x);CHKERRQ(ierr);
+    for (i = 0; i < clSize; ++i) {
+      if (x[i] != u[(c-cStart)*clSize+i]) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Gathered closure of cell %D differs in value %D", c, i);
+    }
+    ierr = DMPlexVecRestoreClosure(dm, section, locX, c, NULL, &x);CHKERRQ(ierr);
+  }
+
+  for (i = 0; i < (cEnd-cStart)*clSize; ++i) {ierr = PetscRandomGetValue(rand, &u[i]);CHKERRQ(ierr);}
+  for (m = 0; m < (PetscInt) (sizeof(modes)/sizeof(modes[0])); ++m) {
+    ierr = VecCopy(locX, locY);CHKERRQ(ierr);
+    ierr = VecCopy(locX, locZ);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosureBatch(dm, section, locY, cStart, cEnd, clSize, u, modes[m]);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {ierr = DMPlexVecSetClosure(dm, section, locZ, c, &u[(c-cStart)*clSize], modes[m]);CHKERRQ(ierr);}
+    ierr = VecAXPY(locY, -1.0, locZ);CHKERRQ(ierr);
+    ierr = VecNorm(locY, NORM_INFINITY, &norm);CHKERRQ(ierr);
+    if (norm > 1.0e-12) {ierr = PetscPrintf(PETSC_COMM_SELF, "Scattered closures differ by %g for insert mode %D\n", (double) norm, (PetscInt) modes[m]);CHKERRQ(ierr);}
+  }
+
+  for (i = 0; i < (cEnd-cStart)*clSize*clSize; ++i) {ierr = PetscRandomGetValue(rand, &elemMat[i]);CHKERRQ(ierr);}
+  ierr = DMCreateMatrix(dm, &A);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(dm, &B);CHKERRQ(ierr);
+  ierr = DMPlexMatSetClosureBatch(dm, section, gsection, A, cStart, cEnd, clSize, elemMat, ADD_VALUES);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {ierr = DMPlexMatSetClosure(dm, section, gsection, B, c, &elemMat[(c-cStart)*clSize*clSize], ADD_VALUES);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAXPY(A, -1.0, B, SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(A, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  if (norm > 1.0e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD, "Assembled matrices differ by %g\n", (double) norm);CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFree2(u, elemMat);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locY);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locZ);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The refined reference cell gives a simplicial mesh without a mesh generator */
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM             dmDist = NULL;
+  DMLabel        label;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMPlexCreateReferenceCell(comm, user->dim, user->simplex, dm);CHKERRQ(ierr);
+  ierr = DMCreateLabel(*dm, "marker");CHKERRQ(ierr);
+  ierr = DMGetLabel(*dm, "marker", &label);CHKERRQ(ierr);
+  ierr = DMPlexMarkBoundaryFaces(*dm, 1, label);CHKERRQ(ierr);
+  ierr = DMPlexLabelComplete(*dm, label);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = CreateDiscretization(dm, &user);CHKERRQ(ierr);
+  ierr = CheckClosures(dm);CHKERRQ(ierr);
+  if (user.tensor) {
+    /* the closure dof maps cached by the first check must not be reused with the new closure permutation */
+    ierr = DMPlexSetClosurePermutationTensor(dm, PETSC_DETERMINE, NULL);CHKERRQ(ierr);
+    ierr = CheckClosures(dm);CHKERRQ(ierr);
+  }
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: p1
+    nsize: {{1 2}}
+    output_file: output/ex41_p1.out
+    args: -dm_refine 2 -f0_petscspace_degree 1
+
+  test:
+    suffix: p3
+    args: -dm_refine 2 -num_fields 2 -f0_petscspace_degree 3 -f1_petscspace_degree 2
+
+  test:
+    suffix: q2
+    nsize: {{1 2}}
+    output_file: output/ex41_q2.out
+    args: -simplex 0 -dm_refine 2 -num_fields 2 -f0_petscspace_degree 2 -f1_petscspace_degree 1
+
+  test:
+    suffix: q2_tensor
+    nsize: {{1 2}}
+    args: -simplex 0 -dm_refine 2 -num_fields 2 -f0_petscspace_degree 2 -f1_petscspace_degree 1 -tensor
+
+  test:
+    suffix: q2_nobc
+    args: -simplex 0 -dm_refine 2 -bc 0 -f0_petscspace_degree 2
+
+  test:
+    suffix: hex
+    args: -dim 3 -simplex 0 -dm_refine 1 -f0_petscspace_degree 2
+
+TEST*/
@@ -0,0 +1,274 @@
+static char help[] = "Tests the space filling curve orderings of DMPlex, applied explicitly and after distribution.\n\n";
+
+#include <petscdmplex.h>
+#include <petscds.h>
+
+typedef struct {
+  PetscInt  dim;                  /* The topological dimension */
+  PetscBool simplex;              /* Flag for simplices */
+  PetscBool shuffle;              /* Randomly renumber the points of the serial mesh */
+  PetscBool adjacency;            /* Use the FVM adjacency, which the distributed mesh must keep */
+  char      otype[256];           /* The ordering applied to the serial mesh */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim      = 2;
+  options->simplex  = PETSC_TRUE;
+  options->shuffle   = PETSC_FALSE;
+  options->adjacency = PETSC_FALSE;
+  options->otype[0]  = '\0';
+
+  ierr = PetscOptionsBegin(comm, "", "Mesh Ordering Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim", "The topological dimension", "ex42.c", options->dim, &options->dim, NULL, 1, 3);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Flag for simplices", "ex42.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-shuffle", "Randomly renumber the points of the serial mesh", "ex42.c", options->shuffle, &options->shuffle, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-adjacency", "Use the FVM adjacency, which the distributed mesh must keep", "ex42.c", options->adjacency, &options->adjacency, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-order", "The ordering applied to the serial mesh", "ex42.c", options->otype, options->otype, sizeof(options->otype), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode linear(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  PetscInt d;
+  u[0] = 1.0;
+  for (d = 0; d < dim; ++d) u[0] += (d+1)*x[d];
+  return 0;
+}
+
+/* The points in each stratum are numbered in random order */
+static PetscErrorCode ShuffleMesh(DM *dm)
+{
+  DM             pdm;
+  IS             perm;
+  PetscRandom    rand;
+  PetscReal      r;
+  PetscInt      *pperm, depth, d, pStart, pEnd, p, q, tmp;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscRandomCreate(PETSC_COMM_SELF, &rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(*dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(pEnd-pStart, &pperm);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) pperm[p] = p;
+  ierr = DMPlexGetDepth(*dm, &depth);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    ierr = DMPlexGetDepthStratum(*dm, d, &pStart, &pEnd);CHKERRQ(ierr);
+    for (p = pEnd-1; p > pStart; --p) {
+      ierr = PetscRandomGetValueReal(rand, &r);CHKERRQ(ierr);
+      q        = pStart + PetscMin((PetscInt) (r*(p-pStart+1)), p-pStart);
+      tmp      = pperm[p];
+      pperm[p] = pperm[q];
+      pperm[q] = tmp;
+    }
+  }
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(*dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, pEnd-pStart, pperm, PETSC_OWN_POINTER, &perm);CHKERRQ(ierr);
+  ierr = DMPlexPermute(*dm, perm, &pdm);CHKERRQ(ierr);
+  ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = DMDestroy(dm);CHKERRQ(ierr);
+  *dm  = pdm;
+  PetscFunctionReturn(0);
+}
+
+/* The mean distance between the numbers of the local cells sharing a face */
+static PetscErrorCode ComputeCellDistance(DM dm, PetscReal *dist)
+{
+  PetscInt       fStart, fEnd, f, n = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  *dist = 0.0;
+  ierr = DMPlexGetHeightStratum(dm, 1, &fStart, &fEnd);CHKERRQ(ierr);
+  for (f = fStart; f < fEnd; ++f) {
+    const PetscInt *support;
+    PetscInt        supportSize;
+
+    ierr = DMPlexGetSupportSize(dm, f, &supportSize);CHKERRQ(ierr);
+    if (supportSize != 2) continue;
+    ierr = DMPlexGetSupport(dm, f, &support);CHKERRQ(ierr);
+    *dist += PetscAbsInt(support[1] - support[0]);
+    ++n;
+  }
+  if (n) *dist /= n;
+  PetscFunctionReturn(0);
+}
+
+/* The refined reference cell gives a simplicial mesh without a mesh generator, but it is created on every process */
+static PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM              dmDist = NULL;
+  DMLabel         label;
+  MatOrderingType rtype;
+  char            rname[256];
+  PetscReal       dist = 0.0;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  if (user->simplex) {
+    ierr = DMPlexCreateReferenceCell(comm, user->dim, user->simplex, dm);CHKERRQ(ierr);
+    ierr = DMCreateLabel(*dm, "marker");CHKERRQ(ierr);
+    ierr = DMGetLabel(*dm, "marker", &label);CHKERRQ(ierr);
+    ierr = DMPlexMarkBoundaryFaces(*dm, 1, label);CHKERRQ(ierr);
+    ierr = DMPlexLabelComplete(*dm, label);CHKERRQ(ierr);
+  } else {
+    const PetscInt  faces[3] = {2, 2, 2};
+    const PetscReal lower[3] = {-1.0, -1.0, -1.0}, upper[3] = {1.0, 1.0, 1.0};
+
+    ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, faces, lower, upper, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  if (user->shuffle) {ierr = ShuffleMesh(dm);CHKERRQ(ierr);}
+  if (user->otype[0]) {
+    DM        pdm;
+    IS        perm;
+    PetscReal dist, pdist;
+
+    ierr = DMPlexGetOrdering(*dm, user->otype, NULL, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(*dm, perm, &pdm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    ierr = ComputeCellDistance(*dm, &dist);CHKERRQ(ierr);
+    ierr = ComputeCellDistance(pdm, &pdist);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Ordering %s reduces the cell distance: %s\n", user->otype, pdist < dist ? "yes" : "no");CHKERRQ(ierr);
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = pdm;
+  }
+  if (user->adjacency) {ierr = DMSetBasicAdjacency(*dm, PETSC_TRUE, PETSC_FALSE);CHKERRQ(ierr);}
+  /* the mesh distributed without reordering gives the cell distance to compare with */
+  ierr = DMPlexGetReorderType(*dm, &rtype);CHKERRQ(ierr);
+  rname[0] = '\0';
+  if (rtype) {
+    ierr = PetscStrncpy(rname, rtype, sizeof(rname));CHKERRQ(ierr);
+    ierr = DMPlexSetReorderType(*dm, NULL);CHKERRQ(ierr);
+    ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+    ierr = ComputeCellDistance(dmDist ? dmDist : *dm, &dist);CHKERRQ(ierr);
+    ierr = DMDestroy(&dmDist);CHKERRQ(ierr);
+    ierr = DMPlexSetReorderType(*dm, rname);CHKERRQ(ierr);
+  }
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  if (rname[0]) {
+    PetscReal   rdist;
+    PetscMPIInt reduced, allreduced;
+
+    ierr = ComputeCellDistance(*dm, &rdist);CHKERRQ(ierr);
+    reduced = rdist < dist ? 1 : 0;
+    ierr = MPIU_Allreduce(&reduced, &allreduced, 1, MPI_INT, MPI_LAND, comm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Reordering after distribution reduces the cell distance: %s\n", allreduced ? "yes" : "no");CHKERRQ(ierr);
+  }
+  if (user->adjacency) {
+    PetscBool useCone, useClosure;
+
+    ierr = DMGetBasicAdjacency(*dm, &useCone, &useClosure);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Adjacency of the distributed mesh: useCone %s useClosure %s\n", PetscBools[useCone], PetscBools[useClosure]);CHKERRQ(ierr);
+  }
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The reordered mesh must be valid, and a linear function must be represented exactly in the space on it */
+static PetscErrorCode CheckMesh(DM dm, AppCtx *user)
+{
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {linear};
+  PetscFE          fe;
+  Vec              u;
+  PetscReal        vol = 0.0, gvol, error;
+  PetscInt         cStart, cEnd, c, id = 1;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMPlexCheckSymmetry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dm, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(dm, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckGeometry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckPointSF(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckInterfaceCones(dm);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscReal cvol;
+
+    ierr = DMPlexComputeCellGeometryFVM(dm, c, &cvol, NULL, NULL);CHKERRQ(ierr);
+    vol += cvol;
+  }
+  ierr = MPIU_Allreduce(&vol, &gvol, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscFECreateDefault(PetscObjectComm((PetscObject) dm), user->dim, 1, user->simplex, NULL, -1, &fe);CHKERRQ(ierr);
+  ierr = DMSetField(dm, 0, NULL, (PetscObject) fe);CHKERRQ(ierr);
+  ierr = PetscFEDestroy(&fe);CHKERRQ(ierr);
+  ierr = DMCreateDS(dm);CHKERRQ(ierr);
+  ierr = DMAddBoundary(dm, DM_BC_ESSENTIAL, "wall", "marker", 0, 0, NULL, (void (*)(void)) linear, 1, &id, NULL);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u);CHKERRQ(ierr);
+  ierr = DMComputeL2Diff(dm, 0.0, funcs, NULL, u, &error);CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Volume %g L2 error %s\n", (double) gvol, error < 1.0e-10 ? "< 1.0e-10" : "too large");CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = CheckMesh(dm, &user);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: tri_hilbert
+    args: -dm_refine 4 -shuffle -order hilbert -petscspace_degree 1
+
+  test:
+    suffix: quad_morton
+    args: -simplex 0 -dm_refine 3 -shuffle -order morton -petscspace_degree 1
+
+  test:
+    suffix: hex_hilbert
+    args: -dim 3 -simplex 0 -dm_refine 1 -shuffle -order hilbert -petscspace_degree 1
+
+  test:
+    suffix: tet_hilbert
+    args: -dim 3 -dm_refine 2 -shuffle -order hilbert -petscspace_degree 1
+
+  test:
+    suffix: dist_quad
+    nsize: 2
+    args: -simplex 0 -dm_refine 3 -shuffle -dm_plex_reorder {{hilbert morton rcm}} -petscspace_degree 1
+    output_file: output/ex42_dist_quad.out
+
+  # on one process the mesh is not distributed, but it is still reordered
+  test:
+    suffix: dist_quad_serial
+    args: -simplex 0 -dm_refine 3 -shuffle -dm_plex_reorder {{hilbert morton rcm}} -petscspace_degree 1
+    output_file: output/ex42_dist_quad.out
+
+  # the basic adjacency is kept by the reordering, on one process too
+  test:
+    suffix: dist_quad_adjacency
+    nsize: {{1 2}}
+    args: -simplex 0 -dm_refine 3 -shuffle -dm_plex_reorder hilbert -adjacency -petscspace_degree 1
+    output_file: output/ex42_dist_quad_adjacency.out
+
+  test:
+    suffix: dist_hex
+    nsize: 3
+    args: -dim 3 -simplex 0 -dm_refine 1 -shuffle -dm_plex_reorder {{hilbert morton}} -petscspace_degree 1
+    output_file: output/ex42_dist_hex.out
+
+TEST*/
@@ -0,0 +1,215 @@
+static char help[] = "Convert a mesh file to HDF5 and load it in parallel without a serial copy of the mesh\n\n";
+
+#include <petscdmplex.h>
+#include <petscviewerhdf5.h>
+#include <petscsf.h>
+#include <petscbt.h>
+
+typedef struct {
+  char      filename[PETSC_MAX_PATH_LEN]; /* The mesh file to convert */
+  char      outfile[PETSC_MAX_PATH_LEN];  /* The HDF5 file */
+  PetscBool interpolate;                  /* Generate intermediate mesh elements */
+  PetscBool convert;                      /* Write the HDF5 file before loading it */
+  PetscBool distribute;                   /* Rebalance the loaded mesh */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->filename[0] = '\0';
+  ierr = PetscStrcpy(options->outfile, "ex10.h5");CHKERRQ(ierr);
+  options->interpolate = PETSC_TRUE;
+  options->convert     = PETSC_TRUE;
+  options->distribute  = PETSC_TRUE;
+
+  ierr = PetscOptionsBegin(comm, "", "Mesh Conversion Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsString("-filename", "The mesh file to convert", "ex10.c", options->filename, options->filename, sizeof(options->filename), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-outfile", "The HDF5 file", "ex10.c", options->outfile, options->outfile, sizeof(options->outfile), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate", "Generate intermediate mesh elements", "ex10.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-convert", "Write the HDF5 file before loading it", "ex10.c", options->convert, &options->convert, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-distribute", "Rebalance the loaded mesh", "ex10.c", options->distribute, &options->distribute, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* The conversion is a preprocessing step, so it is done by a single process */
+static PetscErrorCode ConvertMesh(MPI_Comm comm, AppCtx *user)
+{
+  DM             dm;
+  PetscViewer    viewer;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = DMPlexCreateFromFile(PETSC_COMM_SELF, user->filename, user->interpolate, &dm);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject) dm, "Mesh");CHKERRQ(ierr);
+    ierr = PetscViewerHDF5Open(PETSC_COMM_SELF, user->outfile, FILE_MODE_WRITE, &viewer);CHKERRQ(ierr);
+    ierr = DMView(dm, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  }
+  ierr = MPI_Barrier(comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Every process reads its slab of the file with -dm_plex_hdf5_parallel_load, and the partitioner rebalances the slabs */
+static PetscErrorCode LoadMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  PetscViewer    viewer;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5Open(comm, user->outfile, FILE_MODE_READ, &viewer);CHKERRQ(ierr);
+  ierr = DMLoad(*dm, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *dm, "Mesh");CHKERRQ(ierr);
+  if (user->distribute) {
+    DM               dmDist = NULL;
+    PetscPartitioner part;
+
+    ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+    ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+    ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+    if (dmDist) {
+      ierr = DMDestroy(dm);CHKERRQ(ierr);
+      *dm  = dmDist;
+    }
+  }
+  ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(*dm, NULL, "-dm_view");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Report quantities which do not depend on the partition */
+static PetscErrorCode ReportMesh(DM dm)
+{
+  MPI_Comm        comm;
+  PetscSF         sf;
+  PetscBT         ghost;
+  const PetscInt *leaves;
+  PetscReal       vol = 0.0, gvol;
+  PetscInt        dim, depth, d, cStart, cEnd, c, pStart, pEnd, nleaves, l, numLabels;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &nleaves, &leaves, NULL);CHKERRQ(ierr);
+  ierr = PetscBTCreate(pEnd-pStart, &ghost);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {ierr = PetscBTSet(ghost, (leaves ? leaves[l] : l) - pStart);CHKERRQ(ierr);}
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    PetscInt sStart, sEnd, s, n = 0, N;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &sStart, &sEnd);CHKERRQ(ierr);
+    for (s = sStart; s < sEnd; ++s) if (!PetscBTLookup(ghost, s - pStart)) ++n;
+    ierr = MPIU_Allreduce(&n, &N, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Depth %D: %D points\n", d, N);CHKERRQ(ierr);
+  }
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  if (depth == dim) {
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      PetscReal v;
+
+      if (PetscBTLookup(ghost, c - pStart)) continue;
+      ierr = DMPlexComputeCellGeometryFVM(dm, c, &v, NULL, NULL);CHKERRQ(ierr);
+      vol += v;
+    }
+    ierr = MPIU_Allreduce(&vol, &gvol, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Volume: %g\n", (double) gvol);CHKERRQ(ierr);
+  }
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel     label;
+    const char *name;
+    PetscBool   skip;
+    PetscInt    p, n = 0, N;
+
+    ierr = DMGetLabelName(dm, l, &name);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name, "depth", &skip);CHKERRQ(ierr);
+    if (skip) continue;
+    ierr = PetscStrcmp(name, "celltype", &skip);CHKERRQ(ierr);
+    if (skip) continue;
+    ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+    for (p = pStart; p < pEnd; ++p) {
+      PetscInt val;
+
+      if (PetscBTLookup(ghost, p - pStart)) continue;
+      ierr = DMLabelGetValue(label, p, &val);CHKERRQ(ierr);
+      if (val >= 0) ++n;
+    }
+    ierr = MPIU_Allreduce(&n, &N, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Label %s: %D points\n", name, N);CHKERRQ(ierr);
+  }
+  ierr = PetscBTDestroy(&ghost);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  if (user.convert) {ierr = ConvertMesh(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);}
+  ierr = LoadMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSymmetry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dm, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(dm, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckGeometry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckPointSF(dm);CHKERRQ(ierr);
+  ierr = ReportMesh(dm);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  build:
+    requires: hdf5
+
+  testset:
+    requires: !complex
+    args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/square.msh -petscpartitioner_type simple
+    test:
+      suffix: tri_seq
+      output_file: output/ex10_tri.out
+    test:
+      suffix: tri
+      nsize: {{2 3}}
+      output_file: output/ex10_tri.out
+      args: -dm_plex_hdf5_parallel_load
+    test:
+      suffix: tri_nodist
+      nsize: 3
+      output_file: output/ex10_tri.out
+      args: -distribute 0 -dm_plex_hdf5_parallel_load
+
+  testset:
+    requires: !complex
+    args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/doublet-tet.msh -petscpartitioner_type simple
+    test:
+      suffix: tet_seq
+      output_file: output/ex10_tet.out
+    test:
+      suffix: tet
+      nsize: {{2 4}}
+      output_file: output/ex10_tet.out
+      args: -dm_plex_hdf5_parallel_load
+    test:
+      suffix: tet_uninterp
+      nsize: 3
+      args: -interpolate 0 -dm_plex_hdf5_parallel_load
+
+TEST*/
@@ -34,6 +34,7 @@ PetscErrorCode  DMFinalizePackage(void)
 PETSC_EXTERN PetscErrorCode MatCreate_HYPREStruct(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_HYPRESStruct(Mat);
 #endif
+PETSC_EXTERN PetscErrorCode MatCreate_DAStencil(Mat);
 
 /*@C
   DMInitializePackage - This function initializes everything in the DM package. It is called
@@ -64,6 +65,7 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = MatRegister(MATHYPRESTRUCT, MatCreate_HYPREStruct);CHKERRQ(ierr);
   ierr = MatRegister(MATHYPRESSTRUCT, MatCreate_HYPRESStruct);CHKERRQ(ierr);
 #endif
+  ierr = MatRegister(MATDASTENCIL, MatCreate_DAStencil);CHKERRQ(ierr);
   ierr = PetscSectionSymRegister(PETSCSECTIONSYMLABEL,PetscSectionSymCreate_Label);CHKERRQ(ierr);
 
   /* Register Constructors */
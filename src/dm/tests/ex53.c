@@ -0,0 +1,275 @@
+static char help[] = "Tests MATDASTENCIL against the MATAIJ matrix of the same stencil and as the operator of PCMG.\n\n\
+  -dim <1,2,3>   - dimension of the DMDA\n\
+  -box           - use the box stencil instead of the star one\n\
+  -periodic      - use periodic boundaries\n\
+  -variable      - vary the coefficients from point to point\n\
+  -mg            - solve with KSP on the DMDA with MATDASTENCIL on the finest level\n\n";
+
+#include <petscdmda.h>
+#include <petscksp.h>
+
+typedef struct {
+  PetscBool variable;
+} AppCtx;
+
+/* The coefficient of the entry s at offset (di,dj,dk) of the stencil of the point (i,j,k), diagonally dominant and nonsymmetric if variable */
+static PetscScalar Coefficient(PetscInt i,PetscInt j,PetscInt k,PetscInt s,PetscInt di,PetscInt dj,PetscInt dk,PetscInt ns,PetscBool variable)
+{
+  if (di || dj || dk) return variable ? -(1.0 + 0.2*((i + 2*j + 3*k + s) % 5)) : -1.0;
+  return variable ? 1.8*(ns-1) + 0.5 : ns - 0.5;
+}
+
+/* Sets the coefficients of a MATDASTENCIL matrix, or assembles a MATAIJ matrix, with the stencil entries ordered as MATDASTENCIL orders them */
+static PetscErrorCode ComputeMatrix(DM da,Mat A,PetscBool variable)
+{
+  DMDAStencilType stype;
+  DMBoundaryType  bx,by,bz;
+  PetscInt        dim,M,N,P,xs,ys,zs,xm,ym,zm,i,j,k,s,n,ns,di,dj,dk;
+  PetscScalar     coef[27],*ca;
+  MatStencil      row,cols[27];
+  PetscBool       isstencil;
+  DM              cda;
+  Vec             c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetInfo(da,&dim,&M,&N,&P,NULL,NULL,NULL,NULL,NULL,&bx,&by,&bz,&stype);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ns   = stype == DMDA_STENCIL_STAR ? 2*dim+1 : (dim == 1 ? 3 : (dim == 2 ? 9 : 27));
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATDASTENCIL,&isstencil);CHKERRQ(ierr);
+  if (isstencil && !variable) {
+    for (s=0; s<ns; s++) coef[s] = s == ns/2 ? Coefficient(0,0,0,s,0,0,0,ns,PETSC_FALSE) : Coefficient(0,0,0,s,1,0,0,ns,PETSC_FALSE);
+    ierr = MatDAStencilSetCoefficients(A,coef);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ca = NULL;
+  if (isstencil) {
+    ierr = DMDACreateCompatibleDMDA(da,ns,&cda);CHKERRQ(ierr);
+    ierr = DMCreateGlobalVector(cda,&c);CHKERRQ(ierr);
+    ierr = VecGetArray(c,&ca);CHKERRQ(ierr);
+  }
+  for (k=zs; k<zs+zm; k++) {
+    for (j=ys; j<ys+ym; j++) {
+      for (i=xs; i<xs+xm; i++) {
+        row.i = i; row.j = j; row.k = k;
+        n = 0; s = 0;
+        for (dk=(dim > 2 ? -1 : 0); dk<=(dim > 2 ? 1 : 0); dk++) {
+          for (dj=(dim > 1 ? -1 : 0); dj<=(dim > 1 ? 1 : 0); dj++) {
+            for (di=-1; di<=1; di++) {
+              if (stype == DMDA_STENCIL_STAR && (di != 0) + (dj != 0) + (dk != 0) > 1) continue;
+              if (ca) *ca++ = Coefficient(i,j,k,s,di,dj,dk,ns,variable);
+              else if ((bx == DM_BOUNDARY_PERIODIC || (i+di >= 0 && i+di < M)) && (by == DM_BOUNDARY_PERIODIC || (j+dj >= 0 && j+dj < N)) && (bz == DM_BOUNDARY_PERIODIC || (k+dk >= 0 && k+dk < P))) {
+                cols[n].i = i+di; cols[n].j = j+dj; cols[n].k = k+dk;
+                coef[n++] = Coefficient(i,j,k,s,di,dj,dk,ns,variable);
+              }
+              s++;
+            }
+          }
+        }
+        if (!isstencil) {ierr = MatSetValuesStencil(A,1,&row,n,cols,coef,INSERT_VALUES);CHKERRQ(ierr);}
+      }
+    }
+  }
+  if (isstencil) {
+    ierr = VecRestoreArray(c,&ca);CHKERRQ(ierr);
+    ierr = MatDAStencilSetVariableCoefficients(A,c);CHKERRQ(ierr);
+    ierr = VecDestroy(&c);CHKERRQ(ierr);
+    ierr = DMDestroy(&cda);CHKERRQ(ierr);
+  } else {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ComputeOperators(KSP ksp,Mat J,Mat A,void *ctx)
+{
+  AppCtx         *user = (AppCtx*)ctx;
+  DM             da;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPGetDM(ksp,&da);CHKERRQ(ierr);
+  ierr = ComputeMatrix(da,A,user->variable);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ComputeRHS(KSP ksp,Vec b,void *ctx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Prints a line if x and y differ */
+static PetscErrorCode Compare(Vec x,Vec y,PetscReal tol,const char *what)
+{
+  Vec            d;
+  PetscReal      norm,dnorm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(x,&d);CHKERRQ(ierr);
+  ierr = VecWAXPY(d,-1.0,x,y);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_2,&dnorm);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&norm);CHKERRQ(ierr);
+  if (dnorm > tol*norm) {ierr = PetscPrintf(PetscObjectComm((PetscObject)x),"%s differ by %g relative to %g\n",what,(double)dnorm,(double)norm);CHKERRQ(ierr);}
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Solves with GMRES preconditioned with SOR */
+static PetscErrorCode Solve(Mat A,Vec b,Vec x)
+{
+  KSP                ksp;
+  PC                 pc;
+  KSPConvergedReason reason;
+  MatType            type;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPCreate(PetscObjectComm((PetscObject)A),&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPGMRES);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCSOR);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-10,PETSC_DEFAULT,PETSC_DEFAULT,200);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+  if (reason < 0) {
+    ierr = MatGetType(A,&type);CHKERRQ(ierr);
+    ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"Solve with %s did not converge\n",type);CHKERRQ(ierr);
+  }
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  AppCtx             user;
+  DM                 da;
+  Mat                A,B;
+  Vec                x,y,z;
+  KSP                ksp;
+  KSPConvergedReason reason;
+  PetscRandom        rand;
+  MatType            type;
+  PetscInt           dim = 2;
+  PetscBool          box = PETSC_FALSE,periodic = PETSC_FALSE,mg = PETSC_FALSE;
+  DMDAStencilType    stype;
+  DMBoundaryType     bd;
+  PetscErrorCode     ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  user.variable = PETSC_FALSE;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-box",&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-periodic",&periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-variable",&user.variable,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-mg",&mg,NULL);CHKERRQ(ierr);
+  stype = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+  bd    = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  /* the multicolor SOR of MATDASTENCIL needs an even number of points in the periodic directions */
+  if (dim == 1) {
+    ierr = DMDACreate1d(PETSC_COMM_WORLD,bd,periodic ? 32 : 33,1,1,NULL,&da);CHKERRQ(ierr);
+  } else if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,bd,bd,stype,periodic ? 16 : 17,periodic ? 16 : 17,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,bd,bd,bd,stype,periodic ? 8 : 9,periodic ? 8 : 9,periodic ? 8 : 9,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  if (mg) {
+    /* the coarser DMDAs inherit the matrix type, so that no level stores a sparse matrix and the coarse solve is also done with SOR */
+    ierr = DMSetMatType(da,MATDASTENCIL);CHKERRQ(ierr);
+    ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+    ierr = KSPSetDM(ksp,da);CHKERRQ(ierr);
+    ierr = KSPSetComputeRHS(ksp,ComputeRHS,NULL);CHKERRQ(ierr);
+    ierr = KSPSetComputeOperators(ksp,ComputeOperators,&user);CHKERRQ(ierr);
+    ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,NULL,NULL);CHKERRQ(ierr);
+    ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+    ierr = KSPGetOperators(ksp,&A,NULL);CHKERRQ(ierr);
+    ierr = MatGetType(A,&type);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Multigrid solve with a %s operator %s\n",type,reason > 0 ? "converged" : "diverged");CHKERRQ(ierr);
+    ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+    ierr = DMDestroy(&da);CHKERRQ(ierr);
+    ierr = PetscFinalize();
+    return ierr;
+  }
+
+  ierr = MatCreateDAStencil(da,&A);CHKERRQ(ierr);
+  ierr = ComputeMatrix(da,A,user.variable);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&B);CHKERRQ(ierr);
+  ierr = ComputeMatrix(da,B,user.variable);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = Compare(y,z,1.e-12,"MatMult() results");CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,z,z);CHKERRQ(ierr);
+  ierr = Compare(y,z,1.e-12,"MatMultAdd() results");CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,y);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(B,z);CHKERRQ(ierr);
+  ierr = Compare(y,z,1.e-12,"Diagonals");CHKERRQ(ierr);
+
+  /* the multicolor SOR of MATDASTENCIL is a different preconditioner, but the solutions agree */
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = Solve(A,x,y);CHKERRQ(ierr);
+  ierr = Solve(B,x,z);CHKERRQ(ierr);
+  ierr = Compare(y,z,1.e-7,"Solutions");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MATDASTENCIL test completed\n");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 2d
+      nsize: {{1 2}}
+      output_file: output/ex53_1.out
+      args: -variable {{0 1}} -box {{0 1}}
+
+   test:
+      suffix: 3d
+      nsize: {{1 3}}
+      output_file: output/ex53_1.out
+      args: -dim 3 -variable {{0 1}} -box {{0 1}}
+
+   test:
+      suffix: periodic
+      nsize: 2
+      output_file: output/ex53_1.out
+      args: -dim {{1 2}} -periodic -variable -mat_dastencil_tile 1
+
+   test:
+      suffix: periodic_box
+      nsize: 2
+      output_file: output/ex53_1.out
+      args: -dim {{2 3}} -periodic -box -variable
+
+   test:
+      suffix: mg
+      nsize: {{1 2}}
+      output_file: output/ex53_mg.out
+      args: -mg -dim {{2 3}} -variable -pc_type mg -pc_mg_levels 3 -ksp_rtol 1.e-8 -mg_coarse_ksp_type richardson -mg_coarse_ksp_norm_type none -mg_coarse_ksp_max_it 20 -mg_coarse_pc_type sor
+
+TEST*/
@@ -42,6 +42,7 @@
     data used during the optional Lanczo process used to compute eigenvalues
 */
 #include <../src/ksp/ksp/impls/cg/cgimpl.h>       /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
 extern PetscErrorCode KSPComputeExtremeSingularValues_CG(KSP,PetscReal*,PetscReal*);
 extern PetscErrorCode KSPComputeEigenvalues_CG(KSP,PetscInt,PetscReal*,PetscReal*,PetscInt*);
 
@@ -419,6 +420,240 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
   PetscFunctionReturn(0);
 }
 
+/*
+   KSPCGBlockDot_Private - computes the local part of the s x s matrix P'*Q, with P' the conjugate
+   transpose of P (or its transpose for the complex symmetric variant), stored in C with leading dimension s
+*/
+static PetscErrorCode KSPCGBlockDot_Private(KSP ksp,Mat P,Mat Q,PetscScalar *C)
+{
+  KSP_CG            *cg = (KSP_CG*)ksp->data;
+  const PetscScalar *p,*q;
+  PetscScalar       one = 1.0,zero = 0.0;
+  PetscInt          m,s,ldp,ldq;
+  PetscBLASInt      bm,bs,bldp,bldq;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetLocalSize(P,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(P,NULL,&s);CHKERRQ(ierr);
+  if (!m) {
+    ierr = PetscArrayzero(C,s*s);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatDenseGetLDA(P,&ldp);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(Q,&ldq);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldp,&bldp);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldq,&bldq);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(P,&p);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(Q,&q);CHKERRQ(ierr);
+  PetscStackCallBLAS("BLASgemm",BLASgemm_(cg->type == KSP_CG_HERMITIAN ? "C" : "T","N",&bs,&bs,&bm,&one,p,&bldp,q,&bldq,&zero,C,&bs));
+  ierr = MatDenseRestoreArrayRead(Q,&q);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArrayRead(P,&p);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*s*s*m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPCGBlockAXPY_Private - computes Y <- Y + a P*C, with C an s x s matrix stored with leading dimension s
+*/
+static PetscErrorCode KSPCGBlockAXPY_Private(Mat Y,PetscScalar a,Mat P,const PetscScalar *C)
+{
+  const PetscScalar *p;
+  PetscScalar       *y,one = 1.0;
+  PetscInt          m,s,ldp,ldy;
+  PetscBLASInt      bm,bs,bldp,bldy;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetLocalSize(P,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(P,NULL,&s);CHKERRQ(ierr);
+  if (!m) PetscFunctionReturn(0);
+  ierr = MatDenseGetLDA(P,&ldp);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(Y,&ldy);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldp,&bldp);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldy,&bldy);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(P,&p);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(Y,&y);CHKERRQ(ierr);
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&bm,&bs,&bs,&a,p,&bldp,C,&bs,&one,y,&bldy));
+  ierr = MatDenseRestoreArray(Y,&y);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArrayRead(P,&p);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*s*s*m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPCGBlockReduce_Private - computes with a single reduction the s x s matrix Z'*R and the norms of the
+   columns of the residuals selected by the norm type, and returns the largest of these norms
+*/
+static PetscErrorCode KSPCGBlockReduce_Private(KSP ksp,Mat R,Mat Z,PetscScalar *lwork,PetscScalar *RZ,PetscReal *rnorm)
+{
+  const PetscScalar *v;
+  PetscReal         nrm;
+  PetscInt          i,j,m,s,ld;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetLocalSize(R,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(R,NULL,&s);CHKERRQ(ierr);
+  ierr = KSPCGBlockDot_Private(ksp,Z,R,lwork);CHKERRQ(ierr);
+  for (j=0; j<s; j++) lwork[s*s+j] = 0.0;
+  if (ksp->normtype == KSP_NORM_PRECONDITIONED || ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+    Mat N = ksp->normtype == KSP_NORM_PRECONDITIONED ? Z : R;
+
+    ierr = MatDenseGetLDA(N,&ld);CHKERRQ(ierr);
+    ierr = MatDenseGetArrayRead(N,&v);CHKERRQ(ierr);
+    for (j=0; j<s; j++) {
+      nrm = 0.0;
+      for (i=0; i<m; i++) nrm += PetscRealPart(v[i+j*ld]*PetscConj(v[i+j*ld]));
+      lwork[s*s+j] = nrm;
+    }
+    ierr = MatDenseRestoreArrayRead(N,&v);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*s*m);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(lwork,RZ,s*s+s,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ksp));CHKERRQ(ierr);
+  *rnorm = 0.0;
+  for (j=0; j<s; j++) {
+    switch (ksp->normtype) {
+    case KSP_NORM_PRECONDITIONED:
+    case KSP_NORM_UNPRECONDITIONED:
+      nrm = PetscSqrtReal(PetscRealPart(RZ[s*s+j]));
+      break;
+    case KSP_NORM_NATURAL:
+      nrm = PetscSqrtReal(PetscAbsScalar(RZ[j*(s+1)]));
+      break;
+    default:
+      nrm = 0.0;
+    }
+    *rnorm = PetscMax(*rnorm,nrm);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPMatSolve_CG - block conjugate gradient method of O'Leary (1980) for a block of right-hand sides
+   stored in a MATDENSE: the operator is applied with a single MatMatMult() per iteration and the inner
+   products of all columns are computed with two reductions per iteration, as in KSPSolve_CG().  The
+   residual norm reported to the monitors and to the convergence test is the largest of the column norms.
+   The search directions become linearly dependent when a column is zero, is a combination of the others, or
+   converges much sooner than the others; P'AP is then singular, so the remaining iterations are done column
+   by column with KSPSolve(), starting from the current iterates.
+*/
+static PetscErrorCode KSPMatSolve_CG(KSP ksp,Mat B,Mat X)
+{
+  Mat            Amat,R,Z,P,Q = NULL,W = NULL;
+  PetscScalar    *lwork,*RZ,*RZold,*LU,*C;
+  PetscReal      dp = 0.0,dmin,dmax;
+  PetscInt       i,j,m,M,s,ss;
+  PetscBLASInt   bs,*pivots,info;
+  PetscBool      diagonalscale,guess_zero,deficient = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+  if (ksp->transpose_solve) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support transpose solves with a block of right-hand sides",((PetscObject)ksp)->type_name);
+  ierr = PCGetOperators(ksp->pc,&Amat,NULL);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(B,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(B,&M,&s);CHKERRQ(ierr);
+  ss   = s*s;
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr = MatCreateDense(PetscObjectComm((PetscObject)B),m,PETSC_DECIDE,M,s,NULL,&R);CHKERRQ(ierr);
+  ierr = MatDuplicate(R,MAT_DO_NOT_COPY_VALUES,&Z);CHKERRQ(ierr);
+  ierr = MatDuplicate(R,MAT_DO_NOT_COPY_VALUES,&P);CHKERRQ(ierr);
+  ierr = PetscMalloc6(ss+s,&lwork,ss+s,&RZ,ss,&RZold,ss,&LU,ss,&C,s,&pivots);CHKERRQ(ierr);
+
+  ksp->its    = 0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  if (!ksp->guess_zero) {
+    ierr = MatMatMult(Amat,X,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W);CHKERRQ(ierr); /*    R <- B - AX                       */
+    ierr = MatCopy(B,R,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatAXPY(R,-1.0,W,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatDestroy(&W);CHKERRQ(ierr);
+  } else {
+    ierr = MatZeroEntries(X);CHKERRQ(ierr);
+    ierr = MatCopy(B,R,SAME_NONZERO_PATTERN);CHKERRQ(ierr);                   /*    R <- B (X is 0)                   */
+  }
+  ierr = KSP_PCMatApply(ksp,R,Z);CHKERRQ(ierr);                                /*    Z <- MR                           */
+  ierr = KSPCGBlockReduce_Private(ksp,R,Z,lwork,RZ,&dp);CHKERRQ(ierr);        /*    RZ <- Z'R                         */
+  ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+  ierr       = KSPMonitor(ksp,0,dp);CHKERRQ(ierr);
+  ksp->rnorm = dp;
+  /* the right-hand sides are not available to the default convergence test, so the initial residual norm is always used as reference */
+  guess_zero      = ksp->guess_zero;
+  ksp->guess_zero = PETSC_TRUE;
+  ierr = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  ksp->guess_zero = guess_zero;
+
+  for (i=0; !ksp->reason && i<ksp->max_it; i++) {
+    if (!i) {
+      ierr = MatCopy(Z,P,SAME_NONZERO_PATTERN);CHKERRQ(ierr);                 /*    P <- Z                            */
+    } else {
+      ierr = KSPCGBlockAXPY_Private(Z,1.0,P,C);CHKERRQ(ierr);                  /*    P <- Z + P beta                   */
+      ierr = MatCopy(Z,P,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    }
+    ierr = MatMatMult(Amat,P,Q ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,&Q);CHKERRQ(ierr); /*    Q <- AP                           */
+    ierr = KSPCGBlockDot_Private(ksp,P,Q,lwork);CHKERRQ(ierr);                 /*    LU <- P'Q                         */
+    ierr = MPIU_Allreduce(lwork,LU,ss,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ksp));CHKERRQ(ierr);
+    for (j=0; j<s; j++) {
+      if (PetscRealPart(LU[j*(s+1)]) < 0.0) {
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        ierr = PetscInfo1(ksp,"Diverging due to indefinite or negative definite matrix, column %D\n",j);CHKERRQ(ierr);
+        break;
+      }
+      if (PetscRealPart(LU[j*(s+1)]) == 0.0) deficient = PETSC_TRUE;
+    }
+    if (ksp->reason) break;
+    if (!deficient) {
+      ierr = PetscArraycpy(C,RZ,ss);CHKERRQ(ierr);                             /*    alpha <- (P'Q)^{-1} Z'R           */
+      PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&bs,&bs,LU,&bs,pivots,C,&bs,&info));
+      dmin = PETSC_MAX_REAL;
+      dmax = 0.0;
+      for (j=0; j<s; j++) {
+        dmin = PetscMin(dmin,PetscAbsScalar(LU[j*(s+1)]));
+        dmax = PetscMax(dmax,PetscAbsScalar(LU[j*(s+1)]));
+      }
+      if (info || dmin <= s*PETSC_MACHINE_EPSILON*dmax) deficient = PETSC_TRUE;
+    }
+    if (deficient) {
+      ierr = PetscInfo1(ksp,"Rank deficient search directions at iteration %D\n",i);CHKERRQ(ierr);
+      break;
+    }
+    ierr = KSPCGBlockAXPY_Private(X,1.0,P,C);CHKERRQ(ierr);                    /*    X <- X + P alpha                  */
+    ierr = KSPCGBlockAXPY_Private(R,-1.0,Q,C);CHKERRQ(ierr);                   /*    R <- R - Q alpha                  */
+    ierr = KSP_PCMatApply(ksp,R,Z);CHKERRQ(ierr);                              /*    Z <- MR                           */
+    ierr = PetscArraycpy(RZold,RZ,ss);CHKERRQ(ierr);
+    ierr = KSPCGBlockReduce_Private(ksp,R,Z,lwork,RZ,&dp);CHKERRQ(ierr);      /*    RZ <- Z'R                         */
+    ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->its   = i+1;
+    ksp->rnorm = dp;
+    ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,i+1,dp);CHKERRQ(ierr);
+    ierr = (*ksp->converged)(ksp,i+1,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+    if (ksp->reason) break;
+    ierr = PetscArraycpy(C,RZ,ss);CHKERRQ(ierr);                               /*    beta <- (Z'R)_old^{-1} Z'R        */
+    PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&bs,&bs,RZold,&bs,pivots,C,&bs,&info));
+    if (info) {
+      deficient = PETSC_TRUE;
+      ierr = PetscInfo1(ksp,"Rank deficient residuals at iteration %D\n",i+1);CHKERRQ(ierr);
+      break;
+    }
+  }
+  ierr = PetscFree6(lwork,RZ,RZold,LU,C,pivots);CHKERRQ(ierr);
+  ierr = MatDestroy(&Q);CHKERRQ(ierr);
+  ierr = MatDestroy(&P);CHKERRQ(ierr);
+  ierr = MatDestroy(&Z);CHKERRQ(ierr);
+  ierr = MatDestroy(&R);CHKERRQ(ierr);
+  if (deficient) {
+    ierr = KSPMatSolveColumns_Private(ksp,B,X);CHKERRQ(ierr);
+  } else if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+  PetscFunctionReturn(0);
+}
+
 /*
      KSPDestroy_CG - Frees resources allocated in KSPSetup_CG and clears function
                      compositions from KSPCreate_CG. If adding your own KSP implementation,
@@ -603,6 +838,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_CG(KSP ksp)
   */
   ksp->ops->setup          = KSPSetUp_CG;
   ksp->ops->solve          = KSPSolve_CG;
+  ksp->ops->matsolve       = KSPMatSolve_CG;
   ksp->ops->destroy        = KSPDestroy_CG;
   ksp->ops->view           = KSPView_CG;
   ksp->ops->setfromoptions = KSPSetFromOptions_CG;
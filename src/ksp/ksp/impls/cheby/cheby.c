@@ -8,6 +8,9 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
+  ierr = MatDestroy(&cheb->matwork[0]);CHKERRQ(ierr);
+  ierr = MatDestroy(&cheb->matwork[1]);CHKERRQ(ierr);
+  ierr = MatDestroy(&cheb->matwork[2]);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -306,6 +309,85 @@ PETSC_STATIC_INLINE PetscScalar chebyhash(PetscInt xx)
   return (PetscScalar)((PetscInt64)x-2147483648)*5.e-10; /* center around zero, scaled about -1. to 1.*/
 }
 
+/*
+   Estimates the extreme eigenvalues with cheb->kspest when the operators have changed since the last estimate,
+   rhs is the right hand side of the estimation when the noisy vector is not used
+*/
+static PetscErrorCode KSPChebyshevComputeEigenvalues_Private(KSP ksp,Vec rhs)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  Mat              Amat,Pmat;
+  PetscObjectId    amatid,    pmatid;
+  PetscObjectState amatstate, pmatstate;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+    PetscReal          max=0.0,min=0.0;
+    Vec                B;
+    KSPConvergedReason reason;
+
+    ierr = KSPSetPC(cheb->kspest,ksp->pc);CHKERRQ(ierr);
+    if (cheb->usenoisy) {
+      PetscInt       n,i,istart;
+      PetscScalar    *xx;
+
+      B    = ksp->work[1];
+      ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
+      ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
+      ierr = VecGetArrayWrite(B,&xx);CHKERRQ(ierr);
+      for (i=0; i<n; i++) xx[i] = chebyhash(i+istart);
+      ierr = VecRestoreArrayWrite(B,&xx);CHKERRQ(ierr);
+    } else {
+      PetscBool change;
+
+      ierr = PCPreSolveChangeRHS(ksp->pc,&change);CHKERRQ(ierr);
+      if (change) {
+        B = ksp->work[1];
+        ierr = VecCopy(rhs,B);CHKERRQ(ierr);
+      } else B = rhs;
+    }
+    ierr = KSPSolve(cheb->kspest,B,ksp->work[0]);CHKERRQ(ierr);
+    ierr = KSPGetConvergedReason(cheb->kspest,&reason);CHKERRQ(ierr);
+    if (reason == KSP_DIVERGED_ITS) {
+      ierr = PetscInfo(ksp,"Eigen estimator ran for prescribed number of iterations\n");CHKERRQ(ierr);
+    } else if (reason == KSP_DIVERGED_PC_FAILED) {
+      PetscInt       its;
+      PCFailedReason pcreason;
+
+      ierr = KSPGetIterationNumber(cheb->kspest,&its);CHKERRQ(ierr);
+      ierr = PCGetFailedReason(ksp->pc,&pcreason);CHKERRQ(ierr);
+      if (!pcreason) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_PLIB,"KSP has KSP_DIVERGED_PC_FAILED but PC has no error flag");
+      ksp->reason = KSP_DIVERGED_PC_FAILED;
+      ierr = PetscInfo3(ksp,"Eigen estimator failed: %s %s at iteration %D",KSPConvergedReasons[reason],PCFailedReasons[pcreason],its);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    } else if (reason == KSP_CONVERGED_RTOL || reason == KSP_CONVERGED_ATOL) {
+      ierr = PetscInfo(ksp,"Eigen estimator converged prematurely. Should not happen except for small or low rank problem\n");CHKERRQ(ierr);
+    } else if (reason < 0) {
+      ierr = PetscInfo1(ksp,"Eigen estimator failed %s, using estimates anyway\n",KSPConvergedReasons[reason]);CHKERRQ(ierr);
+    }
+
+    ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
+    ierr = KSPSetPC(cheb->kspest,NULL);CHKERRQ(ierr);
+
+    cheb->emin_computed = min;
+    cheb->emax_computed = max;
+    cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
+    cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
+
+    cheb->amatid    = amatid;
+    cheb->pmatid    = pmatid;
+    cheb->amatstate = amatstate;
+    cheb->pmatstate = pmatstate;
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -323,71 +405,10 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 
   ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
   if (cheb->kspest) {
-    PetscObjectId    amatid,    pmatid;
-    PetscObjectState amatstate, pmatstate;
-
-    ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
-    ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
-    ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
-    ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
-    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
-      PetscReal          max=0.0,min=0.0;
-      Vec                B;
-      KSPConvergedReason reason;
-
-      ierr = KSPSetPC(cheb->kspest,ksp->pc);CHKERRQ(ierr);
-      if (cheb->usenoisy) {
-        PetscInt       n,i,istart;
-        PetscScalar    *xx;
-
-        B    = ksp->work[1];
-        ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
-        ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
-        ierr = VecGetArrayWrite(B,&xx);CHKERRQ(ierr);
-        for (i=0; i<n; i++) xx[i] = chebyhash(i+istart);
-        ierr = VecRestoreArrayWrite(B,&xx);CHKERRQ(ierr);
-      } else {
-        PetscBool change;
-
-        ierr = PCPreSolveChangeRHS(ksp->pc,&change);CHKERRQ(ierr);
-        if (change) {
-          B = ksp->work[1];
-          ierr = VecCopy(ksp->vec_rhs,B);CHKERRQ(ierr);
-        } else B = ksp->vec_rhs;
-      }
-      ierr = KSPSolve(cheb->kspest,B,ksp->work[0]);CHKERRQ(ierr);
-      ierr = KSPGetConvergedReason(cheb->kspest,&reason);CHKERRQ(ierr);
-      if (reason == KSP_DIVERGED_ITS) {
-        ierr = PetscInfo(ksp,"Eigen estimator ran for prescribed number of iterations\n");CHKERRQ(ierr);
-      } else if (reason == KSP_DIVERGED_PC_FAILED) {
-        PetscInt       its;
-        PCFailedReason pcreason;
-
-        ierr = KSPGetIterationNumber(cheb->kspest,&its);CHKERRQ(ierr);
-        ierr = PCGetFailedReason(ksp->pc,&pcreason);CHKERRQ(ierr);
-        if (!pcreason) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_PLIB,"KSP has KSP_DIVERGED_PC_FAILED but PC has no error flag");
-        ksp->reason = KSP_DIVERGED_PC_FAILED;
-        ierr = VecSetInf(ksp->vec_sol);CHKERRQ(ierr);
-        ierr = PetscInfo3(ksp,"Eigen estimator failed: %s %s at iteration %D",KSPConvergedReasons[reason],PCFailedReasons[pcreason],its);CHKERRQ(ierr);
-        PetscFunctionReturn(0);
-      } else if (reason == KSP_CONVERGED_RTOL || reason == KSP_CONVERGED_ATOL) {
-        ierr = PetscInfo(ksp,"Eigen estimator converged prematurely. Should not happen except for small or low rank problem\n");CHKERRQ(ierr);
-      } else if (reason < 0) {
-        ierr = PetscInfo1(ksp,"Eigen estimator failed %s, using estimates anyway\n",KSPConvergedReasons[reason]);CHKERRQ(ierr);
-      }
-
-      ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
-      ierr = KSPSetPC(cheb->kspest,NULL);CHKERRQ(ierr);
-
-      cheb->emin_computed = min;
-      cheb->emax_computed = max;
-      cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
-      cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
-
-      cheb->amatid    = amatid;
-      cheb->pmatid    = pmatid;
-      cheb->amatstate = amatstate;
-      cheb->pmatstate = pmatstate;
+    ierr = KSPChebyshevComputeEigenvalues_Private(ksp,ksp->vec_rhs);CHKERRQ(ierr);
+    if (ksp->reason == KSP_DIVERGED_PC_FAILED) {
+      ierr = VecSetInf(ksp->vec_sol);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
     }
   }
   ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
@@ -547,6 +568,212 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   PetscFunctionReturn(0);
 }
 
+/* returns the largest norm of the columns of the residual R, Z = B^{-1}R is computed for the preconditioned norm */
+static PetscErrorCode KSPChebyshevMatNorm_Private(KSP ksp,Mat R,Mat Z,PetscReal *rnorm)
+{
+  PetscReal      *norms;
+  PetscInt       i,N;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *rnorm = 0.0;
+  if (ksp->normtype == KSP_NORM_NONE) PetscFunctionReturn(0);
+  ierr = MatGetSize(R,NULL,&N);CHKERRQ(ierr);
+  ierr = PetscMalloc1(N,&norms);CHKERRQ(ierr);
+  switch (ksp->normtype) {
+  case KSP_NORM_PRECONDITIONED:
+    ierr = KSP_PCMatApply(ksp,R,Z);CHKERRQ(ierr);
+    ierr = MatGetColumnNorms(Z,NORM_2,norms);CHKERRQ(ierr);
+    break;
+  case KSP_NORM_UNPRECONDITIONED:
+  case KSP_NORM_NATURAL:
+    ierr = MatGetColumnNorms(R,NORM_2,norms);CHKERRQ(ierr);
+    break;
+  default: SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"%s",KSPNormTypes[ksp->normtype]);
+  }
+  for (i=0; i<N; i++) *rnorm = PetscMax(*rnorm,norms[i]);
+  ierr = PetscFree(norms);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the convergence test is applied to the largest column norm, relative to the initial residuals as ksp->vec_rhs is not set */
+static PetscErrorCode KSPChebyshevMatConverged_Private(KSP ksp,PetscInt i,PetscReal rnorm)
+{
+  PetscBool      guess_zero = ksp->guess_zero;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  KSPCheckNorm(ksp,rnorm);
+  ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm = rnorm;
+  ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+  ksp->guess_zero = PETSC_TRUE;
+  ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  ksp->guess_zero = guess_zero;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Same iteration as KSPSolve_Chebyshev() on a block of right hand sides, the operator is applied with MatMatMult()
+   and the preconditioner with PCMatApply(), the eigenvalues are estimated once for the whole block when
+   the noisy right hand side is not used, from a combination of all the normalized columns with positive weights
+*/
+static PetscErrorCode KSPMatSolve_Chebyshev(KSP ksp,Mat B,Mat X)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  PetscInt         k,kp1,km1,ktmp,i,N,Nw;
+  PetscScalar      alpha,omegaprod,mu,omega,Gamma,c[3],scale,*ww;
+  PetscReal        rnorm = 0.0,*norms;
+  Vec              w;
+  Mat              P[3],R,Amat,Pmat;
+  PetscObjectId    amatid,pmatid;
+  PetscObjectState amatstate,pmatstate;
+  PetscBool        diagonalscale;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = MatGetSize(B,NULL,&N);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  if (cheb->kspest && (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate)) {
+    PetscInt j,jStart,jEnd;
+
+    /* the zero columns are left out, and the weights differ so that columns do not cancel */
+    ierr = PetscMalloc1(N,&norms);CHKERRQ(ierr);
+    ierr = MatGetColumnNorms(B,NORM_2,norms);CHKERRQ(ierr);
+    ierr = MatCreateVecs(B,&w,NULL);CHKERRQ(ierr);
+    ierr = VecGetOwnershipRange(w,&jStart,&jEnd);CHKERRQ(ierr);
+    ierr = VecGetArrayWrite(w,&ww);CHKERRQ(ierr);
+    for (j=jStart; j<jEnd; j++) ww[j-jStart] = norms[j] > 0.0 ? (1.5+chebyhash(j))/norms[j] : 0.0;
+    ierr = VecRestoreArrayWrite(w,&ww);CHKERRQ(ierr);
+    ierr = MatMult(B,w,ksp->work[2]);CHKERRQ(ierr);
+    ierr = VecDestroy(&w);CHKERRQ(ierr);
+    ierr = PetscFree(norms);CHKERRQ(ierr);
+    ierr = KSPChebyshevComputeEigenvalues_Private(ksp,ksp->work[2]);CHKERRQ(ierr);
+    if (ksp->reason == KSP_DIVERGED_PC_FAILED) PetscFunctionReturn(0);
+  }
+  if (cheb->matwork[0]) {
+    ierr = MatGetSize(cheb->matwork[0],NULL,&Nw);CHKERRQ(ierr);
+    if (Nw != N) {
+      ierr = MatDestroy(&cheb->matwork[0]);CHKERRQ(ierr);
+      ierr = MatDestroy(&cheb->matwork[1]);CHKERRQ(ierr);
+      ierr = MatDestroy(&cheb->matwork[2]);CHKERRQ(ierr);
+    }
+  }
+  if (!cheb->matwork[0]) {
+    ierr = MatDuplicate(X,MAT_DO_NOT_COPY_VALUES,&cheb->matwork[0]);CHKERRQ(ierr);
+    ierr = MatDuplicate(X,MAT_DO_NOT_COPY_VALUES,&cheb->matwork[1]);CHKERRQ(ierr);
+    ierr = MatDuplicate(X,MAT_DO_NOT_COPY_VALUES,&cheb->matwork[2]);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  km1    = 0; k = 1; kp1 = 2;
+  P[km1] = X;
+  P[k]   = cheb->matwork[0];
+  P[kp1] = cheb->matwork[1];
+  R      = cheb->matwork[2];
+
+  scale     = 2.0/(cheb->emax + cheb->emin);
+  alpha     = 1.0 - scale*(cheb->emin);
+  Gamma     = 1.0;
+  mu        = 1.0/alpha;
+  omegaprod = 2.0/alpha;
+
+  c[km1] = 1.0;
+  c[k]   = mu;
+
+  if (!ksp->guess_zero) {
+    ierr = MatMatMult(Amat,X,MAT_REUSE_MATRIX,PETSC_DEFAULT,&R);CHKERRQ(ierr);     /*  R = B - A*P[km1] */
+    ierr = MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  } else {
+    ierr = MatCopy(B,R,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  }
+
+  if (ksp->normtype) {
+    ierr = KSPChebyshevMatNorm_Private(ksp,R,P[k],&rnorm);CHKERRQ(ierr);
+    ierr = KSPChebyshevMatConverged_Private(ksp,0,rnorm);CHKERRQ(ierr);
+  } else ksp->reason = KSP_CONVERGED_ITERATING;
+  if (ksp->reason || ksp->max_it==0) {
+    if (ksp->max_it==0) ksp->reason = KSP_DIVERGED_ITS;
+    PetscFunctionReturn(0);
+  }
+  if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
+    ierr = KSP_PCMatApply(ksp,R,P[k]);CHKERRQ(ierr);  /* P[k] = B^{-1}R */
+  }
+  ierr = MatAYPX(P[k],scale,P[km1],SAME_NONZERO_PATTERN);CHKERRQ(ierr);  /* P[k] = scale B^{-1}R + P[km1] */
+  ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 1;
+  ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  for (i=1; i<ksp->max_it; i++) {
+    ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->its++;
+    ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+    ierr = MatMatMult(Amat,P[k],MAT_REUSE_MATRIX,PETSC_DEFAULT,&R);CHKERRQ(ierr);     /*  R = B - A*P[k] */
+    ierr = MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    if (ksp->normtype) {
+      ierr = KSPChebyshevMatNorm_Private(ksp,R,P[kp1],&rnorm);CHKERRQ(ierr);
+      ierr = KSPChebyshevMatConverged_Private(ksp,i,rnorm);CHKERRQ(ierr);
+      if (ksp->reason) break;
+    }
+    if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
+      ierr = KSP_PCMatApply(ksp,R,P[kp1]);CHKERRQ(ierr);     /*  P[kp1] = B^{-1}R  */
+    }
+
+    c[kp1] = 2.0*mu*c[k] - c[km1];
+    omega  = omegaprod*c[k]/c[kp1];
+
+    /* Y^{k+1} = omega(Y^{k} - Y^{k-1} + Gamma*R^{k}) + Y^{k-1} */
+    ierr = MatScale(P[kp1],omega*Gamma*scale);CHKERRQ(ierr);
+    ierr = MatAXPY(P[kp1],1.0-omega,P[km1],SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatAXPY(P[kp1],omega,P[k],SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+
+    ktmp = km1;
+    km1  = k;
+    k    = kp1;
+    kp1  = ktmp;
+  }
+  if (!ksp->reason) {
+    if (ksp->normtype) {
+      ierr = MatMatMult(Amat,P[k],MAT_REUSE_MATRIX,PETSC_DEFAULT,&R);CHKERRQ(ierr);       /*  R = B - A*P[k] */
+      ierr = MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      ierr = KSPChebyshevMatNorm_Private(ksp,R,P[kp1],&rnorm);CHKERRQ(ierr);
+      KSPCheckNorm(ksp,rnorm);
+      ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm = rnorm;
+      ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+    }
+    if (ksp->its >= ksp->max_it) {
+      if (ksp->normtype != KSP_NORM_NONE) {
+        PetscBool guess_zero = ksp->guess_zero;
+
+        ksp->guess_zero = PETSC_TRUE;
+        ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+        ksp->guess_zero = guess_zero;
+        if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      } else ksp->reason = KSP_CONVERGED_ITS;
+    }
+  }
+
+  /* make sure the solution is in X */
+  if (k) {
+    ierr = MatCopy(P[k],X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -607,6 +834,9 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           Chebyshev is configured as a smoother by default, targetting the "upper" part of the spectrum.
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
+          With KSPMatSolve(), the eigenvalues are estimated once for the whole block of right hand sides, from a
+          combination of all its nonzero columns, unless -ksp_chebyshev_esteig_noisy is used.
+
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
            KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
            KSPRICHARDSON, KSPCG, PCMG
@@ -639,6 +869,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
 
   ksp->ops->setup          = KSPSetUp_Chebyshev;
   ksp->ops->solve          = KSPSolve_Chebyshev;
+  ksp->ops->matsolve       = KSPMatSolve_Chebyshev;
   ksp->ops->destroy        = KSPDestroy_Chebyshev;
   ksp->ops->buildsolution  = KSPBuildSolutionDefault;
   ksp->ops->buildresidual  = KSPBuildResidualDefault;
@@ -14,6 +14,7 @@ typedef struct {
   PetscReal        tform[4];     /* transform from Krylov estimates to Chebyshev bounds */
   PetscInt         eststeps;     /* number of kspest steps in KSP used to estimate eigenvalues */
   PetscBool        usenoisy;    /* use noisy right hand side vector to estimate eigenvalues */
+  Mat              matwork[3];   /* work blocks of KSPMatSolve() */
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
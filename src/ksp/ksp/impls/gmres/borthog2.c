@@ -109,10 +109,60 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   PetscFunctionReturn(0);
 }
 
+/*@C
+     KSPGMRESClassicalGramSchmidtFusedOrthogonalization -  Classical Gram-Schmidt with one step of iterative refinement,
+                where the update of the first pass and the inner products of the second pass share a pass over the vectors
+
+     Collective on ksp
+
+  Input Parameters:
++   ksp - KSP object, must be associated with GMRES, FGMRES, or LGMRES Krylov method
+-   its - one less then the current GMRES restart iteration, i.e. the size of the Krylov space
+
+   Options Database Keys:
+.   -ksp_gmres_fusedgramschmidt - Activates KSPGMRESClassicalGramSchmidtFusedOrthogonalization()
 
+    Notes:
+    This computes the same as KSPGMRESClassicalGramSchmidtOrthogonalization() with KSP_GMRES_CGS_REFINE_ALWAYS, with
+    the same two global reductions, but uses VecMAXPYMDot() so the Krylov vectors are read from memory three times
+    instead of four. The refinement type set with KSPGMRESSetCGSRefinementType() is ignored.
 
+   Level: intermediate
 
+.seealso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetOrthogonalization(), VecMAXPYMDot()
 
+@*/
+PetscErrorCode  KSPGMRESClassicalGramSchmidtFusedOrthogonalization(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       j;
+  PetscScalar    *hh,*hes,*lhh;
 
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  if (!gmres->orthogwork) {
+    ierr = PetscMalloc1(gmres->max_k + 2,&gmres->orthogwork);CHKERRQ(ierr);
+  }
+  lhh = gmres->orthogwork;
+  hh  = HH(0,it);
+  hes = HES(0,it);
 
+  ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
+  for (j=0; j<=it; j++) {
+    KSPCheckDot(ksp,lhh[j]);
+    hh[j]  = lhh[j];
+    lhh[j] = -lhh[j];
+  }
 
+  /* subtract the projection and compute the inner products of the refinement step, hes is used as work space */
+  ierr = VecMAXPYMDot(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),hes);CHKERRQ(ierr);
+  for (j=0; j<=it; j++) {
+    lhh[j]  = -hes[j];
+    hh[j]  += hes[j];
+    hes[j]  = hh[j];
+  }
+  ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
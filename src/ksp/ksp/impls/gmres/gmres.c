@@ -29,6 +29,7 @@
  */
 
 #include <../src/ksp/ksp/impls/gmres/gmresimpl.h>       /*I  "petscksp.h"  I*/
+#include <petscblaslapack.h>
 #define GMRES_DELTA_DIRECTIONS 10
 #define GMRES_DEFAULT_MAXK     30
 static PetscErrorCode KSPGMRESUpdateHessenberg(KSP,PetscInt,PetscBool,PetscReal*);
@@ -263,6 +264,286 @@ PetscErrorCode KSPSolve_GMRES(KSP ksp)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_USE_COMPLEX)
+#define KSPGMRES_BLOCK_TRANS "C"
+#else
+#define KSPGMRES_BLOCK_TRANS "T"
+#endif
+
+/*
+   KSPGMRESBlockOrthogonalize_Private - orthonormalizes the block of s vectors Vb stored after the first n
+   orthonormal columns of V, with the local parts of all columns stored contiguously with leading dimension m.
+
+   The projection coefficients and the Gram matrix of Vb are computed with a single reduction, and Vb is
+   then orthonormalized with a Cholesky factorization of its Gram matrix.  As in
+   KSPGMRESClassicalGramSchmidtOrthogonalization(), a second pass is done depending on the
+   KSPGMRESCGSRefinementType, and always when the Cholesky factorization fails or is ill-conditioned.  On output, rows 0 to n+s-1 of H
+   hold the coefficients of the original Vb in the new basis.
+
+   work must have room for 3(n+s)s+2s^2 scalars and dwork for s reals.
+*/
+static PetscErrorCode KSPGMRESBlockOrthogonalize_Private(KSP ksp,PetscInt m,PetscInt n,PetscInt s,PetscScalar *V,PetscScalar *H,PetscInt ldh,PetscScalar *work,PetscReal *dwork,PetscBool *breakdown)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  PetscScalar    *Vb = V+n*m,*lbuf = work,*C = lbuf+(n+s)*s,*S = C+(n+s)*s,*R1 = S+s*s,*T = R1+s*s,one = 1.0,mone = -1.0,zero = 0.0;
+  PetscReal      ratio,dmin,dmax,tol = 1.0/PetscSqrtReal(PETSC_SQRT_MACHINE_EPSILON);
+  PetscInt       i,j,pass;
+  PetscBLASInt   bm,bldv,bn,bs,bns,bldh,info;
+  PetscBool      normalized = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *breakdown = PETSC_FALSE;
+  ierr = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(PetscMax(m,1),&bldv);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(n+s,&bns);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldh,&bldh);CHKERRQ(ierr);
+  for (pass=0; pass<2; pass++) {
+    /* C <- [V Vb]'Vb with a single reduction */
+    if (m) {
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&bns,&bs,&bm,&one,V,&bldv,Vb,&bldv,&zero,lbuf,&bns));
+    } else {
+      ierr = PetscArrayzero(lbuf,(n+s)*s);CHKERRQ(ierr);
+    }
+    ierr = MPIU_Allreduce(lbuf,C,(n+s)*s,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ksp));CHKERRQ(ierr);
+    for (j=0; j<s; j++) {
+      for (i=0; i<s; i++) S[i+j*s] = C[n+i+j*(n+s)];
+      dwork[j] = PetscRealPart(S[j*(s+1)]);
+    }
+    if (n) {
+      /* S <- S - C'C is the Gram matrix of Vb - VC */
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&bs,&bs,&bn,&mone,C,&bns,C,&bns,&one,S,&bs));
+      if (m) PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&bm,&bs,&bn,&mone,V,&bldv,C,&bns,&one,Vb,&bldv));
+      if (normalized) {
+        PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&bn,&bs,&bs,&one,C,&bns,R1,&bs,&one,H,&bldh));
+      } else {
+        for (j=0; j<s; j++) for (i=0; i<n; i++) H[i+j*ldh] += C[i+j*(n+s)];
+      }
+    }
+    ratio = 1.0;
+    for (j=0; j<s; j++) if (dwork[j] > 0.0) ratio = PetscMin(ratio,PetscRealPart(S[j*(s+1)])/dwork[j]);
+    PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&bs,S,&bs,&info));
+    for (j=0; j<s; j++) for (i=j+1; i<s; i++) S[i+j*s] = 0.0;
+    dmin = PETSC_MAX_REAL;
+    dmax = 0.0;
+    if (!info) {
+      for (j=0; j<s; j++) {
+        dmin = PetscMin(dmin,PetscAbsScalar(S[j*(s+1)]));
+        dmax = PetscMax(dmax,PetscAbsScalar(S[j*(s+1)]));
+      }
+      if (dmin == 0.0) info = 1;
+    }
+    if (!info && m) PetscStackCallBLAS("BLAStrsm",BLAStrsm_("R","U","N","N",&bm,&bs,&one,S,&bs,Vb,&bldv));
+    ierr = PetscLogFlops(2.0*(n+s)*s*m+4.0*n*s*s+2.0*n*s*m+s*s*m);CHKERRQ(ierr);
+    if (!pass) {
+      if (info) {
+        ierr = PetscInfo1(ksp,"Reorthogonalizing block %D since the Cholesky factorization failed\n",n/s);CHKERRQ(ierr);
+      } else if (dmax > tol*dmin) {
+        ierr = PetscInfo1(ksp,"Reorthogonalizing block %D since the Cholesky factorization is ill-conditioned\n",n/s);CHKERRQ(ierr);
+      } else if (n && (gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS || (gmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED && ratio < 0.5))) {
+        ierr = PetscInfo2(ksp,"Reorthogonalizing block %D (cancellation ratio %g)\n",n/s,(double)ratio);CHKERRQ(ierr);
+      } else break;
+      if (!info) {
+        ierr = PetscArraycpy(R1,S,s*s);CHKERRQ(ierr);
+        normalized = PETSC_TRUE;
+      }
+    } else {
+      if (info) {
+        *breakdown = PETSC_TRUE;
+        PetscFunctionReturn(0);
+      }
+      if (normalized) {
+        PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&bs,&bs,&bs,&one,S,&bs,R1,&bs,&zero,T,&bs));
+        ierr = PetscArraycpy(S,T,s*s);CHKERRQ(ierr);
+      }
+    }
+  }
+  for (j=0; j<s; j++) for (i=0; i<s; i++) H[n+i+j*ldh] = S[i+j*s];
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPMatSolve_GMRES - block GMRES for a block of s right-hand sides stored in a MATDENSE.  Each iteration
+   applies the operator to a block of s basis vectors with a single MatMatMult() and orthogonalizes it with
+   one reduction (two when reorthogonalization is needed), and the block Hessenberg matrix is reduced to
+   triangular form with Householder reflections.  The restart is the number of blocks in the basis, and the
+   residual norm reported to the monitors and to the convergence test is the largest of the column norms.
+   When the residuals are rank deficient, e.g., because a column is zero or a combination of the others, the
+   Cholesky QR breaks down and the columns are solved one by one with KSPSolve() from the current iterates.
+*/
+static PetscErrorCode KSPMatSolve_GMRES(KSP ksp,Mat B,Mat X)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  Mat            Amat,*Vmat,T,U = NULL,W = NULL;
+  PetscScalar    *V,*H,*G,*tau,*work,*qwork,*t,one = 1.0,zero = 0.0;
+  PetscReal      *dwork,dp,nrm;
+  PetscInt       i,j,c,nb,k = gmres->max_k,m,M,s,ldh,ldt,lqwork;
+  PetscBLASInt   bm,bldv,bs,b2s,bnbs,bldh,bldt,blq,info;
+  PetscBool      diagonalscale,breakdown = PETSC_FALSE,deficient = PETSC_FALSE,first = PETSC_TRUE,guess_zero = ksp->guess_zero;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+  if (ksp->transpose_solve) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support transpose solves with a block of right-hand sides",((PetscObject)ksp)->type_name);
+  if (ksp->pc_side == PC_SYMMETRIC) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support symmetric preconditioning with a block of right-hand sides",((PetscObject)ksp)->type_name);
+  ierr   = PCGetOperators(ksp->pc,&Amat,NULL);CHKERRQ(ierr);
+  ierr   = MatGetLocalSize(B,&m,NULL);CHKERRQ(ierr);
+  ierr   = MatGetSize(B,&M,&s);CHKERRQ(ierr);
+  ldh    = (k+1)*s;
+  lqwork = ldh*s;
+  ierr   = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
+  ierr   = PetscBLASIntCast(PetscMax(m,1),&bldv);CHKERRQ(ierr);
+  ierr   = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr   = PetscBLASIntCast(2*s,&b2s);CHKERRQ(ierr);
+  ierr   = PetscBLASIntCast(ldh,&bldh);CHKERRQ(ierr);
+  ierr   = PetscBLASIntCast(lqwork,&blq);CHKERRQ(ierr);
+  ierr   = PetscMalloc7(m*ldh,&V,ldh*k*s,&H,ldh*s,&G,k*s,&tau,3*ldh*s+2*s*s,&work,lqwork,&qwork,s,&dwork);CHKERRQ(ierr);
+  ierr   = PetscMalloc1(k+1,&Vmat);CHKERRQ(ierr);
+  for (j=0; j<=k; j++) {
+    ierr = MatCreateDense(PetscObjectComm((PetscObject)B),m,PETSC_DECIDE,M,s,V+j*m*s,Vmat+j);CHKERRQ(ierr);
+  }
+  ierr = MatDuplicate(Vmat[0],MAT_DO_NOT_COPY_VALUES,&T);CHKERRQ(ierr);
+
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  if (guess_zero) {
+    ierr = MatZeroEntries(X);CHKERRQ(ierr);
+  }
+  while (!ksp->reason) {
+    /* V_0 <- B - AX for right preconditioning, M(B - AX) for left preconditioning */
+    if (guess_zero && first) {
+      ierr = MatCopy(B,T,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    } else {
+      ierr = MatMatMult(Amat,X,W ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W);CHKERRQ(ierr);
+      ierr = MatCopy(B,T,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      ierr = MatAXPY(T,-1.0,W,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    }
+    first = PETSC_FALSE;
+    /* the right-hand sides are not available to the default convergence test, so the initial residual norm is always used as reference */
+    ksp->guess_zero = PETSC_TRUE;
+    if (ksp->pc_side == PC_RIGHT) {
+      ierr = MatCopy(T,Vmat[0],SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    } else {
+      ierr = KSP_PCMatApply(ksp,T,Vmat[0]);CHKERRQ(ierr);
+    }
+    /* V_0 G_0 <- V_0, so that the columns of G_0 have the norms of the residuals */
+    ierr = PetscArrayzero(G,ldh*s);CHKERRQ(ierr);
+    ierr = KSPGMRESBlockOrthogonalize_Private(ksp,m,0,s,V,G,ldh,work,dwork,&breakdown);CHKERRQ(ierr);
+    if (breakdown) {
+      deficient = PETSC_TRUE;
+      ierr = PetscInfo(ksp,"Breakdown due to rank deficient residuals\n");CHKERRQ(ierr);
+      break;
+    }
+    dp = 0.0;
+    for (c=0; c<s; c++) {
+      nrm = 0.0;
+      for (i=0; i<=c; i++) nrm += PetscRealPart(G[i+c*ldh]*PetscConj(G[i+c*ldh]));
+      dp = PetscMax(dp,PetscSqrtReal(nrm));
+    }
+    ksp->rnorm = dp;
+    ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+    ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+    for (nb=0; nb<k && !ksp->reason; nb++) {
+      if (ksp->its >= ksp->max_it) {
+        ksp->reason = KSP_DIVERGED_ITS;
+        break;
+      }
+      /* V_{nb+1} <- AMV_{nb} or MAV_{nb} */
+      if (ksp->pc_side == PC_RIGHT) {
+        ierr = KSP_PCMatApply(ksp,Vmat[nb],T);CHKERRQ(ierr);
+        ierr = MatMatMult(Amat,T,U ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,&U);CHKERRQ(ierr);
+        ierr = MatCopy(U,Vmat[nb+1],SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      } else {
+        ierr = MatCopy(Vmat[nb],T,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+        ierr = MatMatMult(Amat,T,U ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,&U);CHKERRQ(ierr);
+        ierr = KSP_PCMatApply(ksp,U,Vmat[nb+1]);CHKERRQ(ierr);
+      }
+      ierr = PetscArrayzero(H+nb*s*ldh,ldh*s);CHKERRQ(ierr);
+      ierr = KSPGMRESBlockOrthogonalize_Private(ksp,m,(nb+1)*s,s,V,H+nb*s*ldh,ldh,work,dwork,&breakdown);CHKERRQ(ierr);
+      if (breakdown) {
+        ierr = PetscInfo1(ksp,"Breakdown due to rank deficient block %D of the Krylov basis\n",nb+1);CHKERRQ(ierr);
+        break;
+      }
+      /* apply the previous reflections to the new block column of the Hessenberg matrix, and triangularize it */
+      for (j=0; j<nb; j++) {
+        PetscStackCallBLAS("LAPACKormqr",LAPACKormqr_("L",KSPGMRES_BLOCK_TRANS,&b2s,&bs,&bs,H+j*s+j*s*ldh,&bldh,tau+j*s,H+j*s+nb*s*ldh,&bldh,qwork,&blq,&info));
+        if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+      }
+      PetscStackCallBLAS("LAPACKgeqrf",LAPACKgeqrf_(&b2s,&bs,H+nb*s+nb*s*ldh,&bldh,tau+nb*s,qwork,&blq,&info));
+      if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+      PetscStackCallBLAS("LAPACKormqr",LAPACKormqr_("L",KSPGMRES_BLOCK_TRANS,&b2s,&bs,&bs,H+nb*s+nb*s*ldh,&bldh,tau+nb*s,G+nb*s,&bldh,qwork,&blq,&info));
+      if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+      for (c=0; c<s; c++) {
+        if (PetscAbsScalar(H[nb*s+c+(nb*s+c)*ldh]) == 0.0) breakdown = PETSC_TRUE;
+      }
+      if (breakdown) {
+        ierr = PetscInfo1(ksp,"Breakdown due to a singular block %D of the Hessenberg matrix\n",nb);CHKERRQ(ierr);
+        break;
+      }
+      /* the residual norms are the norms of the columns of the last block of G */
+      dp = 0.0;
+      for (c=0; c<s; c++) {
+        nrm = 0.0;
+        for (i=0; i<s; i++) nrm += PetscRealPart(G[(nb+1)*s+i+c*ldh]*PetscConj(G[(nb+1)*s+i+c*ldh]));
+        dp = PetscMax(dp,PetscSqrtReal(nrm));
+      }
+      ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->its++;
+      ksp->rnorm = dp;
+      ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+    }
+
+    /* X <- X + V_{0:nb} Y or X + MV_{0:nb} Y, with Y the solution of the triangular least-squares problem */
+    if (nb) {
+      ierr = PetscBLASIntCast(nb*s,&bnbs);CHKERRQ(ierr);
+      PetscStackCallBLAS("BLAStrsm",BLAStrsm_("L","U","N","N",&bnbs,&bs,&one,H,&bldh,G,&bldh));
+      if (m) {
+        ierr = MatDenseGetLDA(T,&ldt);CHKERRQ(ierr);
+        ierr = PetscBLASIntCast(ldt,&bldt);CHKERRQ(ierr);
+        ierr = MatDenseGetArray(T,&t);CHKERRQ(ierr);
+        PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&bm,&bs,&bnbs,&one,V,&bldv,G,&bldh,&zero,t,&bldt));
+        ierr = MatDenseRestoreArray(T,&t);CHKERRQ(ierr);
+      }
+      ierr = PetscLogFlops(1.0*nb*s*nb*s*s+2.0*m*nb*s*s);CHKERRQ(ierr);
+      if (ksp->pc_side == PC_RIGHT) {
+        ierr = KSP_PCMatApply(ksp,T,U);CHKERRQ(ierr);
+        ierr = MatAXPY(X,1.0,U,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      } else {
+        ierr = MatAXPY(X,1.0,T,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      }
+    }
+    /* after a breakdown, the next cycle restarts from the current residuals unless no progress was made */
+    if (breakdown && !nb && !ksp->reason) {
+      deficient = PETSC_TRUE;
+      break;
+    }
+    breakdown = PETSC_FALSE;
+  }
+  ksp->guess_zero = guess_zero;
+  for (j=0; j<=k; j++) {
+    ierr = MatDestroy(Vmat+j);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(Vmat);CHKERRQ(ierr);
+  ierr = PetscFree7(V,H,G,tau,work,qwork,dwork);CHKERRQ(ierr);
+  ierr = MatDestroy(&T);CHKERRQ(ierr);
+  ierr = MatDestroy(&U);CHKERRQ(ierr);
+  ierr = MatDestroy(&W);CHKERRQ(ierr);
+  if (deficient) {
+    ierr = KSPMatSolveColumns_Private(ksp,B,X);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode KSPReset_GMRES(KSP ksp)
 {
   KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
@@ -513,6 +794,8 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
     default:
       SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Unknown orthogonalization");
     }
+  } else if (gmres->orthog == KSPGMRESClassicalGramSchmidtFusedOrthogonalization) {
+    cstr = "Classical (unmodified) Gram-Schmidt Orthogonalization with one step of iterative refinement, fused passes";
   } else if (gmres->orthog == KSPGMRESModifiedGramSchmidtOrthogonalization) {
     cstr = "Modified Gram-Schmidt Orthogonalization";
   } else {
@@ -587,6 +870,8 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetPreAllocateVectors(ksp);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupBegin("-ksp_gmres_classicalgramschmidt","Classical (unmodified) Gram-Schmidt (fast)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsBoolGroup("-ksp_gmres_fusedgramschmidt","Classical Gram-Schmidt with refinement, fusing the two passes (fast,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtFusedOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
@@ -838,6 +1123,7 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
                              vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_fusedgramschmidt - use classical Gram-Schmidt with one step of refinement, computed with fewer passes over the Krylov space
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
@@ -876,6 +1162,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
   ksp->ops->buildsolution                = KSPBuildSolution_GMRES;
   ksp->ops->setup                        = KSPSetUp_GMRES;
   ksp->ops->solve                        = KSPSolve_GMRES;
+  ksp->ops->matsolve                     = KSPMatSolve_GMRES;
   ksp->ops->reset                        = KSPReset_GMRES;
   ksp->ops->destroy                      = KSPDestroy_GMRES;
   ksp->ops->view                         = KSPView_GMRES;
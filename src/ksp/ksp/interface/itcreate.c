@@ -686,6 +686,7 @@ PetscErrorCode  KSPCreate(MPI_Comm comm,KSP *inksp)
   ierr = PetscHeaderCreate(ksp,KSP_CLASSID,"KSP","Krylov Method","KSP",comm,KSPDestroy,KSPView);CHKERRQ(ierr);
 
   ksp->max_it  = 10000;
+  ksp->nmax    = PETSC_DECIDE;
   ksp->pc_side = ksp->pc_side_set = PC_SIDE_DEFAULT;
   ksp->rtol    = 1.e-5;
 #if defined(PETSC_USE_REAL_SINGLE)
@@ -917,6 +917,39 @@ PetscErrorCode KSPSolveTranspose(KSP ksp,Vec b,Vec x)
   PetscFunctionReturn(0);
 }
 
+/*
+   KSPMatSolveColumns_Private - solves for the columns of a block of right-hand sides one at a time with KSPSolve(), starting from the
+   current block of solutions.  The block methods fall back to it when the block Krylov basis becomes rank deficient, e.g., when a
+   right-hand side is zero or a linear combination of the others, since the block factorizations cannot deflate such columns.
+   On output, ksp->its includes the iterations of all the solves, and ksp->reason is the first reason of divergence if any.
+*/
+PetscErrorCode KSPMatSolveColumns_Private(KSP ksp, Mat B, Mat X)
+{
+  Vec                b, x;
+  PetscInt           n, N, its = ksp->its;
+  PetscBool          guess_zero = ksp->guess_zero;
+  KSPConvergedReason reason = KSP_CONVERGED_ITERATING;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(B, NULL, &N);CHKERRQ(ierr);
+  ierr = PetscInfo2(ksp, "KSP type %s solving the %D columns one by one from the current iterates\n", ((PetscObject)ksp)->type_name, N);CHKERRQ(ierr);
+  ksp->guess_zero = PETSC_FALSE;
+  for (n = 0; n < N; ++n) {
+    ierr = MatDenseGetColumnVecRead(B, n, &b);CHKERRQ(ierr);
+    ierr = MatDenseGetColumnVec(X, n, &x);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp, b, x);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVec(X, n, &x);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(B, n, &b);CHKERRQ(ierr);
+    its += ksp->its;
+    if (!reason || (reason > 0 && ksp->reason < 0)) reason = ksp->reason;
+  }
+  ksp->guess_zero = guess_zero;
+  ksp->its        = its;
+  ksp->reason     = reason;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPViewFinalMatResidual_Internal(KSP ksp, Mat B, Mat X, PetscViewer viewer, PetscViewerFormat format, PetscInt shift)
 {
   Mat            A, R;
@@ -963,9 +996,15 @@ static PetscErrorCode KSPViewFinalMatResidual_Internal(KSP ksp, Mat B, Mat X, Pe
    Notes:
      This is a stripped-down version of KSPSolve(), which only handles -ksp_view, -ksp_converged_reason, and -ksp_view_final_residual.
 
+     KSPCG, KSPGMRES, and KSPHPDDM iterate on blocks of columns, so that the operator is applied with MatMatMult() and the inner products of all the columns of a block are computed with a single reduction.
+     KSPPREONLY and KSPCHEBYSHEV apply the preconditioner to the whole block with PCMatApply().
+     The other Krylov methods call KSPSolve() on each column.  With KSPCG and KSPGMRES, the residual norm passed to the monitors and to the convergence test is the largest norm of the columns of the block, and the relative tolerance is
+     always applied to the norm of the initial residuals.  When the block of residuals or of search directions becomes rank deficient, e.g., because a right-hand side is zero or a
+     linear combination of the others, KSPCG and KSPGMRES finish the solve by calling KSPSolve() on each column, starting from the current iterates.
+
    Level: intermediate
 
-.seealso:  KSPSolve(), MatMatSolve(), MATDENSE, KSPHPDDM, PCBJACOBI, PCASM
+.seealso:  KSPSolve(), MatMatSolve(), KSPSetMatSolveBlockSize(), MATDENSE, KSPCG, KSPGMRES, KSPHPDDM, PCBJACOBI, PCASM
 @*/
 PetscErrorCode KSPMatSolve(KSP ksp, Mat B, Mat X)
 {
@@ -1064,6 +1103,7 @@ PetscErrorCode KSPSetMatSolveBlockSize(KSP ksp, PetscInt bs)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
   PetscValidLogicalCollectiveInt(ksp, bs, 2);
+  ksp->nmax = bs;
   ierr = PetscTryMethod(ksp, "KSPSetMatSolveBlockSize_C", (KSP, PetscInt), (ksp, bs));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1087,7 +1127,7 @@ PetscErrorCode KSPGetMatSolveBlockSize(KSP ksp, PetscInt *bs)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
-  *bs = PETSC_DECIDE;
+  *bs = ksp->nmax;
   ierr = PetscTryMethod(ksp, "KSPGetMatSolveBlockSize_C", (KSP, PetscInt*), (ksp, bs));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
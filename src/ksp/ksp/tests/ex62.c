@@ -0,0 +1,141 @@
+static char help[] = "Tests KSPMatSolve() with the native block methods of KSPCG and KSPGMRES against KSPSolve() column by column.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B,X,Y,R;
+  KSP            ksp;
+  Vec            b,y;
+  PetscRandom    rand;
+  PetscReal      *rnorm,*bnorm,*enorm,*ynorm,rtol = 1.e-8;
+  PetscInt       m = 12,n = 10,N = 6,i,j,Ii,J,Istart,Iend;
+  PetscScalar    v,conv = 0.0,*array;
+  PetscInt       lda;
+  PetscBool      nonzero = PETSC_FALSE,deficient = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrhs",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetScalar(NULL,NULL,"-convection",&conv,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-nonzero_guess",&nonzero,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-rank_deficient",&deficient,NULL);CHKERRQ(ierr);
+
+  /* a 5-point Laplacian on an m x n grid, with an optional first-order convection term */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,m*n,m*n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (Ii=Istart; Ii<Iend; Ii++) {
+    v = -1.0; i = Ii/n; j = Ii - i*n;
+    if (i>0)   {J = Ii - n; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);}
+    if (i<m-1) {J = Ii + n; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);}
+    if (j<n-1) {J = Ii + 1; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);}
+    v = -1.0 - conv;
+    if (j>0)   {J = Ii - 1; ierr = MatSetValues(A,1,&Ii,1,&J,&v,ADD_VALUES);CHKERRQ(ierr);}
+    v = 4.0 + conv; ierr = MatSetValues(A,1,&Ii,1,&Ii,&v,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateDense(PETSC_COMM_WORLD,Iend-Istart,PETSC_DECIDE,m*n,N,NULL,&B);CHKERRQ(ierr);
+  ierr = MatDuplicate(B,MAT_DO_NOT_COPY_VALUES,&X);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+  if (deficient && N > 2) {
+    /* the second right-hand side is zero and the third one is twice the first one */
+    ierr = MatDenseGetLDA(B,&lda);CHKERRQ(ierr);
+    ierr = MatDenseGetArray(B,&array);CHKERRQ(ierr);
+    for (i=0; i<Iend-Istart; i++) {
+      array[i+lda]   = 0.0;
+      array[i+2*lda] = 2.0*array[i];
+    }
+    ierr = MatDenseRestoreArray(B,&array);CHKERRQ(ierr);
+  }
+  if (nonzero) {
+    ierr = MatSetRandom(X,rand);CHKERRQ(ierr);
+  }
+  ierr = MatDuplicate(X,MAT_COPY_VALUES,&Y);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,rtol,PETSC_DEFAULT,PETSC_DEFAULT,500);CHKERRQ(ierr);
+  ierr = KSPSetInitialGuessNonzero(ksp,nonzero);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPMatSolve(ksp,B,X);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    ierr = MatDenseGetColumnVecRead(B,i,&b);CHKERRQ(ierr);
+    ierr = MatDenseGetColumnVecWrite(Y,i,&y);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,y);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecWrite(Y,i,&y);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(B,i,&b);CHKERRQ(ierr);
+  }
+
+  /* both solutions must have small residuals and agree to the accuracy of the solves */
+  ierr = PetscMalloc4(N,&rnorm,N,&bnorm,N,&enorm,N,&ynorm);CHKERRQ(ierr);
+  ierr = MatMatMult(A,X,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&R);CHKERRQ(ierr);
+  ierr = MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatGetColumnNorms(R,NORM_2,rnorm);CHKERRQ(ierr);
+  ierr = MatGetColumnNorms(B,NORM_2,bnorm);CHKERRQ(ierr);
+  ierr = MatGetColumnNorms(Y,NORM_2,ynorm);CHKERRQ(ierr);
+  ierr = MatAXPY(Y,-1.0,X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatGetColumnNorms(Y,NORM_2,enorm);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    if (rnorm[i] > 1.e3*rtol*bnorm[i]) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Column %D: relative residual norm of KSPMatSolve() %g\n",i,(double)(rnorm[i]/bnorm[i]));CHKERRQ(ierr);
+    }
+    if (enorm[i] > 1.e4*rtol*ynorm[i]) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Column %D: KSPMatSolve() and KSPSolve() differ by %g\n",i,(double)(enorm[i]/ynorm[i]));CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree4(rnorm,bnorm,enorm,ynorm);CHKERRQ(ierr);
+
+  ierr = MatDestroy(&R);CHKERRQ(ierr);
+  ierr = MatDestroy(&Y);CHKERRQ(ierr);
+  ierr = MatDestroy(&X);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/ex62_1.out
+      nsize: {{1 2}}
+      args: -ksp_type cg -pc_type jacobi
+      test:
+         suffix: cg
+         args: -ksp_norm_type {{preconditioned unpreconditioned natural}}
+      test:
+         suffix: cg_block_size
+         args: -ksp_matsolve_block_size 4 -nonzero_guess
+      test:
+         suffix: cg_bjacobi
+         args: -pc_type bjacobi -sub_pc_type icc
+      test:
+         suffix: cg_rank_deficient
+         args: -rank_deficient
+
+   testset:
+      output_file: output/ex62_1.out
+      nsize: {{1 2}}
+      args: -ksp_type gmres -convection 0.5 -pc_type bjacobi
+      test:
+         suffix: gmres
+         args: -ksp_pc_side {{left right}} -ksp_gmres_restart 5
+      test:
+         suffix: gmres_block_size
+         args: -ksp_matsolve_block_size 4 -nonzero_guess -ksp_pc_side right
+      test:
+         suffix: gmres_rank_deficient
+         args: -rank_deficient -ksp_pc_side {{left right}}
+
+TEST*/
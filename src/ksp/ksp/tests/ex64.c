@@ -0,0 +1,157 @@
+static char help[] = "Tests PCMatApply() against PCApply() column by column, and KSPMatSolve() with a multigrid preconditioner.\n\n";
+
+#include <petscdmda.h>
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  DM             da;
+  Mat            A,B,B1,X,X1,Y,R;
+  KSP            ksp;
+  PC             pc;
+  Vec            b,b1,y;
+  PetscRandom    rand;
+  MatStencil     row,col[5];
+  PetscScalar    v[5];
+  PetscReal      *norms,*ynorms,rtol = 1.e-8;
+  PetscInt       N = 5,i,j,k,xs,ys,xm,ym,Mx,My,m,M;
+  PetscBool      solve = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrhs",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-solve",&solve,NULL);CHKERRQ(ierr);
+
+  /* a 5-point Laplacian on a grid that can be coarsened twice, so that PCMG can get its hierarchy from the DM */
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,17,17,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&A);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(da,NULL,&Mx,&My,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,NULL,&xm,&ym,NULL);CHKERRQ(ierr);
+  for (j=ys; j<ys+ym; j++) {
+    for (i=xs; i<xs+xm; i++) {
+      row.i = i; row.j = j; k = 0;
+      if (i > 0)    {col[k].i = i-1; col[k].j = j; v[k++] = -1.0;}
+      if (i < Mx-1) {col[k].i = i+1; col[k].j = j; v[k++] = -1.0;}
+      if (j > 0)    {col[k].i = i; col[k].j = j-1; v[k++] = -1.0;}
+      if (j < My-1) {col[k].i = i; col[k].j = j+1; v[k++] = -1.0;}
+      col[k].i = i; col[k].j = j; v[k++] = 4.0;
+      ierr = MatSetValuesStencil(A,1,&row,k,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(A,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatCreateDense(PETSC_COMM_WORLD,m,PETSC_DECIDE,M,N,NULL,&B);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+  ierr = MatDuplicate(B,MAT_DO_NOT_COPY_VALUES,&X);CHKERRQ(ierr);
+  ierr = MatDuplicate(B,MAT_DO_NOT_COPY_VALUES,&Y);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetDM(ksp,da);CHKERRQ(ierr);
+  ierr = KSPSetDMActive(ksp,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,rtol,PETSC_DEFAULT,PETSC_DEFAULT,100);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSetUp(ksp);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PetscMalloc2(N,&norms,N,&ynorms);CHKERRQ(ierr);
+
+  if (!solve) {
+    /* a first block of one column, so that the work storage kept by some factors has to grow for the next one */
+    ierr = MatCreateDense(PETSC_COMM_WORLD,m,PETSC_DECIDE,M,1,NULL,&B1);CHKERRQ(ierr);
+    ierr = MatDenseGetColumnVecRead(B,0,&b);CHKERRQ(ierr);
+    ierr = MatDenseGetColumnVecWrite(B1,0,&b1);CHKERRQ(ierr);
+    ierr = VecCopy(b,b1);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecWrite(B1,0,&b1);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(B,0,&b);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(B1,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B1,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatDuplicate(B1,MAT_DO_NOT_COPY_VALUES,&X1);CHKERRQ(ierr);
+    ierr = PCMatApply(pc,B1,X1);CHKERRQ(ierr);
+    ierr = MatDestroy(&X1);CHKERRQ(ierr);
+    ierr = MatDestroy(&B1);CHKERRQ(ierr);
+    /* the block application must agree with the column by column one up to roundoff */
+    ierr = PCMatApply(pc,B,X);CHKERRQ(ierr);
+    for (i=0; i<N; i++) {
+      ierr = MatDenseGetColumnVecRead(B,i,&b);CHKERRQ(ierr);
+      ierr = MatDenseGetColumnVecWrite(Y,i,&y);CHKERRQ(ierr);
+      ierr = PCApply(pc,b,y);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecWrite(Y,i,&y);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecRead(B,i,&b);CHKERRQ(ierr);
+    }
+    ierr = MatGetColumnNorms(Y,NORM_2,ynorms);CHKERRQ(ierr);
+    ierr = MatAXPY(Y,-1.0,X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatGetColumnNorms(Y,NORM_2,norms);CHKERRQ(ierr);
+    for (i=0; i<N; i++) {
+      if (norms[i] > 1.e-10*ynorms[i]) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"Column %D: PCMatApply() and PCApply() differ by %g\n",i,(double)(norms[i]/ynorms[i]));CHKERRQ(ierr);
+      }
+    }
+  } else {
+    ierr = KSPMatSolve(ksp,B,X);CHKERRQ(ierr);
+    ierr = MatMatMult(A,X,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&R);CHKERRQ(ierr);
+    ierr = MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatGetColumnNorms(R,NORM_2,norms);CHKERRQ(ierr);
+    ierr = MatGetColumnNorms(B,NORM_2,ynorms);CHKERRQ(ierr);
+    for (i=0; i<N; i++) {
+      if (norms[i] > 1.e3*rtol*ynorms[i]) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"Column %D: relative residual norm of KSPMatSolve() %g\n",i,(double)(norms[i]/ynorms[i]));CHKERRQ(ierr);
+      }
+    }
+    ierr = MatDestroy(&R);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(norms,ynorms);CHKERRQ(ierr);
+
+  ierr = MatDestroy(&Y);CHKERRQ(ierr);
+  ierr = MatDestroy(&X);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/ex64_1.out
+      nsize: {{1 2}}
+      args: -ksp_type preonly
+      test:
+         suffix: jacobi
+         args: -pc_type jacobi
+      test:
+         suffix: bjacobi
+         args: -pc_type bjacobi -sub_pc_type {{ilu icc}}
+      test:
+         suffix: mg
+         args: -pc_type mg -pc_mg_levels 3 -pc_mg_galerkin -pc_mg_cycle_type {{v w}} -mg_levels_ksp_max_it 3 -mg_levels_pc_type {{jacobi sor}}
+      test:
+         suffix: mg_additive
+         args: -pc_type mg -pc_mg_levels 3 -pc_mg_galerkin -pc_mg_type additive
+
+   testset:
+      output_file: output/ex64_1.out
+      args: -ksp_type preonly
+      test:
+         suffix: factor
+         args: -pc_type {{lu ilu icc cholesky}} -pc_factor_mat_ordering_type {{natural rcm}}
+      test:
+         suffix: ilu_levels
+         args: -pc_type ilu -pc_factor_levels 1
+
+   test:
+      suffix: cg_mg
+      output_file: output/ex64_1.out
+      nsize: {{1 2}}
+      args: -solve -ksp_type cg -pc_type mg -pc_mg_levels 3 -pc_mg_galerkin -mg_levels_ksp_norm_type {{none unpreconditioned}}
+
+TEST*/
@@ -224,10 +224,73 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: fused
+      nsize: 2
+      output_file: output/ex2_2.out
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_fusedgramschmidt
+
+   test:
+      suffix: sf_pipeline
+      nsize: 2
+      output_file: output/ex2_2.out
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -vecscatter_type sf -sf_basic_pipeline
+
+   test:
+      suffix: fused_fgmres
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_type fgmres -ksp_gmres_fusedgramschmidt
+
+   test:
+      suffix: level_solve
+      output_file: output/ex2_1.out
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -pc_factor_level_scheduled_solve
+
+   test:
+      suffix: level_solve_icc
+      nsize: 2
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type cg -sub_pc_type icc -sub_pc_factor_levels 1 -sub_pc_factor_mat_ordering_type rcm -sub_pc_factor_level_scheduled_solve
+
+   test:
+      suffix: level_solve_omp
+      nsize: 2
+      requires: openmp
+      output_file: output/ex2_level_solve_icc.out
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type cg -sub_pc_type icc -sub_pc_factor_levels 1 -sub_pc_factor_mat_ordering_type rcm -sub_pc_factor_level_scheduled_solve -omp_num_threads 3
+
+   test:
+      suffix: chowpatel
+      args: -ksp_monitor_short -m 9 -n 9 -pc_type ilu -pc_factor_chowpatel_sweeps 3 -pc_factor_chowpatel_solve_sweeps 3 -ksp_view
+
+   test:
+      suffix: chowpatel_omp
+      requires: openmp
+      output_file: output/ex2_chowpatel.out
+      args: -ksp_monitor_short -m 9 -n 9 -pc_type ilu -pc_factor_chowpatel_sweeps 3 -pc_factor_chowpatel_solve_sweeps 3 -ksp_view -omp_num_threads 4
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: aijdelta
+      output_file: output/ex2_3.out
+      args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -mat_type aijdelta
+
+   test:
+      suffix: aijdelta_mpi
+      nsize: 2
+      requires: !complex
+      args: -pc_type sor -pc_sor_local_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -mat_type aijdelta -mat_aijdelta_single
+
+   test:
+      suffix: autotune
+      output_file: output/ex2_1.out
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_autotune
+
+   test:
+      suffix: autotune_sell
+      args: -ksp_monitor_short -pc_type jacobi -ksp_gmres_cgs_refinement_type refine_always -mat_autotune -mat_autotune_types seqsell -mat_autotune_trials 1 -mat_view ::ascii_info
+
    test:
       suffix: 4
       args: -pc_type eisenstat -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
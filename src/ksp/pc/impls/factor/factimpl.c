@@ -173,6 +173,15 @@ PetscErrorCode  PCFactorSetPivotInBlocks_Factor(PC pc,PetscBool pivot)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode  PCFactorSetLevelScheduledSolve_Factor(PC pc,PetscBool flg)
+{
+  PC_Factor *dir = (PC_Factor*)pc->data;
+
+  PetscFunctionBegin;
+  dir->info.levelsolve = flg ? 1.0 : 0.0;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  PCFactorGetMatrix_Factor(PC pc,Mat *mat)
 {
   PC_Factor *ilu = (PC_Factor*)pc->data;
@@ -253,6 +262,11 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
     ierr = PCFactorSetPivotInBlocks(pc,flg);CHKERRQ(ierr);
   }
 
+  ierr = PetscOptionsBool("-pc_factor_level_scheduled_solve","Solve with the factors one level of independent rows at a time, in parallel with OpenMP","PCFactorSetLevelScheduledSolve",((PC_Factor*)factor)->info.levelsolve ? PETSC_TRUE : PETSC_FALSE,&flg,&set);CHKERRQ(ierr);
+  if (set) {
+    ierr = PCFactorSetLevelScheduledSolve(pc,flg);CHKERRQ(ierr);
+  }
+
   ierr = PetscOptionsBool("-pc_factor_reuse_fill","Use fill from previous factorization","PCFactorSetReuseFill",PETSC_FALSE,&flg,&set);CHKERRQ(ierr);
   if (set) {
     ierr = PCFactorSetReuseFill(pc,flg);CHKERRQ(ierr);
@@ -296,6 +310,7 @@ PetscErrorCode PCView_Factor(PC pc,PetscViewer viewer)
 
     if (factor->reusefill)     {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing fill from past factorization\n");CHKERRQ(ierr);}
     if (factor->reuseordering) {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing reordering from past factorization\n");CHKERRQ(ierr);}
+    if (factor->info.levelsolve) {ierr = PetscViewerASCIIPrintf(viewer,"  level-scheduled triangular solves\n");CHKERRQ(ierr);}
     if (factor->factortype == MAT_FACTOR_ILU || factor->factortype == MAT_FACTOR_ICC) {
       if (factor->info.dt > 0) {
         ierr = PetscViewerASCIIPrintf(viewer,"  drop tolerance %g\n",(double)factor->info.dt);CHKERRQ(ierr);
@@ -306,6 +321,9 @@ PetscErrorCode PCView_Factor(PC pc,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"  %D levels of fill\n",(PetscInt)factor->info.levels);CHKERRQ(ierr);
       }
+      if (factor->info.sweeps > 0) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Chow-Patel iterative factorization with %D sweeps, %D Jacobi sweeps in the triangular solves\n",(PetscInt)factor->info.sweeps,(PetscInt)factor->info.solvesweeps);CHKERRQ(ierr);
+      }
     }
 
     ierr = PetscViewerASCIIPrintf(viewer,"  tolerance for zero pivot %g\n",(double)factor->info.zeropivot);CHKERRQ(ierr);
@@ -178,6 +178,52 @@ PetscErrorCode  PCFactorSetDropTolerance(PC pc,PetscReal dt,PetscReal dtcol,Pets
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCFactorSetChowPatelSweeps - The preconditioner will compute the ILU factors with the fine-grained iterative
+   algorithm of Chow and Patel, and optionally approximate the triangular solves with Jacobi sweeps
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+.  sweeps - the number of fixed-point sweeps computing the factors, 0 for the standard ILU factorization
+-  solvesweeps - the number of Jacobi sweeps in each triangular solve, 0 for exact triangular solves
+
+   Options Database Keys:
++  -pc_factor_chowpatel_sweeps <sweeps> - Sets the number of sweeps of the factorization
+-  -pc_factor_chowpatel_solve_sweeps <solvesweeps> - Sets the number of sweeps of the triangular solves
+
+   Notes:
+   Each sweep updates all the nonzeros of the factors, with the sparsity pattern of ILU(k), from their values in the
+   previous sweep, so the nonzeros are computed concurrently by the OpenMP threads when PETSc is configured with OpenMP.
+   A few sweeps usually give factors that are as good a preconditioner as the standard ILU(k) factors, and so do a
+   few Jacobi sweeps of the triangular solves, which are also computed concurrently. The Jacobi sweeps can also be
+   used with the standard factors, by setting sweeps to 0 and solvesweeps to a positive number.
+
+   Only implemented for the out of place ILU(k) of SeqAIJ matrices with the PETSc solver, and the factorization
+   does not support shifts, see PCFactorSetShiftType().
+
+   Level: intermediate
+
+   References:
+.  1. - E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput., 37, 2015.
+
+.seealso: PCILU, PCFactorSetLevels(), PCFactorSetLevelScheduledSolve()
+@*/
+PetscErrorCode  PCFactorSetChowPatelSweeps(PC pc,PetscInt sweeps,PetscInt solvesweeps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,sweeps,2);
+  PetscValidLogicalCollectiveInt(pc,solvesweeps,3);
+  if (sweeps < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of sweeps %D cannot be negative",sweeps);
+  if (solvesweeps < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of solve sweeps %D cannot be negative",solvesweeps);
+  ierr = PetscTryMethod(pc,"PCFactorSetChowPatelSweeps_C",(PC,PetscInt,PetscInt),(pc,sweeps,solvesweeps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCFactorGetZeroPivot - Gets the tolerance used to define a zero privot
 
@@ -644,6 +690,41 @@ PetscErrorCode  PCFactorSetPivotInBlocks(PC pc,PetscBool pivot)
   PetscFunctionReturn(0);
 }
 
+/*@
+    PCFactorSetLevelScheduledSolve - Determines if the triangular solves with the factors are done one level at a time,
+      where a level is a set of rows that only depend on rows of earlier levels
+
+    Logically Collective on PC
+
+    Input Parameters:
++   pc - the preconditioner context
+-   flg - PETSC_TRUE or PETSC_FALSE
+
+    Options Database Key:
+.   -pc_factor_level_scheduled_solve <true,false>
+
+    Notes:
+    The level schedules of the factors are computed during the numeric factorization. The rows of each level are
+    solved concurrently by the OpenMP threads, so this only pays off when PETSc is configured with OpenMP and the
+    factors have few levels compared to their number of rows, for example with ILU(0) or ICC(0) of a stencil matrix.
+
+    Only implemented for SeqAIJ matrices, the option is ignored for other matrix types and solver packages.
+
+    Level: intermediate
+
+.seealso: PCILU, PCICC, PCLU, PCCHOLESKY, PCFactorSetLevels()
+@*/
+PetscErrorCode  PCFactorSetLevelScheduledSolve(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCFactorSetLevelScheduledSolve_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCFactorSetReuseFill - When matrices with different nonzero structure are factored,
    this causes later ones to use the fill ratio computed in the initial factorization.
@@ -701,6 +782,7 @@ PetscErrorCode PCFactorInitialize(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetAllowDiagonalFill_C",PCFactorSetAllowDiagonalFill_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorGetAllowDiagonalFill_C",PCFactorGetAllowDiagonalFill_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetPivotInBlocks_C",PCFactorSetPivotInBlocks_Factor);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetLevelScheduledSolve_C",PCFactorSetLevelScheduledSolve_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetUseInPlace_C",PCFactorSetUseInPlace_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorGetUseInPlace_C",PCFactorGetUseInPlace_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseOrdering_C",PCFactorSetReuseOrdering_Factor);CHKERRQ(ierr);
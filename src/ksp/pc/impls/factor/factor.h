@@ -35,6 +35,7 @@ PETSC_INTERN PetscErrorCode PCFactorSetLevels_Factor(PC,PetscInt);
 PETSC_INTERN PetscErrorCode PCFactorSetAllowDiagonalFill_Factor(PC,PetscBool);
 PETSC_INTERN PetscErrorCode PCFactorGetAllowDiagonalFill_Factor(PC,PetscBool*);
 PETSC_INTERN PetscErrorCode PCFactorSetPivotInBlocks_Factor(PC,PetscBool);
+PETSC_INTERN PetscErrorCode PCFactorSetLevelScheduledSolve_Factor(PC,PetscBool);
 PETSC_INTERN PetscErrorCode PCFactorSetMatSolverType_Factor(PC,MatSolverType);
 PETSC_INTERN PetscErrorCode PCFactorSetUpMatSolverType_Factor(PC);
 PETSC_INTERN PetscErrorCode PCFactorGetMatSolverType_Factor(PC,MatSolverType*);
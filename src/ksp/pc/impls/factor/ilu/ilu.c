@@ -42,10 +42,24 @@ PetscErrorCode  PCFactorSetDropTolerance_ILU(PC pc,PetscReal dt,PetscReal dtcol,
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode  PCFactorSetChowPatelSweeps_ILU(PC pc,PetscInt sweeps,PetscInt solvesweeps)
+{
+  PC_ILU *ilu = (PC_ILU*)pc->data;
+
+  PetscFunctionBegin;
+  if (pc->setupcalled && (((PC_Factor*)ilu)->info.sweeps > 0) != (sweeps > 0)) {
+    SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot switch to or from the Chow-Patel factorization after using PC");
+  }
+  ((PC_Factor*)ilu)->info.sweeps      = sweeps;
+  ((PC_Factor*)ilu)->info.solvesweeps = solvesweeps;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCSetFromOptions_ILU(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PetscErrorCode ierr;
   PetscInt       itmp;
+  PetscInt       sweeps,solvesweeps;
   PetscBool      flg,set;
   PC_ILU         *ilu = (PC_ILU*)pc->data;
   PetscReal      tol;
@@ -66,6 +80,14 @@ static PetscErrorCode PCSetFromOptions_ILU(PetscOptionItems *PetscOptionsObject,
     ierr = PCFactorReorderForNonzeroDiagonal(pc,tol);CHKERRQ(ierr);
   }
 
+  sweeps      = (PetscInt)((PC_Factor*)ilu)->info.sweeps;
+  solvesweeps = (PetscInt)((PC_Factor*)ilu)->info.solvesweeps;
+  ierr = PetscOptionsInt("-pc_factor_chowpatel_sweeps","Sweeps of the Chow-Patel iterative factorization","PCFactorSetChowPatelSweeps",sweeps,&sweeps,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_factor_chowpatel_solve_sweeps","Jacobi sweeps of the triangular solves with the ILU factors","PCFactorSetChowPatelSweeps",solvesweeps,&solvesweeps,&set);CHKERRQ(ierr);
+  if (flg || set) {
+    ierr = PCFactorSetChowPatelSweeps(pc,sweeps,solvesweeps);CHKERRQ(ierr);
+  }
+
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -92,6 +114,10 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
       }
     }
   }
+  if (((PC_Factor*)ilu)->info.sweeps > 0 || ((PC_Factor*)ilu)->info.solvesweeps > 0) {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)pc->pmat,MATSEQAIJ,&flg);CHKERRQ(ierr);
+    if (!flg || ilu->hdr.inplace || ((PC_Factor*)ilu)->info.usedt) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"The Chow-Patel factorization and the Jacobi triangular solves are only supported by the out of place ILU(k) of MATSEQAIJ");
+  }
 
   ierr = MatSetErrorIfFailure(pc->pmat,pc->erroriffailure);CHKERRQ(ierr);
   if (ilu->hdr.inplace) {
@@ -203,6 +229,16 @@ static PetscErrorCode PCApply_ILU(PC pc,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCMatApply_ILU(PC pc,Mat X,Mat Y)
+{
+  PC_ILU         *ilu = (PC_ILU*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMatSolve(((PC_Factor*)ilu)->fact,X,Y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCApplyTranspose_ILU(PC pc,Vec x,Vec y)
 {
   PC_ILU         *ilu = (PC_ILU*)pc->data;
@@ -246,9 +282,12 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
 .  -pc_factor_nonzeros_along_diagonal - reorder the matrix before factorization to remove zeros from the diagonal,
                                    this decreases the chance of getting a zero pivot
 .  -pc_factor_mat_ordering_type <natural,nd,1wd,rcm,qmd> - set the row/column ordering of the factored matrix
--  -pc_factor_pivot_in_blocks - for block ILU(k) factorization, i.e. with BAIJ matrices with block size larger
+.  -pc_factor_pivot_in_blocks - for block ILU(k) factorization, i.e. with BAIJ matrices with block size larger
                              than 1 the diagonal blocks are factored with partial pivoting (this increases the
                              stability of the ILU factorization
+.  -pc_factor_chowpatel_sweeps <s> - compute the factors with s sweeps of the Chow-Patel iterative algorithm, see PCFactorSetChowPatelSweeps()
+.  -pc_factor_chowpatel_solve_sweeps <s> - approximate the triangular solves with the Chow-Patel or the standard factors by s Jacobi sweeps
+-  -pc_factor_level_scheduled_solve - solve with the factors one level of independent rows at a time, see PCFactorSetLevelScheduledSolve()
 
    Level: beginner
 
@@ -277,7 +316,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
            PCFactorSetZeroPivot(), PCFactorSetShiftSetType(), PCFactorSetAmount(),
            PCFactorSetDropTolerance(),PCFactorSetFill(), PCFactorSetMatOrderingType(), PCFactorSetReuseOrdering(),
            PCFactorSetLevels(), PCFactorSetUseInPlace(), PCFactorSetAllowDiagonalFill(), PCFactorSetPivotInBlocks(),
-           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace()
+           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace(), PCFactorSetLevelScheduledSolve(), PCFactorSetChowPatelSweeps()
 
 M*/
 
@@ -304,6 +343,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ILU(PC pc)
   pc->ops->reset               = PCReset_ILU;
   pc->ops->destroy             = PCDestroy_ILU;
   pc->ops->apply               = PCApply_ILU;
+  pc->ops->matapply            = PCMatApply_ILU;
   pc->ops->applytranspose      = PCApplyTranspose_ILU;
   pc->ops->setup               = PCSetUp_ILU;
   pc->ops->setfromoptions      = PCSetFromOptions_ILU;
@@ -313,5 +353,6 @@ PETSC_EXTERN PetscErrorCode PCCreate_ILU(PC pc)
   pc->ops->applyrichardson     = NULL;
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetDropTolerance_C",PCFactorSetDropTolerance_ILU);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorReorderForNonzeroDiagonal_C",PCFactorReorderForNonzeroDiagonal_ILU);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetChowPatelSweeps_C",PCFactorSetChowPatelSweeps_ILU);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -272,6 +272,41 @@ static PetscErrorCode PCApply_Jacobi(PC pc,Vec x,Vec y)
   ierr = VecPointwiseMult(y,x,jac->diag);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*
+   PCMatApply_Jacobi - Scales each row of a block of vectors, in a single
+   pass over the dense storage.
+
+   Application Interface Routine: PCMatApply()
+ */
+static PetscErrorCode PCMatApply_Jacobi(PC pc,Mat X,Mat Y)
+{
+  PC_Jacobi         *jac = (PC_Jacobi*)pc->data;
+  const PetscScalar *x,*d;
+  PetscScalar       *y;
+  PetscInt          i,j,m,N,ldx,ldy;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!jac->diag) {
+    ierr = PCSetUp_Jacobi_NonSymmetric(pc);CHKERRQ(ierr);
+  }
+  ierr = MatGetLocalSize(X,&m,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(X,NULL,&N);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(X,&ldx);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(Y,&ldy);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayWrite(Y,&y);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(jac->diag,&d);CHKERRQ(ierr);
+  for (j=0; j<N; j++) {
+    for (i=0; i<m; i++) y[i+j*ldy] = x[i+j*ldx]*d[i];
+  }
+  ierr = VecRestoreArrayRead(jac->diag,&d);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArrayWrite(Y,&y);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(1.0*m*N);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 /* -------------------------------------------------------------------------- */
 /*
    PCApplySymmetricLeftOrRight_Jacobi - Applies the left or right part of a
@@ -416,6 +451,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_Jacobi(PC pc)
       not needed.
   */
   pc->ops->apply               = PCApply_Jacobi;
+  pc->ops->matapply            = PCMatApply_Jacobi;
   pc->ops->applytranspose      = PCApply_Jacobi;
   pc->ops->setup               = PCSetUp_Jacobi;
   pc->ops->reset               = PCReset_Jacobi;
@@ -58,6 +58,105 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
   PetscFunctionReturn(0);
 }
 
+/* block version of KSPCheckSolve(), a failed smoother marks the preconditioner as failed */
+static PetscErrorCode PCMGCheckMatSolve_Private(KSP ksp,PC pc)
+{
+  PetscErrorCode     ierr;
+  PCFailedReason     pcreason;
+  KSPConvergedReason reason;
+  PC                 subpc;
+
+  PetscFunctionBegin;
+  ierr = KSPGetPC(ksp,&subpc);CHKERRQ(ierr);
+  ierr = PCGetFailedReason(subpc,&pcreason);CHKERRQ(ierr);
+  ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+  if (pcreason || (reason < 0 && reason != KSP_DIVERGED_ITS)) {
+    if (pc->erroriffailure) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_NOT_CONVERGED,"Detected not converged in KSP inner solve: KSP reason %s PC reason %s",KSPConvergedReasons[reason],PCFailedReasons[pcreason]);
+    ierr = PetscInfo2(ksp,"Detected not converged in KSP inner solve: KSP reason %s PC reason %s\n",KSPConvergedReasons[reason],PCFailedReasons[pcreason]);CHKERRQ(ierr);
+    pc->failedreason = PC_SUBPC_ERROR;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* block version of MatRestrict(), the product *Y is created on the first call and reused afterwards */
+static PetscErrorCode PCMGMatRestrict_Private(Mat A,Mat X,Mat *Y)
+{
+  PetscErrorCode ierr;
+  PetscInt       N,Mx;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,NULL,&N);CHKERRQ(ierr);
+  ierr = MatGetSize(X,&Mx,NULL);CHKERRQ(ierr);
+  if (N == Mx) {
+    ierr = MatMatMult(A,X,*Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,Y);CHKERRQ(ierr);
+  } else {
+    ierr = MatTransposeMatMult(A,X,*Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,Y);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* block version of MatInterpolateAdd() with Y += A X, using the product *W as work space */
+static PetscErrorCode PCMGMatInterpolateAdd_Private(Mat A,Mat X,Mat *W,Mat Y)
+{
+  PetscErrorCode ierr;
+  PetscInt       M,My;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(Y,&My,NULL);CHKERRQ(ierr);
+  if (M == My) {
+    ierr = MatMatMult(A,X,*W ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,W);CHKERRQ(ierr);
+  } else {
+    ierr = MatTransposeMatMult(A,X,*W ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,W);CHKERRQ(ierr);
+  }
+  ierr = MatAXPY(Y,1.0,*W,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Multiplicative cycle on blocks of vectors, the smoothers are applied with KSPMatSolve() and the residuals,
+   restrictions, and interpolations are computed with MatMatMult(), so that each level operator is traversed
+   once per block instead of once per column
+*/
+static PetscErrorCode PCMGMCycleMat_Private(PC pc,PC_MG_Levels **mglevelsin)
+{
+  PC_MG_Levels   *mgc,*mglevels = *mglevelsin;
+  PetscErrorCode ierr;
+  PetscInt       cycles = (mglevels->level == 1) ? 1 : (PetscInt) mglevels->cycles;
+
+  PetscFunctionBegin;
+  if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  ierr = KSPMatSolve(mglevels->smoothd,mglevels->B,mglevels->X);CHKERRQ(ierr);  /* pre-smooth */
+  ierr = PCMGCheckMatSolve_Private(mglevels->smoothd,pc);CHKERRQ(ierr);
+  if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  if (mglevels->level) {  /* not the coarsest grid */
+    if (mglevels->eventresidual) {ierr = PetscLogEventBegin(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatMatMult(mglevels->A,mglevels->X,mglevels->R ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,PETSC_DEFAULT,&mglevels->R);CHKERRQ(ierr);
+    ierr = MatAYPX(mglevels->R,-1.0,mglevels->B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    if (mglevels->eventresidual) {ierr = PetscLogEventEnd(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+
+    mgc = *(mglevelsin - 1);
+    if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = PCMGMatRestrict_Private(mglevels->restrct,mglevels->R,&mgc->B);CHKERRQ(ierr);
+    if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (!mgc->X) {
+      ierr = MatDuplicate(mgc->B,MAT_DO_NOT_COPY_VALUES,&mgc->X);CHKERRQ(ierr);
+    }
+    ierr = MatZeroEntries(mgc->X);CHKERRQ(ierr);
+    while (cycles--) {
+      ierr = PCMGMCycleMat_Private(pc,mglevelsin-1);CHKERRQ(ierr);
+    }
+    if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = PCMGMatInterpolateAdd_Private(mglevels->interpolate,mgc->X,&mglevels->W,mglevels->X);CHKERRQ(ierr);
+    if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    ierr = KSPMatSolve(mglevels->smoothu,mglevels->B,mglevels->X);CHKERRQ(ierr);    /* post smooth */
+    ierr = PCMGCheckMatSolve_Private(mglevels->smoothu,pc);CHKERRQ(ierr);
+    if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCApplyRichardson_MG(PC pc,Vec b,Vec x,Vec w,PetscReal rtol,PetscReal abstol, PetscReal dtol,PetscInt its,PetscBool zeroguess,PetscInt *outits,PCRichardsonConvergedReason *reason)
 {
   PC_MG          *mg        = (PC_MG*)pc->data;
@@ -157,6 +256,10 @@ PetscErrorCode PCReset_MG(PC pc)
     ierr = VecDestroy(&mglevels[n-1]->b);CHKERRQ(ierr);
 
     for (i=0; i<n; i++) {
+      ierr = MatDestroy(&mglevels[i]->B);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->X);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->R);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->W);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i]->A);CHKERRQ(ierr);
       if (mglevels[i]->smoothd != mglevels[i]->smoothu) {
         ierr = KSPReset(mglevels[i]->smoothd);CHKERRQ(ierr);
@@ -394,6 +497,78 @@ static PetscErrorCode PCApply_MG(PC pc,Vec b,Vec x)
   PetscFunctionReturn(0);
 }
 
+/*
+   PCMatApply_MG - Runs multiplicative cycles on a block of vectors.
+
+  Note:
+  The other cycles, user-provided residual routines, and smoothers that change the right hand side
+  are applied column by column with PCApply_MG().
+*/
+static PetscErrorCode PCMatApply_MG(PC pc,Mat B,Mat X)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscErrorCode ierr;
+  PC             tpc;
+  PetscInt       levels = mglevels[0]->levels,i,N,Nl;
+  PetscBool      changeu,changed,block = PETSC_TRUE;
+  Vec            cb,cx;
+
+  PetscFunctionBegin;
+  ierr = KSPGetPC(mglevels[levels-1]->smoothd,&tpc);CHKERRQ(ierr);
+  ierr = PCPreSolveChangeRHS(tpc,&changed);CHKERRQ(ierr);
+  ierr = KSPGetPC(mglevels[levels-1]->smoothu,&tpc);CHKERRQ(ierr);
+  ierr = PCPreSolveChangeRHS(tpc,&changeu);CHKERRQ(ierr);
+  if (mg->am != PC_MG_MULTIPLICATIVE || changed || changeu) block = PETSC_FALSE;
+  for (i=1; i<levels; i++) {
+    if (mglevels[i]->residual != PCMGResidualDefault) block = PETSC_FALSE;
+  }
+  ierr = MatGetSize(B,NULL,&N);CHKERRQ(ierr);
+  if (!block) {
+    ierr = PetscInfo(pc,"Cycle type or residual routines not supported on blocks, applying column by column\n");CHKERRQ(ierr);
+    for (i=0; i<N; i++) {
+      ierr = MatDenseGetColumnVecRead(B,i,&cb);CHKERRQ(ierr);
+      ierr = MatDenseGetColumnVecWrite(X,i,&cx);CHKERRQ(ierr);
+      ierr = PCApply_MG(pc,cb,cx);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecWrite(X,i,&cx);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecRead(B,i,&cb);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+
+  if (mg->stageApply) {ierr = PetscLogStagePush(mg->stageApply);CHKERRQ(ierr);}
+  for (i=0; i<levels; i++) {
+    if (!mglevels[i]->A) {
+      ierr = KSPGetOperators(mglevels[i]->smoothu,&mglevels[i]->A,NULL);CHKERRQ(ierr);
+      ierr = PetscObjectReference((PetscObject)mglevels[i]->A);CHKERRQ(ierr);
+    }
+  }
+  /* the work blocks are kept between applications with the same number of columns */
+  if (mglevels[levels-1]->X) {
+    ierr = MatGetSize(mglevels[levels-1]->X,NULL,&Nl);CHKERRQ(ierr);
+    if (Nl != N) {
+      for (i=0; i<levels; i++) {
+        ierr = MatDestroy(&mglevels[i]->B);CHKERRQ(ierr);
+        ierr = MatDestroy(&mglevels[i]->X);CHKERRQ(ierr);
+        ierr = MatDestroy(&mglevels[i]->R);CHKERRQ(ierr);
+        ierr = MatDestroy(&mglevels[i]->W);CHKERRQ(ierr);
+      }
+    }
+  }
+  if (!mglevels[levels-1]->X) {
+    ierr = MatDuplicate(X,MAT_DO_NOT_COPY_VALUES,&mglevels[levels-1]->X);CHKERRQ(ierr);
+  }
+  mglevels[levels-1]->B = B;
+  ierr = MatZeroEntries(mglevels[levels-1]->X);CHKERRQ(ierr);
+  for (i=0; i<mg->cyclesperpcapply; i++) {
+    ierr = PCMGMCycleMat_Private(pc,mglevels+levels-1);CHKERRQ(ierr);
+  }
+  mglevels[levels-1]->B = NULL;
+  ierr = MatCopy(mglevels[levels-1]->X,X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  if (mg->stageApply) {ierr = PetscLogStagePop();CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 
 PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
 {
@@ -612,6 +787,13 @@ PetscErrorCode PCSetUp_MG(PC pc)
       mglevels = mg->levels;
     }
   }
+  /* the blocks used by PCMatApply() are recreated with the sizes of the new hierarchy */
+  for (i=0; i<n; i++) {
+    ierr = MatDestroy(&mglevels[i]->B);CHKERRQ(ierr);
+    ierr = MatDestroy(&mglevels[i]->X);CHKERRQ(ierr);
+    ierr = MatDestroy(&mglevels[i]->R);CHKERRQ(ierr);
+    ierr = MatDestroy(&mglevels[i]->W);CHKERRQ(ierr);
+  }
   ierr = KSPGetPC(mglevels[0]->smoothd,&cpc);CHKERRQ(ierr);
 
 
@@ -1315,6 +1497,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
   pc->useAmat = PETSC_TRUE;
 
   pc->ops->apply          = PCApply_MG;
+  pc->ops->matapply       = PCMatApply_MG;
   pc->ops->setup          = PCSetUp_MG;
   pc->ops->reset          = PCReset_MG;
   pc->ops->destroy        = PCDestroy_MG;
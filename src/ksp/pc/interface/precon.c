@@ -7,7 +7,7 @@
 
 /* Logging support */
 PetscClassId  PC_CLASSID;
-PetscLogEvent PC_SetUp, PC_SetUpOnBlocks, PC_Apply, PC_ApplyCoarse, PC_ApplyMultiple, PC_ApplySymmetricLeft;
+PetscLogEvent PC_SetUp, PC_SetUpOnBlocks, PC_Apply, PC_MatApply, PC_ApplyCoarse, PC_ApplyMultiple, PC_ApplySymmetricLeft;
 PetscLogEvent PC_ApplySymmetricRight, PC_ModifySubMatrices, PC_ApplyOnBlocks, PC_ApplyTransposeOnBlocks;
 PetscInt      PetscMGLevelId;
 
@@ -448,6 +448,71 @@ PetscErrorCode  PCApply(PC pc,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMatApply - Applies the preconditioner to multiple vectors stored as a MATDENSE. Like PCApply(), Y and X must be different matrices.
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  X - block of input vectors
+
+   Output Parameter:
+.  Y - block of output vectors
+
+   Notes:
+   Preconditioners that do not provide a block implementation are applied with PCApply() to each column of X.
+
+   Level: developer
+
+.seealso: PCApply(), KSPMatSolve()
+@*/
+PetscErrorCode PCMatApply(PC pc,Mat X,Mat Y)
+{
+  Mat            A;
+  Vec            cy,cx;
+  PetscInt       m1,M1,m2,M2,n1,N1,n2,N2,i;
+  PetscBool      match;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidHeaderSpecific(X,MAT_CLASSID,2);
+  PetscValidHeaderSpecific(Y,MAT_CLASSID,3);
+  PetscCheckSameComm(pc,1,X,2);
+  PetscCheckSameComm(pc,1,Y,3);
+  if (Y == X) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_IDN,"Y and X must be different matrices");
+  ierr = PCGetOperators(pc,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(A,&m1,NULL);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(Y,&m2,&n2);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&M1,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(Y,&M2,&N2);CHKERRQ(ierr);
+  if (m1 != m2 || M1 != M2) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Cannot use a block of input vectors with (m2,M2) = (%D,%D) for a preconditioner with (m1,M1) = (%D,%D)",m2,M2,m1,M1);
+  ierr = MatGetLocalSize(X,&m1,&n1);CHKERRQ(ierr);
+  ierr = MatGetSize(X,&M1,&N1);CHKERRQ(ierr);
+  if (m1 != m2 || M1 != M2 || n1 != n2 || N1 != N2) SETERRQ8(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Incompatible block of input vectors (m2,M2)x(n2,N2) = (%D,%D)x(%D,%D) and output vectors (m1,M1)x(n1,N1) = (%D,%D)x(%D,%D)",m2,M2,n2,N2,m1,M1,n1,N1);
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)Y,&match,MATSEQDENSE,MATMPIDENSE,"");CHKERRQ(ierr);
+  if (!match) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Provided block of output vectors not stored in a dense Mat");
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)X,&match,MATSEQDENSE,MATMPIDENSE,"");CHKERRQ(ierr);
+  if (!match) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Provided block of input vectors not stored in a dense Mat");
+  ierr = PCSetUp(pc);CHKERRQ(ierr);
+  if (pc->ops->matapply) {
+    ierr = PetscLogEventBegin(PC_MatApply,pc,X,Y,0);CHKERRQ(ierr);
+    ierr = (*pc->ops->matapply)(pc,X,Y);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(PC_MatApply,pc,X,Y,0);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo1(pc,"PC type %s applying column by column\n",((PetscObject)pc)->type_name);CHKERRQ(ierr);
+    for (i=0; i<N2; i++) {
+      ierr = MatDenseGetColumnVecRead(X,i,&cx);CHKERRQ(ierr);
+      ierr = MatDenseGetColumnVecWrite(Y,i,&cy);CHKERRQ(ierr);
+      ierr = PCApply(pc,cx,cy);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecWrite(Y,i,&cy);CHKERRQ(ierr);
+      ierr = MatDenseRestoreColumnVecRead(X,i,&cx);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCApplySymmetricLeft - Applies the left part of a symmetric preconditioner to a vector.
 
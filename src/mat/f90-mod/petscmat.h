@@ -140,6 +140,9 @@
       PetscEnum, parameter :: MAT_FACTORINFO_ZERO_PIVOT = 9
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_TYPE = 10
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_AMOUNT = 11
+      PetscEnum, parameter :: MAT_FACTORINFO_LEVEL_SOLVE = 12
+      PetscEnum, parameter :: MAT_FACTORINFO_SWEEPS = 13
+      PetscEnum, parameter :: MAT_FACTORINFO_SOLVE_SWEEPS = 14
 !
 !  Options for SOR and SSOR
 !  MatSorType may be bitwise ORd together, so do not change the numbers
@@ -434,6 +437,9 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_ZERO_PIVOT
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SHIFT_TYPE
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SHIFT_AMOUNT
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_LEVEL_SOLVE
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SWEEPS
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SOLVE_SWEEPS
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_FORWARD_SWEEP
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_BACKWARD_SWEEP
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_SYMMETRIC_SWEEP
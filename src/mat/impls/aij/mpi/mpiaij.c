@@ -19,7 +19,7 @@
 . -mat_type aij - sets the matrix type to "aij" during a call to MatSetFromOptions()
 
   Developer Notes:
-    Subclasses include MATAIJCUSP, MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
+    Subclasses include MATAIJCUSP, MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJDELTA, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
    enough exist.
 
   Level: beginner
@@ -1252,6 +1252,22 @@ PetscErrorCode MatScale_MPIAIJ(Mat A,PetscScalar aa)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree(aij->coo_sendperm);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->coo_sendbuf,aij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree4(aij->Ajmap1,aij->Aperm1,aij->Ajmap2,aij->Aperm2);CHKERRQ(ierr);
+  ierr = PetscFree4(aij->Bjmap1,aij->Bperm1,aij->Bjmap2,aij->Bperm2);CHKERRQ(ierr);
+  aij->coo_nsend = 0;
+  aij->coo_nrecv = 0;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -1276,6 +1292,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
 
   /* may be created by MatCreateMPIAIJSumSeqAIJSymbolic */
@@ -1288,6 +1305,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpibaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
@@ -1818,6 +1837,9 @@ PetscErrorCode MatSetOption_MPIAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_IGNORE_OFF_PROC_ENTRIES:
     a->donotstash = flg;
     break;
+  case MAT_USE_HASH_TABLE:
+    A->hash_assembly = flg;
+    break;
   /* Symmetry flags are handled directly by MatSetOption() and they don't affect preallocation */
   case MAT_SPD:
   case MAT_SYMMETRIC:
@@ -2164,12 +2186,158 @@ PetscErrorCode MatCopy_MPIAIJ(Mat A,Mat B,MatStructure str)
   PetscFunctionReturn(0);
 }
 
+/*
+   With MAT_USE_HASH_TABLE the values of the local rows, and those received from the stash at MAT_FLUSH_ASSEMBLY,
+   are inserted into A->hash_table until the first final assembly, which preallocates the exact number of nonzeros
+   of each row of the diagonal and off-diagonal parts and fills their rows in a single pass
+*/
+static PetscErrorCode MatSetValues_MPIAIJ_Hash(Mat mat,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode addv)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscBool      roworiented = aij->roworiented,ignorezeroentries = ((Mat_SeqAIJ*)aij->A->data)->ignorezeroentries,missing;
+  PetscInt       i,j,rstart = mat->rmap->rstart,rend = mat->rmap->rend;
+  PetscHashIJKey key;
+  PetscHashIter  it;
+  PetscScalar    value,old;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (im[i] < 0) continue;
+    if (PetscUnlikelyDebug(im[i] >= mat->rmap->N)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[i],mat->rmap->N-1);
+    if (im[i] >= rstart && im[i] < rend) {
+      key.i = im[i] - rstart;
+      for (j=0; j<n; j++) {
+        if (in[j] < 0) continue;
+        if (PetscUnlikelyDebug(in[j] >= mat->cmap->N)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",in[j],mat->cmap->N-1);
+        if (v) value = roworiented ? v[i*n+j] : v[i+j*m];
+        else   value = 0.0;
+        if (ignorezeroentries && value == 0.0 && (addv == ADD_VALUES) && im[i] != in[j]) continue;
+        key.j = in[j];
+        ierr  = PetscHMapIJVPut(mat->hash_table,key,&it,&missing);CHKERRQ(ierr);
+        if (!missing && addv == ADD_VALUES) {
+          ierr   = PetscHMapIJVIterGet(mat->hash_table,it,&old);CHKERRQ(ierr);
+          value += old;
+        }
+        ierr = PetscHMapIJVIterSet(mat->hash_table,it,value);CHKERRQ(ierr);
+      }
+    } else {
+      if (mat->nooffprocentries) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Setting off process row %D even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set",im[i]);
+      if (!aij->donotstash) {
+        mat->assembled = PETSC_FALSE;
+        if (roworiented) {
+          ierr = MatStashValuesRow_Private(&mat->stash,im[i],n,in,v+i*n,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        } else {
+          ierr = MatStashValuesCol_Private(&mat->stash,im[i],n,in,v+i,m,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatZeroEntries_MPIAIJ_Hash(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscHMapIJVClear(A->hash_table);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_MPIAIJ_Hash(Mat mat,MatAssemblyType mode)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a,*b;
+  PetscMPIInt    n;
+  PetscInt       i,j,k,rstart,ncols,flg,cstart = mat->cmap->rstart,cend = mat->cmap->rend,*row,*col,*dnz,*onz;
+  PetscHashIJKey key;
+  PetscHashIter  it;
+  PetscScalar    *val,value;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!aij->donotstash && !mat->nooffprocentries) {
+    while (1) {
+      ierr = MatStashScatterGetMesg_Private(&mat->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
+      if (!flg) break;
+
+      for (i=0; i<n; ) {
+        for (j=i,rstart=row[j]; j<n; j++) {
+          if (row[j] != rstart) break;
+        }
+        ncols = j-i;
+        ierr  = MatSetValues_MPIAIJ_Hash(mat,1,row+i,ncols,col+i,val+i,mat->insertmode);CHKERRQ(ierr);
+        i     = j;
+      }
+    }
+    ierr = MatStashScatterEnd_Private(&mat->stash);CHKERRQ(ierr);
+  }
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  ierr = PetscCalloc2(mat->rmap->n,&dnz,mat->rmap->n,&onz);CHKERRQ(ierr);
+  PetscHashIterBegin(mat->hash_table,it);
+  while (!PetscHashIterAtEnd(mat->hash_table,it)) {
+    PetscHashIterGetKey(mat->hash_table,it,key);
+    if (key.j >= cstart && key.j < cend) dnz[key.i]++;
+    else onz[key.i]++;
+    PetscHashIterNext(mat->hash_table,it);
+  }
+  ierr = PetscMemcpy(mat->ops,mat->hash_ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = PetscFree(mat->hash_ops);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(aij->A,0,dnz);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(aij->B,0,onz);CHKERRQ(ierr);
+  ierr = PetscFree2(dnz,onz);CHKERRQ(ierr);
+
+  /* the off-diagonal part keeps the global column indices until MatSetUpMultiply_MPIAIJ() */
+  a = (Mat_SeqAIJ*)aij->A->data;
+  b = (Mat_SeqAIJ*)aij->B->data;
+  PetscHashIterBegin(mat->hash_table,it);
+  while (!PetscHashIterAtEnd(mat->hash_table,it)) {
+    PetscHashIterGetKey(mat->hash_table,it,key);
+    PetscHashIterGetVal(mat->hash_table,it,value);
+    if (key.j >= cstart && key.j < cend) {
+      k       = a->i[key.i] + a->ilen[key.i]++;
+      a->j[k] = key.j - cstart;
+      a->a[k] = value;
+    } else {
+      k       = b->i[key.i] + b->ilen[key.i]++;
+      b->j[k] = key.j;
+      b->a[k] = value;
+    }
+    PetscHashIterNext(mat->hash_table,it);
+  }
+  for (i=0; i<mat->rmap->n; i++) {
+    ierr = PetscSortIntWithScalarArray(a->ilen[i],a->j+a->i[i],a->a+a->i[i]);CHKERRQ(ierr);
+    ierr = PetscSortIntWithScalarArray(b->ilen[i],b->j+b->i[i],b->a+b->i[i]);CHKERRQ(ierr);
+  }
+  a->nz = a->i[mat->rmap->n];
+  b->nz = b->i[mat->rmap->n];
+  aij->A->nonzerostate++;
+  aij->B->nonzerostate++;
+  ierr = PetscInfo2(mat,"Preallocated %D diagonal and %D off-diagonal nonzeros from the hash table\n",a->nz,b->nz);CHKERRQ(ierr);
+  ierr = PetscHMapIJVDestroy(&mat->hash_table);CHKERRQ(ierr);
+  ierr = (*mat->ops->assemblybegin)(mat,mode);CHKERRQ(ierr);
+  ierr = (*mat->ops->assemblyend)(mat,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetUp_MPIAIJ(Mat A)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  if (A->hash_assembly) {
+    ierr = MatMPIAIJSetPreallocation(A,0,NULL,0,NULL);CHKERRQ(ierr);
+    ierr = PetscHMapIJVCreate(&A->hash_table);CHKERRQ(ierr);
+    ierr = PetscNew(&A->hash_ops);CHKERRQ(ierr);
+    ierr = PetscMemcpy(A->hash_ops,A->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+    A->ops->setvalues   = MatSetValues_MPIAIJ_Hash;
+    A->ops->assemblyend = MatAssemblyEnd_MPIAIJ_Hash;
+    A->ops->zeroentries = MatZeroEntries_MPIAIJ_Hash;
+  } else {
+    ierr = MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -2535,6 +2703,7 @@ PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat
   if (flg) {
     ierr = MatMPIAIJSetUseScalableIncreaseOverlap(A,sc);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-mat_use_hash_table","Insert into a hash table instead of a preallocation until the first assembly","MatSetOption",A->hash_assembly,&A->hash_assembly,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -3818,6 +3987,199 @@ PetscErrorCode MatMPIAIJSetPreallocationCSR_MPIAIJ(Mat B,const PetscInt Ii[],con
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt coo_n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  MPI_Comm       comm;
+  PetscSF        sf;
+  PetscSFNode    *iremote;
+  PetscMPIInt    owner;
+  PetscInt       M,N,m,rstart,rend,cstart,cend,k,p,q,s,lo,hi,nsend,nrecv,nranks,nown,nv,nz,nzA,nzB,n1A,n2A,n1B,n2B;
+  PetscInt       *i,*j,*perm,*sendi,*sendj,*sendperm,*recvi,*recvj,*ranks,*counts,*offsets,*oi,*oj,*osrc,*Ii,*J,*jmap;
+  PetscInt       *Ajmap1,*Aperm1,*Ajmap2,*Aperm2,*Bjmap1,*Bperm1,*Bjmap2,*Bperm2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr   = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  M      = mat->rmap->N;
+  N      = mat->cmap->N;
+  m      = mat->rmap->n;
+  rstart = mat->rmap->rstart;
+  rend   = mat->rmap->rend;
+  cstart = mat->cmap->rstart;
+  cend   = mat->cmap->rend;
+
+  /* sort the entries by row; the locally owned rows are then in [lo,hi) and the ignored entries in [0,s) */
+  ierr = PetscMalloc3(coo_n,&i,coo_n,&j,coo_n,&perm);CHKERRQ(ierr);
+  for (k=0; k<coo_n; k++) {
+    if (coo_i[k] >= M) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has row index %D, must be less than %D",k,coo_i[k],M);
+    if (coo_j[k] >= N) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has column index %D, must be less than %D",k,coo_j[k],N);
+    i[k]    = coo_j[k] < 0 ? -1 : coo_i[k];
+    j[k]    = coo_j[k];
+    perm[k] = k;
+  }
+  ierr = PetscSortIntWithArrayPair(coo_n,i,j,perm);CHKERRQ(ierr);
+  for (s=0; s<coo_n && i[s] < 0; s++) ;
+  for (lo=s; lo<coo_n && i[lo] < rstart; lo++) ;
+  for (hi=lo; hi<coo_n && i[hi] < rend; hi++) ;
+
+  /* gather the off-process entries, which are sorted by owner, and count them per destination process */
+  nsend = (lo-s) + (coo_n-hi);
+  ierr  = PetscMalloc2(nsend,&sendi,nsend,&sendj);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(nsend,&sendperm);CHKERRQ(ierr);
+  ierr  = PetscMalloc3(nsend,&ranks,nsend,&counts,nsend,&offsets);CHKERRQ(ierr);
+  for (k=s,p=0; k<coo_n; k++) {
+    if (k == lo) k = hi;
+    if (k == coo_n) break;
+    sendi[p]    = i[k];
+    sendj[p]    = j[k];
+    sendperm[p] = perm[k];
+    p++;
+  }
+  for (k=0,nranks=0; k<nsend; k++) {
+    if (!nranks || sendi[k] >= mat->rmap->range[ranks[nranks-1]+1]) {
+      ierr = PetscLayoutFindOwner(mat->rmap,sendi[k],&owner);CHKERRQ(ierr);
+      ranks[nranks]    = owner;
+      counts[nranks++] = 0;
+    }
+    counts[nranks-1]++;
+  }
+
+  /* reserve a contiguous segment of the receive buffer of each destination process with an atomic fetch-and-add */
+  ierr = PetscMalloc1(nranks,&iremote);CHKERRQ(ierr);
+  for (q=0; q<nranks; q++) {
+    iremote[q].rank  = ranks[q];
+    iremote[q].index = 0;
+  }
+  ierr  = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr  = PetscSFSetGraph(sf,1,nranks,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr  = PetscSFSetUp(sf);CHKERRQ(ierr);
+  nrecv = 0;
+  ierr  = PetscSFFetchAndOpBegin(sf,MPIU_INT,&nrecv,counts,offsets,MPI_SUM);CHKERRQ(ierr);
+  ierr  = PetscSFFetchAndOpEnd(sf,MPIU_INT,&nrecv,counts,offsets,MPI_SUM);CHKERRQ(ierr);
+  ierr  = PetscSFDestroy(&sf);CHKERRQ(ierr);
+
+  /* build the star forest that moves each off-process entry to its slot at the owner, and send the indices once */
+  ierr = PetscMalloc1(nsend,&iremote);CHKERRQ(ierr);
+  for (q=0,k=0; q<nranks; q++) {
+    for (p=0; p<counts[q]; p++,k++) {
+      iremote[k].rank  = ranks[q];
+      iremote[k].index = offsets[q] + p;
+    }
+  }
+  ierr = PetscSFCreate(comm,&aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(aij->coo_sf,nrecv,nsend,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nrecv,&recvi,nrecv,&recvj);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(aij->coo_sf,MPIU_INT,sendi,recvi,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(aij->coo_sf,MPIU_INT,sendi,recvi,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(aij->coo_sf,MPIU_INT,sendj,recvj,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(aij->coo_sf,MPIU_INT,sendj,recvj,MPIU_REPLACE);CHKERRQ(ierr);
+
+  /* merge the local and received entries; received entries are tagged with negative sources */
+  nown = (hi-lo) + nrecv;
+  ierr = PetscMalloc3(nown,&oi,nown,&oj,nown,&osrc);CHKERRQ(ierr);
+  for (k=lo,p=0; k<hi; k++,p++) {
+    oi[p]   = i[k] - rstart;
+    oj[p]   = j[k];
+    osrc[p] = perm[k];
+  }
+  for (k=0; k<nrecv; k++,p++) {
+    oi[p]   = recvi[k] - rstart;
+    oj[p]   = recvj[k];
+    osrc[p] = -(k+1);
+  }
+  ierr = MatSeqAIJSortCOO_Private(m,nown,oi,oj,osrc,&nv,&nz,&Ii,&J,&jmap);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocationCSR(mat,Ii,J,NULL);CHKERRQ(ierr);
+
+  /* split the unique entries between the diagonal and off-diagonal blocks, whose nonzeros are stored in the same order */
+  n1A = n2A = n1B = n2B = nzA = nzB = 0;
+  for (k=0; k<nz; k++) {
+    PetscBool diag = (PetscBool)(cstart <= J[k] && J[k] < cend);
+    for (p=jmap[k]; p<jmap[k+1]; p++) {
+      if (osrc[p] >= 0) {if (diag) n1A++; else n1B++;}
+      else              {if (diag) n2A++; else n2B++;}
+    }
+    if (diag) nzA++;
+    else      nzB++;
+  }
+  ierr = PetscMalloc4(nzA+1,&Ajmap1,n1A,&Aperm1,nzA+1,&Ajmap2,n2A,&Aperm2);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nzB+1,&Bjmap1,n1B,&Bperm1,nzB+1,&Bjmap2,n2B,&Bperm2);CHKERRQ(ierr);
+  n1A  = n2A = n1B = n2B = nzA = nzB = 0;
+  Ajmap1[0] = Ajmap2[0] = Bjmap1[0] = Bjmap2[0] = 0;
+  for (k=0; k<nz; k++) {
+    if (cstart <= J[k] && J[k] < cend) {
+      for (p=jmap[k]; p<jmap[k+1]; p++) {
+        if (osrc[p] >= 0) Aperm1[n1A++] = osrc[p];
+        else              Aperm2[n2A++] = -osrc[p]-1;
+      }
+      nzA++;
+      Ajmap1[nzA] = n1A;
+      Ajmap2[nzA] = n2A;
+    } else {
+      for (p=jmap[k]; p<jmap[k+1]; p++) {
+        if (osrc[p] >= 0) Bperm1[n1B++] = osrc[p];
+        else              Bperm2[n2B++] = -osrc[p]-1;
+      }
+      nzB++;
+      Bjmap1[nzB] = n1B;
+      Bjmap2[nzB] = n2B;
+    }
+  }
+
+  aij->coo_nsend    = nsend;
+  aij->coo_nrecv    = nrecv;
+  aij->coo_sendperm = sendperm;
+  ierr = PetscMalloc2(nsend,&aij->coo_sendbuf,nrecv,&aij->coo_recvbuf);CHKERRQ(ierr);
+  aij->Ajmap1 = Ajmap1; aij->Aperm1 = Aperm1; aij->Ajmap2 = Ajmap2; aij->Aperm2 = Aperm2;
+  aij->Bjmap1 = Bjmap1; aij->Bperm1 = Bperm1; aij->Bjmap2 = Bjmap2; aij->Bperm2 = Bperm2;
+
+  ierr = PetscFree3(i,j,perm);CHKERRQ(ierr);
+  ierr = PetscFree2(sendi,sendj);CHKERRQ(ierr);
+  ierr = PetscFree3(ranks,counts,offsets);CHKERRQ(ierr);
+  ierr = PetscFree2(recvi,recvj);CHKERRQ(ierr);
+  ierr = PetscFree3(oi,oj,osrc);CHKERRQ(ierr);
+  ierr = PetscFree(Ii);CHKERRQ(ierr);
+  ierr = PetscFree(J);CHKERRQ(ierr);
+  ierr = PetscFree(jmap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat            A = aij->A,B = aij->B;
+  PetscInt       k,nzA = ((Mat_SeqAIJ*)A->data)->nz,nzB = ((Mat_SeqAIJ*)B->data)->nz;
+  PetscScalar    *Aa,*Ba;
+  PetscBool      nooffprocentries;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!aij->Ajmap1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() before MatSetValuesCOO()");
+  /* the off-process values travel while the local ones are summed */
+  for (k=0; k<aij->coo_nsend; k++) aij->coo_sendbuf[k] = v[aij->coo_sendperm[k]];
+  ierr = PetscSFReduceBegin(aij->coo_sf,MPIU_SCALAR,aij->coo_sendbuf,aij->coo_recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(B,&Ba);CHKERRQ(ierr);
+  MatSeqAIJSumCOO_Private(nzA,aij->Ajmap1,aij->Aperm1,v,imode,Aa);
+  MatSeqAIJSumCOO_Private(nzB,aij->Bjmap1,aij->Bperm1,v,imode,Ba);
+  ierr = PetscSFReduceEnd(aij->coo_sf,MPIU_SCALAR,aij->coo_sendbuf,aij->coo_recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  MatSeqAIJSumCOO_Private(nzA,aij->Ajmap2,aij->Aperm2,aij->coo_recvbuf,ADD_VALUES,Aa);
+  MatSeqAIJSumCOO_Private(nzB,aij->Bjmap2,aij->Bperm2,aij->coo_recvbuf,ADD_VALUES,Ba);
+  ierr = MatSeqAIJRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArray(B,&Ba);CHKERRQ(ierr);
+
+  nooffprocentries      = mat->nooffprocentries;
+  mat->nooffprocentries = PETSC_TRUE;
+  ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  mat->nooffprocentries = nooffprocentries;
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMPIAIJSetPreallocationCSR - Allocates memory for a sparse parallel matrix in AIJ format
    (the default parallel PETSc format).
@@ -5717,6 +6079,7 @@ PetscErrorCode MatGetCommunicationStructs(Mat A, Vec *lvec, PetscInt *colmap[],
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJDelta(Mat,MatType,MatReuse,Mat*);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat,MatType,MatReuse,Mat*);
 #endif
@@ -5871,9 +6234,12 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijsell_C",MatConvert_MPIAIJ_MPIAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijdelta_C",MatConvert_MPIAIJ_MPIAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijmkl_C",MatConvert_MPIAIJ_MPIAIJMKL);CHKERRQ(ierr);
 #endif
@@ -69,6 +69,14 @@ typedef struct {
   /* Used by MPICUSPARSE classes */
   void * spptr;
 
+  /* Used by MatSetValuesCOO(): the diagonal block values A->a[k] are the sum of v[Aperm1[p]] over Ajmap1[k] <= p < Ajmap1[k+1]
+     plus the sum of coo_recvbuf[Aperm2[p]] over Ajmap2[k] <= p < Ajmap2[k+1], and similarly for the off-diagonal block B */
+  PetscSF     coo_sf;              /* sends the values of off-process COO entries to their owners */
+  PetscInt    coo_nsend,coo_nrecv; /* number of COO entries sent to and received from other processes */
+  PetscInt    *coo_sendperm;       /* coo_sendbuf[k] = v[coo_sendperm[k]] */
+  PetscScalar *coo_sendbuf,*coo_recvbuf;
+  PetscInt    *Ajmap1,*Aperm1,*Ajmap2,*Aperm2;
+  PetscInt    *Bjmap1,*Bperm1,*Bjmap2,*Bperm2;
 } Mat_MPIAIJ;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
@@ -76,6 +84,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
 
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat,PetscInt,IS [],PetscInt);
@@ -1046,6 +1046,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
   if (A->was_assembled && A->ass_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
 
+  a->omp_nparts = 0;
   if (m) rmax = ailen[0]; /* determine row with most nonzeros */
   for (i=1; i<m; i++) {
     /* move each row back by the amount of empty slots (fshift) before it*/
@@ -1166,6 +1167,13 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  ierr = PetscFree4(a->omp_rows,a->omp_cprows,a->omp_nodes,a->omp_noderows);CHKERRQ(ierr);
+  ierr = MatSolveLevelDestroy_Private(&a->lsolve);CHKERRQ(ierr);
+  ierr = MatSolveLevelDestroy_Private(&a->usolve);CHKERRQ(ierr);
+  ierr = PetscFree(a->jacobi_work);CHKERRQ(ierr);
+  ierr = PetscFree(a->matsolve_work);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1184,6 +1192,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqsbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijperm_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijdelta_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatAutotune_C",NULL);CHKERRQ(ierr);
 
 #if defined(PETSC_HAVE_CUDA)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijcusparse_C",NULL);CHKERRQ(ierr);
@@ -1204,6 +1214,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_is_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_seqdense_seqaij_C",NULL);CHKERRQ(ierr);
@@ -1249,9 +1261,11 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
     break;
   case MAT_NEW_DIAGONALS:
   case MAT_IGNORE_OFF_PROC_ENTRIES:
-  case MAT_USE_HASH_TABLE:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
+  case MAT_USE_HASH_TABLE:
+    A->hash_assembly = flg;
+    break;
   case MAT_USE_INODES:
     /* Not an error because MatSetOption_SeqAIJ_Inode handles this one */
     break;
@@ -1259,8 +1273,9 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
     A->submat_singleis = flg;
     break;
   case MAT_SORTED_FULL:
-    if (flg) A->ops->setvalues = MatSetValues_SeqAIJ_SortedFull;
-    else     A->ops->setvalues = MatSetValues_SeqAIJ;
+    if (A->hash_table) A->hash_ops->setvalues = flg ? MatSetValues_SeqAIJ_SortedFull : MatSetValues_SeqAIJ;
+    else if (flg)      A->ops->setvalues      = MatSetValues_SeqAIJ_SortedFull;
+    else               A->ops->setvalues      = MatSetValues_SeqAIJ;
     break;
   default:
     SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"unknown option %d",op);
@@ -1362,6 +1377,79 @@ PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec xx,Vec yy)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+
+/* Splits n units, the nonzeros of unit k starting at ai[k], into nparts parts with about the same number of nonzeros */
+static void MatSeqAIJOMPSplit_Private(PetscInt n,const PetscInt ai[],PetscInt nparts,PetscInt part[])
+{
+  PetscInt   p,k = 0;
+  PetscInt64 nz = n ? ai[n] - ai[0] : 0;
+
+  part[0] = 0;
+  for (p=1; p<nparts; p++) {
+    while (k < n && (PetscInt64)(ai[k] - ai[0])*nparts < p*nz) k++;
+    part[p] = k;
+  }
+  part[nparts] = n;
+}
+
+/*
+   Computes one part per OpenMP thread of the rows, the compressed rows and the inodes of A. They are kept until the
+   next assembly that changes the nonzero structure, or until the number of threads changes.
+*/
+PetscErrorCode MatSeqAIJOMPSetUpPartition_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       nparts = omp_get_max_threads(),ncprows = a->compressedrow.use ? a->compressedrow.nrows : 0;
+  PetscInt       nnodes = a->inode.size ? a->inode.node_count : 0,i,*noderows,*nodei;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->omp_nparts == nparts && a->omp_cprows[nparts] == ncprows && a->omp_nodes[nparts] == nnodes) PetscFunctionReturn(0);
+  ierr = PetscFree4(a->omp_rows,a->omp_cprows,a->omp_nodes,a->omp_noderows);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nparts+1,&a->omp_rows,nparts+1,&a->omp_cprows,nparts+1,&a->omp_nodes,nparts+1,&a->omp_noderows);CHKERRQ(ierr);
+  MatSeqAIJOMPSplit_Private(A->rmap->n,a->i,nparts,a->omp_rows);
+  MatSeqAIJOMPSplit_Private(ncprows,a->compressedrow.i,nparts,a->omp_cprows);
+  ierr = PetscMalloc2(nnodes+1,&noderows,nnodes+1,&nodei);CHKERRQ(ierr);
+  noderows[0] = 0;
+  for (i=0; i<nnodes; i++) noderows[i+1] = noderows[i] + a->inode.size[i];
+  for (i=0; i<=nnodes; i++) nodei[i] = a->i[noderows[i]];
+  MatSeqAIJOMPSplit_Private(nnodes,nodei,nparts,a->omp_nodes);
+  for (i=0; i<=nparts; i++) a->omp_noderows[i] = noderows[a->omp_nodes[i]];
+  ierr = PetscFree2(noderows,nodei);CHKERRQ(ierr);
+  a->omp_nparts = nparts;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes z[r] = y[r] + A(r,:) x, with y = NULL for zero, in parallel over the parts; r = ridx[i] for the rows i of
+   each part when ridx[] is given, and r = i otherwise
+*/
+static void MatMultAdd_SeqAIJ_OpenMP_Private(PetscInt nparts,const PetscInt part[],const PetscInt ii[],const PetscInt ridx[],const PetscInt aj[],const MatScalar aa[],const PetscScalar x[],const PetscScalar y[],PetscScalar z[])
+{
+  PetscInt p;
+
+#pragma omp parallel for schedule(static,1)
+  for (p=0; p<nparts; p++) {
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscInt        i,r,n;
+    PetscScalar     sum;
+
+    for (i=part[p]; i<part[p+1]; i++) {
+      r   = ridx ? ridx[i] : i;
+      n   = ii[i+1] - ii[i];
+      idx = aj + ii[i];
+      v   = aa + ii[i];
+      sum = y ? y[r] : 0.0;
+      PetscSparseDensePlusDot(sum,x,v,idx,n);
+      z[r] = sum;
+    }
+  }
+}
+#endif
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
 
 PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
@@ -1385,6 +1473,17 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+  if (a->omp_nparts > 1) {
+    if (usecprow) {
+      ierr = PetscArrayzero(y,m);CHKERRQ(ierr);
+      MatMultAdd_SeqAIJ_OpenMP_Private(a->omp_nparts,a->omp_cprows,a->compressedrow.i,a->compressedrow.rindex,a->j,a->a,x,NULL,y);
+    } else {
+      MatMultAdd_SeqAIJ_OpenMP_Private(a->omp_nparts,a->omp_rows,ii,NULL,a->j,a->a,x,NULL,y);
+    }
+  } else
+#endif
   if (usecprow) { /* use compressed row format */
     ierr = PetscArrayzero(y,m);CHKERRQ(ierr);
     m    = a->compressedrow.nrows;
@@ -1536,6 +1635,19 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+  if (a->omp_nparts > 1) {
+    if (usecprow) {
+      if (zz != yy) {
+        ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+      }
+      MatMultAdd_SeqAIJ_OpenMP_Private(a->omp_nparts,a->omp_cprows,a->compressedrow.i,a->compressedrow.rindex,a->j,a->a,x,y,z);
+    } else {
+      MatMultAdd_SeqAIJ_OpenMP_Private(a->omp_nparts,a->omp_rows,a->i,NULL,a->j,a->a,x,y,z);
+    }
+  } else
+#endif
   if (usecprow) { /* use compressed row format */
     if (zz != yy) {
       ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
@@ -1706,11 +1818,10 @@ PetscErrorCode MatMissingDiagonal_SeqAIJ(Mat A,PetscBool  *missing,PetscInt *d)
 PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *diag)
 {
   PetscErrorCode  ierr;
-  PetscInt        n = A->rmap->n, i, ncnt = 0, *indx,j,bsizemax = 0,*v_pivots;
+  PetscInt        n = A->rmap->n, i, ncnt = 0, *indx,j,k,bsizemax = 0,*v_pivots;
   PetscBool       allowzeropivot,zeropivotdetected=PETSC_FALSE;
   const PetscReal shift = 0.0;
-  PetscInt        ipvt[5];
-  PetscScalar     work[25],*v_work;
+  PetscScalar     *v_work,*d;
 
   PetscFunctionBegin;
   allowzeropivot = PetscNot(A->erroriffailure);
@@ -1723,51 +1834,37 @@ PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A,PetscInt nblocks,cons
   if (bsizemax > 7) {
     ierr = PetscMalloc2(bsizemax,&v_work,bsizemax,&v_pivots);CHKERRQ(ierr);
   }
+  /* gather the blocks first, so that runs of blocks of the same small size are inverted several at a time */
   ncnt = 0;
-  for (i=0; i<nblocks; i++) {
+  for (i=0, d=diag; i<nblocks; i++) {
     for (j=0; j<bsizes[i]; j++) indx[j] = ncnt+j;
-    ierr    = MatGetValues(A,bsizes[i],indx,bsizes[i],indx,diag);CHKERRQ(ierr);
-    switch (bsizes[i]) {
-    case 1:
-      *diag = 1.0/(*diag);
-      break;
-    case 2:
-      ierr  = PetscKernel_A_gets_inverse_A_2(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_2(diag);CHKERRQ(ierr);
-      break;
-    case 3:
-      ierr  = PetscKernel_A_gets_inverse_A_3(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_3(diag);CHKERRQ(ierr);
-      break;
-    case 4:
-      ierr  = PetscKernel_A_gets_inverse_A_4(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_4(diag);CHKERRQ(ierr);
-      break;
-    case 5:
-      ierr  = PetscKernel_A_gets_inverse_A_5(diag,ipvt,work,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    ierr  = MatGetValues(A,bsizes[i],indx,bsizes[i],indx,d);CHKERRQ(ierr);
+    ncnt += bsizes[i];
+    d    += bsizes[i]*bsizes[i];
+  }
+  for (i=0; i<nblocks; i=k) {
+    for (k=i+1; k<nblocks && bsizes[k] == bsizes[i]; k++) ;
+    if (bsizes[i] >= 2 && bsizes[i] <= PETSC_KERNEL_BATCH_MAXBS) {
+      ierr = PetscKernel_A_gets_inverse_A_Batched(bsizes[i],k-i,diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
       if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_5(diag);CHKERRQ(ierr);
-      break;
-    case 6:
-      ierr  = PetscKernel_A_gets_inverse_A_6(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_6(diag);CHKERRQ(ierr);
-      break;
-    case 7:
-      ierr  = PetscKernel_A_gets_inverse_A_7(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_7(diag);CHKERRQ(ierr);
-      break;
-    default:
-      ierr  = PetscKernel_A_gets_inverse_A(bsizes[i],diag,v_pivots,v_work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_N(diag,bsizes[i]);CHKERRQ(ierr);
+      for (j=i; j<k; j++) {
+        ierr  = PetscKernel_A_gets_transpose_A_N(diag,bsizes[j]);CHKERRQ(ierr);
+        diag += bsizes[j]*bsizes[j];
+      }
+      continue;
+    }
+    for (j=i; j<k; j++) {
+      switch (bsizes[j]) {
+      case 1:
+        *diag = 1.0/(*diag);
+        break;
+      default:
+        ierr  = PetscKernel_A_gets_inverse_A(bsizes[j],diag,v_pivots,v_work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+        if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+        ierr  = PetscKernel_A_gets_transpose_A_N(diag,bsizes[j]);CHKERRQ(ierr);
+      }
+      diag += bsizes[j]*bsizes[j];
     }
-    ncnt   += bsizes[i];
-    diag += bsizes[i]*bsizes[i];
   }
   if (bsizemax > 7) {
     ierr = PetscFree2(v_work,v_pivots);CHKERRQ(ierr);
@@ -2914,12 +3011,125 @@ PetscErrorCode MatCopy_SeqAIJ(Mat A,Mat B,MatStructure str)
   PetscFunctionReturn(0);
 }
 
+/*
+   With MAT_USE_HASH_TABLE the values are inserted into A->hash_table until the first final assembly, which
+   preallocates the exact number of nonzeros of each row and fills the rows in a single pass
+*/
+static PetscErrorCode MatSetValues_SeqAIJ_Hash(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscHashIJKey key;
+  PetscHashIter  it;
+  PetscBool      missing;
+  PetscScalar    value,old;
+  PetscInt       i,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (im[i] < 0) continue;
+    if (PetscUnlikelyDebug(im[i] >= A->rmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[i],A->rmap->n-1);
+    key.i = im[i];
+    for (j=0; j<n; j++) {
+      if (in[j] < 0) continue;
+      if (PetscUnlikelyDebug(in[j] >= A->cmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",in[j],A->cmap->n-1);
+      if (v) value = a->roworiented ? v[i*n+j] : v[i+j*m];
+      else   value = 0.0;
+      if (value == 0.0 && a->ignorezeroentries && is == ADD_VALUES && im[i] != in[j]) continue;
+      key.j = in[j];
+      ierr  = PetscHMapIJVPut(A->hash_table,key,&it,&missing);CHKERRQ(ierr);
+      if (!missing && is == ADD_VALUES) {
+        ierr   = PetscHMapIJVIterGet(A->hash_table,it,&old);CHKERRQ(ierr);
+        value += old;
+      }
+      ierr = PetscHMapIJVIterSet(A->hash_table,it,value);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatZeroEntries_SeqAIJ_Hash(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscHMapIJVClear(A->hash_table);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJ_Hash(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscHashIJKey key;
+  PetscHashIter  it;
+  PetscScalar    value;
+  PetscInt       i,k,*nnz;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  ierr = PetscCalloc1(A->rmap->n,&nnz);CHKERRQ(ierr);
+  PetscHashIterBegin(A->hash_table,it);
+  while (!PetscHashIterAtEnd(A->hash_table,it)) {
+    PetscHashIterGetKey(A->hash_table,it,key);
+    nnz[key.i]++;
+    PetscHashIterNext(A->hash_table,it);
+  }
+  ierr = PetscMemcpy(A->ops,A->hash_ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = PetscFree(A->hash_ops);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,0,nnz);CHKERRQ(ierr);
+  ierr = PetscFree(nnz);CHKERRQ(ierr);
+
+  PetscHashIterBegin(A->hash_table,it);
+  while (!PetscHashIterAtEnd(A->hash_table,it)) {
+    PetscHashIterGetKey(A->hash_table,it,key);
+    PetscHashIterGetVal(A->hash_table,it,value);
+    k        = a->i[key.i] + a->ilen[key.i]++;
+    a->j[k]  = key.j;
+    if (a->a) a->a[k] = value;
+    PetscHashIterNext(A->hash_table,it);
+  }
+  for (i=0; i<A->rmap->n; i++) {
+    if (a->a) {ierr = PetscSortIntWithScalarArray(a->ilen[i],a->j+a->i[i],a->a+a->i[i]);CHKERRQ(ierr);}
+    else      {ierr = PetscSortInt(a->ilen[i],a->j+a->i[i]);CHKERRQ(ierr);}
+  }
+  a->nz = a->i[A->rmap->n];
+  A->nonzerostate++;
+  ierr = PetscInfo1(A,"Preallocated %D nonzeros from the hash table\n",a->nz);CHKERRQ(ierr);
+  ierr = PetscHMapIJVDestroy(&A->hash_table);CHKERRQ(ierr);
+  if (A->ops->assemblybegin) {ierr = (*A->ops->assemblybegin)(A,mode);CHKERRQ(ierr);}
+  ierr = (*A->ops->assemblyend)(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetUp_SeqAIJ(Mat A)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  if (A->hash_assembly) {
+    ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,0,NULL);CHKERRQ(ierr);
+    ierr = PetscHMapIJVCreate(&A->hash_table);CHKERRQ(ierr);
+    ierr = PetscNew(&A->hash_ops);CHKERRQ(ierr);
+    ierr = PetscMemcpy(A->hash_ops,A->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+    A->ops->setvalues     = MatSetValues_SeqAIJ_Hash;
+    A->ops->assemblybegin = NULL;
+    A->ops->assemblyend   = MatAssemblyEnd_SeqAIJ_Hash;
+    A->ops->zeroentries   = MatZeroEntries_SeqAIJ_Hash;
+  } else {
+    ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqAIJ options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_use_hash_table","Insert into a hash table instead of a preallocation until the first assembly","MatSetOption",A->hash_assembly,&A->hash_assembly,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -3205,8 +3415,8 @@ PetscErrorCode MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ*) A->data;
   PetscErrorCode  ierr;
-  PetscInt        i,bs = PetscAbs(A->rmap->bs),mbs = A->rmap->n/bs,ipvt[5],bs2 = bs*bs,*v_pivots,ij[7],*IJ,j;
-  MatScalar       *diag,work[25],*v_work;
+  PetscInt        i,bs = PetscAbs(A->rmap->bs),mbs = A->rmap->n/bs,bs2 = bs*bs,*v_pivots,ij[PETSC_KERNEL_BATCH_MAXBS],*IJ,j;
+  MatScalar       *diag,*v_work;
   const PetscReal shift = 0.0;
   PetscBool       allowzeropivot,zeropivotdetected=PETSC_FALSE;
 
@@ -3239,64 +3449,16 @@ PetscErrorCode MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
       diag[i] = (PetscScalar)1.0 / (diag[i] + shift);
     }
     break;
-  case 2:
-    for (i=0; i<mbs; i++) {
-      ij[0] = 2*i; ij[1] = 2*i + 1;
-      ierr  = MatGetValues(A,2,ij,2,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_2(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_2(diag);CHKERRQ(ierr);
-      diag += 4;
-    }
-    break;
-  case 3:
+  case 2: case 3: case 4: case 5: case 6: case 7: case 8:
+    /* gather the blocks, then invert them several at a time */
     for (i=0; i<mbs; i++) {
-      ij[0] = 3*i; ij[1] = 3*i + 1; ij[2] = 3*i + 2;
-      ierr  = MatGetValues(A,3,ij,3,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_3(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_3(diag);CHKERRQ(ierr);
-      diag += 9;
+      for (j=0; j<bs; j++) ij[j] = bs*i + j;
+      ierr = MatGetValues(A,bs,ij,bs,ij,diag+bs2*i);CHKERRQ(ierr);
     }
-    break;
-  case 4:
+    ierr = PetscKernel_A_gets_inverse_A_Batched(bs,mbs,diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
     for (i=0; i<mbs; i++) {
-      ij[0] = 4*i; ij[1] = 4*i + 1; ij[2] = 4*i + 2; ij[3] = 4*i + 3;
-      ierr  = MatGetValues(A,4,ij,4,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_4(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_4(diag);CHKERRQ(ierr);
-      diag += 16;
-    }
-    break;
-  case 5:
-    for (i=0; i<mbs; i++) {
-      ij[0] = 5*i; ij[1] = 5*i + 1; ij[2] = 5*i + 2; ij[3] = 5*i + 3; ij[4] = 5*i + 4;
-      ierr  = MatGetValues(A,5,ij,5,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_5(diag,ipvt,work,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_5(diag);CHKERRQ(ierr);
-      diag += 25;
-    }
-    break;
-  case 6:
-    for (i=0; i<mbs; i++) {
-      ij[0] = 6*i; ij[1] = 6*i + 1; ij[2] = 6*i + 2; ij[3] = 6*i + 3; ij[4] = 6*i + 4; ij[5] = 6*i + 5;
-      ierr  = MatGetValues(A,6,ij,6,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_6(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_6(diag);CHKERRQ(ierr);
-      diag += 36;
-    }
-    break;
-  case 7:
-    for (i=0; i<mbs; i++) {
-      ij[0] = 7*i; ij[1] = 7*i + 1; ij[2] = 7*i + 2; ij[3] = 7*i + 3; ij[4] = 7*i + 4; ij[5] = 7*i + 5; ij[5] = 7*i + 6;
-      ierr  = MatGetValues(A,7,ij,7,ij,diag);CHKERRQ(ierr);
-      ierr  = PetscKernel_A_gets_inverse_A_7(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      ierr  = PetscKernel_A_gets_transpose_A_7(diag);CHKERRQ(ierr);
-      diag += 49;
+      ierr = PetscKernel_A_gets_transpose_A_N(diag+bs2*i,bs);CHKERRQ(ierr);
     }
     break;
   default:
@@ -3445,7 +3607,7 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         0,
                                 /* 74*/ 0,
                                         MatFDColoringApply_AIJ,
-                                        0,
+                                        MatSetFromOptions_SeqAIJ,
                                         0,
                                         0,
                                 /* 79*/ MatFindZeroDiagonals_SeqAIJ,
@@ -3952,6 +4114,20 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
     for (i=1; i<B->rmap->n+1; i++) {
       b->i[i] = b->i[i-1] + b->imax[i-1];
     }
+#if defined(PETSC_HAVE_OPENMP)
+    /* first touch the rows from the threads that will process them in MatMult_SeqAIJ() */
+    b->omp_nparts = 0;
+    ierr = MatSeqAIJOMPSetUpPartition_Private(B);CHKERRQ(ierr);
+    {
+      PetscInt p;
+#pragma omp parallel for schedule(static,1)
+      for (p=0; p<b->omp_nparts; p++) {
+        PetscInt k,kstart = b->i[b->omp_rows[p]],kend = b->i[b->omp_rows[p+1]];
+        for (k=kstart; k<kend; k++) b->j[k] = 0;
+        if (b->a) for (k=kstart; k<kend; k++) b->a[k] = 0.0;
+      }
+    }
+#endif
     if (B->structure_only) {
       b->singlemalloc = PETSC_FALSE;
       b->free_a       = PETSC_FALSE;
@@ -4078,6 +4254,120 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+/*
+   MatSeqAIJSortCOO_Private - Sorts a list of COO entries with local row indices by row and column and merges repeated entries
+
+   Input Parameters:
++  m - the number of rows
+.  n - the number of COO entries
+.  i - the row indices, in [0,m) or negative for entries to be ignored (overwritten)
+.  j - the column indices, negative for entries to be ignored (overwritten)
+-  src - an arbitrary tag carried along with each entry (overwritten)
+
+   Output Parameters:
++  nvalid - the number of entries that were not ignored; on output the first nvalid entries of i[], j[] and src[] are these entries sorted by row and column
+.  nz - the number of unique (row,column) pairs
+.  Ii - the CSR row offsets of the unique entries, of length m+1
+.  J - the column indices of the unique entries, of length nz
+-  jmap - of length nz+1, the entries src[jmap[k]] to src[jmap[k+1]-1] all have the (row,column) of the k-th unique entry
+
+   Notes:
+   The caller is responsible for freeing Ii, J and jmap with PetscFree()
+*/
+PetscErrorCode MatSeqAIJSortCOO_Private(PetscInt m,PetscInt n,PetscInt i[],PetscInt j[],PetscInt src[],PetscInt *nvalid,PetscInt *nz,PetscInt **Ii,PetscInt **J,PetscInt **jmap)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,s,e,q,row,nv,*ii,*jj,*jm;
+
+  PetscFunctionBegin;
+  /* entries with a negative index get row -1 so that they are sorted to the front, then dropped */
+  for (k=0; k<n; k++) if (j[k] < 0) i[k] = -1;
+  ierr = PetscSortIntWithArrayPair(n,i,j,src);CHKERRQ(ierr);
+  for (s=0; s<n && i[s] < 0; s++) ;
+  nv   = n - s;
+  ierr = PetscArraymove(i,i+s,nv);CHKERRQ(ierr);
+  ierr = PetscArraymove(j,j+s,nv);CHKERRQ(ierr);
+  ierr = PetscArraymove(src,src+s,nv);CHKERRQ(ierr);
+  for (k=0; k<nv; k=e) {
+    row = i[k];
+    for (e=k+1; e<nv && i[e] == row; e++) ;
+    ierr = PetscSortIntWithArray(e-k,j+k,src+k);CHKERRQ(ierr);
+  }
+
+  ierr = PetscCalloc1(m+1,&ii);CHKERRQ(ierr);
+  for (k=0,q=0; k<nv; k++) {
+    if (k && i[k] == i[k-1] && j[k] == j[k-1]) continue;
+    ii[i[k]+1]++;
+    q++;
+  }
+  for (row=0; row<m; row++) ii[row+1] += ii[row];
+  ierr = PetscMalloc1(q,&jj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(q+1,&jm);CHKERRQ(ierr);
+  jm[0] = 0;
+  for (k=0,q=0; k<nv; k++) {
+    if (!k || i[k] != i[k-1] || j[k] != j[k-1]) jj[q++] = j[k];
+    jm[q] = k+1;
+  }
+  *nvalid = nv;
+  *nz     = q;
+  *Ii     = ii;
+  *J      = jj;
+  *jmap   = jm;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat mat,PetscInt coo_n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *seq;
+  PetscErrorCode ierr;
+  PetscInt       k,m,n,nv,nz,*i,*j,*perm,*Ii,*J,*jmap;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  m    = mat->rmap->n;
+  n    = mat->cmap->n;
+  ierr = PetscMalloc1(coo_n,&i);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coo_n,&j);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coo_n,&perm);CHKERRQ(ierr);
+  for (k=0; k<coo_n; k++) {
+    if (coo_i[k] >= m) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has row index %D, must be less than %D",k,coo_i[k],m);
+    if (coo_j[k] >= n) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has column index %D, must be less than %D",k,coo_j[k],n);
+    i[k]    = coo_i[k];
+    j[k]    = coo_j[k];
+    perm[k] = k;
+  }
+  ierr = MatSeqAIJSortCOO_Private(m,coo_n,i,j,perm,&nv,&nz,&Ii,&J,&jmap);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocationCSR(mat,Ii,J,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(i);CHKERRQ(ierr);
+  ierr = PetscFree(j);CHKERRQ(ierr);
+  ierr = PetscFree(Ii);CHKERRQ(ierr);
+  ierr = PetscFree(J);CHKERRQ(ierr);
+
+  seq  = (Mat_SeqAIJ*)mat->data;
+  ierr = PetscFree(seq->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(seq->coo_perm);CHKERRQ(ierr);
+  seq->coo_jmap = jmap;
+  seq->coo_perm = perm;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *seq = (Mat_SeqAIJ*)A->data;
+  PetscScalar    *a;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!seq->coo_jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() before MatSetValuesCOO()");
+  ierr = MatSeqAIJGetArray(A,&a);CHKERRQ(ierr);
+  MatSeqAIJSumCOO_Private(seq->nz,seq->coo_jmap,seq->coo_perm,v,imode,a);
+  ierr = MatSeqAIJRestoreArray(A,&a);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4189,7 +4479,7 @@ M*/
 . -mat_type aij - sets the matrix type to "aij" during a call to MatSetFromOptions()
 
   Developer Notes:
-    Subclasses include MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
+    Subclasses include MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJDELTA, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
    enough exist.
 
   Level: beginner
@@ -4420,6 +4710,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqbaij_C",MatConvert_SeqAIJ_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijperm_C",MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsell_C",MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijdelta_C",MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatAutotune_C",MatAutotune_SeqAIJ);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmkl_C",MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -4443,6 +4735,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_is_seqaij_C",MatProductSetFromOptions_IS_XAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_seqdense_seqaij_C",MatProductSetFromOptions_SeqDense_SeqAIJ);CHKERRQ(ierr);
@@ -4490,6 +4784,22 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
     c->singlemalloc = PETSC_TRUE;
 
     ierr = PetscArraycpy(c->i,a->i,m+1);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+    /* first touch the rows from the threads that will process them in MatMult_SeqAIJ() */
+    if (m > 0) {
+      PetscInt p;
+
+      ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+#pragma omp parallel for schedule(static,1)
+      for (p=0; p<a->omp_nparts; p++) {
+        PetscInt kstart = a->i[a->omp_rows[p]],kend = a->i[a->omp_rows[p+1]];
+
+        PetscMemcpy(c->j+kstart,a->j+kstart,(kend-kstart)*sizeof(PetscInt));
+        if (cpvalues == MAT_COPY_VALUES) PetscMemcpy(c->a+kstart,a->a+kstart,(kend-kstart)*sizeof(MatScalar));
+        else PetscMemzero(c->a+kstart,(kend-kstart)*sizeof(MatScalar));
+      }
+    }
+#else
     if (m > 0) {
       ierr = PetscArraycpy(c->j,a->j,a->i[m]);CHKERRQ(ierr);
       if (cpvalues == MAT_COPY_VALUES) {
@@ -4498,6 +4808,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
         ierr = PetscArrayzero(c->a,a->i[m]);CHKERRQ(ierr);
       }
     }
+#endif
   }
 
   c->ignorezeroentries = a->ignorezeroentries;
@@ -5039,6 +5350,7 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   ierr = MatSeqAIJRegister(MATSEQAIJCRL,      MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJPERM,     MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJSELL,     MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJDELTA,    MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatSeqAIJRegister(MATSEQAIJMKL,      MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -5048,6 +5360,101 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   PetscFunctionReturn(0);
 }
 
+/*
+   Times MatMult() of A converted to each candidate format and converts A in place to the fastest one; called from
+   MatAssemblyEnd() at the first assembly of a matrix with -mat_autotune
+*/
+PetscErrorCode MatAutotune_SeqAIJ(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  Mat            B;
+  Vec            x,y;
+  char           *types[16],name[64];
+  const char     *deft[] = {MATSEQAIJ,MATSEQAIJPERM,MATSEQAIJSELL,MATSEQAIJDELTA
+#if defined(PETSC_HAVE_MKL_SPARSE)
+                           ,MATSEQAIJMKL
+#endif
+                           };
+  PetscInt       ntypes = 16,ntrials = 3,nmult,m = A->rmap->n,nz = a->nz,rmax = 0,bs = 0,best = -1,i,t,k;
+  PetscReal      mean,var = 0.0;
+  PetscLogDouble t0,t1,tbest = -1.0,tmin;
+  PetscLogEvent  event = 0;
+  PetscBool      set,same;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetInt(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_trials",&ntrials,NULL);CHKERRQ(ierr);
+  if (ntrials < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"The number of trials %D must be at least 1",ntrials);
+  ierr = PetscLogEventBegin(MAT_Autotune,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscOptionsGetStringArray(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_types",types,&ntypes,&set);CHKERRQ(ierr);
+  if (!set) {
+    ntypes = sizeof(deft)/sizeof(deft[0]);
+    for (i=0; i<ntypes; i++) {ierr = PetscStrallocpy(deft[i],&types[i]);CHKERRQ(ierr);}
+  }
+
+  /* the distribution of the row lengths, and the block size that the inodes suggest */
+  mean = m ? (PetscReal)nz/m : 0.0;
+  for (i=0; i<m; i++) {
+    rmax = PetscMax(rmax,a->ilen[i]);
+    var += (a->ilen[i] - mean)*(a->ilen[i] - mean);
+  }
+  if (m) var /= m;
+  if (a->inode.size) {
+    for (i=0; i<a->inode.node_count; i++) {
+      PetscInt p = bs,q = a->inode.size[i],r;
+      while (q) {r = p % q; p = q; q = r;}
+      bs = p;
+    }
+  }
+  ierr = PetscInfo5(A,"Row lengths: mean %g, standard deviation %g, max %D; block size %D, suggested by the inodes %D\n",(double)mean,(double)PetscSqrtReal(var),rmax,PetscMax(A->rmap->bs,1),bs);CHKERRQ(ierr);
+
+  /* enough products in each trial to time at least about 10^6 nonzeros */
+  nmult = PetscMax(1,1000000/(nz+m+1));
+  ierr  = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr  = VecSet(x,1.0);CHKERRQ(ierr);
+  for (i=0; i<ntypes; i++) {
+    ierr = PetscStrcmp(types[i],MATSEQBAIJ,&same);CHKERRQ(ierr);
+    if (same && A->rmap->bs <= 1) {
+      ierr = PetscInfo1(A,"Skipping %s, call MatSetBlockSize() before the preallocation to consider it\n",types[i]);CHKERRQ(ierr);
+      continue;
+    }
+    ierr = PetscObjectTypeCompare((PetscObject)A,types[i],&same);CHKERRQ(ierr);
+    if (same) B = A;
+    else {
+      ierr = MatConvert(A,types[i],MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+    }
+    /* call the kernel directly so that the trials are not logged as MatMult() */
+    ierr = (*B->ops->mult)(B,x,y);CHKERRQ(ierr);
+    tmin = -1.0;
+    for (t=0; t<ntrials; t++) {
+      ierr = PetscTime(&t0);CHKERRQ(ierr);
+      for (k=0; k<nmult; k++) {ierr = (*B->ops->mult)(B,x,y);CHKERRQ(ierr);}
+      ierr = PetscTime(&t1);CHKERRQ(ierr);
+      if (tmin < 0.0 || t1 - t0 < tmin) tmin = t1 - t0;
+    }
+    tmin /= nmult;
+    ierr = PetscInfo2(A,"MatMult() with %s takes %g seconds\n",types[i],tmin);CHKERRQ(ierr);
+    if (best < 0 || tmin < tbest) {best = i; tbest = tmin;}
+    if (B != A) {ierr = MatDestroy(&B);CHKERRQ(ierr);}
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_Autotune,A,0,0,0);CHKERRQ(ierr);
+
+  /* the conversion is logged in an event named after the selected format, so that -log_view shows the decisions */
+  if (best >= 0) {
+    ierr = PetscInfo2(A,"Selected %s, %g seconds per MatMult()\n",types[best],tbest);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(name,sizeof(name),"MatAutotune_%s",types[best]);CHKERRQ(ierr);
+    ierr = PetscLogEventGetId(name,&event);CHKERRQ(ierr);
+    if (event < 0) {ierr = PetscLogEventRegister(name,MAT_CLASSID,&event);CHKERRQ(ierr);}
+    ierr = PetscLogEventBegin(event,A,0,0,0);CHKERRQ(ierr);
+    ierr = MatConvert(A,types[best],MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(event,A,0,0,0);CHKERRQ(ierr);
+  }
+  for (i=0; i<ntypes; i++) {ierr = PetscFree(types[i]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*
     Special version for direct calls from Fortran
 */
@@ -111,6 +111,23 @@ PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFac
 PETSC_INTERN PetscErrorCode MatSeqAIJGetArray_SeqAIJ(Mat,PetscScalar**);
 PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat,PetscScalar**);
 
+/*
+   Level schedule of a triangular factor used by the level-scheduled MatSolve(): the rows in a level only depend on rows
+   in earlier levels so they can be solved concurrently. The off-diagonal entries are copied in level order, so that
+   each level is contiguous in memory.
+*/
+typedef struct {
+  PetscInt  nlevels;
+  PetscInt  *level;                           /* the rows of level l are row[k] for level[l] <= k < level[l+1] */
+  PetscInt  *row;                             /* the rows in level order */
+  PetscInt  *i,*j;                            /* off-diagonal entries of row[k] are j[] and a[] from i[k] to i[k+1] */
+  MatScalar *a;
+  MatScalar *idiag;                           /* inverse of the diagonal of row[k], NULL for a unit diagonal */
+} Mat_SolveLevel;
+
+PETSC_INTERN PetscErrorCode MatSolveLevelCreate_Private(PetscInt,PetscBool,const PetscInt[],const PetscInt[],const PetscInt[],const MatScalar[],Mat_SolveLevel**);
+PETSC_INTERN PetscErrorCode MatSolveLevelDestroy_Private(Mat_SolveLevel**);
+
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
@@ -122,8 +139,38 @@ typedef struct {
   PetscBool   ibdiagvalid;                    /* inverses of block diagonals are valid. */
   PetscBool   diagonaldense;                  /* all entries along the diagonal have been set; i.e. no missing diagonal terms */
   PetscScalar fshift,omega;                   /* last used omega and fshift */
+
+  /* data used by MatSetValuesCOO(): a[k] is the sum of v[coo_perm[p]] over coo_jmap[k] <= p < coo_jmap[k+1] */
+  PetscInt    *coo_jmap,*coo_perm;
+
+  /* partitions used by the OpenMP kernels, each part has about the same number of nonzeros; part p holds the
+     rows omp_rows[p] <= i < omp_rows[p+1], and similarly for the compressed rows and the inodes */
+  PetscInt    omp_nparts;                     /* number of parts, 0 if they need to be recomputed */
+  PetscInt    *omp_rows,*omp_cprows;
+  PetscInt    *omp_nodes,*omp_noderows;       /* first inode of each part and its first row */
+
+  Mat_SolveLevel *lsolve,*usolve;             /* level schedules of the L and U factors, see MatFactorInfo.levelsolve */
+  PetscInt       jacobisweeps;                /* sweeps of MatSolve_SeqAIJ_Jacobi(), see MatFactorInfo.solvesweeps */
+  PetscScalar    *jacobi_work;
+  PetscScalar    *matsolve_work;              /* interlaced right-hand sides of MatMatSolve_SeqAIJ(), kept with the factor */
+  PetscInt       matsolve_nrhs;               /* number of right-hand sides matsolve_work has room for */
 } Mat_SeqAIJ;
 
+/*
+    Sums the COO values v[] into the nonzero values a[] of a SeqAIJ matrix with nz nonzeros, using the maps built by MatSeqAIJSortCOO_Private()
+*/
+PETSC_STATIC_INLINE void MatSeqAIJSumCOO_Private(PetscInt nz,const PetscInt jmap[],const PetscInt perm[],const PetscScalar v[],InsertMode imode,MatScalar a[])
+{
+  PetscInt    k,p;
+  PetscScalar sum;
+
+  for (k=0; k<nz; k++) {
+    sum = 0.0;
+    for (p=jmap[k]; p<jmap[k+1]; p++) sum += v[perm[p]];
+    a[k] = (imode == INSERT_VALUES ? 0.0 : a[k]) + sum;
+  }
+}
+
 /*
   Frees the a, i, and j arrays from the XAIJ (AIJ, BAIJ, and SBAIJ) matrix types
 */
@@ -243,6 +290,7 @@ PETSC_INTERN PetscErrorCode MatLUFactorSymbolic_SeqAIJ_inplace(Mat,Mat,IS,IS,con
 PETSC_INTERN PetscErrorCode MatLUFactorSymbolic_SeqAIJ(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatILUFactorNumeric_SeqAIJ_ChowPatel(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_InplaceWithPerm(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactor_SeqAIJ(Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_inplace(Mat,Vec,Vec);
@@ -251,6 +299,9 @@ PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Level(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpSolveLevel_Private(Mat);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_InplaceWithPerm(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ_inplace(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ(Mat,Vec,Vec,Vec);
@@ -287,12 +338,14 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscR
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,PetscReal,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat);
 #endif
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
@@ -358,6 +411,9 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_Elemental(Mat,MatType,MatReuse,Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
+PETSC_INTERN PetscErrorCode MatAutotune_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat,PetscReal,IS,IS);
@@ -379,6 +435,13 @@ PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat,IS,IS,PetscInt,MatReus
 PETSC_INTERN PetscErrorCode MatSeqAIJCompactOutExtraColumns_SeqAIJ(Mat,ISLocalToGlobalMapping*);
 PETSC_INTERN PetscErrorCode MatSetSeqAIJWithArrays_private(MPI_Comm,PetscInt,PetscInt,PetscInt[],PetscInt[],PetscScalar[],MatType,Mat);
 
+PETSC_INTERN PetscErrorCode MatSeqAIJSortCOO_Private(PetscInt,PetscInt,PetscInt[],PetscInt[],PetscInt[],PetscInt*,PetscInt*,PetscInt**,PetscInt**,PetscInt**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscErrorCode MatSeqAIJOMPSetUpPartition_Private(Mat);
+#endif
+
 /*
     PetscSparseDenseMinusDot - The inner kernel of triangular solves and Gauss-Siedel smoothing. \sum_i xv[i] * r[xi[i]] for CSR storage
 
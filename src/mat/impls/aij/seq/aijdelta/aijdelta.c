@@ -0,0 +1,478 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class, but keeps a copy of the
+  column indices stored as 16-bit offsets from a base column, and optionally
+  of the values in single precision, which is used by the operations that
+  are limited by the memory bandwidth, MatMult() and its variants and MatSOR().
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/*
+   The nonzeros of each row are split into segments of consecutive nonzeros whose columns lie within 65536 of the
+   first column of the segment, the base. Row i holds the segments rseg[i] <= k < rseg[i+1], and segment k holds the
+   nonzeros ci[k] <= l < ci[k+1] of the SeqAIJ matrix, in column cbase[k] + dj[l]. For most matrices there is one
+   segment per row.
+*/
+typedef struct {
+  PetscInt         nseg;
+  PetscInt         *rseg,*ci,*cbase;
+  unsigned short   *dj;
+  float            *sa;            /* the values in single precision, or NULL */
+  PetscBool        single;         /* store the values in single precision */
+  PetscObjectState nonzerostate;   /* nonzero state of the matrix when the offsets were built */
+  PetscObjectState state;          /* state of the matrix when the single precision values were built */
+} Mat_SeqAIJDelta;
+
+#define MAT_SEQAIJDELTA_MAXOFFSET 65535
+
+/* Returns sum_l v[l] x[j[l]] over the nonzeros lstart <= l < lend of row i */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJDeltaRowDot_Private(const Mat_SeqAIJDelta *d,const MatScalar aa[],PetscInt i,PetscInt lstart,PetscInt lend,const PetscScalar x[])
+{
+  PetscScalar       sum = 0.0;
+  const PetscScalar *xb;
+  PetscInt          k,l,l0,l1;
+
+  for (k=d->rseg[i]; k<d->rseg[i+1]; k++) {
+    xb = x + d->cbase[k];
+    l0 = PetscMax(d->ci[k],lstart);
+    l1 = PetscMin(d->ci[k+1],lend);
+    if (d->sa) {
+      for (l=l0; l<l1; l++) sum += d->sa[l]*xb[d->dj[l]];
+    } else {
+      for (l=l0; l<l1; l++) sum += aa[l]*xb[d->dj[l]];
+    }
+  }
+  return sum;
+}
+
+/* Builds the offsets if the nonzero structure changed, and the single precision values if the values changed */
+static PetscErrorCode MatSeqAIJDeltaSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta  *d = (Mat_SeqAIJDelta*)A->spptr;
+  PetscInt         m = A->rmap->n,nz = a->i[m],i,l,k = 0,nseg;
+  PetscObjectState state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (!d->rseg || d->nonzerostate != A->nonzerostate) {
+    ierr = PetscFree3(d->rseg,d->ci,d->cbase);CHKERRQ(ierr);
+    ierr = PetscFree(d->dj);CHKERRQ(ierr);
+    ierr = PetscFree(d->sa);CHKERRQ(ierr);
+    nseg = 0;
+    for (i=0; i<m; i++) {
+      for (l=a->i[i]; l<a->i[i+1]; l++) {
+        if (l == a->i[i] || a->j[l] - a->j[k] > MAT_SEQAIJDELTA_MAXOFFSET) {k = l; nseg++;}
+      }
+    }
+    ierr = PetscMalloc3(m+1,&d->rseg,nseg+1,&d->ci,nseg,&d->cbase);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nz,&d->dj);CHKERRQ(ierr);
+    nseg = 0;
+    for (i=0; i<m; i++) {
+      d->rseg[i] = nseg;
+      for (l=a->i[i]; l<a->i[i+1]; l++) {
+        if (l == a->i[i] || a->j[l] - d->cbase[nseg-1] > MAT_SEQAIJDELTA_MAXOFFSET) {
+          d->ci[nseg]    = l;
+          d->cbase[nseg] = a->j[l];
+          nseg++;
+        }
+        d->dj[l] = (unsigned short)(a->j[l] - d->cbase[nseg-1]);
+      }
+    }
+    d->rseg[m]      = nseg;
+    d->ci[nseg]     = nz;
+    d->nseg         = nseg;
+    d->nonzerostate = A->nonzerostate;
+    d->state        = -1;
+    ierr = PetscLogObjectMemory((PetscObject)A,(m+1+2*nseg+1)*sizeof(PetscInt)+nz*sizeof(unsigned short));CHKERRQ(ierr);
+    ierr = PetscInfo3(A,"Stored the column indices of %D nonzeros as 16-bit offsets in %D segments for %D rows\n",nz,nseg,m);CHKERRQ(ierr);
+  }
+  if (d->single) {
+    ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+    if (!d->sa || d->state != state) {
+      if (!d->sa) {
+        ierr = PetscMalloc1(nz,&d->sa);CHKERRQ(ierr);
+        ierr = PetscLogObjectMemory((PetscObject)A,nz*sizeof(float));CHKERRQ(ierr);
+      }
+#if defined(PETSC_USE_COMPLEX)
+      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Single precision values are not supported for complex scalars");
+#else
+      for (l=0; l<nz; l++) d->sa[l] = (float)a->a[l];
+#endif
+      d->state = state;
+    }
+  } else {
+    ierr = PetscFree(d->sa);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJDeltaReset_Private(Mat_SeqAIJDelta *d)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(d->rseg,d->ci,d->cbase);CHKERRQ(ierr);
+  ierr = PetscFree(d->dj);CHKERRQ(ierr);
+  ierr = PetscFree(d->sa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  /* This routine is only called to convert a MATAIJDELTA to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  PetscErrorCode  ierr;
+  Mat             B = *newmat;
+  Mat_SeqAIJDelta *d;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  d = (Mat_SeqAIJDelta*)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate        = MatDuplicate_SeqAIJ;
+  B->ops->destroy          = MatDestroy_SeqAIJ;
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJ;
+  B->ops->mult             = MatMult_SeqAIJ;
+  B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+  B->ops->sor              = MatSOR_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",NULL);CHKERRQ(ierr);
+
+  ierr = MatSeqAIJDeltaReset_Private(d);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this SeqAIJDelta matrix will not have an spptr pointer. */
+  if (A->spptr) {
+    ierr = MatSeqAIJDeltaReset_Private((Mat_SeqAIJDelta*)A->spptr);CHKERRQ(ierr);
+    ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaijdelta_seqaij_C",NULL);CHKERRQ(ierr);
+
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ() to destroy everything that remains. */
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDuplicate_SeqAIJDelta(Mat A,MatDuplicateOption op,Mat *M)
+{
+  Mat_SeqAIJDelta *d = (Mat_SeqAIJDelta*)A->spptr,*dd;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDuplicate_SeqAIJ(A,op,M);CHKERRQ(ierr);
+  dd   = (Mat_SeqAIJDelta*)(*M)->spptr;
+  dd->single = d->single;
+  ierr = MatSeqAIJDeltaReset_Private(dd);CHKERRQ(ierr);
+  if ((*M)->assembled) {
+    ierr = MatSeqAIJDeltaSetUp_Private(*M);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJDelta(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  /* Disable the inode routines so that the MatMult() and MatSOR() of this class are used */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  ierr = MatSeqAIJDeltaSetUp_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Computes z = y + A x, with y = NULL for zero */
+static PetscErrorCode MatMultAdd_SeqAIJDelta_Private(Mat A,const PetscScalar x[],const PetscScalar y[],PetscScalar z[])
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta *d = (Mat_SeqAIJDelta*)A->spptr;
+  const MatScalar *aa = a->a;
+  const PetscInt  *ai = a->i;
+  PetscInt        m = A->rmap->n,i;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscErrorCode  ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+  if (a->omp_nparts > 1) {
+    const PetscInt *part = a->omp_rows;
+    PetscInt       p;
+
+#pragma omp parallel for schedule(static,1)
+    for (p=0; p<a->omp_nparts; p++) {
+      PetscInt j;
+      for (j=part[p]; j<part[p+1]; j++) z[j] = (y ? y[j] : 0.0) + MatSeqAIJDeltaRowDot_Private(d,aa,j,ai[j],ai[j+1],x);
+    }
+  } else
+#endif
+  {
+    for (i=0; i<m; i++) z[i] = (y ? y[i] : 0.0) + MatSeqAIJDeltaRowDot_Private(d,aa,i,ai[i],ai[i+1],x);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaSetUp_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJDelta_Private(A,x,NULL,y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y,*z;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaSetUp_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJDelta_Private(A,x,y,z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTransposeAdd_SeqAIJDelta(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *d = (Mat_SeqAIJDelta*)A->spptr;
+  const MatScalar   *aa = a->a;
+  const PetscScalar *x;
+  PetscScalar       *z,*zb,alpha;
+  PetscInt          m = A->rmap->n,i,k,l;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaSetUp_Private(A);CHKERRQ(ierr);
+  if (zz != yy) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    alpha = x[i];
+    for (k=d->rseg[i]; k<d->rseg[i+1]; k++) {
+      zb = z + d->cbase[k];
+      if (d->sa) {
+        for (l=d->ci[k]; l<d->ci[k+1]; l++) zb[d->dj[l]] += alpha*d->sa[l];
+      } else {
+        for (l=d->ci[k]; l<d->ci[k+1]; l++) zb[d->dj[l]] += alpha*aa[l];
+      }
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTranspose_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(yy,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_SeqAIJDelta(A,xx,yy,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Forward, backward and symmetric sweeps, local or not, with the diagonal in double precision; Eisenstat's trick and
+   the application of the triangular parts use the full precision SeqAIJ routine
+*/
+PetscErrorCode MatSOR_SeqAIJDelta(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *d = (Mat_SeqAIJDelta*)A->spptr;
+  const MatScalar   *aa = a->a;
+  const PetscInt    *ai = a->i,*diag;
+  const PetscScalar *b,*idiag;
+  PetscScalar       *x,sum;
+  PetscInt          m = A->rmap->n,i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (flag & ~(SOR_ZERO_INITIAL_GUESS | SOR_SYMMETRIC_SWEEP | SOR_LOCAL_SYMMETRIC_SWEEP)) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatSeqAIJDeltaSetUp_Private(A);CHKERRQ(ierr);
+  its  = its*lits;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+  diag      = a->diag;
+  idiag     = a->idiag;
+
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = VecSet(xx,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        sum  = b[i] - MatSeqAIJDeltaRowDot_Private(d,aa,i,ai[i],diag[i],x) - MatSeqAIJDeltaRowDot_Private(d,aa,i,diag[i]+1,ai[i+1],x);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum  = b[i] - MatSeqAIJDeltaRowDot_Private(d,aa,i,ai[i],diag[i],x) - MatSeqAIJDeltaRowDot_Private(d,aa,i,diag[i]+1,ai[i+1],x);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i];
+      }
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a SeqAIJDelta matrix. This routine is called by the
+   MatCreate_SeqAIJDelta() routine, but can also be used to convert an assembled SeqAIJ matrix into a SeqAIJDelta one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode  ierr;
+  Mat             B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJDelta *d;
+  PetscBool       sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr     = PetscNewLog(B,&d);CHKERRQ(ierr);
+  b        = (Mat_SeqAIJ*)B->data;
+  B->spptr = (void*)d;
+
+  /* Disable use of the inode routines so that the AIJDELTA ones will be used instead.
+     This happens in MatAssemblyEnd_SeqAIJDelta() as well, but the assembly end may not be called, so set it here, too. */
+  b->inode.use = PETSC_FALSE;
+
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"AIJDELTA Options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aijdelta_single","Store the values in single precision","MatCreateSeqAIJDelta",d->single,&d->single,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  if (d->single) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Single precision values are not supported for complex scalars");
+#endif
+
+  B->ops->duplicate        = MatDuplicate_SeqAIJDelta;
+  B->ops->destroy          = MatDestroy_SeqAIJDelta;
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJDelta;
+  B->ops->mult             = MatMult_SeqAIJDelta;
+  B->ops->multadd          = MatMultAdd_SeqAIJDelta;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJDelta;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJDelta;
+  B->ops->sor              = MatSOR_SeqAIJDelta;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",MatConvert_SeqAIJDelta_SeqAIJ);CHKERRQ(ierr);
+
+  /* If A has already been assembled, build the offsets now. */
+  if (A->assembled) {
+    ierr = MatSeqAIJDeltaSetUp_Private(B);CHKERRQ(ierr);
+  }
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJDELTA);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatCreateSeqAIJDelta - Creates a sparse matrix of type SEQAIJDELTA.
+   This type inherits from AIJ and is largely identical, but keeps a copy of the column indices
+   stored as 16-bit offsets from a base column of each row, and optionally of the values in single
+   precision, which reduces the memory traffic of MatMult(), MatMultAdd(), MatMultTranspose(),
+   MatMultTransposeAdd() and MatSOR() by up to a half. The sums are always accumulated in the
+   precision of PetscScalar.
+   Because SEQAIJDELTA is a subtype of SEQAIJ, the option "-mat_seqaij_type seqaijdelta" can be used to make
+   sequential AIJ matrices default to being instances of MATSEQAIJDELTA.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Options Database Keys:
+.  -mat_aijdelta_single - store the values in single precision; intended for matrices used only to build preconditioners, where the full precision is not needed
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   A row whose columns span more than 65536 is split into several segments, each with its own base column.
+
+   Single precision values are not supported for complex scalars.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatCreateMPIAIJDelta(), MatSetValues(), MATAIJDELTA
+@*/
+PetscErrorCode MatCreateSeqAIJDelta(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJDELTA);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJDelta(A,MATSEQAIJDELTA,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -587,7 +587,13 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
 
   ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
   ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
-  if (b->inode.size) {
+  b->jacobisweeps = (PetscInt)info->solvesweeps;
+  if (b->jacobisweeps) {
+    C->ops->solve = MatSolve_SeqAIJ_Jacobi;
+  } else if (info->levelsolve) {
+    ierr = MatSeqAIJSetUpSolveLevel_Private(C);CHKERRQ(ierr);
+    C->ops->solve = MatSolve_SeqAIJ_Level;
+  } else if (b->inode.size) {
     C->ops->solve = MatSolve_SeqAIJ_Inode;
   } else if (row_identity && col_identity) {
     C->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
@@ -597,7 +603,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
-  C->ops->matsolve          = MatMatSolve_SeqAIJ;
+  C->ops->matsolve          = b->jacobisweeps ? NULL : MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
@@ -1073,10 +1079,10 @@ PetscErrorCode MatMatSolve_SeqAIJ(Mat A,Mat B,Mat X)
   Mat_SeqAIJ        *a    = (Mat_SeqAIJ*)A->data;
   IS                iscol = a->col,isrow = a->row;
   PetscErrorCode    ierr;
-  PetscInt          i, n = A->rmap->n,*vi,*ai = a->i,*aj = a->j,*adiag = a->diag;
-  PetscInt          nz,neq,ldb,ldx;
+  PetscInt          i,j,n = A->rmap->n,*vi,*ai = a->i,*aj = a->j,*adiag = a->diag;
+  PetscInt          nz,neq,nrhs = B->cmap->n,ldb,ldx;
   const PetscInt    *rout,*cout,*r,*c;
-  PetscScalar       *x,*tmp = a->solve_work,sum;
+  PetscScalar       *x,*tmp,*t,*u;
   const PetscScalar *b,*aa = a->a,*v;
   PetscBool         isdense;
 
@@ -1094,35 +1100,44 @@ PetscErrorCode MatMatSolve_SeqAIJ(Mat A,Mat B,Mat X)
   ierr = MatDenseGetLDA(X,&ldx);CHKERRQ(ierr);
   ierr = ISGetIndices(isrow,&rout);CHKERRQ(ierr); r = rout;
   ierr = ISGetIndices(iscol,&cout);CHKERRQ(ierr); c = cout;
-  for (neq=0; neq<B->cmap->n; neq++) {
-    /* forward solve the lower triangular */
-    tmp[0] = b[r[0]];
-    v      = aa;
-    vi     = aj;
-    for (i=1; i<n; i++) {
-      nz  = ai[i+1] - ai[i];
-      sum = b[r[i]];
-      PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
-      tmp[i] = sum;
-      v     += nz; vi += nz;
+  /* the right-hand sides are interlaced in tmp, row i of all of them stored contiguously,
+     so that the factor is traversed once for the whole block instead of once per column */
+  if (nrhs > a->matsolve_nrhs) {
+    ierr = PetscFree(a->matsolve_work);CHKERRQ(ierr);
+    ierr = PetscMalloc1(n*nrhs,&a->matsolve_work);CHKERRQ(ierr);
+    a->matsolve_nrhs = nrhs;
+  }
+  tmp = a->matsolve_work;
+  /* forward solve the lower triangular */
+  v  = aa;
+  vi = aj;
+  for (i=0; i<n; i++) {
+    nz = ai[i+1] - ai[i];
+    t  = tmp + i*nrhs;
+    for (neq=0; neq<nrhs; neq++) t[neq] = b[r[i]+neq*ldb];
+    for (j=0; j<nz; j++) {
+      u = tmp + vi[j]*nrhs;
+      for (neq=0; neq<nrhs; neq++) t[neq] -= v[j]*u[neq];
     }
-    /* backward solve the upper triangular */
-    for (i=n-1; i>=0; i--) {
-      v   = aa + adiag[i+1]+1;
-      vi  = aj + adiag[i+1]+1;
-      nz  = adiag[i]-adiag[i+1]-1;
-      sum = tmp[i];
-      PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
-      x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+    v += nz; vi += nz;
+  }
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v  = aa + adiag[i+1]+1;
+    vi = aj + adiag[i+1]+1;
+    nz = adiag[i]-adiag[i+1]-1;
+    t  = tmp + i*nrhs;
+    for (j=0; j<nz; j++) {
+      u = tmp + vi[j]*nrhs;
+      for (neq=0; neq<nrhs; neq++) t[neq] -= v[j]*u[neq];
     }
-    b += ldb;
-    x += ldx;
+    for (neq=0; neq<nrhs; neq++) x[c[i]+neq*ldx] = t[neq] = t[neq]*v[nz]; /* v[nz] = aa[adiag[i]] */
   }
   ierr = ISRestoreIndices(isrow,&rout);CHKERRQ(ierr);
   ierr = ISRestoreIndices(iscol,&cout);CHKERRQ(ierr);
   ierr = MatDenseRestoreArrayRead(B,&b);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(X,&x);CHKERRQ(ierr);
-  ierr = PetscLogFlops(B->cmap->n*(2.0*a->nz - n));CHKERRQ(ierr);
+  ierr = PetscLogFlops(nrhs*(2.0*a->nz - n));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1693,6 +1708,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
     if (a->inode.size) {
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
     }
+    if (info->sweeps > 0) fact->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_ChowPatel;
     PetscFunctionReturn(0);
   }
 
@@ -1833,6 +1849,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
   if (a->inode.size) {
     (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   }
+  if (info->sweeps > 0) (fact)->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_ChowPatel;
   ierr = MatSeqAIJCheckInode_FactorLU(fact);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2160,11 +2177,18 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *
     B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
     B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1_NaturalOrdering;
     B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1_NaturalOrdering;
+    B->ops->matsolve       = MatMatSolve_SeqSBAIJ_1_NaturalOrdering;
   } else {
     B->ops->solve          = MatSolve_SeqSBAIJ_1;
     B->ops->solvetranspose = MatSolve_SeqSBAIJ_1;
     B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
     B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
+    B->ops->matsolve       = NULL;
+  }
+  if (info->levelsolve) {
+    ierr = MatSeqSBAIJSetUpSolveLevel_Private(B);CHKERRQ(ierr);
+    B->ops->solve          = MatSolve_SeqSBAIJ_1_Level;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_Level;
   }
 
   C->assembled    = PETSC_TRUE;
@@ -3194,6 +3218,468 @@ PetscErrorCode MatSolve_SeqAIJ(Mat A,Vec bb,Vec xx)
   PetscFunctionReturn(0);
 }
 
+/*
+   Computes the level schedule of a triangular factor whose row i has the off-diagonal entries aj[] and aa[] from
+   rstart[i] to rend[i], solved by forward substitution, or by backward substitution when backward is true
+*/
+PetscErrorCode MatSolveLevelCreate_Private(PetscInt n,PetscBool backward,const PetscInt rstart[],const PetscInt rend[],const PetscInt aj[],const MatScalar aa[],Mat_SolveLevel **solvelevel)
+{
+  Mat_SolveLevel *sl;
+  PetscInt       i,k,l,p,nz = 0,*lev;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&sl);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&lev);CHKERRQ(ierr);
+  /* the level of a row is one more than the largest level of the rows it depends on */
+  for (k=0; k<n; k++) {
+    i = backward ? n-1-k : k;
+    l = 0;
+    for (p=rstart[i]; p<rend[i]; p++) l = PetscMax(l,lev[aj[p]]+1);
+    lev[i]      = l;
+    sl->nlevels = PetscMax(sl->nlevels,l+1);
+    nz         += rend[i] - rstart[i];
+  }
+  ierr = PetscCalloc1(sl->nlevels+1,&sl->level);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n,&sl->row,n+1,&sl->i,nz,&sl->j,nz,&sl->a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) sl->level[lev[i]+1]++;
+  for (l=0; l<sl->nlevels; l++) sl->level[l+1] += sl->level[l];
+  for (k=0; k<n; k++) {
+    i = backward ? n-1-k : k;
+    sl->row[sl->level[lev[i]]++] = i;
+  }
+  for (l=sl->nlevels; l>0; l--) sl->level[l] = sl->level[l-1];
+  sl->level[0] = 0;
+  sl->i[0]     = 0;
+  for (k=0; k<n; k++) {
+    i    = sl->row[k];
+    nz   = rend[i] - rstart[i];
+    ierr = PetscArraycpy(sl->j+sl->i[k],aj+rstart[i],nz);CHKERRQ(ierr);
+    ierr = PetscArraycpy(sl->a+sl->i[k],aa+rstart[i],nz);CHKERRQ(ierr);
+    sl->i[k+1] = sl->i[k] + nz;
+  }
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+  *solvelevel = sl;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolveLevelDestroy_Private(Mat_SolveLevel **solvelevel)
+{
+  Mat_SolveLevel *sl = *solvelevel;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!sl) PetscFunctionReturn(0);
+  ierr = PetscFree(sl->level);CHKERRQ(ierr);
+  ierr = PetscFree4(sl->row,sl->i,sl->j,sl->a);CHKERRQ(ierr);
+  ierr = PetscFree(sl->idiag);CHKERRQ(ierr);
+  ierr = PetscFree(*solvelevel);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Solves with a triangular factor one level after the other: t[i] = (b[rin[i]] - sum_j A(i,j) t[j]) idiag[i], with
+   t[i] instead of b[rin[i]] when b is NULL, and also stores it in x[rout[i]] when x is given.
+
+   With OpenMP it must be called by all the threads of a parallel region, which share the rows of each level.
+*/
+static void MatSolveLevel_Private(const Mat_SolveLevel *sl,const PetscInt rin[],const PetscScalar b[],PetscScalar t[],const PetscInt rout[],PetscScalar x[])
+{
+  PetscInt l,k;
+
+  for (l=0; l<sl->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (k=sl->level[l]; k<sl->level[l+1]; k++) {
+      const PetscInt  i = sl->row[k],nz = sl->i[k+1] - sl->i[k],*vi = sl->j + sl->i[k];
+      const MatScalar *v = sl->a + sl->i[k];
+      PetscScalar     sum = b ? b[rin[i]] : t[i];
+
+      PetscSparseDenseMinusDot(sum,t,v,vi,nz);
+      if (sl->idiag) sum *= sl->idiag[k];
+      t[i] = sum;
+      if (x) x[rout[i]] = sum;
+    }
+  }
+}
+
+/*
+   Computes the level schedules of the L and U factors of A for MatSolve_SeqAIJ_Level()
+*/
+PetscErrorCode MatSeqAIJSetUpSolveLevel_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,k,n = A->rmap->n,*ustart,*uend;
+  const PetscInt *adiag = a->diag;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSolveLevelDestroy_Private(&a->lsolve);CHKERRQ(ierr);
+  ierr = MatSolveLevelDestroy_Private(&a->usolve);CHKERRQ(ierr);
+  ierr = MatSolveLevelCreate_Private(n,PETSC_FALSE,a->i,a->i+1,a->j,a->a,&a->lsolve);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&ustart,n,&uend);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ustart[i] = adiag[i+1] + 1;
+    uend[i]   = adiag[i];
+  }
+  ierr = MatSolveLevelCreate_Private(n,PETSC_TRUE,ustart,uend,a->j,a->a,&a->usolve);CHKERRQ(ierr);
+  ierr = PetscFree2(ustart,uend);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&a->usolve->idiag);CHKERRQ(ierr);
+  for (k=0; k<n; k++) a->usolve->idiag[k] = a->a[adiag[a->usolve->row[k]]];
+  ierr = PetscInfo3(A,"Level-scheduled solves with %D levels in L and %D levels in U for %D rows\n",a->lsolve->nlevels,a->usolve->nlevels,n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolve_SeqAIJ_Level(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  const PetscInt    *r,*c;
+  PetscScalar       *x,*tmp = a->solve_work;
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    MatSolveLevel_Private(a->lsolve,r,b,tmp,NULL,NULL);
+    MatSolveLevel_Private(a->usolve,NULL,NULL,tmp,c,x);
+  }
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the level schedules of the factors U^T and U of a Cholesky factor A for MatSolve_SeqSBAIJ_1_Level(); the
+   rows of U^T are formed from the columns of U and the values of both are negated, since the solves add them
+*/
+PetscErrorCode MatSeqSBAIJSetUpSolveLevel_Private(Mat A)
+{
+  Mat_SeqSBAIJ   *a = (Mat_SeqSBAIJ*)A->data;
+  PetscInt       i,k,p,n = a->mbs,*ti,*tj,*uend;
+  const PetscInt *ai = a->i,*aj = a->j;
+  MatScalar      *ta;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSolveLevelDestroy_Private(&a->lsolve);CHKERRQ(ierr);
+  ierr = MatSolveLevelDestroy_Private(&a->usolve);CHKERRQ(ierr);
+  /* row k of U has its off-diagonal entries from ai[k] to ai[k+1]-1 and the inverse of its diagonal at ai[k+1]-1 */
+  ierr = PetscCalloc1(n+1,&ti);CHKERRQ(ierr);
+  ierr = PetscMalloc3(n,&uend,ai[n]-n,&tj,ai[n]-n,&ta);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    uend[k] = ai[k+1] - 1;
+    for (p=ai[k]; p<uend[k]; p++) ti[aj[p]+1]++;
+  }
+  for (i=0; i<n; i++) ti[i+1] += ti[i];
+  for (k=0; k<n; k++) {
+    for (p=ai[k]; p<uend[k]; p++) {
+      tj[ti[aj[p]]]   = k;
+      ta[ti[aj[p]]++] = -a->a[p];
+    }
+  }
+  for (i=n; i>0; i--) ti[i] = ti[i-1];
+  ti[0] = 0;
+  ierr = MatSolveLevelCreate_Private(n,PETSC_FALSE,ti,ti+1,tj,ta,&a->lsolve);CHKERRQ(ierr);
+  ierr = MatSolveLevelCreate_Private(n,PETSC_TRUE,ai,uend,aj,a->a,&a->usolve);CHKERRQ(ierr);
+  for (p=0; p<a->usolve->i[n]; p++) a->usolve->a[p] = -a->usolve->a[p];
+  ierr = PetscFree(ti);CHKERRQ(ierr);
+  ierr = PetscFree3(uend,tj,ta);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Level-scheduled solves with %D levels in U^T and %D levels in U for %D rows\n",a->lsolve->nlevels,a->usolve->nlevels,n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolve_SeqSBAIJ_1_Level(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqSBAIJ      *a = (Mat_SeqSBAIJ*)A->data;
+  PetscErrorCode    ierr;
+  const PetscInt    mbs = a->mbs,*ai = a->i,*rp;
+  const MatScalar   *aa = a->a;
+  PetscScalar       *x,*t = a->solve_work;
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  if (!mbs) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&rp);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    PetscInt k;
+
+    /* solve U^T*D*y = perm(b), then U*perm(x) = y */
+    MatSolveLevel_Private(a->lsolve,rp,b,t,NULL,NULL);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (k=0; k<mbs; k++) t[k] *= aa[ai[k+1]-1];
+    MatSolveLevel_Private(a->usolve,NULL,NULL,t,rp,x);
+  }
+  ierr = ISRestoreIndices(a->row,&rp);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(4.0*a->nz - 3.0*mbs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sum of l_ik u_kj over k < kmax, merging row i of L (columns lj[], values lv[]) with column j of U (rows uk[], values at
+   the positions up[] of x[])
+*/
+PETSC_STATIC_INLINE PetscScalar MatChowPatelDot_Private(PetscInt kmax,PetscInt nl,const PetscInt lj[],const MatScalar lv[],PetscInt nu,const PetscInt uk[],const PetscInt up[],const MatScalar x[],PetscLogDouble *flops)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    p = 0,q = 0;
+
+  while (p < nl && q < nu && lj[p] < kmax && uk[q] < kmax) {
+    if (lj[p] < uk[q]) p++;
+    else if (lj[p] > uk[q]) q++;
+    else {
+      sum    += lv[p++]*x[up[q++]];
+      *flops += 2.0;
+    }
+  }
+  return sum;
+}
+
+/*
+   Fine-grained iterative ILU of Chow and Patel: with S the nonzero pattern computed by the symbolic factorization, each
+   sweep updates all the entries of the factors from their values in the previous sweep
+      l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj   for (i,j) in S, i > j
+      u_ij =  a_ij - sum_{k<i} l_ik u_kj           for (i,j) in S, i <= j
+   so that all the entries are computed concurrently, starting from the lower part of A scaled by its diagonal and the
+   upper part of A. The sweeps are synchronous, so the factors do not depend on the number of threads.
+*/
+PetscErrorCode MatILUFactorNumeric_SeqAIJ_ChowPatel(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  IS              isrow = b->row,isicol = b->icol;
+  PetscErrorCode  ierr;
+  const PetscInt  n = A->rmap->n,*ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*bdiag = b->diag,*r,*ic;
+  const MatScalar *aa = a->a;
+  MatScalar       *ba = b->a,*av,*x,*y,*t,*rtmp,*work;
+  PetscInt        i,j,k,p,q,s,nz = bdiag[0]+1,sweeps = (PetscInt)info->sweeps,*ci,*ck,*cp;
+  PetscLogDouble  flops = 0.0;
+  PetscBool       row_identity,col_identity;
+  FactorShiftCtx  sctx;
+
+  PetscFunctionBegin;
+  if (info->shifttype != (PetscReal)MAT_SHIFT_NONE) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"The Chow-Patel factorization does not support the shift type %s",MatFactorShiftTypes[(int)info->shifttype]);
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(isicol,&ic);CHKERRQ(ierr);
+  ierr = PetscMalloc2(3*nz,&work,n,&rtmp);CHKERRQ(ierr);
+  av   = work;
+  x    = work + nz;
+  y    = work + 2*nz;
+
+  /* the values of the permuted A on the nonzero pattern of the factors */
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) rtmp[bj[p]] = 0.0;
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) rtmp[bj[p]] = 0.0;
+    rtmp[i] = 0.0;
+    for (p=ai[r[i]]; p<ai[r[i]+1]; p++) rtmp[ic[aj[p]]] = aa[p];
+    for (p=bi[i]; p<bi[i+1]; p++) av[p] = rtmp[bj[p]];
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) av[p] = rtmp[bj[p]];
+    av[bdiag[i]] = rtmp[i];
+  }
+
+  /* the columns of U, including the diagonal, with increasing row numbers */
+  ierr = PetscCalloc1(n+1,&ci);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    for (p=bdiag[k+1]+1; p<bdiag[k]; p++) ci[bj[p]+1]++;
+    ci[k+1]++;
+  }
+  for (j=0; j<n; j++) ci[j+1] += ci[j];
+  ierr = PetscMalloc2(ci[n],&ck,ci[n],&cp);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    for (p=bdiag[k+1]+1; p<bdiag[k]; p++) {
+      q     = ci[bj[p]]++;
+      ck[q] = k;
+      cp[q] = p;
+    }
+    q     = ci[k]++;
+    ck[q] = k;
+    cp[q] = bdiag[k];
+  }
+  for (j=n; j>0; j--) ci[j] = ci[j-1];
+  ci[0] = 0;
+
+  /* initial guess */
+  for (i=0; i<n; i++) {
+    sctx.pv = av[bdiag[i]];
+    ierr    = MatPivotCheck_none(B,A,info,&sctx,i);CHKERRQ(ierr);
+    if (B->factorerrortype) goto finished;
+  }
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) x[p] = av[p]/av[bdiag[bj[p]]];
+    for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) x[p] = av[p];
+  }
+
+  for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(dynamic,32) reduction(+:flops)
+#endif
+    for (i=0; i<n; i++) {
+      const PetscInt  nl = bi[i+1] - bi[i],*lj = bj + bi[i];
+      const MatScalar *lv = x + bi[i];
+      PetscInt        p,j;
+
+      for (p=bi[i]; p<bi[i+1]; p++) {
+        j    = bj[p];
+        y[p] = (av[p] - MatChowPatelDot_Private(j,nl,lj,lv,ci[j+1]-ci[j],ck+ci[j],cp+ci[j],x,&flops))/x[bdiag[j]];
+      }
+      for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) {
+        j    = p == bdiag[i] ? i : bj[p];
+        y[p] = av[p] - MatChowPatelDot_Private(i,nl,lj,lv,ci[j+1]-ci[j],ck+ci[j],cp+ci[j],x,&flops);
+      }
+    }
+    t = x; x = y; y = t;
+    flops += bi[n];
+  }
+
+  /* the factors with the inverse of the diagonal of U, as stored by MatLUFactorNumeric_SeqAIJ() */
+  for (i=0; i<n; i++) {
+    sctx.pv = x[bdiag[i]];
+    ierr    = MatPivotCheck_none(B,A,info,&sctx,i);CHKERRQ(ierr);
+    if (B->factorerrortype) goto finished;
+    for (p=bi[i]; p<bi[i+1]; p++) ba[p] = x[p];
+    for (p=bdiag[i+1]+1; p<bdiag[i]; p++) ba[p] = x[p];
+    ba[bdiag[i]] = 1.0/x[bdiag[i]];
+  }
+
+finished:
+  ierr = PetscFree2(work,rtmp);CHKERRQ(ierr);
+  ierr = PetscFree(ci);CHKERRQ(ierr);
+  ierr = PetscFree2(ck,cp);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+
+  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
+  b->jacobisweeps = (PetscInt)info->solvesweeps;
+  if (b->jacobisweeps) {
+    B->ops->solve = MatSolve_SeqAIJ_Jacobi;
+  } else if (info->levelsolve) {
+    ierr = MatSeqAIJSetUpSolveLevel_Private(B);CHKERRQ(ierr);
+    B->ops->solve = MatSolve_SeqAIJ_Level;
+  } else if (b->inode.size) {
+    B->ops->solve = MatSolve_SeqAIJ_Inode;
+  } else if (row_identity && col_identity) {
+    B->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+  } else {
+    B->ops->solve = MatSolve_SeqAIJ;
+  }
+  B->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  B->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  B->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  /* the approximate triangular solves are applied column by column so that MatMatSolve() matches MatSolve() */
+  B->ops->matsolve          = b->jacobisweeps ? NULL : MatMatSolve_SeqAIJ;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  ierr = PetscLogFlops(flops + n);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Chow-Patel factorization with %D sweeps, triangular solves with %D Jacobi sweeps for %D rows\n",sweeps,b->jacobisweeps,n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Approximates the triangular solves by Jacobi sweeps, y_{m+1} = P b - (L - I) y_m starting from y_0 = P b and then
+   z_{m+1} = D^{-1} (y - (U - D) z_m) starting from z_0 = D^{-1} y; they are exact after n sweeps
+*/
+PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  const PetscInt    n = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag,sweeps = a->jacobisweeps,*r,*c;
+  const MatScalar   *aa = a->a;
+  PetscScalar       *x,*tmp = a->solve_work,*w;
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  if (!a->jacobi_work) {
+    ierr = PetscMalloc1(2*n,&a->jacobi_work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,2*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  w    = a->jacobi_work;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    PetscScalar     *yo = w,*yn = w + n,*zo = tmp,*zn,*t,sum;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscInt        i,s,nz;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) yo[i] = b[r[i]];
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        nz  = ai[i+1] - ai[i];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,yo,v,vi,nz);
+        yn[i] = sum;
+      }
+      t = yo; yo = yn; yn = t;
+    }
+
+    /* yo holds the solution with L, yn is reused for the solution with U */
+    zn = yn;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) zo[i] = yo[i]*aa[adiag[i]];
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + adiag[i+1] + 1;
+        vi  = aj + adiag[i+1] + 1;
+        nz  = adiag[i] - adiag[i+1] - 1;
+        sum = yo[i];
+        PetscSparseDenseMinusDot(sum,zo,v,vi,nz);
+        zn[i] = sum*v[nz];
+      }
+      t = zo; zo = zn; zn = t;
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[c[i]] = zo[i];
+  }
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(sweeps*(2.0*a->nz - n) + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     This will get a new name and become a varient of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
 */
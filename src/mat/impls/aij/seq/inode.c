@@ -364,6 +364,39 @@ static PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Inode(Mat A,PetscInt oshift,Pets
 
 /* ----------------------------------------------------------- */
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Computes z = y + A x, with y = NULL for zero, in parallel over the inode parts of A. The rows of an inode are
+   stored one after the other with the same column indices, so each x[] entry is loaded once per inode.
+*/
+static void MatMultAdd_SeqAIJ_Inode_OpenMP_Private(Mat_SeqAIJ *a,const PetscScalar x[],const PetscScalar y[],PetscScalar z[])
+{
+  PetscInt p;
+
+#pragma omp parallel for schedule(static,1)
+  for (p=0; p<a->omp_nparts; p++) {
+    const PetscInt  *ns = a->inode.size,*ii = a->i,*idx;
+    const MatScalar *v;
+    PetscScalar     sum[5],tmp;               /* inodes have at most inode.max_limit = 5 rows */
+    PetscInt        i,j,k,n,nsz,row = a->omp_noderows[p];
+
+    for (i=a->omp_nodes[p]; i<a->omp_nodes[p+1]; i++) {
+      nsz = ns[i];
+      n   = ii[row+1] - ii[row];
+      idx = a->j + ii[row];
+      v   = a->a + ii[row];
+      for (k=0; k<nsz; k++) sum[k] = y ? y[row+k] : 0.0;
+      for (j=0; j<n; j++) {
+        tmp = x[idx[j]];
+        for (k=0; k<nsz; k++) sum[k] += v[k*n+j]*tmp;
+      }
+      for (k=0; k<nsz; k++) z[row+k] = sum[k];
+      row += nsz;
+    }
+  }
+}
+#endif
+
 static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -381,6 +414,18 @@ static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
 
   PetscFunctionBegin;
   if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+  if (a->omp_nparts > 1) {
+    ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+    ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+    MatMultAdd_SeqAIJ_Inode_OpenMP_Private(a,x,NULL,y);
+    ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   node_max = a->inode.node_count;
   ns       = a->inode.size;     /* Node Size array */
   ierr     = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
@@ -567,6 +612,18 @@ static PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
 
   PetscFunctionBegin;
   if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = MatSeqAIJOMPSetUpPartition_Private(A);CHKERRQ(ierr);
+  if (a->omp_nparts > 1) {
+    ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+    ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+    MatMultAdd_SeqAIJ_Inode_OpenMP_Private(a,x,z,y);
+    ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+    ierr = VecRestoreArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   node_max = a->inode.node_count;
   ns       = a->inode.size;     /* Node Size array */
 
@@ -1831,7 +1888,13 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
   ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
 
-  if (b->inode.size) {
+  b->jacobisweeps = (PetscInt)info->solvesweeps;
+  if (b->jacobisweeps) {
+    C->ops->solve           = MatSolve_SeqAIJ_Jacobi;
+  } else if (info->levelsolve) {
+    ierr = MatSeqAIJSetUpSolveLevel_Private(C);CHKERRQ(ierr);
+    C->ops->solve           = MatSolve_SeqAIJ_Level;
+  } else if (b->inode.size) {
     C->ops->solve           = MatSolve_SeqAIJ_Inode;
   } else {
     C->ops->solve           = MatSolve_SeqAIJ;
@@ -1839,7 +1902,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
-  C->ops->matsolve          = MatMatSolve_SeqAIJ;
+  C->ops->matsolve          = b->jacobisweeps ? NULL : MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
@@ -4049,6 +4112,7 @@ PetscErrorCode MatSeqAIJCheckInode(Mat A)
   if (!a->inode.use) PetscFunctionReturn(0);
   if (a->inode.checked && A->nonzerostate == a->inode.mat_nonzerostate) PetscFunctionReturn(0);
 
+  a->omp_nparts = 0;
   m = A->rmap->n;
   if (a->inode.size) ns = a->inode.size;
   else {
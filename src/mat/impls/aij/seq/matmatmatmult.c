@@ -21,18 +21,25 @@ PetscErrorCode MatMatMatMultSymbolic_SeqAIJ_SeqAIJ_SeqAIJ(Mat A,Mat B,Mat C,Pets
   Mat               BC;
   Mat_MatMatMatMult *matmatmatmult;
   char              *alg;
+  PetscBool         hash;
 
   PetscFunctionBegin;
   MatCheckProduct(D,5);
   if (D->product->data) SETERRQ(PetscObjectComm((PetscObject)D),PETSC_ERR_PLIB,"Product data not empty");
+  ierr = PetscStrcmp(D->product->alg,"hash_threaded",&hash);CHKERRQ(ierr);
   ierr = MatCreate(PETSC_COMM_SELF,&BC);CHKERRQ(ierr);
-  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(B,C,fill,BC);CHKERRQ(ierr);
+  if (hash) { /* both products with the threaded algorithm */
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(B,C,fill,BC);CHKERRQ(ierr);
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(A,BC,fill,D);CHKERRQ(ierr);
+  } else {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(B,C,fill,BC);CHKERRQ(ierr);
 
-  ierr = PetscStrallocpy(D->product->alg,&alg);CHKERRQ(ierr);
-  ierr = MatProductSetAlgorithm(D,"sorted");CHKERRQ(ierr); /* set alg for D = A*BC */
-  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(A,BC,fill,D);CHKERRQ(ierr);
-  ierr = MatProductSetAlgorithm(D,alg);CHKERRQ(ierr); /* resume original algorithm */
-  ierr = PetscFree(alg);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(D->product->alg,&alg);CHKERRQ(ierr);
+    ierr = MatProductSetAlgorithm(D,"sorted");CHKERRQ(ierr); /* set alg for D = A*BC */
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(A,BC,fill,D);CHKERRQ(ierr);
+    ierr = MatProductSetAlgorithm(D,alg);CHKERRQ(ierr); /* resume original algorithm */
+    ierr = PetscFree(alg);CHKERRQ(ierr);
+  }
 
   /* create struct Mat_MatMatMatMult and attached it to D */
   if (D->product->data) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Not yet coded");
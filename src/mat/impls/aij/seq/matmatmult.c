@@ -9,6 +9,10 @@
 #include <petscbt.h>
 #include <petsc/private/isimpl.h>
 #include <../src/mat/impls/dense/seq/dense.h>
+#include <petsc/private/hashtable.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat A,Mat B,Mat C)
 {
@@ -124,6 +128,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat C
     PetscFunctionReturn(0);
   }
 
+  /* hash_threaded */
+  ierr = PetscStrcmp(alg,"hash_threaded",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(A,B,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1150,6 +1161,237 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Sorted(Mat A,Mat B,PetscReal fil
   PetscFunctionReturn(0);
 }
 
+/*
+   "hash_threaded": Gustavson's row by row product, where each row of C is accumulated in a small open addressing hash
+   table instead of a dense array of length B->cmap->n. The rows of A are split into one part per OpenMP thread with
+   about the same number of multiplications, and each part has its own table, sized for the longest row of C it can
+   produce. The symbolic phase counts the nonzeros of each row of C in a first pass, sums the counts up to get ci[], and
+   then fills cj[] in a second pass.
+*/
+
+/* returns the slot of col in the table keys[] of size mask+1, where empty slots are -1; col is added if not present */
+PETSC_STATIC_INLINE PetscInt MatMatMultHashSlot_Private(PetscInt keys[],PetscInt mask,PetscInt col,PetscBool *isnew)
+{
+  PetscInt h = (PetscInt)(PetscHashInt(col) & (PetscHash_t)mask);
+
+  while (keys[h] != col && keys[h] != -1) h = (h+1) & mask;
+  *isnew  = (PetscBool)(keys[h] == -1);
+  keys[h] = col;
+  return h;
+}
+
+/* PetscSortInt() cannot be used by several threads at the same time, since it logs the call stack */
+static void MatMatMultHashSort_Private(PetscInt n,PetscInt x[])
+{
+  PetscInt i,j,last,pivot,t;
+
+  while (n > 8) {
+    pivot = x[n/2]; x[n/2] = x[0]; x[0] = pivot;
+    for (last=0,i=1; i<n; i++) {
+      if (x[i] < pivot) {last++; t = x[i]; x[i] = x[last]; x[last] = t;}
+    }
+    x[0] = x[last]; x[last] = pivot;
+    MatMatMultHashSort_Private(last,x);
+    x += last+1; n -= last+1;
+  }
+  for (i=1; i<n; i++) {
+    t = x[i];
+    for (j=i; j>0 && x[j-1] > t; j--) x[j] = x[j-1];
+    x[j] = t;
+  }
+}
+
+/*
+   Splits the rows of A into nparts parts with about the same number of multiplications in A*B, and gives the offset
+   hoff[p] of the hash table of each part; the table of a part is a power of 2 at least twice the longest row of C
+   that the part can produce
+*/
+static PetscErrorCode MatMatMultHashSetUp_Private(Mat A,Mat B,PetscInt *nparts,PetscInt **part,PetscInt **hoff,PetscLogDouble *flops)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  const PetscInt *ai = a->i,*aj = a->j,*bi = b->i;
+  PetscInt       am = A->rmap->n,bn = B->cmap->n,np = 1,i,j,k,p,rmax,*rub;
+  PetscInt64     *work;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  np = omp_get_max_threads();
+#endif
+  ierr = PetscMalloc2(np+1,part,np+1,hoff);CHKERRQ(ierr);
+  ierr = PetscMalloc2(am+1,&work,am,&rub);CHKERRQ(ierr);
+  work[0] = 0;
+  for (i=0; i<am; i++) {
+    for (rmax=0,j=ai[i]; j<ai[i+1]; j++) rmax += bi[aj[j]+1] - bi[aj[j]];
+    work[i+1] = work[i] + rmax + 1;
+    rub[i]    = PetscMin(rmax,bn);
+  }
+  *flops = 2.0*(work[am] - am);
+  (*part)[0] = 0;
+  for (i=0,p=1; p<np; p++) {
+    while (i < am && work[i]*np < p*work[am]) i++;
+    (*part)[p] = i;
+  }
+  (*part)[np] = am;
+  (*hoff)[0]  = 0;
+  for (p=0; p<np; p++) {
+    for (rmax=0,i=(*part)[p]; i<(*part)[p+1]; i++) rmax = PetscMax(rmax,rub[i]);
+    for (k=2; k<2*rmax; k*=2) ;
+    (*hoff)[p+1] = (*hoff)[p] + k;
+  }
+  ierr = PetscFree2(work,rub);CHKERRQ(ierr);
+  *nparts = np;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c = (Mat_SeqAIJ*)C->data;
+  const PetscInt *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*ci = c->i,*cj = c->j;
+  const MatScalar *aa = a->a,*ba = b->a;
+  MatScalar      *ca = c->a;
+  PetscInt       nparts,*part,*hoff,*keys,*slots,p;
+  PetscScalar    *vals;
+  PetscLogDouble flops;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultHashSetUp_Private(A,B,&nparts,&part,&hoff,&flops);CHKERRQ(ierr);
+  ierr = PetscMalloc3(hoff[nparts],&keys,hoff[nparts],&slots,hoff[nparts],&vals);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (p=0; p<nparts; p++) {
+    PetscInt    *pkeys = keys + hoff[p],*pslots = slots + hoff[p],mask = hoff[p+1] - hoff[p] - 1,i,j,k,cnt,h;
+    PetscScalar *pvals = vals + hoff[p],av;
+    PetscBool   isnew;
+
+    for (h=0; h<=mask; h++) pkeys[h] = -1;
+    for (i=part[p]; i<part[p+1]; i++) {
+      cnt = 0;
+      for (j=ai[i]; j<ai[i+1]; j++) {
+        av = aa[j];
+        for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+          h = MatMatMultHashSlot_Private(pkeys,mask,bj[k],&isnew);
+          if (isnew) {pslots[cnt++] = h; pvals[h] = av*ba[k];}
+          else pvals[h] += av*ba[k];
+        }
+      }
+      /* entries of C that are not in the product (with a new nonzero structure of A or B) are zero */
+      for (k=ci[i]; k<ci[i+1]; k++) {
+        for (h=(PetscInt)(PetscHashInt(cj[k]) & (PetscHash_t)mask); pkeys[h] != cj[k] && pkeys[h] != -1; h=(h+1) & mask) ;
+        ca[k] = pkeys[h] == -1 ? 0.0 : pvals[h];
+      }
+      for (k=0; k<cnt; k++) pkeys[pslots[k]] = -1;
+    }
+  }
+  ierr = PetscFree3(keys,slots,vals);CHKERRQ(ierr);
+  ierr = PetscFree2(part,hoff);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat B,PetscReal fill,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c;
+  const PetscInt *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j;
+  PetscInt       *ci,*cj,am = A->rmap->N,bn = B->cmap->N,bm = B->rmap->N,nparts,*part,*hoff,*keys,*slots,i,p;
+  MatScalar      *ca;
+  PetscReal      afill;
+  PetscLogDouble flops;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultHashSetUp_Private(A,B,&nparts,&part,&hoff,&flops);CHKERRQ(ierr);
+  ierr = PetscMalloc2(hoff[nparts],&keys,hoff[nparts],&slots);CHKERRQ(ierr);
+  ierr = PetscMalloc1(am+1,&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+
+  /* count the nonzeros of each row of C */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (p=0; p<nparts; p++) {
+    PetscInt  *pkeys = keys + hoff[p],*pslots = slots + hoff[p],mask = hoff[p+1] - hoff[p] - 1,i,j,k,cnt,h;
+    PetscBool isnew;
+
+    for (h=0; h<=mask; h++) pkeys[h] = -1;
+    for (i=part[p]; i<part[p+1]; i++) {
+      cnt = 0;
+      for (j=ai[i]; j<ai[i+1]; j++) {
+        for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+          h = MatMatMultHashSlot_Private(pkeys,mask,bj[k],&isnew);
+          if (isnew) pslots[cnt++] = h;
+        }
+      }
+      ci[i+1] = cnt;
+      for (k=0; k<cnt; k++) pkeys[pslots[k]] = -1;
+    }
+  }
+  for (i=0; i<am; i++) ci[i+1] += ci[i];
+  ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ci[am]+1,&ca);CHKERRQ(ierr);
+
+  /* fill the sorted column indices of each row of C, the values are first touched by the thread that computes them */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (p=0; p<nparts; p++) {
+    PetscInt  *pkeys = keys + hoff[p],*pslots = slots + hoff[p],mask = hoff[p+1] - hoff[p] - 1,i,j,k,cnt,h;
+    PetscBool isnew;
+
+    for (i=part[p]; i<part[p+1]; i++) {
+      cnt = 0;
+      for (j=ai[i]; j<ai[i+1]; j++) {
+        for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+          h = MatMatMultHashSlot_Private(pkeys,mask,bj[k],&isnew);
+          if (isnew) {pslots[cnt] = h; cj[ci[i] + cnt++] = bj[k];}
+        }
+      }
+      for (k=0; k<cnt; k++) {
+        pkeys[pslots[k]] = -1;
+        ca[ci[i] + k]    = 0.0;
+      }
+      MatMatMultHashSort_Private(cnt,cj + ci[i]);
+    }
+  }
+  ierr = PetscFree2(keys,slots);CHKERRQ(ierr);
+  ierr = PetscFree2(part,hoff);CHKERRQ(ierr);
+
+  /* put together the new symbolic matrix */
+  ierr = MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A),am,bn,ci,cj,ca,((PetscObject)A)->type_name,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(C,A,B);CHKERRQ(ierr);
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)(C->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/PetscMax(ai[am]+bi[bm],1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                  = ci[am];
+  c->nz                     = ci[am];
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    ierr = PetscInfo3(C,"%D threads; Fill ratio: given %g needed %g.\n",nparts,(double)fill,(double)afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(C,"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatDestroy_SeqAIJ_MatMatMultTrans(void *data)
 {
   PetscErrorCode      ierr;
@@ -1957,11 +2199,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
-#else
-  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hypre"};
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_threaded"};
   PetscInt       nalg = 8;
+#else
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_threaded","hypre"};
+  PetscInt       nalg = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2067,11 +2309,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool      flg = PETSC_FALSE;
   PetscInt       alg = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char      *algTypes[2] = {"scalable","rap"};
-  PetscInt        nalg = 2;
-#else
-  const char      *algTypes[3] = {"scalable","rap","hypre"};
+  const char      *algTypes[3] = {"scalable","rap","hash_threaded"};
   PetscInt        nalg = 3;
+#else
+  const char      *algTypes[4] = {"scalable","rap","hash_threaded","hypre"};
+  PetscInt        nalg = 4;
 #endif
 
   PetscFunctionBegin;
@@ -2140,8 +2382,8 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_ABC(Mat C)
   Mat_Product    *product = C->product;
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_threaded"};
+  PetscInt       nalg = 8;
 
   PetscFunctionBegin;
   /* Set default algorithm */
@@ -32,8 +32,9 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(0);
   }
 
-  /* "rap" */
+  /* "rap", and "hash_threaded" that computes both products of P^T*A*P with MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded() */
   ierr = PetscStrcmp(alg,"rap",&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscStrcmp(alg,"hash_threaded",&flg);CHKERRQ(ierr);}
   if (flg) {
     Mat_MatTransMatMult *atb;
 
@@ -21,8 +21,8 @@ PetscErrorCode MatInvertBlockDiagonal_SeqBAIJ(Mat A,const PetscScalar **values)
 {
   Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*) A->data;
   PetscErrorCode ierr;
-  PetscInt       *diag_offset,i,bs = A->rmap->bs,mbs = a->mbs,ipvt[5],bs2 = bs*bs,*v_pivots;
-  MatScalar      *v    = a->a,*odiag,*diag,work[25],*v_work;
+  PetscInt       *diag_offset,i,bs = A->rmap->bs,mbs = a->mbs,bs2 = bs*bs,*v_pivots;
+  MatScalar      *v    = a->a,*odiag,*diag,*v_work;
   PetscReal      shift = 0.0;
   PetscBool      allowzeropivot,zeropivotdetected=PETSC_FALSE;
 
@@ -61,61 +61,13 @@ PetscErrorCode MatInvertBlockDiagonal_SeqBAIJ(Mat A,const PetscScalar **values)
       diag    += 1;
     }
     break;
-  case 2:
+  case 2: case 3: case 4: case 5: case 6: case 7: case 8:
+    /* gather the blocks, then invert them several at a time */
     for (i=0; i<mbs; i++) {
-      odiag    = v + 4*diag_offset[i];
-      diag[0]  = odiag[0]; diag[1] = odiag[1]; diag[2] = odiag[2]; diag[3] = odiag[3];
-      ierr     = PetscKernel_A_gets_inverse_A_2(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag    += 4;
-    }
-    break;
-  case 3:
-    for (i=0; i<mbs; i++) {
-      odiag    = v + 9*diag_offset[i];
-      diag[0]  = odiag[0]; diag[1] = odiag[1]; diag[2] = odiag[2]; diag[3] = odiag[3];
-      diag[4]  = odiag[4]; diag[5] = odiag[5]; diag[6] = odiag[6]; diag[7] = odiag[7];
-      diag[8]  = odiag[8];
-      ierr     = PetscKernel_A_gets_inverse_A_3(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag    += 9;
-    }
-    break;
-  case 4:
-    for (i=0; i<mbs; i++) {
-      odiag  = v + 16*diag_offset[i];
-      ierr   = PetscArraycpy(diag,odiag,16);CHKERRQ(ierr);
-      ierr   = PetscKernel_A_gets_inverse_A_4(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag  += 16;
-    }
-    break;
-  case 5:
-    for (i=0; i<mbs; i++) {
-      odiag  = v + 25*diag_offset[i];
-      ierr   = PetscArraycpy(diag,odiag,25);CHKERRQ(ierr);
-      ierr   = PetscKernel_A_gets_inverse_A_5(diag,ipvt,work,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag  += 25;
-    }
-    break;
-  case 6:
-    for (i=0; i<mbs; i++) {
-      odiag  = v + 36*diag_offset[i];
-      ierr   = PetscArraycpy(diag,odiag,36);CHKERRQ(ierr);
-      ierr   = PetscKernel_A_gets_inverse_A_6(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag  += 36;
-    }
-    break;
-  case 7:
-    for (i=0; i<mbs; i++) {
-      odiag  = v + 49*diag_offset[i];
-      ierr   = PetscArraycpy(diag,odiag,49);CHKERRQ(ierr);
-      ierr   = PetscKernel_A_gets_inverse_A_7(diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
-      if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
-      diag  += 49;
+      ierr = PetscArraycpy(diag+bs2*i,v+bs2*diag_offset[i],bs2);CHKERRQ(ierr);
     }
+    ierr = PetscKernel_A_gets_inverse_A_Batched(bs,mbs,diag,shift,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
     break;
   default:
     ierr = PetscMalloc2(bs,&v_work,bs,&v_pivots);CHKERRQ(ierr);
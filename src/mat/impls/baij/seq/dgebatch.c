@@ -0,0 +1,143 @@
+/*
+     Inverts batches of small dense matrices of the same size, as in the block diagonals of PCPBJACOBI and PCVPBJACOBI.
+
+     The blocks are inverted PETSC_KERNEL_BATCH at a time with Gauss-Jordan elimination on a copy in which entry
+   (i,j) of the blocks of the batch is contiguous, so that each step of the elimination is a loop over the blocks that
+   the compiler vectorizes. The elimination does not pivot; a block whose pivot is zero, much smaller than the
+   entries below it, or small relative to the largest entry of the block is instead inverted alone with the partial
+   pivoting kernels of dgefa*.c, which also handle the zero pivots and the shift. As in dgefa*.c, only exactly zero
+   pivots are reported as such; the relative test only moves nearly singular blocks to the pivoting kernels.
+*/
+#include <petsc/private/matimpl.h>
+#include <petsc/private/kernels/blockinvert.h>
+
+#define PETSC_KERNEL_BATCH 8
+
+/* the pivots are accepted if they are at least this fraction of the largest entry below them, as in threshold pivoting */
+#define PETSC_KERNEL_BATCH_PIVOT_THRESHOLD 0.1
+/* and at least this fraction of the largest entry of the block, which also covers the last pivot with no entry below it */
+#define PETSC_KERNEL_BATCH_PIVOT_RTOL      PETSC_SQRT_MACHINE_EPSILON
+
+static PetscErrorCode PetscKernel_A_gets_inverse_A_Single_Private(PetscInt bs,MatScalar *a,PetscReal shift,PetscBool allowzeropivot,PetscBool *zeropivotdetected)
+{
+  PetscInt       ipvt[PETSC_KERNEL_BATCH_MAXBS];
+  MatScalar      work[PETSC_KERNEL_BATCH_MAXBS*PETSC_KERNEL_BATCH_MAXBS];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  switch (bs) {
+  case 2: ierr = PetscKernel_A_gets_inverse_A_2(a,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  case 3: ierr = PetscKernel_A_gets_inverse_A_3(a,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  case 4: ierr = PetscKernel_A_gets_inverse_A_4(a,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  case 5: ierr = PetscKernel_A_gets_inverse_A_5(a,ipvt,work,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  case 6: ierr = PetscKernel_A_gets_inverse_A_6(a,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  case 7: ierr = PetscKernel_A_gets_inverse_A_7(a,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+  default: ierr = PetscKernel_A_gets_inverse_A(bs,a,ipvt,work,allowzeropivot,zeropivotdetected);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Inverts the n <= PETSC_KERNEL_BATCH blocks of size bs starting at a; bs is a constant in each of the calls below,
+   so that the compiler generates a version of the loops for each block size
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscKernel_A_gets_inverse_A_Batch_Private(const PetscInt bs,PetscInt n,MatScalar *a,PetscReal shift,PetscBool allowzeropivot,PetscBool *zeropivotdetected)
+{
+  const PetscInt L = PETSC_KERNEL_BATCH,bs2 = bs*bs;
+  MatScalar      w[PETSC_KERNEL_BATCH_MAXBS*PETSC_KERNEL_BATCH_MAXBS*PETSC_KERNEL_BATCH],pinv[PETSC_KERNEL_BATCH],f[PETSC_KERNEL_BATCH];
+  PetscReal      colmax[PETSC_KERNEL_BATCH],amax[PETSC_KERNEL_BATCH],p;
+  PetscBool      bad[PETSC_KERNEL_BATCH],anybad = PETSC_FALSE,zp;
+  PetscInt       i,j,k,l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* the blocks beyond n are the identity */
+  for (l=0; l<L; l++) {
+    bad[l]  = PETSC_FALSE;
+    amax[l] = 0.0;
+  }
+  for (i=0; i<bs2; i++) {
+    for (l=0; l<n; l++) w[i*L+l] = a[l*bs2+i];
+    for (l=n; l<L; l++) w[i*L+l] = (i % (bs+1)) ? 0.0 : 1.0;
+    for (l=0; l<L; l++) amax[l] = PetscMax(amax[l],PetscAbsScalar(w[i*L+l]));
+  }
+  for (k=0; k<bs; k++) {
+    for (l=0; l<L; l++) colmax[l] = 0.0;
+    for (i=k+1; i<bs; i++) {
+      for (l=0; l<L; l++) colmax[l] = PetscMax(colmax[l],PetscAbsScalar(w[(k*bs+i)*L+l]));
+    }
+    for (l=0; l<L; l++) {
+      p = PetscAbsScalar(w[(k*bs+k)*L+l]);
+      if (!bad[l] && (p == 0.0 || p < PETSC_KERNEL_BATCH_PIVOT_THRESHOLD*colmax[l] || p < PETSC_KERNEL_BATCH_PIVOT_RTOL*amax[l])) {
+        /* this block is inverted with pivoting below, the elimination continues on the identity */
+        bad[l] = anybad = PETSC_TRUE;
+        for (i=0; i<bs2; i++) w[i*L+l] = (i % (bs+1)) ? 0.0 : 1.0;
+      }
+      pinv[l] = 1.0/w[(k*bs+k)*L+l];
+      w[(k*bs+k)*L+l] = 1.0;
+    }
+    /* scale row k, then eliminate column k from the other rows */
+    for (j=0; j<bs; j++) {
+      for (l=0; l<L; l++) w[(j*bs+k)*L+l] *= pinv[l];
+    }
+    for (i=0; i<bs; i++) {
+      if (i == k) continue;
+      for (l=0; l<L; l++) {
+        f[l]            = w[(k*bs+i)*L+l];
+        w[(k*bs+i)*L+l] = 0.0;
+      }
+      for (j=0; j<bs; j++) {
+        for (l=0; l<L; l++) w[(j*bs+i)*L+l] -= f[l]*w[(j*bs+k)*L+l];
+      }
+    }
+  }
+  for (i=0; i<bs2; i++) {
+    for (l=0; l<n; l++) if (!bad[l]) a[l*bs2+i] = w[i*L+l];
+  }
+  if (anybad) {
+    for (l=0; l<n; l++) {
+      if (!bad[l]) continue;
+      ierr = PetscKernel_A_gets_inverse_A_Single_Private(bs,a+l*bs2,shift,allowzeropivot,&zp);CHKERRQ(ierr);
+      if (zp && zeropivotdetected) *zeropivotdetected = PETSC_TRUE;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscKernel_A_gets_inverse_A_Batched - Inverts n consecutive blocks of size bs, 2 <= bs <= PETSC_KERNEL_BATCH_MAXBS,
+   stored in column major order
+
+   Input Parameters:
++  bs - the size of the blocks
+.  n - the number of blocks
+.  a - the blocks
+.  shift - the shift of the zero pivots, as in PetscKernel_A_gets_inverse_A_2()
+-  allowzeropivot - do not generate an error on zero pivots
+
+   Output Parameters:
++  a - the inverses of the blocks
+-  zeropivotdetected - set if a zero pivot was found in any block
+*/
+PETSC_INTERN PetscErrorCode PetscKernel_A_gets_inverse_A_Batched(PetscInt bs,PetscInt n,MatScalar *a,PetscReal shift,PetscBool allowzeropivot,PetscBool *zeropivotdetected)
+{
+  PetscInt       b,nb;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (zeropivotdetected) *zeropivotdetected = PETSC_FALSE;
+  for (b=0; b<n; b+=PETSC_KERNEL_BATCH) {
+    nb = PetscMin(PETSC_KERNEL_BATCH,n-b);
+    switch (bs) {
+    case 2: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(2,nb,a+4*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 3: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(3,nb,a+9*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 4: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(4,nb,a+16*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 5: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(5,nb,a+25*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 6: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(6,nb,a+36*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 7: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(7,nb,a+49*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    case 8: ierr = PetscKernel_A_gets_inverse_A_Batch_Private(8,nb,a+64*b,shift,allowzeropivot,zeropivotdetected);CHKERRQ(ierr); break;
+    default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Block size %D not supported by the batched kernels",bs);
+    }
+  }
+  PetscFunctionReturn(0);
+}
@@ -1982,8 +1982,8 @@ PetscErrorCode MatMatSolve_SeqSBAIJ_1_NaturalOrdering(Mat A,Mat B,Mat X)
   const PetscInt    mbs=a->mbs,*ai=a->i,*aj=a->j,*vj,*adiag=a->diag;
   const MatScalar   *aa=a->a,*v;
   const PetscScalar *b;
-  PetscScalar       *x,xi;
-  PetscInt          nz,i,j,neq,ldb,ldx;
+  PetscScalar       *x,*xk,xi;
+  PetscInt          nz,i,j,k,neq,ldb,ldx;
   PetscBool         isdense;
 
   PetscFunctionBegin;
@@ -1999,27 +1999,32 @@ PetscErrorCode MatMatSolve_SeqSBAIJ_1_NaturalOrdering(Mat A,Mat B,Mat X)
   ierr = MatDenseGetArray(X,&x);CHKERRQ(ierr);
   ierr = MatDenseGetLDA(X,&ldx);CHKERRQ(ierr);
   for (neq=0; neq<B->cmap->n; neq++) {
-    /* solve U^T*D*y = b by forward substitution */
-    ierr = PetscArraycpy(x,b,mbs);CHKERRQ(ierr);
-    for (i=0; i<mbs; i++) {
-      v  = aa + ai[i];
-      vj = aj + ai[i];
-      xi = x[i];
-      nz = ai[i+1] - ai[i] - 1; /* exclude diag[i] */
-      for (j=0; j<nz; j++) x[vj[j]] += v[j]*xi;
-      x[i] = xi*v[nz];  /* v[nz] = aa[diag[i]] = 1/D(i) */
+    ierr = PetscArraycpy(x+neq*ldx,b+neq*ldb,mbs);CHKERRQ(ierr);
+  }
+  /* all the right-hand sides are swept together, so that each row of the factor is loaded once */
+  /* solve U^T*D*y = b by forward substitution */
+  for (i=0; i<mbs; i++) {
+    v  = aa + ai[i];
+    vj = aj + ai[i];
+    nz = ai[i+1] - ai[i] - 1; /* exclude diag[i] */
+    for (neq=0; neq<B->cmap->n; neq++) {
+      xk = x + neq*ldx;
+      xi = xk[i];
+      for (j=0; j<nz; j++) xk[vj[j]] += v[j]*xi;
+      xk[i] = xi*v[nz];  /* v[nz] = aa[diag[i]] = 1/D(i) */
     }
-    /* solve U*x = y by backward substitution */
-    for (i=mbs-2; i>=0; i--) {
-      xi = x[i];
-      v  = aa + adiag[i] - 1; /* end of row i, excluding diag */
-      vj = aj + adiag[i] - 1;
-      nz = ai[i+1] - ai[i] - 1;
-      for (j=0; j<nz; j++) xi += v[-j]*x[vj[-j]];
-      x[i] = xi;
+  }
+  /* solve U*x = y by backward substitution */
+  for (i=mbs-2; i>=0; i--) {
+    v  = aa + adiag[i] - 1; /* end of row i, excluding diag */
+    vj = aj + adiag[i] - 1;
+    nz = ai[i+1] - ai[i] - 1;
+    for (neq=0; neq<B->cmap->n; neq++) {
+      xk = x + neq*ldx;
+      xi = xk[i];
+      for (k=0; k<nz; k++) xi += v[-k]*xk[vj[-k]];
+      xk[i] = xi;
     }
-    b += ldb;
-    x += ldx;
   }
   ierr = MatDenseRestoreArrayRead(B,&b);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(X,&x);CHKERRQ(ierr);
@@ -31,6 +31,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJDelta(Mat);
 
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
@@ -123,6 +125,10 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegister(MATMPIAIJSELL,     MatCreate_MPIAIJSELL);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQAIJSELL,     MatCreate_SeqAIJSELL);CHKERRQ(ierr);
 
+  ierr = MatRegisterRootName(MATAIJDELTA,MATSEQAIJDELTA,MATMPIAIJDELTA);CHKERRQ(ierr);
+  ierr = MatRegister(MATMPIAIJDELTA,    MatCreate_MPIAIJDelta);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJDELTA,    MatCreate_SeqAIJDelta);CHKERRQ(ierr);
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL,MATMPIAIJMKL);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIAIJMKL,      MatCreate_MPIAIJMKL);CHKERRQ(ierr);
@@ -16,7 +16,7 @@ PetscLogEvent MAT_Mult, MAT_Mults, MAT_MultConstrained, MAT_MultAdd, MAT_MultTra
 PetscLogEvent MAT_MultTransposeConstrained, MAT_MultTransposeAdd, MAT_Solve, MAT_Solves, MAT_SolveAdd, MAT_SolveTranspose, MAT_MatSolve,MAT_MatTrSolve;
 PetscLogEvent MAT_SolveTransposeAdd, MAT_SOR, MAT_ForwardSolve, MAT_BackwardSolve, MAT_LUFactor, MAT_LUFactorSymbolic;
 PetscLogEvent MAT_LUFactorNumeric, MAT_CholeskyFactor, MAT_CholeskyFactorSymbolic, MAT_CholeskyFactorNumeric, MAT_ILUFactor;
-PetscLogEvent MAT_ILUFactorSymbolic, MAT_ICCFactorSymbolic, MAT_Copy, MAT_Convert, MAT_Scale, MAT_AssemblyBegin;
+PetscLogEvent MAT_ILUFactorSymbolic, MAT_ICCFactorSymbolic, MAT_Copy, MAT_Convert, MAT_Autotune, MAT_Scale, MAT_AssemblyBegin;
 PetscLogEvent MAT_AssemblyEnd, MAT_SetValues, MAT_GetValues, MAT_GetRow, MAT_GetRowIJ, MAT_CreateSubMats, MAT_GetOrdering, MAT_RedundantMat, MAT_GetSeqNonzeroStructure;
 PetscLogEvent MAT_IncreaseOverlap, MAT_Partitioning, MAT_PartitioningND, MAT_Coarsen, MAT_ZeroEntries, MAT_Load, MAT_View, MAT_AXPY, MAT_FDColoringCreate;
 PetscLogEvent MAT_FDColoringSetUp, MAT_FDColoringApply,MAT_Transpose,MAT_FDColoringFunction, MAT_CreateSubMat;
@@ -32,6 +32,7 @@ PetscLogEvent MAT_GetBrowsOfAocols, MAT_Getlocalmat, MAT_Getlocalmatcondensed, M
 PetscLogEvent MAT_Applypapt, MAT_Applypapt_numeric, MAT_Applypapt_symbolic, MAT_GetSequentialNonzeroStructure;
 PetscLogEvent MAT_GetMultiProcBlock;
 PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
+PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
@@ -1290,6 +1291,8 @@ PetscErrorCode MatDestroy(Mat *A)
   ierr = PetscFree((*A)->defaultvectype);CHKERRQ(ierr);
   ierr = PetscFree((*A)->bsizes);CHKERRQ(ierr);
   ierr = PetscFree((*A)->solvertype);CHKERRQ(ierr);
+  ierr = PetscHMapIJVDestroy(&(*A)->hash_table);CHKERRQ(ierr);
+  ierr = PetscFree((*A)->hash_ops);CHKERRQ(ierr);
   ierr = MatDestroy_Redundant(&(*A)->redundant);CHKERRQ(ierr);
   ierr = MatProductClear(*A);CHKERRQ(ierr);
   ierr = MatNullSpaceDestroy(&(*A)->nullsp);CHKERRQ(ierr);
@@ -3373,18 +3376,19 @@ static PetscErrorCode MatMatSolve_Basic(Mat A,Mat B,Mat X,PetscBool trans)
 {
   PetscErrorCode ierr;
   Vec            b,x;
-  PetscInt       m,N,i;
+  PetscInt       ldb,ldx,N,i;
   PetscScalar    *bb,*xx;
 
   PetscFunctionBegin;
   ierr = MatDenseGetArrayRead(B,(const PetscScalar**)&bb);CHKERRQ(ierr);
   ierr = MatDenseGetArray(X,&xx);CHKERRQ(ierr);
-  ierr = MatGetLocalSize(B,&m,NULL);CHKERRQ(ierr);  /* number local rows */
-  ierr = MatGetSize(B,NULL,&N);CHKERRQ(ierr);       /* total columns in dense matrix */
+  ierr = MatDenseGetLDA(B,&ldb);CHKERRQ(ierr);  /* leading dimensions of the local arrays */
+  ierr = MatDenseGetLDA(X,&ldx);CHKERRQ(ierr);
+  ierr = MatGetSize(B,NULL,&N);CHKERRQ(ierr);   /* total columns in dense matrix */
   ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
   for (i=0; i<N; i++) {
-    ierr = VecPlaceArray(b,bb + i*m);CHKERRQ(ierr);
-    ierr = VecPlaceArray(x,xx + i*m);CHKERRQ(ierr);
+    ierr = VecPlaceArray(b,bb + i*ldb);CHKERRQ(ierr);
+    ierr = VecPlaceArray(x,xx + i*ldx);CHKERRQ(ierr);
     if (trans) {
       ierr = MatSolveTranspose(A,b,x);CHKERRQ(ierr);
     } else {
@@ -5307,7 +5311,10 @@ PetscErrorCode MatAssembled(Mat mat,PetscBool  *assembled)
 .  -mat_view socket - Sends matrix to socket, can be accessed from Matlab (See Users-Manual: ch_matlab )
 .  -viewer_socket_machine <machine> - Machine to use for socket
 .  -viewer_socket_port <port> - Port number to use for socket
--  -mat_view binary:filename[:append] - Save matrix to file in binary format
+.  -mat_view binary:filename[:append] - Save matrix to file in binary format
+.  -mat_autotune - At the first final assembly, time MatMult() in several formats and convert the matrix in place to the fastest one (sequential AIJ matrices only)
+.  -mat_autotune_types <seqaij,seqaijperm,seqaijsell,seqaijdelta> - The formats to try, may include seqbaij (if a block size is set) and seqsell
+-  -mat_autotune_trials <3> - The number of timed trials of each format, at least 1
 
    Notes:
    MatSetValues() generally caches the values.  The matrix is ready to
@@ -5320,6 +5327,9 @@ PetscErrorCode MatAssembled(Mat mat,PetscBool  *assembled)
    out by assembly. If you intend to use that extra space on a subsequent assembly, be sure to insert explicit zeros
    before MAT_FINAL_ASSEMBLY so the space is not compressed out.
 
+   With -mat_autotune the default formats are the subclasses of MATSEQAIJ, which support all of its operations; the
+   selected format of each matrix is logged by -log_view as an event MatAutotune_<type>, and -info prints the timings.
+
    Level: beginner
 
 .seealso: MatAssemblyBegin(), MatSetValues(), PetscDrawOpenX(), PetscDrawCreate(), MatView(), MatAssembled(), PetscViewerSocketOpen()
@@ -5362,6 +5372,9 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
     mat->structurally_symmetric_set = PETSC_FALSE;
   }
   if (inassm == 1 && type != MAT_FLUSH_ASSEMBLY) {
+    if (mat->autotune && mat->num_ass == 1) {
+      ierr = PetscTryMethod(mat,"MatAutotune_C",(Mat),(mat));CHKERRQ(ierr);
+    }
     ierr = MatViewFromOptions(mat,NULL,"-mat_view");CHKERRQ(ierr);
 
     if (mat->checksymmetryonassembly) {
@@ -5429,6 +5442,9 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
 -    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
         functions, instead sending only neighbor messages.
+-    MAT_FROZEN_OFF_PROC_ENTRIES - you know that every assembly after setting this flag will set exactly the same
+        off-process entries, in the same order, as the first one. The first assembly records the communication pattern;
+        subsequent assemblies skip sorting the stash and send only the values over persistent neighbor requests.
 
    Notes:
    Except for MAT_UNUSED_NONZERO_LOCATION_ERR and  MAT_ROW_ORIENTED all processes that share the matrix must pass the same value in flg!
@@ -5469,8 +5485,12 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
    is created during the first Matrix Assembly. This hash table is
    used the next time through, during MatSetVaules()/MatSetVaulesBlocked()
    to improve the searching of indices. MAT_NEW_NONZERO_LOCATIONS flag
-   should be used with MAT_USE_HASH_TABLE flag. This option is currently
-   supported by MATMPIBAIJ format only.
+   should be used with MAT_USE_HASH_TABLE flag. This option is
+   supported by MATMPIBAIJ format in this way. For MATSEQAIJ and MATMPIAIJ
+   set before MatSetUp(), instead of a preallocation, it inserts the values
+   into a hash table until the first final assembly, which preallocates the
+   exact nonzero structure from it; the rest of the assemblies work as usual.
+   This can also be set with -mat_use_hash_table.
 
    MAT_KEEP_NONZERO_PATTERN indicates when MatZeroRows() is called the zeroed entries
    are kept in the nonzero structure
@@ -5489,6 +5509,10 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
    MAT_SORTED_FULL - each process provides exactly its local rows; all column indices for a given row are passed in a
                      single call to MatSetValues(), preallocation is perfect, row oriented, INSERT_VALUES is used. Common
                      with finite difference schemes with non-periodic boundary conditions.
+
+   MAT_FROZEN_OFF_PROC_ENTRIES - the off-process entries of each assembly are checked against the recorded ones and an
+        error is generated if they differ. Setting the flag to PETSC_FALSE discards the recorded pattern. This option is
+        ignored with -matstash_legacy.
    Notes:
     Can only be called after MatSetSizes() and MatSetType() have been set.
 
@@ -5526,6 +5550,15 @@ PetscErrorCode MatSetOption(Mat mat,MatOption op,PetscBool flg)
       mat->stash.first_assembly_done = PETSC_FALSE;
     }
     PetscFunctionReturn(0);
+  case MAT_FROZEN_OFF_PROC_ENTRIES:
+    mat->assembly_frozen = flg;
+    if (!mat->assembly_frozen) {
+#if !defined(PETSC_HAVE_MPIUNI)
+      ierr = MatStashFrozenDestroy_Private(&mat->stash);CHKERRQ(ierr);
+      ierr = MatStashFrozenDestroy_Private(&mat->bstash);CHKERRQ(ierr);
+#endif
+    }
+    PetscFunctionReturn(0);
   case MAT_NO_OFF_PROC_ZERO_ROWS:
     mat->nooffproczerorows = flg;
     PetscFunctionReturn(0);
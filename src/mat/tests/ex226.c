@@ -281,6 +281,12 @@ int main(int argc,char **argv)
        nsize: 1
        args: -m 5 -n 5 -o 5 -stencil 3d27point -matmatmult_via rowmerge
 
+ test:
+      suffix: hash_threaded
+      nsize: 1
+      args: -m 5 -n 5 -o 5 -stencil 3d27point -matmatmult_via hash_threaded
+      output_file: output/ex226_2.out
+
  test:
       suffix: 3
       nsize: 4
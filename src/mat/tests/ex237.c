@@ -0,0 +1,87 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO() against MatSetValues().\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       M = 10,N = 10,ncoo,n,k,r,*coo_i,*coo_j;
+  PetscScalar    *coo_v;
+  PetscMPIInt    rank,size;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  N    = M;
+
+  /* every process contributes to all rows, with repeated entries and ignored (negative) entries */
+  ncoo = 3*M+2;
+  ierr = PetscMalloc3(ncoo,&coo_i,ncoo,&coo_j,ncoo,&coo_v);CHKERRQ(ierr);
+  for (r=0,n=0; r<M; r++) {
+    for (k=0; k<3; k++,n++) {
+      coo_i[n] = (r + rank) % M;
+      coo_j[n] = k == 2 ? coo_i[n] : (coo_i[n] + (k+1)*(rank+1)) % N;
+      coo_v[n] = (PetscScalar)(1 + r + 10*k + 100*rank);
+    }
+  }
+  coo_i[n] = -1; coo_j[n] = 0;  coo_v[n++] = 1000.0;
+  coo_i[n] = 0;  coo_j[n] = -1; coo_v[n++] = 1000.0;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,M,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetPreallocationCOO(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,M,N);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (n=0; n<ncoo; n++) {
+    ierr = MatSetValue(B,coo_i[n],coo_j[n],coo_v[n],ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatView(A,NULL);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,10,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatSetValuesCOO() with INSERT_VALUES differs from MatSetValues()\n");CHKERRQ(ierr);}
+
+  /* repeated assembly reuses the pattern */
+  ierr = MatSetValuesCOO(A,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,10,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatSetValuesCOO() with ADD_VALUES differs from MatSetValues()\n");CHKERRQ(ierr);}
+  ierr = MatScale(B,0.5);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,10,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: repeated MatSetValuesCOO() differs from MatSetValues()\n");CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -mat_type aij
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -mat_type aij
+
+   test:
+      suffix: baij
+      nsize: 2
+      args: -mat_type baij -M 6
+
+TEST*/
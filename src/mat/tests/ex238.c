@@ -0,0 +1,107 @@
+static char help[] = "Tests repeated assembly with MAT_FROZEN_OFF_PROC_ENTRIES.\n\n";
+
+#include <petscmat.h>
+
+/* Assembles a 1d finite element Laplacian, each process owns the elements starting at its rows so the last row of
+   each element may belong to the next process */
+static PetscErrorCode AssembleLaplacian(Mat A,PetscInt bs,PetscScalar scale,InsertMode imode)
+{
+  PetscErrorCode ierr;
+  PetscInt       M,rstart,rend,e,idx[2],k;
+  PetscScalar    v[16];
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  M /= bs; rstart /= bs; rend /= bs;
+  for (k=0; k<4*bs*bs; k++) v[k] = scale*(k % (2*bs+1) ? -1.0 : 2.0);
+  for (e=rstart; e<PetscMin(rend,M-1); e++) {
+    idx[0] = e; idx[1] = e+1;
+    if (imode == INSERT_VALUES) { /* only the diagonal blocks of the element, so that no location is inserted twice */
+      ierr = MatSetValuesBlocked(A,1,&idx[1],1,&idx[0],v,imode);CHKERRQ(ierr);
+      ierr = MatSetValuesBlocked(A,1,&idx[0],1,&idx[1],v,imode);CHKERRQ(ierr);
+    } else {
+      ierr = MatSetValuesBlocked(A,2,idx,2,idx,v,imode);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateMatrix(PetscInt M,PetscInt bs,Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(PETSC_COMM_WORLD,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,PETSC_DECIDE,PETSC_DECIDE,M*bs,M*bs);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(*A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatXAIJSetPreallocation(*A,bs,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(*A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       M = 8,bs = 1,it;
+  PetscBool      flg,subset = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-subset",&subset,NULL);CHKERRQ(ierr);
+
+  ierr = CreateMatrix(M,bs,&A);CHKERRQ(ierr);
+  ierr = CreateMatrix(M,bs,&B);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SUBSET_OFF_PROC_ENTRIES,subset);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_TRUE);CHKERRQ(ierr);
+
+  for (it=0; it<3; it++) {
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+    ierr = MatZeroEntries(B);CHKERRQ(ierr);
+    ierr = AssembleLaplacian(A,bs,it+1.0,ADD_VALUES);CHKERRQ(ierr);
+    ierr = AssembleLaplacian(B,bs,it+1.0,ADD_VALUES);CHKERRQ(ierr);
+    ierr = MatEqual(A,B,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: assembly %D with ADD_VALUES differs\n",it);CHKERRQ(ierr);}
+  }
+  ierr = MatView(A,NULL);CHKERRQ(ierr);
+
+  /* a different pattern needs to be recorded again */
+  ierr = MatSetOption(A,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_TRUE);CHKERRQ(ierr);
+  for (it=0; it<2; it++) {
+    ierr = AssembleLaplacian(A,bs,it+5.0,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = AssembleLaplacian(B,bs,it+5.0,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = MatEqual(A,B,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: assembly %D with INSERT_VALUES differs\n",it);CHKERRQ(ierr);}
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: aij
+      nsize: 3
+      args: -mat_type aij
+
+   test:
+      suffix: baij
+      nsize: 3
+      args: -mat_type baij -bs 2 -M 6
+
+   test:
+      suffix: aij_subset
+      nsize: 3
+      output_file: output/ex238_aij.out
+      args: -mat_type aij -subset
+
+TEST*/
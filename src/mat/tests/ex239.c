@@ -0,0 +1,96 @@
+static char help[] = "Tests MatMult() and MatMultAdd() of AIJ matrices, with inodes and compressed rows, against dense matrices.\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       M = 40,bs = 3,nb,rstart,rend,i,j,k,l;
+  PetscScalar    v[9];
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  if (bs > 3) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"Block size at most 3");
+  nb   = M/bs;
+
+  /* every other block row is empty, the others couple to a few blocks with a stride so that some of them are
+     off-process, and each block has bs rows with the same nonzero structure (an inode) */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,nb*bs,nb*bs);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart/bs; i<rend/bs; i++) {
+    if (i % 2) continue;
+    for (k=0; k<4; k++) {
+      j = (i + 7*k) % nb;
+      for (l=0; l<bs*bs; l++) v[l] = (PetscScalar)(1 + i + 2*j + 3*l);
+      ierr = MatSetValuesBlocked(A,1,&i,1,&j,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatMult() differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatMultAdd() differs\n");CHKERRQ(ierr);}
+
+  /* a new nonzero structure */
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = MatSetValue(A,i,i,1.0,ADD_VALUES);CHKERRQ(ierr);
+    ierr = MatSetValue(B,i,i,1.0,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatMult() differs after new nonzeros\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error: MatMultAdd() differs after new nonzeros\n");CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex239_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex239_1.out
+
+   test:
+      suffix: noinode
+      nsize: 2
+      output_file: output/ex239_1.out
+      args: -mat_no_inode -bs 1
+
+   test:
+      suffix: omp
+      nsize: 2
+      requires: openmp
+      output_file: output/ex239_1.out
+      args: -omp_num_threads 3
+
+   test:
+      suffix: omp_noinode
+      requires: openmp
+      output_file: output/ex239_1.out
+      args: -omp_num_threads 4 -mat_no_inode -bs 2
+
+TEST*/
@@ -0,0 +1,146 @@
+static char help[] = "Tests the level-scheduled MatSolve() of SeqAIJ ILU, ICC, LU and Cholesky factors against the default MatSolve().\n\n";
+
+#include <petscmat.h>
+
+/* Solves with the factor of A of type ftype computed with and without MatFactorInfo.levelsolve and compares the solutions */
+static PetscErrorCode TestFactor(Mat A,MatFactorType ftype,MatOrderingType otype,PetscReal levels,Vec b)
+{
+  Mat            F[2];
+  IS             isrow,iscol;
+  MatFactorInfo  info;
+  Vec            x[2];
+  PetscReal      nrm,err;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOrdering(A,otype,&isrow,&iscol);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+    info.fill       = 5.0;
+    info.levels     = levels;
+    info.levelsolve = k;
+    ierr = MatGetFactor(A,MATSOLVERPETSC,ftype,&F[k]);CHKERRQ(ierr);
+    switch (ftype) {
+    case MAT_FACTOR_LU:
+      ierr = MatLUFactorSymbolic(F[k],A,isrow,iscol,&info);CHKERRQ(ierr);
+      break;
+    case MAT_FACTOR_ILU:
+      ierr = MatILUFactorSymbolic(F[k],A,isrow,iscol,&info);CHKERRQ(ierr);
+      break;
+    case MAT_FACTOR_CHOLESKY:
+      ierr = MatCholeskyFactorSymbolic(F[k],A,isrow,&info);CHKERRQ(ierr);
+      break;
+    case MAT_FACTOR_ICC:
+      ierr = MatICCFactorSymbolic(F[k],A,isrow,&info);CHKERRQ(ierr);
+      break;
+    default: SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not tested");
+    }
+    /* factor twice to check that the level schedules are recomputed */
+    if (ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_ILU) {
+      ierr = MatLUFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+      ierr = MatLUFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+    } else {
+      ierr = MatCholeskyFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+      ierr = MatCholeskyFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+    }
+    ierr = VecDuplicate(b,&x[k]);CHKERRQ(ierr);
+    ierr = MatSolve(F[k],b,x[k]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(x[0],NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(x[1],-1.0,x[0]);CHKERRQ(ierr);
+  ierr = VecNorm(x[1],NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*nrm) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Error: %s %s(%D) level-scheduled solve differs by %g\n",otype,MatFactorTypes[ftype],(PetscInt)levels,(double)(err/nrm));CHKERRQ(ierr);
+  }
+  for (k=0; k<2; k++) {
+    ierr = MatDestroy(&F[k]);CHKERRQ(ierr);
+    ierr = VecDestroy(&x[k]);CHKERRQ(ierr);
+  }
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat             A;
+  Vec             b;
+  PetscRandom     rand;
+  PetscInt        m = 12,n = 9,bs = 1,i,j,c,d,row,col;
+  PetscScalar     v;
+  MatOrderingType otypes[] = {MATORDERINGNATURAL,MATORDERINGRCM,MATORDERINGND};
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+
+  /* the 5-point Laplacian on an m x n grid, coupled with bs components per grid point so that the factors have inodes */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m*n*bs,m*n*bs,5*bs,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  for (i=0; i<m*n; i++) {
+    for (c=0; c<bs; c++) {
+      row = i*bs + c;
+      for (d=0; d<bs; d++) {
+        v    = c == d ? 4.0*bs : -0.5;
+        col  = i*bs + d;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+        v    = c == d ? -1.0 : 0.0;
+        if (i % n) {col = (i-1)*bs + d; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+        if (i % n < n-1) {col = (i+1)*bs + d; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+        if (i >= n) {col = (i-n)*bs + d; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+        if (i < (m-1)*n) {col = (i+n)*bs + d; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SYMMETRIC,PETSC_TRUE);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&b,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+
+  for (j=0; j<3; j++) {
+    ierr = TestFactor(A,MAT_FACTOR_ILU,otypes[j],0,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,MAT_FACTOR_ILU,otypes[j],2,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,MAT_FACTOR_LU,otypes[j],0,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,MAT_FACTOR_ICC,otypes[j],0,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,MAT_FACTOR_ICC,otypes[j],1,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,MAT_FACTOR_CHOLESKY,otypes[j],0,b);CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex241_1.out
+
+   test:
+      suffix: inode
+      output_file: output/ex241_1.out
+      args: -bs 3 -m 7 -n 8
+
+   test:
+      suffix: omp
+      requires: openmp
+      output_file: output/ex241_1.out
+      args: -omp_num_threads 4 -m 30 -n 23
+
+   test:
+      suffix: omp_inode
+      requires: openmp
+      output_file: output/ex241_1.out
+      args: -omp_num_threads 3 -bs 2
+
+TEST*/
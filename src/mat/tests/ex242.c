@@ -0,0 +1,115 @@
+static char help[] = "Tests the Chow-Patel iterative ILU factorization and its Jacobi triangular solves against the standard ILU.\n\n";
+
+#include <petscmat.h>
+
+/* Solves with the ILU(levels) factors computed with the given sweeps and compares with the standard ILU, the solutions
+   should be the same if exact and differ otherwise */
+static PetscErrorCode TestFactor(Mat A,MatOrderingType otype,PetscReal levels,PetscInt sweeps,PetscInt solvesweeps,PetscBool exact,Vec b)
+{
+  Mat            F[2];
+  IS             isrow,iscol;
+  MatFactorInfo  info;
+  Vec            x[2];
+  PetscReal      nrm,err;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOrdering(A,otype,&isrow,&iscol);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+    info.fill        = 5.0;
+    info.levels      = levels;
+    info.sweeps      = k ? sweeps : 0;
+    info.solvesweeps = k ? solvesweeps : 0;
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F[k]);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(F[k],A,isrow,iscol,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+    ierr = VecDuplicate(b,&x[k]);CHKERRQ(ierr);
+    ierr = MatSolve(F[k],b,x[k]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(x[0],NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(x[1],-1.0,x[0]);CHKERRQ(ierr);
+  ierr = VecNorm(x[1],NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (exact && err > 1.e-10*nrm) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Error: %s ILU(%D) with %D sweeps and %D solve sweeps differs by %g\n",otype,(PetscInt)levels,sweeps,solvesweeps,(double)(err/nrm));CHKERRQ(ierr);
+  } else if (!exact && err <= 1.e-10*nrm) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Error: %s ILU(%D) with %D sweeps and %D solve sweeps is exact\n",otype,(PetscInt)levels,sweeps,solvesweeps);CHKERRQ(ierr);
+  }
+  for (k=0; k<2; k++) {
+    ierr = MatDestroy(&F[k]);CHKERRQ(ierr);
+    ierr = VecDestroy(&x[k]);CHKERRQ(ierr);
+  }
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat             A;
+  Vec             b;
+  PetscRandom     rand;
+  PetscInt        m = 9,n = 7,i,j,col[5],nc,N;
+  PetscScalar     v[5];
+  MatOrderingType otypes[] = {MATORDERINGNATURAL,MATORDERINGRCM};
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  N    = m*n;
+
+  /* a convection-diffusion operator on an m x n grid */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,N,N,5,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    nc = 0;
+    col[nc] = i; v[nc++] = 4.0;
+    if (i % n)         {col[nc] = i-1; v[nc++] = -1.3;}
+    if (i % n < n-1)   {col[nc] = i+1; v[nc++] = -0.7;}
+    if (i >= n)        {col[nc] = i-n; v[nc++] = -1.1;}
+    if (i < (m-1)*n)   {col[nc] = i+n; v[nc++] = -0.9;}
+    ierr = MatSetValues(A,1,&i,nc,col,v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&b,NULL);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+
+  /* the synchronous sweeps compute the exact ILU factors and triangular solves in a finite number of sweeps */
+  for (j=0; j<2; j++) {
+    ierr = TestFactor(A,otypes[j],0,N,0,PETSC_TRUE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],1,N,0,PETSC_TRUE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],2,N,N,PETSC_TRUE,b);CHKERRQ(ierr);
+    /* the Jacobi triangular solves with the standard factors, which only approximate the solves with few sweeps */
+    ierr = TestFactor(A,otypes[j],0,0,N,PETSC_TRUE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],1,0,N,PETSC_TRUE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],0,0,2,PETSC_FALSE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],1,0,2,PETSC_FALSE,b);CHKERRQ(ierr);
+    ierr = TestFactor(A,otypes[j],1,N,2,PETSC_FALSE,b);CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex242_1.out
+
+   test:
+      suffix: omp
+      requires: openmp
+      output_file: output/ex242_1.out
+      args: -omp_num_threads 4 -m 12 -n 10
+
+TEST*/
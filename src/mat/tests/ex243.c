@@ -0,0 +1,164 @@
+static char help[] = "Tests MatMult(), MatMultTranspose() and MatSOR() of MATSEQAIJDELTA against MATSEQAIJ.\n\n";
+
+#include <petscmat.h>
+
+/* Returns the relative difference of x and y in the infinity norm */
+static PetscErrorCode RelativeDiff(Vec x,Vec y,PetscReal *diff)
+{
+  PetscReal      nrm;
+  Vec            w;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr  = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr  = VecWAXPY(w,-1.0,x,y);CHKERRQ(ierr);
+  ierr  = VecNorm(w,NORM_INFINITY,diff);CHKERRQ(ierr);
+  ierr  = VecNorm(x,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  *diff = *diff/nrm;
+  ierr  = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Applies A and B with all the products and a few relaxations and prints the ones that differ */
+static PetscErrorCode TestProducts(Mat A,Mat B,PetscReal tol,PetscRandom rand)
+{
+  Vec            x,y,z[2];
+  MatSORType     sortypes[] = {(MatSORType)(SOR_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS),SOR_BACKWARD_SWEEP,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),SOR_SYMMETRIC_SWEEP,SOR_EISENSTAT};
+  PetscReal      diff;
+  PetscInt       k,s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z[1]);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rand);CHKERRQ(ierr);
+
+  ierr = MatMult(A,x,z[0]);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z[1]);CHKERRQ(ierr);
+  ierr = RelativeDiff(z[0],z[1],&diff);CHKERRQ(ierr);
+  if (diff > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult() differs by %g\n",(double)diff);CHKERRQ(ierr);}
+  ierr = MatMultAdd(A,x,y,z[0]);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,y,z[1]);CHKERRQ(ierr);
+  ierr = RelativeDiff(z[0],z[1],&diff);CHKERRQ(ierr);
+  if (diff > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultAdd() differs by %g\n",(double)diff);CHKERRQ(ierr);}
+  ierr = MatMultTranspose(A,y,z[0]);CHKERRQ(ierr);
+  ierr = MatMultTranspose(B,y,z[1]);CHKERRQ(ierr);
+  ierr = RelativeDiff(z[0],z[1],&diff);CHKERRQ(ierr);
+  if (diff > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultTranspose() differs by %g\n",(double)diff);CHKERRQ(ierr);}
+  ierr = MatMultTransposeAdd(A,y,x,z[0]);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(B,y,x,z[1]);CHKERRQ(ierr);
+  ierr = RelativeDiff(z[0],z[1],&diff);CHKERRQ(ierr);
+  if (diff > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultTransposeAdd() differs by %g\n",(double)diff);CHKERRQ(ierr);}
+
+  for (s=0; s<(PetscInt)(sizeof(sortypes)/sizeof(sortypes[0])); s++) {
+    for (k=0; k<2; k++) {
+      ierr = VecCopy(x,z[k]);CHKERRQ(ierr);
+      ierr = MatSOR(k ? B : A,y,1.2,sortypes[s],0.0,2,1,z[k]);CHKERRQ(ierr);
+    }
+    ierr = RelativeDiff(z[0],z[1],&diff);CHKERRQ(ierr);
+    if (diff > tol) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatSOR() of type %D differs by %g\n",(PetscInt)sortypes[s],(double)diff);CHKERRQ(ierr);}
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&z[1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  PetscRandom    rand;
+  PetscInt       n = 70000,i,j;
+  PetscReal      tol = 1.e-12;
+  PetscBool      single,flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,NULL,"-mat_aijdelta_single",&single);CHKERRQ(ierr);
+  if (single) tol = 1.e-5;
+
+  /* a diagonally dominant matrix with far couplings, so that rows of large matrices span more than 65536 columns */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,n,n,6,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = MatSetValue(A,i,i,10.0,ADD_VALUES);CHKERRQ(ierr);
+    if (i) {ierr = MatSetValue(A,i,i-1,-1.0-0.001*(i%7),ADD_VALUES);CHKERRQ(ierr);}
+    if (i < n-1) {ierr = MatSetValue(A,i,i+1,-2.0,ADD_VALUES);CHKERRQ(ierr);}
+    j    = (i + 66000) % n;
+    ierr = MatSetValue(A,i,j,0.5,ADD_VALUES);CHKERRQ(ierr);
+    j    = (7*i + 3) % n;
+    ierr = MatSetValue(A,i,j,0.25,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATSEQAIJDELTA,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)B,MATSEQAIJDELTA,&flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Conversion to MATSEQAIJDELTA failed");
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = TestProducts(A,B,tol,rand);CHKERRQ(ierr);
+
+  /* changing the values must update the copies */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+  ierr = MatShift(B,1.0);CHKERRQ(ierr);
+  ierr = TestProducts(A,B,tol,rand);CHKERRQ(ierr);
+
+  /* and so must a new nonzero structure */
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (i=0; i<n; i+=n/10+1) {
+    j    = (i + n/2) % n;
+    ierr = MatSetValue(A,i,j,0.125,ADD_VALUES);CHKERRQ(ierr);
+    ierr = MatSetValue(B,i,j,0.125,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = TestProducts(A,B,tol,rand);CHKERRQ(ierr);
+
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = TestProducts(A,C,tol,rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatConvert(B,MATSEQAIJ,MAT_INPLACE_MATRIX,&B);CHKERRQ(ierr);
+  ierr = MatEqual(A,B,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"Conversion back to MATSEQAIJ changed the matrix\n");CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex243_1.out
+
+   test:
+      suffix: single
+      requires: !complex
+      output_file: output/ex243_1.out
+      args: -mat_aijdelta_single
+
+   test:
+      suffix: small
+      output_file: output/ex243_1.out
+      args: -n 100
+
+   test:
+      suffix: omp
+      requires: openmp !complex
+      output_file: output/ex243_1.out
+      args: -omp_num_threads 3 -mat_aijdelta_single
+
+TEST*/
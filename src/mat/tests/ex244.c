@@ -0,0 +1,107 @@
+static char help[] = "Tests the assembly of MATAIJ into a hash table without preallocation against a preallocated one.\n\n";
+
+#include <petscmat.h>
+
+/* Adds the element matrices of the quadrilaterals of an n x n grid of nodes, each process adding a contiguous range of elements */
+static PetscErrorCode AssembleElements(Mat A,PetscInt n,PetscInt shift)
+{
+  PetscMPIInt    rank,size;
+  PetscInt       e,estart,eend,ne = (n-1)*(n-1),k,l,idx[4];
+  PetscScalar    values[16];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr   = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  estart = (ne*rank)/size;
+  eend   = (ne*(rank+1))/size;
+  /* run through the elements backwards, so that most of them are added to rows owned by another process */
+  for (e=ne-1-estart; e>=ne-eend; e--) {
+    idx[0] = (e/(n-1))*n + e%(n-1);
+    idx[1] = idx[0]+1;
+    idx[2] = idx[0]+n;
+    idx[3] = idx[2]+1;
+    for (k=0; k<4; k++) for (l=0; l<4; l++) values[4*k+l] = k == l ? 4.0+shift : -1.0/(1+e%7);
+    ierr = MatSetValues(A,4,idx,4,idx,values,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+  /* a second sweep over the diagonal overwrites the sums */
+  for (e=estart; e<eend; e++) {
+    k    = (e/(n-1))*n + e%(n-1);
+    ierr = MatSetValue(A,k,k,10.0+shift,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Prints a line if A and B differ, or if A was not assembled into exactly preallocated storage */
+static PetscErrorCode Compare(Mat A,Mat B,const char *stage)
+{
+  MatInfo        info;
+  PetscBool      equal;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+  if (!equal) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: the matrices differ\n",stage);CHKERRQ(ierr);}
+  ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  if (info.mallocs) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: %g mallocs during MatSetValues()\n",stage,info.mallocs);CHKERRQ(ierr);}
+  if (info.nz_unneeded) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: %g unneeded nonzeros\n",stage,info.nz_unneeded);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  PetscInt       n = 10;
+  PetscBool      option = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-set_option",&option,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  if (option) {ierr = MatSetOption(A,MAT_USE_HASH_TABLE,PETSC_TRUE);CHKERRQ(ierr);}
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = AssembleElements(A,n,0);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = AssembleElements(B,n,0);CHKERRQ(ierr);
+  ierr = Compare(A,B,"First assembly");CHKERRQ(ierr);
+
+  /* the later assemblies reuse the nonzero structure */
+  ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  ierr = MatZeroEntries(B);CHKERRQ(ierr);
+  ierr = AssembleElements(A,n,1);CHKERRQ(ierr);
+  ierr = AssembleElements(B,n,1);CHKERRQ(ierr);
+  ierr = Compare(A,B,"Second assembly");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2 3}}
+      output_file: output/ex244_1.out
+
+   test:
+      suffix: options
+      nsize: 2
+      output_file: output/ex244_1.out
+      args: -set_option 0 -mat_use_hash_table -n 7
+
+TEST*/
@@ -0,0 +1,129 @@
+static char help[] = "Tests MatInvertBlockDiagonal() and MatInvertVariableBlockDiagonal() on blocks that need pivoting.\n\n";
+
+#include <petscmat.h>
+
+/*
+   Fills the diagonal block of size bs starting at row r, and couples it to the previous block. The blocks are diagonally
+   dominant, except that every third one has its rows shifted cyclically so that its diagonal is small, and every
+   fifth one has a zero on the diagonal as well.
+*/
+static PetscErrorCode SetBlock(Mat A,PetscRandom rand,PetscInt b,PetscInt r,PetscInt bs)
+{
+  PetscInt       i,j,row;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<bs; i++) {
+    row = (b % 3 || bs == 1) ? i : (i+1) % bs;
+    for (j=0; j<bs; j++) {
+      ierr = PetscRandomGetValue(rand,&v);CHKERRQ(ierr);
+      if (i == j) v += bs;
+      if (!(b % 5) && bs > 1 && row == 0 && j == 0) v = 0.0;
+      ierr = MatSetValue(A,r+row,r+j,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+    if (r) {ierr = MatSetValue(A,r+i,r-1,-1.0,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Returns the largest entry of B inv(B) - I over the blocks, the inverses being stored by columns */
+static PetscErrorCode CheckInverses(Mat A,PetscInt nblocks,const PetscInt *bsizes,const PetscScalar *inv,PetscReal *err)
+{
+  PetscInt       b,i,j,k,r = 0,idx[16];
+  PetscScalar    B[256],s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *err = 0.0;
+  for (b=0; b<nblocks; b++) {
+    for (i=0; i<bsizes[b]; i++) idx[i] = r+i;
+    ierr = MatGetValues(A,bsizes[b],idx,bsizes[b],idx,B);CHKERRQ(ierr);
+    for (i=0; i<bsizes[b]; i++) {
+      for (j=0; j<bsizes[b]; j++) {
+        s = i == j ? -1.0 : 0.0;
+        for (k=0; k<bsizes[b]; k++) s += B[i*bsizes[b]+k]*inv[k+j*bsizes[b]];
+        *err = PetscMax(*err,PetscAbsScalar(s));
+      }
+    }
+    r   += bsizes[b];
+    inv += bsizes[b]*bsizes[b];
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat               A;
+  PetscRandom       rand;
+  PetscInt          bs = 4,mbs = 13,nblocks,bsizes[64],b,r,n;
+  const PetscScalar *inv;
+  PetscScalar       *vinv;
+  PetscReal         err;
+  PetscBool         variable = PETSC_FALSE;
+  PetscErrorCode    ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mbs",&mbs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-variable",&variable,NULL);CHKERRQ(ierr);
+  if (bs > 16 || mbs > 64) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"The test supports block sizes up to 16 and up to 64 blocks");
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+
+  /* the variable block sizes come in runs of equal sizes, with sizes that are and are not batched */
+  nblocks = mbs;
+  for (b=0, n=0; b<nblocks; b++) {
+    bsizes[b] = variable ? 1 + (b/3) % 9 : bs;
+    n        += bsizes[b];
+  }
+  ierr = MatCreate(PETSC_COMM_SELF,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,n,n,n,n);CHKERRQ(ierr);
+  if (!variable) {ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);}
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (b=0, r=0; b<nblocks; b++) {
+    ierr = SetBlock(A,rand,b,r,bsizes[b]);CHKERRQ(ierr);
+    r   += bsizes[b];
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  if (variable) {
+    for (b=0, r=0; b<nblocks; b++) r += bsizes[b]*bsizes[b];
+    ierr = PetscMalloc1(r,&vinv);CHKERRQ(ierr);
+    ierr = MatInvertVariableBlockDiagonal(A,nblocks,bsizes,vinv);CHKERRQ(ierr);
+    ierr = CheckInverses(A,nblocks,bsizes,vinv,&err);CHKERRQ(ierr);
+    ierr = PetscFree(vinv);CHKERRQ(ierr);
+  } else {
+    ierr = MatInvertBlockDiagonal(A,&inv);CHKERRQ(ierr);
+    ierr = CheckInverses(A,nblocks,bsizes,inv,&err);CHKERRQ(ierr);
+  }
+  if (err > 1.e-10) {ierr = PetscPrintf(PETSC_COMM_SELF,"The inverses of the blocks are off by %g\n",(double)err);CHKERRQ(ierr);}
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex245_1.out
+      args: -bs {{1 2 3 4 5 6 7 8 9}} -mat_type {{aij baij}}
+
+   test:
+      suffix: mbs
+      output_file: output/ex245_1.out
+      args: -bs {{3 8}} -mbs {{1 8 17}}
+
+   test:
+      suffix: variable
+      output_file: output/ex245_1.out
+      args: -variable -mbs {{20 27}}
+
+TEST*/
@@ -204,6 +204,17 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via heap
       output_file: output/ex93_1.out
 
+   test:
+      suffix: hash_threaded
+      args: -matmatmult_via hash_threaded -matptap_via hash_threaded
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: hash_threaded_omp
+      requires: openmp
+      args: -matmatmult_via hash_threaded -matptap_via hash_threaded -omp_num_threads 3
+      output_file: output/ex93_1.out
+
    #HYPRE PtAP is broken for complex numbers
    test:
       suffix: hypre
@@ -328,6 +328,19 @@ int main(int argc,char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_matproduct_ab_via rowmerge -inner_offdiag_matproduct_ab_via rowmerge
      output_file: output/ex96_1.out
 
+   test:
+     suffix: seq_hash_threaded
+     nsize: 3
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_matproduct_ab_via hash_threaded -inner_offdiag_matproduct_ab_via hash_threaded
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: seq_hash_threaded_omp
+     nsize: 2
+     requires: openmp
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_matproduct_ab_via hash_threaded -inner_offdiag_matproduct_ab_via hash_threaded -omp_num_threads 3
+     output_file: output/ex96_1.out
+
    test:
      suffix: allatonce
      nsize: 3
@@ -225,6 +225,7 @@ PetscErrorCode  MatSetFromOptions(Mat B)
   ierr = PetscOptionsName("-mat_is_symmetric","Checks if mat is symmetric on MatAssemblyEnd()","MatIsSymmetric",&B->checksymmetryonassembly);CHKERRQ(ierr);
   ierr = PetscOptionsReal("-mat_is_symmetric","Checks if mat is symmetric on MatAssemblyEnd()","MatIsSymmetric",B->checksymmetrytol,&B->checksymmetrytol,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-mat_null_space_test","Checks if provided null space is correct in MatAssemblyEnd()","MatSetNullSpaceTest",B->checknullspaceonassembly,&B->checknullspaceonassembly,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_autotune","Convert to the format with the fastest MatMult() at the first MatAssemblyEnd()","MatAssemblyEnd",B->autotune,&B->autotune,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-mat_error_if_failure","Generate an error if an error occurs when factoring the matrix","MatSetErrorIfFailure",B->erroriffailure,&B->erroriffailure,NULL);CHKERRQ(ierr);
 
   if (B->ops->setfromoptions) {
@@ -322,6 +323,162 @@ PetscErrorCode MatXAIJSetPreallocation(Mat A,PetscInt bs,const PetscInt dnnz[],c
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat            preallocator;
+  IS             is_coo_i,is_coo_j;
+  PetscScalar    zero = 0.0;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),&preallocator);CHKERRQ(ierr);
+  ierr = MatSetType(preallocator,MATPREALLOCATOR);CHKERRQ(ierr);
+  ierr = MatSetSizes(preallocator,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(preallocator,A,A);CHKERRQ(ierr);
+  ierr = MatSetUp(preallocator);CHKERRQ(ierr);
+  for (n=0; n<ncoo; n++) {
+    ierr = MatSetValue(preallocator,coo_i[n],coo_j[n],zero,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatPreallocatorPreallocate(preallocator,PETSC_TRUE,A);CHKERRQ(ierr);
+  ierr = MatDestroy(&preallocator);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,ncoo,coo_i,PETSC_COPY_VALUES,&is_coo_i);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,ncoo,coo_j,PETSC_COPY_VALUES,&is_coo_j);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_coo_i",(PetscObject)is_coo_i);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_coo_j",(PetscObject)is_coo_j);CHKERRQ(ierr);
+  ierr = ISDestroy(&is_coo_i);CHKERRQ(ierr);
+  ierr = ISDestroy(&is_coo_j);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_Basic(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  IS             is_coo_i,is_coo_j;
+  const PetscInt *coo_i,*coo_j;
+  PetscInt       n,n_i,n_j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_coo_i",(PetscObject*)&is_coo_i);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_coo_j",(PetscObject*)&is_coo_j);CHKERRQ(ierr);
+  if (!is_coo_i || !is_coo_j) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() before MatSetValuesCOO()");
+  ierr = ISGetLocalSize(is_coo_i,&n_i);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(is_coo_j,&n_j);CHKERRQ(ierr);
+  if (n_i != n_j) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_COR,"Wrong local size %D != %D",n_i,n_j);
+  ierr = ISGetIndices(is_coo_i,&coo_i);CHKERRQ(ierr);
+  ierr = ISGetIndices(is_coo_j,&coo_j);CHKERRQ(ierr);
+  if (imode != ADD_VALUES) {
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  }
+  for (n=0; n<n_i; n++) {
+    ierr = MatSetValue(A,coo_i[n],coo_j[n],coo_v[n],ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(is_coo_i,&coo_i);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(is_coo_j,&coo_j);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatSetPreallocationCOO - set preallocation for matrices using a coordinate format of the entries
+
+   Collective on Mat
+
+   Input Arguments:
++  A - matrix being preallocated
+.  ncoo - number of entries in the locally owned part of the coordinate format
+.  coo_i - row indices
+-  coo_j - column indices
+
+   Level: beginner
+
+   Notes:
+   The indices are global. Entries with negative row or column indices are ignored, and entries may be
+   repeated, in which case their values are summed by MatSetValuesCOO(). Any process can provide entries
+   for any row; the entries for rows owned by other processes are communicated by MatSetValuesCOO().
+
+   The sorting of the entries, the removal of duplicates and the routing of the off-process entries are
+   done once here. For MATSEQAIJ and MATMPIAIJ matrices every later call to MatSetValuesCOO() then moves
+   the values directly into the compressed row storage, and the off-process values with a single exchange
+   through a PetscSF, without searching the rows or going through the MatStash used by MatSetValues().
+   Other matrix types use a slower fallback based on MATPREALLOCATOR and MatSetValues().
+
+   The matrix is assembled on return, with all entries in the nonzero structure set to zero. Calling
+   MatSetValues() afterwards with entries outside this structure generates an error.
+
+.seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatSeqBAIJSetPreallocation(), MatMPIBAIJSetPreallocation(), MatXAIJSetPreallocation()
+@*/
+PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode (*f)(Mat,PetscInt,const PetscInt[],const PetscInt[]) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (ncoo) PetscValidIntPointer(coo_i,3);
+  if (ncoo) PetscValidIntPointer(coo_j,4);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetPreallocationCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  } else { /* allow fallback */
+    ierr = MatSetPreallocationCOO_Basic(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  A->preallocated = PETSC_TRUE;
+  A->nonzerostate++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatSetValuesCOO - set values at once in a matrix preallocated using MatSetPreallocationCOO()
+
+   Collective on Mat
+
+   Input Arguments:
++  A - matrix being preallocated
+.  coo_v - the matrix values, in the same order as the indices passed to MatSetPreallocationCOO()
+-  imode - the insert mode
+
+   Level: beginner
+
+   Notes:
+   With INSERT_VALUES each matrix entry is replaced by the sum of the values of the coordinate entries that
+   map to it; with ADD_VALUES that sum is added to the current value.
+
+   The matrix is assembled on return, there is no need to call MatAssemblyBegin() and MatAssemblyEnd().
+
+.seealso: MatSetPreallocationCOO(), InsertMode, INSERT_VALUES, ADD_VALUES
+@*/
+PetscErrorCode MatSetValuesCOO(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode (*f)(Mat,const PetscScalar[],InsertMode) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  MatCheckPreallocated(A,1);
+  PetscValidLogicalCollectiveEnum(A,imode,3);
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Only INSERT_VALUES and ADD_VALUES are supported");
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetValuesCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,coo_v,imode);CHKERRQ(ierr);
+  } else { /* allow fallback */
+    ierr = MatSetValuesCOO_Basic(A,coo_v,imode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
         Merges some information from Cs header to A; the C object is then destroyed
 
@@ -79,6 +79,9 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
 
+  stash->frozen_record = PETSC_FALSE;
+  stash->frozen_setup  = PETSC_FALSE;
+
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_reproduce",&stash->reproduce,NULL);CHKERRQ(ierr);
 #if !defined(PETSC_HAVE_MPIUNI)
   flg  = PETSC_FALSE;
@@ -110,6 +113,9 @@ PetscErrorCode MatStashDestroy_Private(MatStash *stash)
   PetscFunctionBegin;
   ierr = PetscMatStashSpaceDestroy(&stash->space_head);CHKERRQ(ierr);
   if (stash->ScatterDestroy) {ierr = (*stash->ScatterDestroy)(stash);CHKERRQ(ierr);}
+#if !defined(PETSC_HAVE_MPIUNI)
+  ierr = MatStashFrozenDestroy_Private(stash);CHKERRQ(ierr);
+#endif
 
   stash->space = 0;
 
@@ -725,6 +731,12 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode in
     }
   }
   if (cnt != n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"MatStash n %D, but counted %D entries",n,cnt);
+  if (stash->frozen_record) { /* Remember the stashed entries in the order they were set, frozen_map[] is filled below */
+    stash->frozen_n = n;
+    ierr = PetscMalloc3(n,&stash->frozen_idx,n,&stash->frozen_idy,n,&stash->frozen_map);CHKERRQ(ierr);
+    ierr = PetscArraycpy(stash->frozen_idx,row,n);CHKERRQ(ierr);
+    ierr = PetscArraycpy(stash->frozen_idy,col,n);CHKERRQ(ierr);
+  }
   ierr = PetscSortIntWithArrayPair(n,row,col,perm);CHKERRQ(ierr);
   /* Scan through the rows, sorting each one, combining duplicates, and packing send buffers */
   for (rowstart=0,cnt=0,i=1; i<=n; i++) {
@@ -738,7 +750,9 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode in
         block->row = row[rowstart];
         block->col = col[colstart];
         ierr = PetscArraycpy(block->vals,valptr[perm[colstart]],bs2);CHKERRQ(ierr);
+        if (stash->frozen_record) stash->frozen_map[perm[colstart]] = cnt;
         for (j=colstart+1; j<i && col[j] == col[colstart]; j++) { /* Add any extra stashed blocks at the same (row,col) */
+          if (stash->frozen_record) stash->frozen_map[perm[j]] = cnt;
           if (insertmode == ADD_VALUES) {
             for (l=0; l<bs2; l++) block->vals[l] += valptr[perm[j]][l];
           } else {
@@ -746,6 +760,7 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode in
           }
         }
         colstart = j;
+        cnt++;
       }
       rowstart = i;
     }
@@ -840,6 +855,39 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionReturn(0);
 }
 
+/*
+ * Frozen pattern: the stashed entries are checked against the recorded ones and accumulated directly into the send
+ * buffer, which holds for each destination the values of its blocks followed by the InsertMode.
+ */
+static PetscErrorCode MatStashScatterBegin_Frozen(Mat mat,MatStash *stash)
+{
+  PetscErrorCode     ierr;
+  PetscMatStashSpace space;
+  PetscInt           bs2 = stash->bs*stash->bs,i,k,l;
+
+  PetscFunctionBegin;
+  if (stash->n != stash->frozen_n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"MAT_FROZEN_OFF_PROC_ENTRIES set, but %D off-process entries stashed instead of %D in the initial assembly",stash->n,stash->frozen_n);
+  ierr = PetscArrayzero(stash->frozen_sendbuf,stash->frozen_sendoffset[stash->frozen_nsendranks]);CHKERRQ(ierr);
+  for (space=stash->space_head,k=0; space; space=space->next) {
+    for (i=0; i<space->local_used; i++,k++) {
+      PetscScalar *sendvals = &stash->frozen_sendbuf[stash->frozen_map[k]];
+      const PetscScalar *vals = &space->val[i*bs2];
+      if (PetscUnlikely(space->idx[i] != stash->frozen_idx[k] || space->idy[i] != stash->frozen_idy[k])) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"MAT_FROZEN_OFF_PROC_ENTRIES set, but entry (%D,%D) stashed where (%D,%D) was in the initial assembly",space->idx[i],space->idy[i],stash->frozen_idx[k],stash->frozen_idy[k]);
+      if (mat->insertmode == ADD_VALUES) {
+        for (l=0; l<bs2; l++) sendvals[l] += vals[l];
+      } else {
+        ierr = PetscArraycpy(sendvals,vals,bs2);CHKERRQ(ierr);
+      }
+    }
+  }
+  for (i=0; i<stash->frozen_nsendranks; i++) stash->frozen_sendbuf[stash->frozen_sendoffset[i+1]-1] = (PetscReal)mat->insertmode;
+  if (stash->frozen_nrecvranks) {ierr = MPI_Startall(stash->frozen_nrecvranks,stash->frozen_reqs);CHKERRQ(ierr);}
+  if (stash->frozen_nsendranks) {ierr = MPI_Startall(stash->frozen_nsendranks,stash->frozen_reqs+stash->frozen_nrecvranks);CHKERRQ(ierr);}
+  stash->recvcount  = 0;
+  stash->insertmode = &mat->insertmode;
+  PetscFunctionReturn(0);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -850,6 +898,11 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   char *sendblocks;
 
   PetscFunctionBegin;
+  if (stash->frozen_setup) {
+    ierr = MatStashScatterBegin_Frozen(mat,stash);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  stash->frozen_record = mat->assembly_frozen;
   if (PetscDefined(USE_DEBUG)) { /* make sure all processors are either in INSERTMODE or ADDMODE */
     InsertMode addv;
     ierr = MPIU_Allreduce((PetscEnum*)&mat->insertmode,(PetscEnum*)&addv,1,MPIU_ENUM,MPI_BOR,PetscObjectComm((PetscObject)mat));CHKERRQ(ierr);
@@ -915,6 +968,21 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     if (sendno != stash->nsendranks) SETERRQ2(stash->comm,PETSC_ERR_PLIB,"BTS counted %D sendranks, but %D sends",stash->nsendranks,sendno);
   }
 
+  if (stash->frozen_record) { /* Translate the block of each stashed entry to its position in the frozen send buffer */
+    PetscInt i,j,b,bs2 = stash->bs*stash->bs,*offset;
+
+    ierr = PetscMalloc1(stash->nsendranks+1,&stash->frozen_sendoffset);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nblocks,&offset);CHKERRQ(ierr);
+    stash->frozen_sendoffset[0] = 0;
+    for (i=0,b=0; i<stash->nsendranks; i++) {
+      for (j=0; j<stash->sendhdr[i].count; j++,b++) offset[b] = stash->frozen_sendoffset[i] + j*bs2;
+      stash->frozen_sendoffset[i+1] = stash->frozen_sendoffset[i] + stash->sendhdr[i].count*bs2 + 1;
+    }
+    if (b != (PetscInt)nblocks) SETERRQ2(stash->comm,PETSC_ERR_PLIB,"Frozen pattern counted %D blocks, but %D are sent",(PetscInt)nblocks,b);
+    for (i=0; i<stash->frozen_n; i++) stash->frozen_map[i] = offset[stash->frozen_map[i]];
+    ierr = PetscFree(offset);CHKERRQ(ierr);
+  }
+
   /* Encode insertmode on the outgoing messages. If we want to support more than two options, we would need a new
    * message or a dummy entry of some sort. */
   if (mat->insertmode == INSERT_VALUES) {
@@ -954,12 +1022,47 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   PetscFunctionReturn(0);
 }
 
+/*
+ * With a frozen pattern, each message is returned whole, the rows and columns were recorded in the initial assembly
+ */
+static PetscErrorCode MatStashScatterGetMesg_Frozen(MatStash *stash,PetscMPIInt *n,PetscInt **row,PetscInt **col,PetscScalar **val,PetscInt *flg)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    i;
+  PetscInt       bs2 = stash->bs*stash->bs,count;
+  PetscScalar    *vals;
+  InsertMode     insertmode;
+
+  PetscFunctionBegin;
+  *flg = 0;
+  if (stash->recvcount == stash->frozen_nrecvranks) PetscFunctionReturn(0); /* Done */
+  ierr = MPI_Waitany(stash->frozen_nrecvranks,stash->frozen_reqs,&i,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  count = stash->frozen_recvoffset[i+1] - stash->frozen_recvoffset[i];
+  vals  = &stash->frozen_recvbuf[stash->frozen_recvoffset[i]*bs2 + i];
+  insertmode = (InsertMode)(PetscInt)PetscRealPart(vals[count*bs2]);
+  if (count > 0) { /* Check for InsertMode consistency */
+    if (PetscUnlikely(*stash->insertmode == NOT_SET_VALUES)) *stash->insertmode = insertmode;
+    if (PetscUnlikely(*stash->insertmode != insertmode)) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Assembling %s, but rank %d requested %s",*stash->insertmode == INSERT_VALUES ? "INSERT_VALUES" : "ADD_VALUES",stash->frozen_recvranks[i],insertmode == INSERT_VALUES ? "INSERT_VALUES" : "ADD_VALUES");
+  }
+  ierr = PetscMPIIntCast(count,n);CHKERRQ(ierr);
+  *row = &stash->frozen_recvrows[stash->frozen_recvoffset[i]];
+  *col = &stash->frozen_recvcols[stash->frozen_recvoffset[i]];
+  *val = vals;
+  stash->recvcount++;
+  *flg = 1;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,PetscInt **row,PetscInt **col,PetscScalar **val,PetscInt *flg)
 {
   PetscErrorCode ierr;
   MatStashBlock *block;
 
   PetscFunctionBegin;
+  if (stash->frozen_setup) {
+    ierr = MatStashScatterGetMesg_Frozen(stash,n,row,col,val,flg);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   *flg = 0;
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
@@ -971,6 +1074,7 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
     stash->recvframe_count = stash->recvframe_active->count; /* From header; maximum count */
     if (stash->use_status) { /* Count what was actually sent */
       ierr = MPI_Get_count(&stash->some_statuses[stash->some_i],stash->blocktype,&stash->recvframe_count);CHKERRQ(ierr);
+      stash->recvframe_active->count = stash->recvframe_count;
     }
     if (stash->recvframe_count > 0) { /* Check for InsertMode consistency */
       block = (MatStashBlock*)&((char*)stash->recvframe_active->buffer)[0];
@@ -993,17 +1097,88 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
   PetscFunctionReturn(0);
 }
 
+/*
+ * Record the blocks received in the assembly that just completed and create persistent requests
+ * to communicate their values in subsequent assemblies
+ */
+static PetscErrorCode MatStashFrozenSetUp_Private(MatStash *stash)
+{
+  PetscErrorCode ierr;
+  PetscInt       bs2 = stash->bs*stash->bs,i,j,k;
+  PetscMPIInt    tag,count;
+
+  PetscFunctionBegin;
+  stash->frozen_nsendranks = stash->nsendranks;
+  stash->frozen_nrecvranks = stash->nrecvranks;
+  ierr = PetscMalloc2(stash->nrecvranks,&stash->frozen_recvranks,stash->nrecvranks+1,&stash->frozen_recvoffset);CHKERRQ(ierr);
+  ierr = PetscArraycpy(stash->frozen_recvranks,stash->recvranks,stash->nrecvranks);CHKERRQ(ierr);
+  stash->frozen_recvoffset[0] = 0;
+  for (i=0; i<stash->nrecvranks; i++) stash->frozen_recvoffset[i+1] = stash->frozen_recvoffset[i] + stash->recvframes[i].count;
+  ierr = PetscMalloc2(stash->frozen_recvoffset[stash->nrecvranks],&stash->frozen_recvrows,stash->frozen_recvoffset[stash->nrecvranks],&stash->frozen_recvcols);CHKERRQ(ierr);
+  for (i=0,k=0; i<stash->nrecvranks; i++) {
+    for (j=0; j<stash->recvframes[i].count; j++,k++) {
+      MatStashBlock *block = (MatStashBlock*)&((char*)stash->recvframes[i].buffer)[j*stash->blocktype_size];
+      stash->frozen_recvrows[k] = block->row; /* Already decoded by MatStashScatterGetMesg_BTS() */
+      stash->frozen_recvcols[k] = block->col;
+    }
+  }
+  ierr = PetscMalloc2(stash->frozen_sendoffset[stash->nsendranks],&stash->frozen_sendbuf,stash->frozen_recvoffset[stash->nrecvranks]*bs2+stash->nrecvranks,&stash->frozen_recvbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(stash->nrecvranks+stash->nsendranks,&stash->frozen_reqs);CHKERRQ(ierr);
+  ierr = PetscCommGetNewTag(stash->comm,&tag);CHKERRQ(ierr);
+  for (i=0; i<stash->nrecvranks; i++) {
+    ierr = PetscMPIIntCast((stash->frozen_recvoffset[i+1]-stash->frozen_recvoffset[i])*bs2+1,&count);CHKERRQ(ierr);
+    ierr = MPI_Recv_init(&stash->frozen_recvbuf[stash->frozen_recvoffset[i]*bs2+i],count,MPIU_SCALAR,stash->recvranks[i],tag,stash->comm,&stash->frozen_reqs[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<stash->nsendranks; i++) {
+    ierr = PetscMPIIntCast(stash->frozen_sendoffset[i+1]-stash->frozen_sendoffset[i],&count);CHKERRQ(ierr);
+    ierr = MPI_Send_init(&stash->frozen_sendbuf[stash->frozen_sendoffset[i]],count,MPIU_SCALAR,stash->sendranks[i],tag,stash->comm,&stash->frozen_reqs[stash->nrecvranks+i]);CHKERRQ(ierr);
+  }
+  stash->frozen_record = PETSC_FALSE;
+  stash->frozen_setup  = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatStashFrozenDestroy_Private(MatStash *stash)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    i;
+
+  PetscFunctionBegin;
+  if (stash->frozen_setup) {
+    for (i=0; i<stash->frozen_nrecvranks+stash->frozen_nsendranks; i++) {
+      ierr = MPI_Request_free(&stash->frozen_reqs[i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree3(stash->frozen_idx,stash->frozen_idy,stash->frozen_map);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_sendoffset);CHKERRQ(ierr);
+  ierr = PetscFree2(stash->frozen_recvranks,stash->frozen_recvoffset);CHKERRQ(ierr);
+  ierr = PetscFree2(stash->frozen_recvrows,stash->frozen_recvcols);CHKERRQ(ierr);
+  ierr = PetscFree2(stash->frozen_sendbuf,stash->frozen_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree(stash->frozen_reqs);CHKERRQ(ierr);
+  stash->frozen_n          = 0;
+  stash->frozen_nsendranks = 0;
+  stash->frozen_nrecvranks = 0;
+  stash->frozen_record     = PETSC_FALSE;
+  stash->frozen_setup      = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
-  if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
-    void *dummy;
-    ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
-  } else {                      /* No reuse, so collect everything. */
-    ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
+  if (stash->frozen_setup) {
+    ierr = MPI_Waitall(stash->frozen_nsendranks,stash->frozen_reqs+stash->frozen_nrecvranks,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    if (stash->frozen_record) {ierr = MatStashFrozenSetUp_Private(stash);CHKERRQ(ierr);}
+    if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
+      void *dummy;
+      ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
+    } else {                      /* No reuse, so collect everything. */
+      ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
+    }
   }
 
   /* Now update nmaxold to be app 10% more than max n used, this way the
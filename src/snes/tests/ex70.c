@@ -0,0 +1,167 @@
+static char help[] = "Tests DMDASNESSetFunctionLocalSplit() against DMDASNESSetFunctionLocal() on the Bratu problem in 2d and 3d.\n\n";
+
+#include <petscsnes.h>
+#include <petscdmda.h>
+
+typedef struct {
+  PetscReal lambda;
+} AppCtx;
+
+static PetscErrorCode FormFunctionLocal2d(DMDALocalInfo *info,PetscScalar **x,PetscScalar **f,AppCtx *user)
+{
+  PetscInt    i,j;
+  PetscReal   hx = 1.0/(info->mx-1),hy = 1.0/(info->my-1);
+  PetscScalar u,uxx,uyy;
+
+  PetscFunctionBegin;
+  for (j=info->ys; j<info->ys+info->ym; j++) {
+    for (i=info->xs; i<info->xs+info->xm; i++) {
+      if (i == 0 || j == 0 || i == info->mx-1 || j == info->my-1) {
+        f[j][i] = x[j][i];
+        continue;
+      }
+      u       = x[j][i];
+      uxx     = (2.0*u - x[j][i-1] - x[j][i+1])*hy/hx;
+      uyy     = (2.0*u - x[j-1][i] - x[j+1][i])*hx/hy;
+      f[j][i] = uxx + uyy - hx*hy*user->lambda*PetscExpScalar(u);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormFunctionLocal3d(DMDALocalInfo *info,PetscScalar ***x,PetscScalar ***f,AppCtx *user)
+{
+  PetscInt    i,j,k;
+  PetscReal   hx = 1.0/(info->mx-1),hy = 1.0/(info->my-1),hz = 1.0/(info->mz-1);
+  PetscScalar u,uxx,uyy,uzz;
+
+  PetscFunctionBegin;
+  for (k=info->zs; k<info->zs+info->zm; k++) {
+    for (j=info->ys; j<info->ys+info->ym; j++) {
+      for (i=info->xs; i<info->xs+info->xm; i++) {
+        if (i == 0 || j == 0 || k == 0 || i == info->mx-1 || j == info->my-1 || k == info->mz-1) {
+          f[k][j][i] = x[k][j][i];
+          continue;
+        }
+        u          = x[k][j][i];
+        uxx        = (2.0*u - x[k][j][i-1] - x[k][j][i+1])*hy*hz/hx;
+        uyy        = (2.0*u - x[k][j-1][i] - x[k][j+1][i])*hx*hz/hy;
+        uzz        = (2.0*u - x[k-1][j][i] - x[k+1][j][i])*hx*hy/hz;
+        f[k][j][i] = uxx + uyy + uzz - hx*hy*hz*user->lambda*PetscExpScalar(u);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Checks that the interior and the boundary strips cover each owned point once */
+static PetscErrorCode CheckInteriorLocalInfo(DM da)
+{
+  DMDALocalInfo  info,interior,bdry[6];
+  PetscInt       nbdry,b,i,j,k,*count,bad = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  ierr = DMDAGetInteriorLocalInfo(da,&interior,&nbdry,bdry);CHKERRQ(ierr);
+  ierr = PetscCalloc1(info.xm*info.ym*info.zm,&count);CHKERRQ(ierr);
+  for (b=-1; b<nbdry; b++) {
+    DMDALocalInfo *box = b < 0 ? &interior : &bdry[b];
+
+    for (k=box->zs; k<box->zs+box->zm; k++) {
+      for (j=box->ys; j<box->ys+box->ym; j++) {
+        for (i=box->xs; i<box->xs+box->xm; i++) count[((k-info.zs)*info.ym + (j-info.ys))*info.xm + i-info.xs]++;
+      }
+    }
+  }
+  for (i=0; i<info.xm*info.ym*info.zm; i++) if (count[i] != 1) bad++;
+  if (bad) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%D owned points are not covered exactly once",bad);
+  ierr = PetscFree(count);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  SNES                snes;
+  DM                  da;
+  Vec                 x,f,g;
+  PetscRandom         rand;
+  AppCtx              user;
+  PetscInt            dim = 2,sw = 1;
+  PetscReal           norm,dnorm;
+  DMDASNESFunction    func;
+  SNESConvergedReason reason;
+  PetscErrorCode      ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  user.lambda = 6.0;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-stencil_width",&sw,NULL);CHKERRQ(ierr);
+  if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,17,17,PETSC_DECIDE,PETSC_DECIDE,1,sw,NULL,NULL,&da);CHKERRQ(ierr);
+    func = (DMDASNESFunction)FormFunctionLocal2d;
+  } else {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,9,9,9,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,sw,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+    func = (DMDASNESFunction)FormFunctionLocal3d;
+  }
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = CheckInteriorLocalInfo(da);CHKERRQ(ierr);
+
+  ierr = SNESCreate(PETSC_COMM_WORLD,&snes);CHKERRQ(ierr);
+  ierr = SNESSetDM(snes,da);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&f);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&g);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+
+  /* the split evaluation gives the same residual */
+  ierr = DMDASNESSetFunctionLocal(da,INSERT_VALUES,func,&user);CHKERRQ(ierr);
+  ierr = SNESComputeFunction(snes,x,f);CHKERRQ(ierr);
+  ierr = DMDASNESSetFunctionLocalSplit(da,func,&user);CHKERRQ(ierr);
+  ierr = SNESComputeFunction(snes,x,g);CHKERRQ(ierr);
+  ierr = VecAXPY(g,-1.0,f);CHKERRQ(ierr);
+  ierr = VecNorm(g,NORM_2,&dnorm);CHKERRQ(ierr);
+  ierr = VecNorm(f,NORM_2,&norm);CHKERRQ(ierr);
+  if (dnorm > 1.e-14*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"The residuals differ by %g relative to %g\n",(double)dnorm,(double)norm);CHKERRQ(ierr);}
+
+  ierr = SNESSetFromOptions(snes);CHKERRQ(ierr);
+  ierr = VecSet(x,0.0);CHKERRQ(ierr);
+  ierr = SNESSolve(snes,NULL,x);CHKERRQ(ierr);
+  ierr = SNESGetConvergedReason(snes,&reason);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Split residual evaluation: solve %s\n",reason > 0 ? "converged" : "diverged");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&f);CHKERRQ(ierr);
+  ierr = VecDestroy(&g);CHKERRQ(ierr);
+  ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 2d
+      nsize: {{1 2 4}}
+      output_file: output/ex70_1.out
+      args: -stencil_width {{1 2}}
+
+   test:
+      suffix: 3d
+      nsize: {{1 3}}
+      output_file: output/ex70_1.out
+      args: -dim 3
+
+   test:
+      suffix: window
+      nsize: 2
+      requires: define(PETSC_HAVE_MPI_ONE_SIDED)
+      output_file: output/ex70_1.out
+      args: -vecscatter_type sf -sf_type window
+
+TEST*/
@@ -11,6 +11,7 @@ typedef struct {
   void       *jacobianlocalctx;
   void       *objectivelocalctx;
   InsertMode residuallocalimode;
+  PetscBool  residuallocalsplit;  /* the residual is computed on the interior points during the ghost update */
 
   /*   For Picard iteration defined locally */
   PetscErrorCode (*rhsplocal)(DMDALocalInfo*,void*,void*,void*);
@@ -55,6 +56,64 @@ static PetscErrorCode DMDASNESGetContext(DM dm,DMSNES sdm,DMSNES_DA  **dmdasnes)
   PetscFunctionReturn(0);
 }
 
+/*
+   Completes the ghost update of Xloc started by the caller, calling the local function on the interior points before
+   and on the boundary strips after. The owned values of Xloc may not be set until VecScatterEnd(), for instance with
+   PETSCSFWINDOW, so the interior points are computed from a copy of the owned block of X in a second local vector.
+*/
+static PetscErrorCode SNESComputeFunctionSplit_DMDA(SNES snes,Vec X,Vec Xloc,Vec F,DMSNES_DA *dmdasnes)
+{
+  PetscErrorCode ierr;
+  DM             dm;
+  DMDALocalInfo  interior,bdry[6];
+  PetscInt       nbdry,b;
+  void           *x,*f;
+
+  PetscFunctionBegin;
+  ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
+  ierr = DMDAGetInteriorLocalInfo(dm,&interior,&nbdry,bdry);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(dm,F,&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,F,0);CHKERRQ(ierr);
+  if (interior.xm && interior.ym && interior.zm) {
+    DMDALocalInfo     info;
+    Vec               Xint;
+    const PetscScalar *xg;
+    PetscScalar       *xl;
+    PetscInt          j,k,row;
+
+    /* the interior stencil only reads owned values, so the ghost values of Xint are left unset */
+    ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&Xint);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(X,&xg);CHKERRQ(ierr);
+    ierr = VecGetArray(Xint,&xl);CHKERRQ(ierr);
+    for (k=0; k<info.zm; k++) {
+      for (j=0; j<info.ym; j++) {
+        row  = (k+info.zs-info.gzs)*info.gym + j+info.ys-info.gys;
+        ierr = PetscArraycpy(xl+(row*info.gxm+info.xs-info.gxs)*info.dof,xg+(k*info.ym+j)*info.xm*info.dof,info.xm*info.dof);CHKERRQ(ierr);
+      }
+    }
+    ierr = VecRestoreArray(Xint,&xl);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(X,&xg);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayRead(dm,Xint,&x);CHKERRQ(ierr);
+    CHKMEMQ;
+    ierr = (*dmdasnes->residuallocal)(&interior,x,f,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+    CHKMEMQ;
+    ierr = DMDAVecRestoreArrayRead(dm,Xint,&x);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xint);CHKERRQ(ierr);
+  }
+  ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  ierr = DMDAVecGetArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+  for (b=0; b<nbdry; b++) {
+    CHKMEMQ;
+    ierr = (*dmdasnes->residuallocal)(&bdry[b],x,f,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+    CHKMEMQ;
+  }
+  ierr = DMDAVecRestoreArrayRead(dm,Xloc,&x);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,F,0);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(dm,F,&f);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode SNESComputeFunction_DMDA(SNES snes,Vec X,Vec F,void *ctx)
 {
   PetscErrorCode ierr;
@@ -72,6 +131,14 @@ static PetscErrorCode SNESComputeFunction_DMDA(SNES snes,Vec X,Vec F,void *ctx)
   ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
   ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  if (dmdasnes->residuallocalsplit) {
+    ierr = SNESComputeFunctionSplit_DMDA(snes,X,Xloc,F,dmdasnes);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+    if (snes->domainerror) {
+      ierr = VecSetInf(F);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
   ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
   ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
   ierr = DMDAVecGetArray(dm,Xloc,&x);CHKERRQ(ierr);
@@ -224,7 +291,7 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B
 
    Level: beginner
 
-.seealso: DMDASNESSetJacobianLocal(), DMSNESSetFunction(), DMDACreate1d(), DMDACreate2d(), DMDACreate3d()
+.seealso: DMDASNESSetJacobianLocal(), DMSNESSetFunction(), DMDASNESSetFunctionLocalSplit(), DMDACreate1d(), DMDACreate2d(), DMDACreate3d()
 @*/
 PetscErrorCode DMDASNESSetFunctionLocal(DM dm,InsertMode imode,PetscErrorCode (*func)(DMDALocalInfo*,void*,void*,void*),void *ctx)
 {
@@ -240,6 +307,7 @@ PetscErrorCode DMDASNESSetFunctionLocal(DM dm,InsertMode imode,PetscErrorCode (*
   dmdasnes->residuallocalimode = imode;
   dmdasnes->residuallocal      = func;
   dmdasnes->residuallocalctx   = ctx;
+  dmdasnes->residuallocalsplit = PETSC_FALSE;
 
   ierr = DMSNESSetFunction(dm,SNESComputeFunction_DMDA,dmdasnes);CHKERRQ(ierr);
   if (!sdm->ops->computejacobian) {  /* Call us for the Jacobian too, can be overridden by the user. */
@@ -248,6 +316,53 @@ PetscErrorCode DMDASNESSetFunctionLocal(DM dm,InsertMode imode,PetscErrorCode (*
   PetscFunctionReturn(0);
 }
 
+/*@C
+   DMDASNESSetFunctionLocalSplit - set a local residual evaluation function that is called on the interior points
+   while the ghost values are communicated, then on the boundary strips
+
+   Logically Collective
+
+   Input Arguments:
++  dm - DM to associate callback with
+.  func - local residual evaluation, computing the owned part of the residual
+-  ctx - optional context for local residual evaluation
+
+   Calling sequence:
+   For PetscErrorCode (*func)(DMDALocalInfo *info,void *x, void *f, void *ctx),
++  info - DMDALocalInfo defining the points to evaluate the residual on, see DMDAGetInteriorLocalInfo()
+.  x - dimensional pointer to state at which to evaluate residual (e.g. PetscScalar *x or **x or ***x)
+.  f - dimensional pointer to residual, write the residual here (e.g. PetscScalar *f or **f or ***f)
+-  ctx - optional context passed above
+
+   Notes:
+   This is DMDASNESSetFunctionLocal() with INSERT_VALUES, except that the function is called several times for each
+   evaluation: first on the points whose stencil, of the width of the DMDA, only contains owned points, between
+   DMGlobalToLocalBegin() and DMGlobalToLocalEnd() so that the communication is hidden behind the computation, then
+   on the remaining strips of owned points. The function must therefore compute the residual at the points
+   xs <= i < xs+xm, ys <= j < ys+ym, zs <= k < zs+zm of info only, and must not accumulate anything across the
+   points, such as a norm.
+
+   The Jacobian computed by default with finite differences and coloring uses the same split evaluation.
+
+   Level: intermediate
+
+.seealso: DMDASNESSetFunctionLocal(), DMDAGetInteriorLocalInfo(), DMSNESSetFunction()
+@*/
+PetscErrorCode DMDASNESSetFunctionLocalSplit(DM dm,PetscErrorCode (*func)(DMDALocalInfo*,void*,void*,void*),void *ctx)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+  DMSNES_DA      *dmdasnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  ierr = DMDASNESSetFunctionLocal(dm,INSERT_VALUES,func,ctx);CHKERRQ(ierr);
+  ierr = DMGetDMSNESWrite(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMDASNESGetContext(dm,sdm,&dmdasnes);CHKERRQ(ierr);
+  dmdasnes->residuallocalsplit = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMDASNESSetJacobianLocal - set a local Jacobian evaluation function
 
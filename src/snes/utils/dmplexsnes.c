@@ -1440,19 +1440,26 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
     }
     /* Loop over domain */
     if (useFEM) {
-      /* Add elemVec to locX */
-      for (c = cS; c < cE; ++c) {
-        const PetscInt cell = cells ? cells[c] : c;
-        const PetscInt cind = c - cStart;
+      PetscInt clSize = -1;
 
-        if (mesh->printFEM > 1) {ierr = DMPrintCellVector(cell, name, totDim, &elemVec[cind*totDim]);CHKERRQ(ierr);}
-        if (ghostLabel) {
-          PetscInt ghostVal;
+      /* Add elemVec to locX, in one pass over a contiguous range of cells */
+      if (!cells && !ghostLabel && mesh->printFEM <= 1) {ierr = DMPlexGetClosureDofMapSize(dm, section, cS, cE, &clSize);CHKERRQ(ierr);}
+      if (clSize == totDim) {
+        ierr = DMPlexVecSetClosureBatch(dm, section, locF, cS, cE, totDim, &elemVec[(cS-cStart)*totDim], ADD_ALL_VALUES);CHKERRQ(ierr);
+      } else {
+        for (c = cS; c < cE; ++c) {
+          const PetscInt cell = cells ? cells[c] : c;
+          const PetscInt cind = c - cStart;
+
+          if (mesh->printFEM > 1) {ierr = DMPrintCellVector(cell, name, totDim, &elemVec[cind*totDim]);CHKERRQ(ierr);}
+          if (ghostLabel) {
+            PetscInt ghostVal;
 
-          ierr = DMLabelGetValue(ghostLabel,cell,&ghostVal);CHKERRQ(ierr);
-          if (ghostVal > 0) continue;
+            ierr = DMLabelGetValue(ghostLabel,cell,&ghostVal);CHKERRQ(ierr);
+            if (ghostVal > 0) continue;
+          }
+          ierr = DMPlexVecSetClosure(dm, section, locF, cell, &elemVec[cind*totDim], ADD_ALL_VALUES);CHKERRQ(ierr);
         }
-        ierr = DMPlexVecSetClosure(dm, section, locF, cell, &elemVec[cind*totDim], ADD_ALL_VALUES);CHKERRQ(ierr);
       }
     }
     if (useFVM) {
@@ -2066,7 +2073,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   PetscScalar    *elemMat, *elemMatP, *elemMatD, *u, *u_t, *a = NULL;
   const PetscInt *cells;
   PetscInt        Nf, fieldI, fieldJ;
-  PetscInt        totDim, totDimAux, cStart, cEnd, numCells, c;
+  PetscInt        totDim, totDimAux, cStart, cEnd, numCells, clSize = -1, c;
   PetscBool       isMatIS, isMatISP, hasJac, hasPrec, hasDyn, hasFV = PETSC_FALSE, transform;
   PetscErrorCode  ierr;
 
@@ -2105,16 +2112,24 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   ierr = PetscMalloc5(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,hasJac ? numCells*totDim*totDim : 0,&elemMat,hasPrec ? numCells*totDim*totDim : 0, &elemMatP,hasDyn ? numCells*totDim*totDim : 0, &elemMatD);CHKERRQ(ierr);
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
+  /* A contiguous range of cells is gathered, and later assembled, in one pass */
+  if (!cells) {ierr = DMPlexGetClosureDofMapSize(dm, section, cStart, cEnd, &clSize);CHKERRQ(ierr);}
+  if (clSize == totDim) {
+    ierr = DMPlexVecGetClosureBatch(dm, section, X, cStart, cEnd, totDim, u);CHKERRQ(ierr);
+    if (X_t) {ierr = DMPlexVecGetClosureBatch(dm, section, X_t, cStart, cEnd, totDim, u_t);CHKERRQ(ierr);}
+  }
   for (c = cStart; c < cEnd; ++c) {
     const PetscInt cell = cells ? cells[c] : c;
     const PetscInt cind = c - cStart;
     PetscScalar   *x = NULL,  *x_t = NULL;
     PetscInt       i;
 
-    ierr = DMPlexVecGetClosure(dm, section, X, cell, NULL, &x);CHKERRQ(ierr);
-    for (i = 0; i < totDim; ++i) u[cind*totDim+i] = x[i];
-    ierr = DMPlexVecRestoreClosure(dm, section, X, cell, NULL, &x);CHKERRQ(ierr);
-    if (X_t) {
+    if (clSize != totDim) {
+      ierr = DMPlexVecGetClosure(dm, section, X, cell, NULL, &x);CHKERRQ(ierr);
+      for (i = 0; i < totDim; ++i) u[cind*totDim+i] = x[i];
+      ierr = DMPlexVecRestoreClosure(dm, section, X, cell, NULL, &x);CHKERRQ(ierr);
+    }
+    if (X_t && clSize != totDim) {
       ierr = DMPlexVecGetClosure(dm, section, X_t, cell, NULL, &x_t);CHKERRQ(ierr);
       for (i = 0; i < totDim; ++i) u_t[cind*totDim+i] = x_t[i];
       ierr = DMPlexVecRestoreClosure(dm, section, X_t, cell, NULL, &x_t);CHKERRQ(ierr);
@@ -2224,43 +2239,52 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   if (isMatIS && !subSection) {
     ierr = DMPlexGetSubdomainSection(dm, &subSection);CHKERRQ(ierr);
   }
-  for (c = cStart; c < cEnd; ++c) {
-    const PetscInt cell = cells ? cells[c] : c;
-    const PetscInt cind = c - cStart;
-
-    /* Transform to global basis before insertion in Jacobian */
-    if (transform) {ierr = DMPlexBasisTransformPointTensor_Internal(dm, tdm, tv, cell, PETSC_TRUE, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+  if (clSize == totDim && !transform && !isMatIS && !isMatISP && mesh->printFEM <= 1) {
     if (hasPrec) {
-      if (hasJac) {
-        if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
-        if (!isMatIS) {
-          ierr = DMPlexMatSetClosure(dm, section, globalSection, Jac, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
-        } else {
-          Mat lJ;
+      if (hasJac) {ierr = DMPlexMatSetClosureBatch(dm, section, globalSection, Jac, cStart, cEnd, totDim, elemMat, ADD_VALUES);CHKERRQ(ierr);}
+      ierr = DMPlexMatSetClosureBatch(dm, section, globalSection, JacP, cStart, cEnd, totDim, elemMatP, ADD_VALUES);CHKERRQ(ierr);
+    } else if (hasJac) {
+      ierr = DMPlexMatSetClosureBatch(dm, section, globalSection, JacP, cStart, cEnd, totDim, elemMat, ADD_VALUES);CHKERRQ(ierr);
+    }
+  } else {
+    for (c = cStart; c < cEnd; ++c) {
+      const PetscInt cell = cells ? cells[c] : c;
+      const PetscInt cind = c - cStart;
 
-          ierr = MatISGetLocalMat(Jac,&lJ);CHKERRQ(ierr);
-          ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
-        }
-      }
-      if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMatP[cind*totDim*totDim]);CHKERRQ(ierr);}
-      if (!isMatISP) {
-        ierr = DMPlexMatSetClosure(dm, section, globalSection, JacP, cell, &elemMatP[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
-      } else {
-        Mat lJ;
+      /* Transform to global basis before insertion in Jacobian */
+      if (transform) {ierr = DMPlexBasisTransformPointTensor_Internal(dm, tdm, tv, cell, PETSC_TRUE, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+      if (hasPrec) {
+        if (hasJac) {
+          if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+          if (!isMatIS) {
+            ierr = DMPlexMatSetClosure(dm, section, globalSection, Jac, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          } else {
+            Mat lJ;
 
-        ierr = MatISGetLocalMat(JacP,&lJ);CHKERRQ(ierr);
-        ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMatP[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
-      }
-    } else {
-      if (hasJac) {
-        if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+            ierr = MatISGetLocalMat(Jac,&lJ);CHKERRQ(ierr);
+            ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          }
+        }
+        if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMatP[cind*totDim*totDim]);CHKERRQ(ierr);}
         if (!isMatISP) {
-          ierr = DMPlexMatSetClosure(dm, section, globalSection, JacP, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          ierr = DMPlexMatSetClosure(dm, section, globalSection, JacP, cell, &elemMatP[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
         } else {
           Mat lJ;
 
           ierr = MatISGetLocalMat(JacP,&lJ);CHKERRQ(ierr);
-          ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMatP[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+        }
+      } else {
+        if (hasJac) {
+          if (mesh->printFEM > 1) {ierr = DMPrintCellMatrix(cell, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);}
+          if (!isMatISP) {
+            ierr = DMPlexMatSetClosure(dm, section, globalSection, JacP, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          } else {
+            Mat lJ;
+
+            ierr = MatISGetLocalMat(JacP,&lJ);CHKERRQ(ierr);
+            ierr = DMPlexMatSetClosure(dm, section, subSection, lJ, cell, &elemMat[cind*totDim*totDim], ADD_VALUES);CHKERRQ(ierr);
+          }
         }
       }
     }
@@ -2508,11 +2532,12 @@ PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM dm, IS cellIS, PetscReal
 
   Note:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
+  like a GPU, or vectorize on a multicore machine. When the PetscFE of every field can apply the element Jacobian
+  without forming it, as PETSCFESUMFACT does, the element matrices are not formed.
 
   Level: developer
 
-.seealso: FormFunctionLocal()
+.seealso: FormFunctionLocal(), PetscFEIntegrateJacobianAction(), DMSNESCreateJacobianMF()
 @*/
 PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
 {
@@ -2524,12 +2549,12 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
   PetscDS           prob, probAux = NULL;
   PetscQuadrature   quad;
   PetscSection      section, globalSection, sectionAux;
-  PetscScalar      *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z;
+  PetscScalar      *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z, *elemVec = NULL, *yD = NULL;
   PetscInt          Nf, fieldI, fieldJ;
   PetscInt          totDim, totDimAux = 0;
   const PetscInt   *cells;
   PetscInt          cStart, cEnd, numCells, c;
-  PetscBool         hasDyn;
+  PetscBool         hasDyn, useAction = PETSC_TRUE;
   DMField           coordField;
   PetscErrorCode    ierr;
 
@@ -2552,6 +2577,13 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
   ierr = PetscDSHasDynamicJacobian(prob, &hasDyn);CHKERRQ(ierr);
   hasDyn = hasDyn && (X_tShift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
   ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  for (fieldI = 0; fieldI < Nf; ++fieldI) {
+    PetscFE fe;
+
+    ierr = PetscDSGetDiscretization(prob, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
+    if (!fe->ops->integratejacobianaction) useAction = PETSC_FALSE;
+  }
+  if (mesh->printFEM > 1) useAction = PETSC_FALSE;
   ierr = ISGetLocalSize(cellIS, &numCells);CHKERRQ(ierr);
   ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
   ierr = PetscObjectQuery((PetscObject) dm, "dmAux", (PetscObject *) &dmAux);CHKERRQ(ierr);
@@ -2564,7 +2596,8 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
   ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
-  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim*totDim,&elemMat,hasDyn ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,totDim,&z);CHKERRQ(ierr);
+  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,useAction ? 0 : numCells*totDim*totDim,&elemMat,hasDyn && !useAction ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,totDim,&z);CHKERRQ(ierr);
+  if (useAction) {ierr = PetscCalloc2(numCells*totDim, &elemVec, hasDyn ? numCells*totDim : 0, &yD);CHKERRQ(ierr);}
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
@@ -2592,8 +2625,13 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     for (i = 0; i < totDim; ++i) y[cind*totDim+i] = x[i];
     ierr = DMPlexVecRestoreClosure(dm, section, Y, cell, NULL, &x);CHKERRQ(ierr);
   }
-  ierr = PetscArrayzero(elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
-  if (hasDyn)  {ierr = PetscArrayzero(elemMatD, numCells*totDim*totDim);CHKERRQ(ierr);}
+  if (useAction) {
+    /* The action is linear in Y, so the dynamic part is applied to X_tShift Y */
+    if (hasDyn) for (c = 0; c < numCells*totDim; ++c) yD[c] = X_tShift*y[c];
+  } else {
+    ierr = PetscArrayzero(elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
+    if (hasDyn)  {ierr = PetscArrayzero(elemMatD, numCells*totDim*totDim);CHKERRQ(ierr);}
+  }
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscFE  fe;
     PetscInt Nb;
@@ -2627,6 +2665,15 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = PetscFEGeomGetChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
     ierr = PetscFEGeomGetChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
     for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+      if (useAction) {
+        ierr = PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, y, elemVec);CHKERRQ(ierr);
+        ierr = PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &y[offset*totDim], &elemVec[offset*totDim]);CHKERRQ(ierr);
+        if (hasDyn) {
+          ierr = PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, yD, elemVec);CHKERRQ(ierr);
+          ierr = PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &yD[offset*totDim], &elemVec[offset*totDim]);CHKERRQ(ierr);
+        }
+        continue;
+      }
       ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
       ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
       if (hasDyn) {
@@ -2639,7 +2686,7 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = DMSNESRestoreFEGeom(coordField,cellIS,qGeom,PETSC_FALSE,&cgeomFEM);CHKERRQ(ierr);
     ierr = PetscQuadratureDestroy(&qGeom);CHKERRQ(ierr);
   }
-  if (hasDyn) {
+  if (hasDyn && !useAction) {
     for (c = 0; c < numCells*totDim*totDim; ++c) elemMat[c] += X_tShift*elemMatD[c];
   }
   for (c = cStart; c < cEnd; ++c) {
@@ -2648,6 +2695,10 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     const PetscBLASInt M = totDim, one = 1;
     const PetscScalar  a = 1.0, b = 0.0;
 
+    if (useAction) {
+      ierr = DMPlexVecSetClosure(dm, section, Z, cell, &elemVec[cind*totDim], ADD_VALUES);CHKERRQ(ierr);
+      continue;
+    }
     PetscStackCallBLAS("BLASgemv", BLASgemv_("N", &M, &M, &a, &elemMat[cind*totDim*totDim], &M, &y[cind*totDim], &one, &b, z, &one));
     if (mesh->printFEM > 1) {
       ierr = DMPrintCellMatrix(c, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);
@@ -2657,6 +2708,7 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = DMPlexVecSetClosure(dm, section, Z, cell, z, ADD_VALUES);CHKERRQ(ierr);
   }
   ierr = PetscFree6(u,u_t,elemMat,elemMatD,y,z);CHKERRQ(ierr);
+  ierr = PetscFree2(elemVec,yD);CHKERRQ(ierr);
   if (mesh->printFEM) {
     ierr = PetscPrintf(PetscObjectComm((PetscObject)Z), "Z:\n");CHKERRQ(ierr);
     ierr = VecView(Z, NULL);CHKERRQ(ierr);
@@ -2682,21 +2734,29 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
 
   Note:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
+  like a GPU, or vectorize on a multicore machine. If Jac was created with DMSNESCreateJacobianMF(), only its
+  linearization point is updated, and JacP is assembled.
 
   Level: developer
 
-.seealso: FormFunctionLocal()
+.seealso: FormFunctionLocal(), DMSNESCreateJacobianMF()
 @*/
 PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void *user)
 {
   DM             plex;
   IS             allcellIS;
+  Vec            locXMF;
   PetscBool      hasJac, hasPrec;
   PetscInt       Nds, s, depth;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject) Jac, "DMSNESJacobianMF_X", (PetscObject *) &locXMF);CHKERRQ(ierr);
+  if (locXMF) {
+    ierr = VecCopy(X, locXMF);CHKERRQ(ierr);
+    if (Jac == JacP) PetscFunctionReturn(0);
+    Jac = JacP;
+  }
   ierr = DMGetNumDS(dm, &Nds);CHKERRQ(ierr);
   ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
@@ -2732,6 +2792,104 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   PetscFunctionReturn(0);
 }
 
+typedef struct {
+  DM    dm;   /* The mesh and discretization */
+  Vec   locX; /* The local linearization point, with boundary values */
+  void *user; /* The user context for the pointwise functions */
+} DMSNESJacobianMFCtx;
+
+static PetscErrorCode MatMult_DMSNESJacobianMF(Mat A, Vec Y, Vec Z)
+{
+  DMSNESJacobianMFCtx *ctx;
+  Vec                  locY, locZ;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A, &ctx);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  /* The constrained values of the input are zero, since the boundary values do not depend on the solution */
+  ierr = VecSet(locY, 0.0);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianAction(ctx->dm, NULL, 0.0, 0.0, ctx->locX, NULL, locY, locZ, ctx->user);CHKERRQ(ierr);
+  ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMSNESJacobianMF(Mat A)
+{
+  DMSNESJacobianMFCtx *ctx;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A, &ctx);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->locX);CHKERRQ(ierr);
+  ierr = DMDestroy(&ctx->dm);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  DMSNESCreateJacobianMF - Create a matrix-free operator which applies the Jacobian of the pointwise residual of a DMPlex
+
+  Collective on dm
+
+  Input Parameters:
++ dm   - The mesh, with the discretization and pointwise Jacobians in its PetscDS
+. X    - The global linearization point, or NULL for zero
+- user - The user context passed to the pointwise functions
+
+  Output Parameter:
+. J - The MATSHELL
+
+  Notes:
+  The operator is applied with DMPlexComputeJacobianAction(), so that the element matrices are never formed when the
+  fields are discretized with PETSCFESUMFACT, and high order problems can be solved without any assembly. It may be
+  passed as the Jacobian to SNESSetJacobian() after DMPlexSetSNESLocalFEM(), in which case the linearization point is
+  updated by DMPlexSNESComputeJacobianFEM() and only the preconditioning matrix, if it is different, is assembled.
+  Boundary integrals in the Jacobian are not included.
+
+  Level: intermediate
+
+.seealso: DMPlexComputeJacobianAction(), DMPlexSNESComputeJacobianFEM(), PetscFEIntegrateJacobianAction(), PETSCFESUMFACT
+@*/
+PetscErrorCode DMSNESCreateJacobianMF(DM dm, Vec X, void *user, Mat *J)
+{
+  DMSNESJacobianMFCtx *ctx;
+  Vec                  g;
+  PetscInt             n, N;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (X) PetscValidHeaderSpecific(X, VEC_CLASSID, 2);
+  PetscValidPointer(J, 4);
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  ctx->dm   = dm;
+  ctx->user = user;
+  ierr = DMCreateLocalVector(dm, &ctx->locX);CHKERRQ(ierr);
+  if (X) {
+    ierr = DMGlobalToLocalBegin(dm, X, INSERT_VALUES, ctx->locX);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm, X, INSERT_VALUES, ctx->locX);CHKERRQ(ierr);
+  }
+  ierr = DMPlexInsertBoundaryValues(dm, PETSC_TRUE, ctx->locX, 0.0, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(g, &n);CHKERRQ(ierr);
+  ierr = VecGetSize(g, &N);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), n, n, N, N, ctx, J);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_MULT, (void (*)(void)) MatMult_DMSNESJacobianMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_DESTROY, (void (*)(void)) MatDestroy_DMSNESJacobianMF);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject) *J, "DMSNESJacobianMF_X", (PetscObject) ctx->locX);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
      MatComputeNeumannOverlap - Computes an unassembled (Neumann) local overlapping Mat in nonlinear context.
 
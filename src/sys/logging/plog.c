@@ -126,6 +126,9 @@ PETSC_INTERN PetscErrorCode PetscLogInitialize(void)
   if (petsc_logObjects) {
     ierr = PetscMalloc1(petsc_maxObjects, &petsc_objects);CHKERRQ(ierr);
   }
+  opt  = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_counters",&opt,NULL);CHKERRQ(ierr);
+  if (opt) {ierr = PetscLogCountersInitialize();CHKERRQ(ierr);}
   PetscLogPHC = PetscLogObjCreateDefault;
   PetscLogPHD = PetscLogObjDestroyDefault;
   /* Setup default logging structures */
@@ -148,6 +151,8 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
   ierr = PetscLogNestedEnd();CHKERRQ(ierr);
+  ierr = PetscLogBufferedDestroy();CHKERRQ(ierr);
+  ierr = PetscLogCountersFinalize();CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
   /* Resetting phase */
@@ -253,7 +258,7 @@ PetscErrorCode  PetscLogSet(PetscErrorCode (*b)(PetscLogEvent, int, PetscObject,
 
   Level: advanced
 
-.seealso: PetscLogDump(), PetscLogAllBegin(), PetscLogView(), PetscLogTraceBegin()
+.seealso: PetscLogDump(), PetscLogAllBegin(), PetscLogView(), PetscLogTraceBegin(), PetscLogBufferedBegin()
 @*/
 PetscErrorCode  PetscLogDefaultBegin(void)
 {
@@ -1326,6 +1331,18 @@ static PetscErrorCode PetscLogViewWarnSync(MPI_Comm comm,FILE *fd)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscLogViewWarnCounters(MPI_Comm comm,FILE *fd)
+{
+  const char     *msg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogCountersGetError(&msg);CHKERRQ(ierr);
+  if (!msg) PetscFunctionReturn(0);
+  ierr = PetscFPrintf(comm, fd, "\n      WARNING!!! -log_view_counters ignored, %s\n\n",msg);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscLogViewWarnDebugging(MPI_Comm comm,FILE *fd)
 {
   PetscErrorCode ierr;
@@ -1392,6 +1409,7 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble     fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble     min, max, tot, ratio, avg, x, y;
   PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax;
+  PetscLogDouble     cyc, ins, cmb;
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   PetscLogDouble     cct, gct, csz, gsz, gmaxt, gflops, gflopr, fracgflops;
   #endif
@@ -1419,6 +1437,7 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   ierr = PetscFPrintf(comm, fd, "************************************************************************************************************************\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "\n---------------------------------------------- PETSc Performance Summary: ----------------------------------------------\n\n");CHKERRQ(ierr);
   ierr = PetscLogViewWarnSync(comm,fd);CHKERRQ(ierr);
+  ierr = PetscLogViewWarnCounters(comm,fd);CHKERRQ(ierr);
   ierr = PetscLogViewWarnDebugging(comm,fd);CHKERRQ(ierr);
   ierr = PetscLogViewWarnNoGpuAwareMpi(comm,fd);CHKERRQ(ierr);
   ierr = PetscGetArchType(arch,sizeof(arch));CHKERRQ(ierr);
@@ -1574,6 +1593,29 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
                           stage, name, stageTime/size, 100.0*fracTime, flops, 100.0*fracFlops,
                           mess, 100.0*fracMessages, avgMessLen, 100.0*fracLength, red, 100.0*fracReductions);CHKERRQ(ierr);
     }
+    if (PetscLogCounters) {
+      ierr = PetscFPrintf(comm, fd, "\nSummary of Stage Counters:   GB/s   F/B   IPC\n");CHKERRQ(ierr);
+      for (stage = 0; stage < numStages; stage++) {
+        if (!stageUsed[stage]) continue;
+        /* CANNOT use MPIU_Allreduce() since it might fail the line number check */
+        if (localStageUsed[stage]) {
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.time,           &maxt,  1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.flops,          &flops, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.cycles,         &cyc,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.instructions,   &ins,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.cacheMissBytes, &cmb,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          name = stageInfo[stage].name;
+        } else {
+          ierr = MPI_Allreduce(&zero,                                     &maxt,  1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                                     &flops, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                                     &cyc,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                                     &ins,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                                     &cmb,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          name = "";
+        }
+        ierr = PetscFPrintf(comm, fd, "%2d: %15s:       %6.2f %5.2f %5.2f\n",stage,name,maxt != 0.0 ? cmb/(1.0e9*maxt) : 0.0,cmb != 0.0 ? flops/cmb : 0.0,cyc != 0.0 ? ins/cyc : 0.0);CHKERRQ(ierr);
+      }
+    }
   }
 
   ierr = PetscFPrintf(comm, fd,"\n------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
@@ -1597,6 +1639,12 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
     ierr = PetscFPrintf(comm, fd, "   MMalloc Mbytes: Increase in high water mark of allocated memory (sum over all calls to event)\n");CHKERRQ(ierr);
     ierr = PetscFPrintf(comm, fd, "   RMI Mbytes: Increase in resident memory (sum over all calls to event)\n");CHKERRQ(ierr);
   }
+  if (PetscLogCounters) {
+    ierr = PetscFPrintf(comm, fd, "   GB/s: 10e-9 * (sum of last level cache misses times the cache line size over all processors)/(max time over all processors)\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   F/B: arithmetic intensity, flop per byte of last level cache misses\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   IPC: instructions per cycle\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   The hardware counters only count the main thread of each process\n");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd, "   GPU Mflop/s: 10e-6 * (sum of flop on GPU over all processors)/(max GPU time over all processors)\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "   CpuToGpu Count: total number of CPU to GPU copies per processor\n");CHKERRQ(ierr);
@@ -1614,6 +1662,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"  Malloc EMalloc MMalloc RMI");CHKERRQ(ierr);
   } 
+  if (PetscLogCounters) {
+    ierr = PetscFPrintf(comm, fd," ---- Counters ----");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd,"   GPU    - CpuToGpu -   - GpuToCpu - GPU");CHKERRQ(ierr);
   #endif
@@ -1622,6 +1673,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd," Mbytes Mbytes Mbytes Mbytes");CHKERRQ(ierr);
   }
+  if (PetscLogCounters) {
+    ierr = PetscFPrintf(comm, fd,"   GB/s   F/B   IPC");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd," Mflop/s Count   Size   Count   Size  %%F");CHKERRQ(ierr); 
   #endif
@@ -1630,6 +1684,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"-----------------------------");CHKERRQ(ierr);
   }
+  if (PetscLogCounters) {
+    ierr = PetscFPrintf(comm, fd,"-------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd,"---------------------------------------");CHKERRQ(ierr); 
   #endif
@@ -1690,6 +1747,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncrease, &malmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncreaseEvent, &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         }
+        if (PetscLogCounters) {
+          ierr  = MPI_Allreduce(&eventInfo[event].cycles,         &cyc,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr  = MPI_Allreduce(&eventInfo[event].instructions,   &ins,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr  = MPI_Allreduce(&eventInfo[event].cacheMissBytes, &cmb,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
         ierr  = MPI_Allreduce(&eventInfo[event].CpuToGpuCount,    &cct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&eventInfo[event].GpuToCpuCount,    &gct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
@@ -1718,6 +1780,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&zero,                        &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
           ierr  = MPI_Allreduce(&zero,                        &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         }
+        if (PetscLogCounters) {
+          ierr  = MPI_Allreduce(&zero,                        &cyc,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr  = MPI_Allreduce(&zero,                        &ins,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr  = MPI_Allreduce(&zero,                        &cmb,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
         ierr  = MPI_Allreduce(&zero,                          &cct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&zero,                          &gct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
@@ -1761,6 +1828,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         if (PetscLogMemory) {
           ierr = PetscFPrintf(comm, fd," %5.0f   %5.0f   %5.0f   %5.0f",mal/1.0e6,emalmax/1.0e6,malmax/1.0e6,mem/1.0e6);CHKERRQ(ierr);
         } 
+        if (PetscLogCounters) {
+          ierr = PetscFPrintf(comm, fd," %6.2f %5.2f %5.2f",maxt != 0.0 ? cmb/(1.0e9*maxt) : 0.0,cmb != 0.0 ? totf/cmb : 0.0,cyc != 0.0 ? ins/cyc : 0.0);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
         if (totf  != 0.0) fracgflops = gflops/totf;  else fracgflops = 0.0;
         if (gmaxt != 0.0) gflopr     = gflops/gmaxt; else gflopr     = 0.0;
@@ -1776,6 +1846,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd, "-----------------------------");CHKERRQ(ierr);
   }
+  if (PetscLogCounters) {
+    ierr = PetscFPrintf(comm, fd, "-------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd, "---------------------------------------");CHKERRQ(ierr); 
   #endif
@@ -1936,6 +2009,7 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
 
   PetscFunctionBegin;
   if (!PetscLogPLB) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Must use -log_view or PetscLogDefaultBegin() before calling this routine");
+  ierr = PetscLogBufferedFlush();CHKERRQ(ierr);
   /* Pop off any stages the user forgot to remove */
   lastStage = 0;
   ierr      = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
@@ -0,0 +1,127 @@
+/*
+     Hardware performance counters for the events of -log_view, read with the Linux perf_event_open() interface.
+*/
+#include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+PetscBool PetscLogCounters = PETSC_FALSE;
+
+#define PETSC_LOG_NUM_COUNTERS 3
+
+static int            petsc_counterfd[PETSC_LOG_NUM_COUNTERS] = {-1,-1,-1};
+static PetscLogDouble petsc_counterlinesize = 64.0;
+static char           petsc_countererror[256] = "";
+
+/*
+  PetscLogCountersInitialize - Opens a group of counters of the cycles, instructions and last level cache misses
+  of the calling thread in user space. If the counters are not available, for example in a virtual machine without
+  a performance monitoring unit, PetscLogCounters remains false and the reason is reported by PetscLogView().
+  Collective on PETSC_COMM_WORLD
+*/
+PetscErrorCode PetscLogCountersInitialize(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H) && defined(SYS_perf_event_open)
+  struct perf_event_attr attr;
+  const unsigned long long config[PETSC_LOG_NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_MISSES};
+  PetscMPIInt            avail = 1,allavail;
+  int                    i,j;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (PetscLogCounters) PetscFunctionReturn(0);
+  for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) {
+    ierr = PetscMemzero(&attr,sizeof(attr));CHKERRQ(ierr);
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = config[i];
+    attr.disabled       = i ? 0 : 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    petsc_counterfd[i]  = (int)syscall(SYS_perf_event_open,&attr,0,-1,i ? petsc_counterfd[0] : -1,0);
+    if (petsc_counterfd[i] < 0) {
+      ierr = PetscSNPrintf(petsc_countererror,sizeof(petsc_countererror),"perf_event_open() failed: %s",strerror(errno));CHKERRQ(ierr);
+      ierr = PetscInfo1(NULL,"Hardware counters are not available, %s\n",petsc_countererror);CHKERRQ(ierr);
+      for (j=0; j<i; j++) {close(petsc_counterfd[j]); petsc_counterfd[j] = -1;}
+      avail = 0;
+      break;
+    }
+  }
+  /* -log_view reduces the counters over all processes, so they must be available everywhere */
+  ierr = MPIU_Allreduce(&avail,&allavail,1,MPI_INT,MPI_MIN,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  if (!allavail) {
+    if (avail) {
+      ierr = PetscStrncpy(petsc_countererror,"hardware counters are not available on all processes",sizeof(petsc_countererror));CHKERRQ(ierr);
+      for (j=0; j<PETSC_LOG_NUM_COUNTERS; j++) {close(petsc_counterfd[j]); petsc_counterfd[j] = -1;}
+    }
+    PetscFunctionReturn(0);
+  }
+#if defined(_SC_LEVEL3_CACHE_LINESIZE)
+  if (sysconf(_SC_LEVEL3_CACHE_LINESIZE) > 0) petsc_counterlinesize = (PetscLogDouble)sysconf(_SC_LEVEL3_CACHE_LINESIZE);
+#endif
+  if (ioctl(petsc_counterfd[0],PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP) || ioctl(petsc_counterfd[0],PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to enable the hardware counters");
+  PetscLogCounters = PETSC_TRUE;
+  PetscFunctionReturn(0);
+#else
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscStrncpy(petsc_countererror,"PETSc was not configured with linux/perf_event.h",sizeof(petsc_countererror));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*
+  PetscLogCountersGet - Returns the cycles, the instructions and the bytes of the last level cache misses, the last
+  estimated as the number of misses times the cache line size, scaled up if the counters were multiplexed
+*/
+PetscErrorCode PetscLogCountersGet(PetscLogDouble counters[])
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H) && defined(SYS_perf_event_open)
+  struct {
+    unsigned long long nr,enabled,running,values[PETSC_LOG_NUM_COUNTERS];
+  } data;
+  PetscLogDouble scale = 1.0;
+
+  PetscFunctionBegin;
+  if (read(petsc_counterfd[0],&data,sizeof(data)) != (ssize_t)sizeof(data)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to read the hardware counters");
+  if (data.running && data.running < data.enabled) scale = (PetscLogDouble)data.enabled/(PetscLogDouble)data.running;
+  counters[0] = scale*(PetscLogDouble)data.values[0];
+  counters[1] = scale*(PetscLogDouble)data.values[1];
+  counters[2] = scale*(PetscLogDouble)data.values[2]*petsc_counterlinesize;
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Hardware counters require linux/perf_event.h");
+#endif
+}
+
+/*
+  PetscLogCountersGetError - Returns why the counters requested with -log_view_counters could not be opened, or NULL
+*/
+PetscErrorCode PetscLogCountersGetError(const char **msg)
+{
+  PetscFunctionBegin;
+  *msg = petsc_countererror[0] ? petsc_countererror : NULL;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogCountersFinalize(void)
+{
+  int i;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (i=PETSC_LOG_NUM_COUNTERS-1; i>=0; i--) if (petsc_counterfd[i] >= 0) close(petsc_counterfd[i]);
+#endif
+  for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) petsc_counterfd[i] = -1;
+  petsc_countererror[0] = 0;
+  PetscLogCounters      = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
@@ -163,6 +163,9 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  eventInfo->cycles        = 0.0;
+  eventInfo->instructions  = 0.0;
+  eventInfo->cacheMissBytes = 0.0;
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -566,6 +569,7 @@ PetscErrorCode PetscLogEventGetPerfInfo(int stage,PetscLogEvent event,PetscEvent
   PetscFunctionBegin;
   PetscValidPointer(info,3);
   if (!PetscLogPLB) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Must use -log_view or PetscLogDefaultBegin() before calling this routine");
+  ierr = PetscLogBufferedFlush();CHKERRQ(ierr);
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   if (stage < 0) {ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);}
   ierr = PetscStageLogGetEventPerfLog(stageLog,stage,&eventLog);CHKERRQ(ierr);
@@ -582,6 +586,7 @@ PetscErrorCode PetscLogEventGetFlops(PetscLogEvent event,PetscLogDouble *flops)
 
   PetscFunctionBegin;
   if (!PetscLogPLB) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Must use -log_view or PetscLogDefaultBegin() before calling this routine");
+  ierr   = PetscLogBufferedFlush();CHKERRQ(ierr);
   ierr   = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr   = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
   ierr   = PetscStageLogGetEventPerfLog(stageLog,stage,&eventLog);CHKERRQ(ierr);
@@ -666,6 +671,13 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
     eventLog->eventInfo[event].mallocIncrease -= usage;
     ierr = PetscMallocPushMaximumUsage((int)event);CHKERRQ(ierr);
   }
+  if (PetscLogCounters) {
+    PetscLogDouble counters[3];
+    ierr = PetscLogCountersGet(counters);CHKERRQ(ierr);
+    eventLog->eventInfo[event].cycles         -= counters[0];
+    eventLog->eventInfo[event].instructions   -= counters[1];
+    eventLog->eventInfo[event].cacheMissBytes -= counters[2];
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount -= petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount -= petsc_gtoc_ct;
@@ -713,6 +725,13 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
     ierr = PetscMallocGetMaximumUsage(&usage);CHKERRQ(ierr);
     eventLog->eventInfo[event].mallocIncrease += usage;
   }
+  if (PetscLogCounters) {
+    PetscLogDouble counters[3];
+    ierr = PetscLogCountersGet(counters);CHKERRQ(ierr);
+    eventLog->eventInfo[event].cycles         += counters[0];
+    eventLog->eventInfo[event].instructions   += counters[1];
+    eventLog->eventInfo[event].cacheMissBytes += counters[2];
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount += petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount += petsc_gtoc_ct;
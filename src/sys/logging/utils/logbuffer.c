@@ -0,0 +1,362 @@
+/*
+     Buffered event logging. Instead of updating the event tables of the current stage at every PetscLogEventBegin()
+   and PetscLogEventEnd(), each thread appends timestamped records to its own buffer, which is aggregated into the
+   event tables only when it is full or when the tables are needed, for example by PetscLogView(). The records can
+   also be kept and written out as a Chrome trace.
+*/
+#include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+typedef unsigned long long PetscLogCycles;
+
+typedef struct {
+  PetscLogEvent  event;
+  int            stage;      /* the stage of a begin record, -1 for an end record */
+  PetscLogCycles cycles;
+  PetscLogDouble flops,messages,length,reductions;
+} PetscLogRecord;
+
+#define PETSC_LOG_BUFFER_MAX_DEPTH 128
+
+typedef struct {
+  PetscLogRecord *records;   /* the records not yet aggregated into the event tables */
+  int            n;
+  PetscLogRecord open[PETSC_LOG_BUFFER_MAX_DEPTH]; /* the begin records of the events still open at the last drain */
+  int            depth;
+  PetscLogRecord *trace;     /* all the aggregated records, kept only for a trace */
+  size_t         ntrace,maxtrace;
+} PetscLogBuffer;
+
+static PetscLogBuffer *petsc_logbuffers      = NULL;
+static int            petsc_numlogbuffers    = 0;
+static PetscInt       petsc_logbuffersize    = 4096;
+static PetscBool      petsc_logbuffertrace   = PETSC_FALSE;
+static PetscBool      petsc_logbufferwtime   = PETSC_FALSE;
+static PetscLogCycles petsc_logbuffercycles0 = 0;
+static PetscLogDouble petsc_logbuffertime0   = 0.0;
+static PetscLogDouble petsc_logsecpercycle   = 1.e-9;
+
+/* The time stamp counter when the processor has one, otherwise nanoseconds of PetscTime() */
+PETSC_STATIC_INLINE PetscLogCycles PetscLogGetCycles(void)
+{
+  PetscLogDouble t;
+
+  if (!petsc_logbufferwtime) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    return (PetscLogCycles)__builtin_ia32_rdtsc();
+#elif defined(__aarch64__) && defined(__GNUC__)
+    PetscLogCycles c;
+    __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (c));
+    return c;
+#endif
+  }
+  PetscTime(&t);
+  return (PetscLogCycles)(t*1.e9);
+}
+
+/* Measures the cycle counter against PetscTime() for a millisecond, falling back to PetscTime() if it does not advance */
+static PetscErrorCode PetscLogCyclesCalibrate_Private(void)
+{
+  PetscLogDouble t;
+  PetscLogCycles c;
+
+  PetscFunctionBegin;
+  PetscTime(&petsc_logbuffertime0);
+  petsc_logbuffercycles0 = PetscLogGetCycles();
+  do {
+    PetscTime(&t);
+    c = PetscLogGetCycles();
+  } while (t - petsc_logbuffertime0 < 1.e-3);
+  if (c > petsc_logbuffercycles0) petsc_logsecpercycle = (t - petsc_logbuffertime0)/(PetscLogDouble)(c - petsc_logbuffercycles0);
+  else {
+    petsc_logbufferwtime   = PETSC_TRUE;
+    petsc_logsecpercycle   = 1.e-9;
+    petsc_logbuffercycles0 = PetscLogGetCycles();
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode PetscLogBufferGet_Private(PetscLogBuffer **buf)
+{
+  int tid = 0;
+
+#if defined(PETSC_HAVE_OPENMP)
+  tid = omp_get_thread_num();
+  if (tid >= petsc_numlogbuffers) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Thread %d has no logging buffer, only %d threads were available in PetscLogBufferedBegin()",tid,petsc_numlogbuffers);
+#endif
+  *buf = &petsc_logbuffers[tid];
+  return 0;
+}
+
+/*
+   The routines below up to PetscLogBufferedFlush() run on the threads of OpenMP parallel regions, so they do not use
+   PetscFunctionBegin and PetscFunctionReturn(), which push to and pop from the stack of the main thread. For the same
+   reason the trace grows with realloc() instead of PetscMalloc(), whose debugging version keeps a global list.
+*/
+
+/* Aggregates the records of a buffer into the event tables of their stages and empties it */
+static PetscErrorCode PetscLogBufferDrain_Private(PetscLogBuffer *buf)
+{
+  PetscEventPerfInfo *info;
+  PetscLogRecord     *r,b;
+  PetscLogRecord     *trace;
+  PetscLogDouble     dt,df;
+  int                i,j,k;
+  PetscErrorCode     ierr;
+
+  if (petsc_logbuffertrace && buf->n) {
+    if (buf->ntrace + buf->n > buf->maxtrace) {
+      buf->maxtrace = PetscMax(2*buf->maxtrace,buf->ntrace + buf->n);
+      trace         = (PetscLogRecord*)realloc(buf->trace,buf->maxtrace*sizeof(PetscLogRecord));
+      if (!trace) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to grow the trace to %.0f records",(double)buf->maxtrace);
+      buf->trace = trace;
+    }
+    ierr = PetscArraycpy(buf->trace+buf->ntrace,buf->records,buf->n);CHKERRQ(ierr);
+    buf->ntrace += buf->n;
+  }
+  for (i=0; i<buf->n; i++) {
+    r = &buf->records[i];
+    if (r->stage >= 0) {
+      if (buf->depth == PETSC_LOG_BUFFER_MAX_DEPTH) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Buffered logging supports at most %d nested events",PETSC_LOG_BUFFER_MAX_DEPTH);
+      buf->open[buf->depth++] = *r;
+      continue;
+    }
+    /* events may overlap instead of nesting, so the matching begin is not necessarily the last one */
+    for (j=buf->depth-1; j>=0; j--) if (buf->open[j].event == r->event) break;
+    if (j < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
+    b = buf->open[j];
+    for (k=j; k<buf->depth-1; k++) buf->open[k] = buf->open[k+1];
+    buf->depth--;
+    /* only the outermost of recursive calls is counted, as in PetscLogEventEndDefault() */
+    for (k=0; k<j; k++) if (buf->open[k].event == r->event) break;
+    if (k < j) continue;
+    info = &petsc_stageLog->stageInfo[b.stage].eventLog->eventInfo[r->event];
+    dt   = r->cycles > b.cycles ? (PetscLogDouble)(r->cycles - b.cycles)*petsc_logsecpercycle : 0.0;
+    df   = r->flops - b.flops;
+    info->count++;
+    info->time          += dt;
+    info->time2         += dt*dt;
+    info->flops         += df;
+    info->flops2        += df*df;
+    info->numMessages   += r->messages - b.messages;
+    info->messageLength += r->length - b.length;
+    info->numReductions += r->reductions - b.reductions;
+  }
+  buf->n = 0;
+  return 0;
+}
+
+static PetscErrorCode PetscLogBufferDrain(PetscLogBuffer *buf)
+{
+  PetscErrorCode ierr;
+
+  /* a thread that fills its buffer inside a parallel region must not update the event tables concurrently with the others */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp critical (PetscLogBuffer)
+#endif
+  ierr = PetscLogBufferDrain_Private(buf);
+  CHKERRQ(ierr);
+  return 0;
+}
+
+PetscErrorCode PetscLogEventBeginBuffered(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscLogBuffer *buf = NULL;
+  PetscLogRecord *r;
+  PetscErrorCode ierr;
+
+  ierr = PetscLogBufferGet_Private(&buf);CHKERRQ(ierr);
+  if (buf->n == petsc_logbuffersize) {ierr = PetscLogBufferDrain(buf);CHKERRQ(ierr);}
+  r             = &buf->records[buf->n++];
+  r->event      = event;
+  r->stage      = petsc_stageLog->curStage;
+  r->flops      = petsc_TotalFlops;
+  r->messages   = petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
+  r->length     = petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
+  r->reductions = petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  r->cycles     = PetscLogGetCycles();
+  return 0;
+}
+
+PetscErrorCode PetscLogEventEndBuffered(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscLogBuffer *buf = NULL;
+  PetscLogRecord *r;
+  PetscLogCycles cycles = PetscLogGetCycles();
+  PetscErrorCode ierr;
+
+  ierr = PetscLogBufferGet_Private(&buf);CHKERRQ(ierr);
+  if (buf->n == petsc_logbuffersize) {ierr = PetscLogBufferDrain(buf);CHKERRQ(ierr);}
+  r             = &buf->records[buf->n++];
+  r->event      = event;
+  r->stage      = -1;
+  r->cycles     = cycles;
+  r->flops      = petsc_TotalFlops;
+  r->messages   = petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
+  r->length     = petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
+  r->reductions = petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  return 0;
+}
+
+/*
+  PetscLogBufferedFlush - Aggregates the records of all the threads into the event tables. Must be called outside
+  of parallel regions, it does nothing if buffered logging is not active.
+*/
+PetscErrorCode PetscLogBufferedFlush(void)
+{
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<petsc_numlogbuffers; i++) {ierr = PetscLogBufferDrain_Private(&petsc_logbuffers[i]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogBufferedDestroy(void)
+{
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<petsc_numlogbuffers; i++) {
+    ierr = PetscFree(petsc_logbuffers[i].records);CHKERRQ(ierr);
+    free(petsc_logbuffers[i].trace);
+  }
+  ierr = PetscFree(petsc_logbuffers);CHKERRQ(ierr);
+  petsc_numlogbuffers  = 0;
+  petsc_logbuffertrace = PETSC_FALSE;
+  petsc_logbufferwtime = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogBufferedBegin - Turns on buffered logging of events. This gathers the same information as
+  PetscLogDefaultBegin() for PetscLogView(), but each PetscLogEventBegin() and PetscLogEventEnd() only
+  appends a record to a buffer of the calling thread, which is aggregated later.
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Options Database Keys:
++ -log_buffered - Activates PetscLogBufferedBegin(), used with -log_view
+- -log_buffered_size <4096> - The number of records in the buffer of each thread
+
+  Notes:
+  Events are timed with the time stamp counter of the processor when it has one, calibrated against PetscTime().
+  The buffers are drained whenever they are full, and by PetscLogView() and PetscLogEventGetPerfInfo().
+
+  Events may be logged from the threads of OpenMP parallel regions, there is one buffer per thread available
+  when this routine is called. Nested parallel regions are not supported.
+
+  Synchronization with -log_sync, memory logging with -log_view_memory and hardware counters with -log_view_counters
+  are not available with buffered logging.
+
+  This must be called before any event begins, usually right after PetscInitialize().
+
+  Level: advanced
+
+.seealso: PetscLogDefaultBegin(), PetscLogView(), PetscLogChromeTraceBegin()
+@*/
+PetscErrorCode PetscLogBufferedBegin(void)
+{
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscLogCounters) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Buffered logging does not record the hardware counters of -log_view_counters");
+  if (!petsc_logbuffers) {
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_buffered_size",&petsc_logbuffersize,NULL);CHKERRQ(ierr);
+    if (petsc_logbuffersize < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"The buffer size %D must be positive",petsc_logbuffersize);
+#if defined(PETSC_HAVE_OPENMP)
+    petsc_numlogbuffers = omp_get_max_threads();
+#else
+    petsc_numlogbuffers = 1;
+#endif
+    ierr = PetscCalloc1(petsc_numlogbuffers,&petsc_logbuffers);CHKERRQ(ierr);
+    for (i=0; i<petsc_numlogbuffers; i++) {ierr = PetscMalloc1(petsc_logbuffersize,&petsc_logbuffers[i].records);CHKERRQ(ierr);}
+    ierr = PetscLogCyclesCalibrate_Private();CHKERRQ(ierr);
+  }
+  ierr = PetscLogSet(PetscLogEventBeginBuffered,PetscLogEventEndBuffered);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogChromeTraceBegin - Turns on buffered logging of events and keeps every record, to be written
+  as a Chrome trace by PetscLogChromeTraceDump().
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Options Database Key:
+. -log_chrome_trace [filename] - Activates PetscLogChromeTraceBegin() and calls PetscLogChromeTraceDump() in PetscFinalize()
+
+  Notes:
+  The memory used by the trace grows with the number of events, it is 48 bytes per call of PetscLogEventBegin() or PetscLogEventEnd().
+
+  Level: advanced
+
+.seealso: PetscLogBufferedBegin(), PetscLogChromeTraceDump(), PetscLogTraceBegin()
+@*/
+PetscErrorCode PetscLogChromeTraceBegin(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogBufferedBegin();CHKERRQ(ierr);
+  petsc_logbuffertrace = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogChromeTraceDump - Writes the events of all processes logged since PetscLogChromeTraceBegin() to a file in the
+  Trace Event Format, which can be loaded in chrome://tracing or https://ui.perfetto.dev
+
+  Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. filename - The name of the file, or NULL for "petsc_trace.json"
+
+  Notes:
+  Each process appears with its rank as process id and each thread with its OpenMP thread number. The events
+  are nested as they were logged, with begins and ends as "B" and "E" records whose time stamps are in microseconds
+  since PetscInitialize(). Events still open appear without an end.
+
+  Level: advanced
+
+.seealso: PetscLogChromeTraceBegin(), PetscLogDump()
+@*/
+PetscErrorCode PetscLogChromeTraceDump(const char filename[])
+{
+  PetscEventRegLog eventRegLog;
+  PetscLogRecord   *r;
+  PetscLogDouble   ts;
+  PetscMPIInt      rank;
+  FILE             *fd;
+  size_t           k;
+  int              i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (!petsc_logbuffertrace) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must use -log_chrome_trace or PetscLogChromeTraceBegin() before calling this routine");
+  ierr = PetscLogBufferedFlush();CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscStageLogGetEventRegLog(petsc_stageLog,&eventRegLog);CHKERRQ(ierr);
+  ierr = PetscFOpen(PETSC_COMM_WORLD,filename ? filename : "petsc_trace.json","w",&fd);CHKERRQ(ierr);
+  ierr = PetscFPrintf(PETSC_COMM_WORLD,fd,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");CHKERRQ(ierr);
+  ierr = PetscSynchronizedFPrintf(PETSC_COMM_WORLD,fd,"%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"Rank %d\"}}",rank ? ",\n" : "",rank,rank);CHKERRQ(ierr);
+  for (i=0; i<petsc_numlogbuffers; i++) {
+    for (k=0; k<petsc_logbuffers[i].ntrace; k++) {
+      r  = &petsc_logbuffers[i].trace[k];
+      ts = 1.e6*((PetscLogDouble)(r->cycles - petsc_logbuffercycles0)*petsc_logsecpercycle + petsc_logbuffertime0 - petsc_BaseTime);
+      if (r->stage >= 0) {
+        ierr = PetscSynchronizedFPrintf(PETSC_COMM_WORLD,fd,",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"B\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",eventRegLog->eventInfo[r->event].name,petsc_stageLog->stageInfo[r->stage].name,rank,i,ts);CHKERRQ(ierr);
+      } else {
+        ierr = PetscSynchronizedFPrintf(PETSC_COMM_WORLD,fd,",\n{\"name\":\"%s\",\"ph\":\"E\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",eventRegLog->eventInfo[r->event].name,rank,i,ts);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscSynchronizedFlush(PETSC_COMM_WORLD,fd);CHKERRQ(ierr);
+  ierr = PetscFPrintf(PETSC_COMM_WORLD,fd,"\n]}\n");CHKERRQ(ierr);
+  ierr = PetscFClose(PETSC_COMM_WORLD,fd);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
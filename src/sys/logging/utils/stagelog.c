@@ -208,6 +208,21 @@ PetscErrorCode  PetscStageLogRegister(PetscStageLog stageLog, const char sname[]
   PetscFunctionReturn(0);
 }
 
+/* Adds (sign 1) or subtracts (sign -1) the current hardware counters to those of a stage, as for its time and flops */
+static PetscErrorCode PetscStageLogCountersUpdate_Private(PetscEventPerfInfo *perfInfo,PetscLogDouble sign)
+{
+  PetscLogDouble counters[3];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!PetscLogCounters || !perfInfo->active) PetscFunctionReturn(0);
+  ierr = PetscLogCountersGet(counters);CHKERRQ(ierr);
+  perfInfo->cycles         += sign*counters[0];
+  perfInfo->instructions   += sign*counters[1];
+  perfInfo->cacheMissBytes += sign*counters[2];
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscStageLogPush - This function pushes a stage on the stack.
 
@@ -263,6 +278,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
     }
+    ierr = PetscStageLogCountersUpdate_Private(&stageLog->stageInfo[curStage].perfInfo,1.0);CHKERRQ(ierr);
   }
   /* Activate the stage */
   ierr = PetscIntStackPush(stageLog->stack, stage);CHKERRQ(ierr);
@@ -278,6 +294,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
   }
+  ierr = PetscStageLogCountersUpdate_Private(&stageLog->stageInfo[stage].perfInfo,-1.0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -327,6 +344,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
   }
+  ierr = PetscStageLogCountersUpdate_Private(&stageLog->stageInfo[curStage].perfInfo,1.0);CHKERRQ(ierr);
   ierr = PetscIntStackEmpty(stageLog->stack, &empty);CHKERRQ(ierr);
   if (!empty) {
     /* Subtract current quantities so that we obtain the difference when we pop */
@@ -338,6 +356,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
     }
+    ierr = PetscStageLogCountersUpdate_Private(&stageLog->stageInfo[curStage].perfInfo,-1.0);CHKERRQ(ierr);
     stageLog->curStage = curStage;
   } else stageLog->curStage = -1;
   PetscFunctionReturn(0);
@@ -0,0 +1,198 @@
+/*
+     NUMA placement of PetscMalloc() selected with -malloc_numa. The allocations are obtained from PetscMallocAlign() and
+   the whole pages they contain are bound with mbind() before they are touched.
+*/
+#include <petscsys.h>             /*I   "petscsys.h"   I*/
+#include <petscviewer.h>
+#if defined(PETSC_HAVE_SYS_SYSCALL_H)
+#include <sys/syscall.h>
+#endif
+#if defined(PETSC_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+#include <errno.h>
+#include <string.h>
+
+#if defined(SYS_mbind) && defined(SYS_getcpu) && defined(PETSC_HAVE_GETPAGESIZE)
+#define PETSC_HAVE_MBIND_SYSCALL
+#endif
+
+/* the memory policies of <numaif.h>, which is only available with libnuma */
+#if !defined(MPOL_PREFERRED)
+#define MPOL_PREFERRED 1
+#endif
+#if !defined(MPOL_LOCAL)
+#define MPOL_LOCAL     4
+#endif
+
+#define PETSC_NUMA_MAX_NODES 64
+
+/*
+   These are defined in mal.c and ensure that malloced space is PetscScalar aligned
+*/
+PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t,PetscBool,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscFreeAlign(void*,int,const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t,int,const char[],const char[],void**);
+
+static PetscBool      petscnumaset    = PETSC_FALSE;
+static int            petscnumapolicy = MPOL_PREFERRED;
+static unsigned long  petscnumamask   = 0;
+static size_t         petscnumapage   = 4096;
+static PetscLogDouble petscnumabound  = 0.0;    /* bytes of the pages bound */
+static int            petscnumaerrno  = 0;      /* errno of the first mbind() that failed */
+
+/*
+   Binds the whole pages of a new allocation, which have not been touched yet if the allocation is large enough to be
+   mapped directly by the system malloc(). A failure only loses the placement, so it is recorded for -memory_view.
+*/
+static void PetscNUMABind_Private(void *ptr,size_t mem)
+{
+#if defined(PETSC_HAVE_MBIND_SYSCALL)
+  PETSC_UINTPTR_T start = ((PETSC_UINTPTR_T)ptr + petscnumapage-1) & ~(PETSC_UINTPTR_T)(petscnumapage-1);
+  PETSC_UINTPTR_T end   = ((PETSC_UINTPTR_T)ptr + mem) & ~(PETSC_UINTPTR_T)(petscnumapage-1);
+
+  if (end <= start) return;
+  if (syscall(SYS_mbind,(void*)start,(unsigned long)(end - start),petscnumapolicy,petscnumapolicy == MPOL_LOCAL ? NULL : &petscnumamask,petscnumapolicy == MPOL_LOCAL ? 0 : 8*sizeof(petscnumamask),0)) {
+    if (!petscnumaerrno) petscnumaerrno = errno;
+    return;
+  }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp atomic
+#endif
+  petscnumabound += (PetscLogDouble)(end - start);
+#endif
+}
+
+static PetscErrorCode PetscNUMAMalloc(size_t a,PetscBool clear,int lineno,const char function[],const char filename[],void **result)
+{
+  PetscErrorCode ierr;
+
+  /* clearing touches the pages, so they are bound before */
+  ierr = PetscMallocAlign(a,PETSC_FALSE,lineno,function,filename,result);if (ierr) return ierr;
+  PetscNUMABind_Private(*result,a);
+  if (clear && a) {ierr = PetscMemzero(*result,a);if (ierr) return ierr;}
+  return 0;
+}
+
+static PetscErrorCode PetscNUMAFree(void *aa,int lineno,const char function[],const char filename[])
+{
+  return PetscFreeAlign(aa,lineno,function,filename);
+}
+
+static PetscErrorCode PetscNUMARealloc(size_t a,int lineno,const char function[],const char filename[],void **result)
+{
+  PetscErrorCode ierr;
+
+  ierr = PetscReallocAlign(a,lineno,function,filename,result);if (ierr) return ierr;
+  PetscNUMABind_Private(*result,a);
+  return 0;
+}
+
+/*
+   Processes that run one thread prefer the node they are running on, so that pages touched later by another thread,
+   for example a progress thread of MPI, still end up there. Threaded processes place each page on the node of the
+   thread that touches it first, which the threaded kernels ensure is the thread that uses it.
+*/
+PETSC_INTERN PetscErrorCode PetscSetUseNUMAMalloc_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MBIND_SYSCALL)
+  {
+    unsigned cpu = 0,node = 0;
+    int      nthreads = 1;
+
+#if defined(PETSC_HAVE_OPENMP)
+    nthreads = omp_get_max_threads();
+#endif
+    petscnumapage = (size_t)getpagesize();
+    if (syscall(SYS_getcpu,&cpu,&node,NULL) || node >= 8*sizeof(petscnumamask)) node = 0;
+    petscnumamask   = 1UL << node;
+    petscnumapolicy = nthreads > 1 ? MPOL_LOCAL : MPOL_PREFERRED;
+    if (nthreads > 1) {
+      ierr = PetscInfo1(NULL,"Binding PetscMalloc() memory to the node of the first of the %d threads touching it\n",nthreads);CHKERRQ(ierr);
+    } else {
+      ierr = PetscInfo2(NULL,"Binding PetscMalloc() memory to node %u of CPU %u\n",node,cpu);CHKERRQ(ierr);
+    }
+  }
+#endif
+  ierr = PetscMallocSet(PetscNUMAMalloc,PetscNUMAFree,PetscNUMARealloc);CHKERRQ(ierr);
+  petscnumaset   = PETSC_TRUE;
+  petscnumabound = 0.0;
+  petscnumaerrno = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Sums the pages of all the mappings of the process per NUMA node, nnodes is set to zero if the OS does not tell */
+static PetscErrorCode PetscNUMAGetResident_Private(PetscLogDouble resident[],PetscMPIInt *nnodes)
+{
+  FILE           *fd;
+  char           line[4096],*tok;
+  PetscLogDouble pages[PETSC_NUMA_MAX_NODES],pagesize;
+  unsigned long  n,kb;
+  int            node;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *nnodes = 0;
+  ierr    = PetscArrayzero(resident,PETSC_NUMA_MAX_NODES);CHKERRQ(ierr);
+  if (!(fd = fopen("/proc/self/numa_maps","r"))) PetscFunctionReturn(0);
+  while (fgets(line,sizeof(line),fd)) {
+    ierr     = PetscArrayzero(pages,PETSC_NUMA_MAX_NODES);CHKERRQ(ierr);
+    pagesize = 4096.0;
+    for (tok = strtok(line," \n"); tok; tok = strtok(NULL," \n")) {
+      if (sscanf(tok,"N%d=%lu",&node,&n) == 2 && node >= 0 && node < PETSC_NUMA_MAX_NODES) {
+        pages[node] += (PetscLogDouble)n;
+        *nnodes      = PetscMax(*nnodes,node+1);
+      } else if (sscanf(tok,"kernelpagesize_kB=%lu",&kb) == 1) pagesize = 1024.0*(PetscLogDouble)kb;
+    }
+    for (node=0; node<*nnodes; node++) resident[node] += pages[node]*pagesize;
+  }
+  if (fclose(fd)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"fclose() failed on file");
+  PetscFunctionReturn(0);
+}
+
+/*
+   Adds to PetscMemoryView() the process memory resident on each NUMA node and the space bound by -malloc_numa
+*/
+PETSC_INTERN PetscErrorCode PetscMemoryViewNUMA_Private(PetscViewer viewer)
+{
+  PetscLogDouble resident[PETSC_NUMA_MAX_NODES],gresident[PETSC_NUMA_MAX_NODES],maxgresident[PETSC_NUMA_MAX_NODES],mingresident[PETSC_NUMA_MAX_NODES];
+  PetscLogDouble gbound,maxgbound,mingbound;
+  PetscMPIInt    nnodes,gnnodes,failed = petscnumaerrno ? 1 : 0,gfailed;
+  MPI_Comm       comm;
+  int            node;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!petscnumaset) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = PetscNUMAGetResident_Private(resident,&nnodes);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&nnodes,&gnnodes,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  if (!gnnodes) {
+    ierr = PetscViewerASCIIPrintf(viewer,"OS cannot compute the NUMA placement of process memory\n");CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Reduce(resident,gresident,gnnodes,MPIU_PETSCLOGDOUBLE,MPI_SUM,0,comm);CHKERRQ(ierr);
+    ierr = MPI_Reduce(resident,maxgresident,gnnodes,MPIU_PETSCLOGDOUBLE,MPI_MAX,0,comm);CHKERRQ(ierr);
+    ierr = MPI_Reduce(resident,mingresident,gnnodes,MPIU_PETSCLOGDOUBLE,MPI_MIN,0,comm);CHKERRQ(ierr);
+    for (node=0; node<gnnodes; node++) {
+      ierr = PetscViewerASCIIPrintf(viewer,"Process memory on NUMA node %2d:                          total %5.4e max %5.4e min %5.4e\n",node,gresident[node],maxgresident[node],mingresident[node]);CHKERRQ(ierr);
+    }
+  }
+  ierr = MPI_Reduce(&petscnumabound,&gbound,1,MPIU_PETSCLOGDOUBLE,MPI_SUM,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Reduce(&petscnumabound,&maxgbound,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Reduce(&petscnumabound,&mingbound,1,MPIU_PETSCLOGDOUBLE,MPI_MIN,0,comm);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Space bound to NUMA nodes by -malloc_numa:               total %5.4e max %5.4e min %5.4e\n",gbound,maxgbound,mingbound);CHKERRQ(ierr);
+  ierr = MPI_Reduce(&failed,&gfailed,1,MPI_INT,MPI_SUM,0,comm);CHKERRQ(ierr);
+  if (gfailed) {
+    ierr = PetscViewerASCIIPrintf(viewer,"mbind() failed on %d processes%s%s\n",gfailed,petscnumaerrno ? ", on this one with: " : "",petscnumaerrno ? strerror(petscnumaerrno) : "");CHKERRQ(ierr);
+  }
+#if !defined(PETSC_HAVE_MBIND_SYSCALL)
+  ierr = PetscViewerASCIIPrintf(viewer,"-malloc_numa has no effect, mbind() is not available\n");CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,405 @@
+/*
+     A pooled allocator for PetscMalloc() selected with -malloc_pool. Small requests are rounded up to one of a few
+   size classes and served from free lists, one set per thread, that are refilled by carving large slabs obtained from
+   PetscMallocAlign(). Memory allocated while a PetscMallocArena is pushed is instead taken from the arena and is
+   released all at once by PetscMallocArenaDestroy().
+*/
+#include <petsc/private/petscimpl.h>        /*I   "petscsys.h"   I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t,PetscBool,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscFreeAlign(void*,int,const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t,int,const char[],const char[],void**);
+
+#define PETSC_POOL_CLASSID  0x7e57c1a5
+#define PETSC_POOL_LARGE    -1    /* obtained from PetscMallocAlign() and returned to it */
+#define PETSC_POOL_ARENA    -2    /* obtained from an arena, released with the arena */
+#define PETSC_POOL_NCLASSES 16
+#define PETSC_POOL_SLAB     65536
+#define PETSC_ARENA_BLOCK   65536
+
+static const size_t PetscPoolSizes[PETSC_POOL_NCLASSES] = {16,32,48,64,96,128,192,256,384,512,768,1024,1536,2048,3072,4096};
+
+/* precedes every chunk handed out; its size is rounded up to a multiple of PETSC_MEMALIGN */
+typedef struct {
+  size_t size;                     /* requested size, used by PetscPoolRealloc() */
+  int    sizeclass;
+  int    classid;
+} PetscPoolHeader;
+
+#define PETSC_POOL_ALIGN(n) (((n) + PETSC_MEMALIGN-1) & ~(size_t)(PETSC_MEMALIGN-1))
+#define PETSC_POOL_HEADER   PETSC_POOL_ALIGN(sizeof(PetscPoolHeader))
+
+typedef struct _PetscPoolLink {
+  struct _PetscPoolLink *next;
+} PetscPoolLink;
+
+struct _n_PetscMallocArena {
+  PetscPoolLink    *blocks;        /* blocks obtained from PetscMallocAlign(), each starting with its link */
+  char             *ptr;           /* next free byte in the current block */
+  size_t           avail;          /* bytes left in the current block */
+  PetscLogDouble   used;           /* bytes handed out, including the chunk headers */
+  PetscMallocArena prev;           /* the arena pushed before this one */
+  PetscBool        pushed;
+};
+
+typedef struct {
+  PetscPoolLink    *free[PETSC_POOL_NCLASSES];
+  PetscPoolLink    *slabs;
+  PetscMallocArena arena;          /* the arena on top of the stack of this thread */
+} PetscPool;
+
+static PetscPool petscpoolself;
+static PetscPool *petscpools  = &petscpoolself;
+static int       petscnpools  = 1;
+static PetscBool petscpoolset = PETSC_FALSE;
+
+/* the pool of the calling thread, or NULL for threads of nested parallel regions which share thread numbers */
+PETSC_STATIC_INLINE PetscPool *PetscPoolGet_Private(void)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  int tid;
+
+  if (omp_get_level() > 1) return NULL;
+  tid = omp_get_thread_num();
+  return tid < petscnpools ? &petscpools[tid] : NULL;
+#else
+  return petscpools;
+#endif
+}
+
+PETSC_STATIC_INLINE int PetscPoolSizeClass_Private(size_t mem)
+{
+  int c;
+
+  for (c=0; c<PETSC_POOL_NCLASSES; c++) if (mem <= PetscPoolSizes[c]) return c;
+  return PETSC_POOL_LARGE;
+}
+
+static PetscErrorCode PetscPoolRefill_Private(PetscPool *pool,int c,int line,const char func[],const char file[])
+{
+  /* the stride is a multiple of PETSC_MEMALIGN, which may exceed the spacing of the small size classes, so that all chunks stay aligned */
+  const size_t   chunk = PETSC_POOL_HEADER + PETSC_POOL_ALIGN(PetscPoolSizes[c]);
+  char           *slab,*p;
+  size_t         i,n;
+  PetscErrorCode ierr;
+
+  ierr = PetscMallocAlign(PETSC_POOL_SLAB,PETSC_FALSE,line,func,file,(void**)&slab);if (ierr) return ierr;
+  ((PetscPoolLink*)slab)->next = pool->slabs;
+  pool->slabs = (PetscPoolLink*)slab;
+  /* the first chunk is left for the link of the slab so that all chunks stay aligned */
+  n = PETSC_POOL_SLAB/chunk - 1;
+  for (i=n; i>0; i--) {
+    p = slab + i*chunk + PETSC_POOL_HEADER;
+    ((PetscPoolHeader*)(p - PETSC_POOL_HEADER))->sizeclass = c;
+    ((PetscPoolHeader*)(p - PETSC_POOL_HEADER))->classid   = PETSC_POOL_CLASSID;
+    ((PetscPoolLink*)p)->next = pool->free[c];
+    pool->free[c] = (PetscPoolLink*)p;
+  }
+  return 0;
+}
+
+static PetscErrorCode PetscArenaMalloc_Private(PetscMallocArena arena,size_t mem,int line,const char func[],const char file[],void **result)
+{
+  const size_t   need = PETSC_POOL_HEADER + PETSC_POOL_ALIGN(mem);
+  char           *block;
+  PetscErrorCode ierr;
+
+  if (need > arena->avail) {
+    /* large requests get a block of their own so that the current block is not wasted */
+    const PetscBool own  = (PetscBool)(4*need > PETSC_ARENA_BLOCK);
+    const size_t    size = PETSC_POOL_HEADER + (own ? need : PETSC_ARENA_BLOCK);
+
+    ierr = PetscMallocAlign(size,PETSC_FALSE,line,func,file,(void**)&block);if (ierr) return ierr;
+    ((PetscPoolLink*)block)->next = arena->blocks;
+    arena->blocks = (PetscPoolLink*)block;
+    if (own) {
+      *result = block + PETSC_POOL_HEADER;
+      arena->used += need;
+      return 0;
+    }
+    arena->ptr   = block + PETSC_POOL_HEADER;
+    arena->avail = PETSC_ARENA_BLOCK;
+  }
+  *result       = arena->ptr;
+  arena->ptr   += need;
+  arena->avail -= need;
+  arena->used  += need;
+  return 0;
+}
+
+static PetscErrorCode PetscPoolMalloc_Private(size_t mem,PetscBool clear,PetscBool usearena,int line,const char func[],const char file[],void **result)
+{
+  PetscPool       *pool;
+  PetscPoolHeader *head;
+  char            *p;
+  int             c;
+  PetscErrorCode  ierr;
+
+  if (!mem) {*result = NULL; return 0;}
+  pool = PetscPoolGet_Private();
+  c    = PetscPoolSizeClass_Private(mem);
+  if (pool && pool->arena && usearena) {
+    ierr = PetscArenaMalloc_Private(pool->arena,mem,line,func,file,(void**)&p);if (ierr) return ierr;
+    c    = PETSC_POOL_ARENA;
+  } else if (!pool || c == PETSC_POOL_LARGE) {
+    ierr = PetscMallocAlign(PETSC_POOL_HEADER + mem,PETSC_FALSE,line,func,file,(void**)&p);if (ierr) return ierr;
+    c    = PETSC_POOL_LARGE;
+  } else {
+    if (!pool->free[c]) {ierr = PetscPoolRefill_Private(pool,c,line,func,file);if (ierr) return ierr;}
+    p             = (char*)pool->free[c] - PETSC_POOL_HEADER;
+    pool->free[c] = pool->free[c]->next;
+  }
+  head            = (PetscPoolHeader*)p;
+  head->size      = mem;
+  head->sizeclass = c;
+  head->classid   = PETSC_POOL_CLASSID;
+  *result         = p + PETSC_POOL_HEADER;
+  if (clear) {ierr = PetscMemzero(*result,mem);if (ierr) return ierr;}
+  return 0;
+}
+
+static PetscErrorCode PetscPoolMalloc(size_t mem,PetscBool clear,int line,const char func[],const char file[],void **result)
+{
+  return PetscPoolMalloc_Private(mem,clear,PETSC_TRUE,line,func,file,result);
+}
+
+static PetscErrorCode PetscPoolFree(void *ptr,int line,const char func[],const char file[])
+{
+  PetscPoolHeader *head;
+  PetscPool       *pool;
+
+  if (!ptr) return 0;
+  head = (PetscPoolHeader*)((char*)ptr - PETSC_POOL_HEADER);
+  if (head->classid != PETSC_POOL_CLASSID) return PetscError(PETSC_COMM_SELF,line,func,file,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Block at address %p was not allocated with -malloc_pool or is corrupted",ptr);
+  switch (head->sizeclass) {
+  case PETSC_POOL_ARENA:
+    /* released with its arena */
+    return 0;
+  case PETSC_POOL_LARGE:
+    return PetscFreeAlign(head,line,func,file);
+  default:
+    /* a chunk freed by another thread than the one that allocated it migrates to the free list of the former,
+       chunks freed from nested parallel regions are not reused */
+    pool = PetscPoolGet_Private();
+    if (!pool) return 0;
+    ((PetscPoolLink*)ptr)->next = pool->free[head->sizeclass];
+    pool->free[head->sizeclass] = (PetscPoolLink*)ptr;
+  }
+  return 0;
+}
+
+static PetscErrorCode PetscPoolRealloc(size_t mem,int line,const char func[],const char file[],void **result)
+{
+  PetscPoolHeader *head;
+  void            *p;
+  PetscErrorCode  ierr;
+
+  if (!*result) return PetscPoolMalloc(mem,PETSC_FALSE,line,func,file,result);
+  if (!mem) {
+    ierr = PetscPoolFree(*result,line,func,file);if (ierr) return ierr;
+    *result = NULL;
+    return 0;
+  }
+  head = (PetscPoolHeader*)((char*)*result - PETSC_POOL_HEADER);
+  if (head->classid != PETSC_POOL_CLASSID) return PetscError(PETSC_COMM_SELF,line,func,file,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Block at address %p was not allocated with -malloc_pool or is corrupted",*result);
+  if (head->sizeclass >= 0 && mem <= PetscPoolSizes[head->sizeclass]) {
+    head->size = mem;
+    return 0;
+  }
+  if (head->sizeclass == PETSC_POOL_LARGE && PetscPoolSizeClass_Private(mem) == PETSC_POOL_LARGE) {
+    p    = head;
+    ierr = PetscReallocAlign(PETSC_POOL_HEADER + mem,line,func,file,&p);if (ierr) return ierr;
+    ((PetscPoolHeader*)p)->size = mem;
+    *result = (char*)p + PETSC_POOL_HEADER;
+    return 0;
+  }
+  /* memory that does not come from an arena, such as a growing global table, is kept out of the arena */
+  ierr = PetscPoolMalloc_Private(mem,PETSC_FALSE,(PetscBool)(head->sizeclass == PETSC_POOL_ARENA),line,func,file,&p);if (ierr) return ierr;
+  ierr = PetscMemcpy(p,*result,PetscMin(mem,head->size));if (ierr) return ierr;
+  ierr = PetscPoolFree(*result,line,func,file);if (ierr) return ierr;
+  *result = p;
+  return 0;
+}
+
+PETSC_INTERN PetscErrorCode PetscSetUsePoolMalloc_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  petscnpools = omp_get_max_threads();
+  if (petscnpools > 1) {
+    ierr = PetscMallocAlign(petscnpools*sizeof(PetscPool),PETSC_TRUE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(void**)&petscpools);CHKERRQ(ierr);
+  }
+#endif
+  ierr = PetscMallocSet(PetscPoolMalloc,PetscPoolFree,PetscPoolRealloc);CHKERRQ(ierr);
+  petscpoolset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Returns the slabs of all threads to the system, called at the end of PetscFinalize() after MPI is finalized */
+PETSC_INTERN PetscErrorCode PetscMallocPoolFinalize_Private(void)
+{
+  PetscPoolLink  *slab;
+  int            t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!petscpoolset) PetscFunctionReturn(0);
+  for (t=0; t<petscnpools; t++) {
+    while ((slab = petscpools[t].slabs)) {
+      petscpools[t].slabs = slab->next;
+      ierr = PetscFreeAlign(slab,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+    }
+  }
+  if (petscpools != &petscpoolself) {ierr = PetscFreeAlign(petscpools,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);}
+  ierr = PetscMemzero(&petscpoolself,sizeof(petscpoolself));CHKERRQ(ierr);
+  petscpools   = &petscpoolself;
+  petscnpools  = 1;
+  petscpoolset = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaCreate - Creates an arena, a region from which all the PetscMalloc() calls made while it is pushed
+   with PetscMallocArenaPush() are served, and which is released in a single call by PetscMallocArenaDestroy()
+
+   Not Collective
+
+   Output Parameter:
+.  arena - the new arena
+
+   Options Database Keys:
+.  -malloc_pool - use the pooled allocator, which is required for arenas to have any effect
+
+   Notes:
+   An object can push its arena around its setup so that the many small allocations made there are contiguous and
+   need no individual bookkeeping, and destroy the arena when it is destroyed itself. PetscFree() of memory from an
+   arena does nothing; the memory is only released by PetscMallocArenaDestroy(), after which none of it may be used.
+   Hence only memory whose lifetime ends with the object should be allocated while its arena is pushed; in particular
+   packages and classes should be registered before.
+
+   Without -malloc_pool, PetscMallocArenaPush() has no effect and memory is allocated and freed as usual.
+
+   Level: developer
+
+.seealso: PetscMallocArenaDestroy(), PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocArenaGetUsage(), PetscMallocSet()
+@*/
+PetscErrorCode PetscMallocArenaCreate(PetscMallocArena *arena)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(arena,1);
+  ierr = PetscMallocAlign(sizeof(struct _n_PetscMallocArena),PETSC_TRUE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(void**)arena);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaDestroy - Releases all the memory allocated from an arena and the arena itself
+
+   Not Collective
+
+   Input Parameter:
+.  arena - the arena
+
+   Level: developer
+
+.seealso: PetscMallocArenaCreate(), PetscMallocArenaPush(), PetscMallocArenaPop()
+@*/
+PetscErrorCode PetscMallocArenaDestroy(PetscMallocArena *arena)
+{
+  PetscPoolLink  *block;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*arena) PetscFunctionReturn(0);
+  if ((*arena)->pushed) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Cannot destroy an arena that is pushed, call PetscMallocArenaPop() first");
+  while ((block = (*arena)->blocks)) {
+    (*arena)->blocks = block->next;
+    ierr = PetscFreeAlign(block,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+  }
+  ierr = PetscFreeAlign(*arena,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+  *arena = NULL;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaPush - Makes the calling thread allocate from an arena until the matching PetscMallocArenaPop()
+
+   Not Collective
+
+   Input Parameter:
+.  arena - the arena
+
+   Notes:
+   Arenas can be nested, the most recently pushed one is used. PetscRealloc() of memory from an arena copies it within
+   the arena, while PetscRealloc() of other memory never moves it into the arena.
+
+   Level: developer
+
+.seealso: PetscMallocArenaCreate(), PetscMallocArenaPop(), PetscMallocArenaDestroy()
+@*/
+PetscErrorCode PetscMallocArenaPush(PetscMallocArena arena)
+{
+  PetscPool *pool = PetscPoolGet_Private();
+
+  PetscFunctionBegin;
+  PetscValidPointer(arena,1);
+  if (arena->pushed) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Arena is already pushed");
+  if (!pool) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Arenas cannot be pushed from nested parallel regions");
+  arena->prev   = pool->arena;
+  arena->pushed = PETSC_TRUE;
+  pool->arena   = arena;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaPop - Stops allocating from the arena last pushed by the calling thread
+
+   Not Collective
+
+   Level: developer
+
+.seealso: PetscMallocArenaCreate(), PetscMallocArenaPush(), PetscMallocArenaDestroy()
+@*/
+PetscErrorCode PetscMallocArenaPop(void)
+{
+  PetscPool        *pool = PetscPoolGet_Private();
+  PetscMallocArena arena;
+
+  PetscFunctionBegin;
+  if (!pool || !pool->arena) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"No arena has been pushed");
+  arena         = pool->arena;
+  pool->arena   = arena->prev;
+  arena->prev   = NULL;
+  arena->pushed = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaGetUsage - Returns the number of bytes allocated from an arena, including the headers of the chunks
+
+   Not Collective
+
+   Input Parameter:
+.  arena - the arena
+
+   Output Parameter:
+.  space - the number of bytes
+
+   Level: developer
+
+.seealso: PetscMallocArenaCreate(), PetscMallocGetCurrentUsage()
+@*/
+PetscErrorCode PetscMallocArenaGetUsage(PetscMallocArena arena,PetscLogDouble *space)
+{
+  PetscFunctionBegin;
+  PetscValidPointer(arena,1);
+  PetscValidRealPointer(space,2);
+  *space = arena->used;
+  PetscFunctionReturn(0);
+}
@@ -14,6 +14,7 @@
 PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t,PetscBool,int,const char[],const char[],void**);
 PETSC_EXTERN PetscErrorCode PetscFreeAlign(void*,int,const char[],const char[]);
 PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t,int,const char[],const char[],void**);
+PETSC_INTERN PetscErrorCode PetscMemoryViewNUMA_Private(PetscViewer);
 
 #define CLASSID_VALUE  ((PetscClassId) 0xf0e0d0c9)
 #define ALREADY_FREED  ((PetscClassId) 0x0f0e0d9c)
@@ -458,6 +459,7 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
 
     Options Database:
 +    -malloc_debug - have PETSc track how much memory it has allocated
+.    -malloc_numa - also show how much process memory is resident on each NUMA node
 -    -memory_view - during PetscFinalize() have this routine called
 
     Level: intermediate
@@ -526,6 +528,7 @@ PetscErrorCode  PetscMemoryView(PetscViewer viewer,const char message[])
   } else {
     ierr = PetscViewerASCIIPrintf(viewer,"Run with -malloc_debug to get statistics on PetscMalloc() calls\nOS cannot compute process memory\n");CHKERRQ(ierr);
   }
+  ierr = PetscMemoryViewNUMA_Private(viewer);CHKERRQ(ierr);
   ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
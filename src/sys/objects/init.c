@@ -305,6 +305,8 @@ PetscErrorCode  PetscEnd(void)
 
 PetscBool PetscOptionsPublish = PETSC_FALSE;
 PETSC_INTERN PetscErrorCode PetscSetUseHBWMalloc_Private(void);
+PETSC_INTERN PetscErrorCode PetscSetUsePoolMalloc_Private(void);
+PETSC_INTERN PetscErrorCode PetscSetUseNUMAMalloc_Private(void);
 PETSC_INTERN PetscBool      petscsetmallocvisited;
 static       char           emacsmachinename[256];
 
@@ -377,7 +379,7 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     /*
       Setup the memory management; support for tracing malloc() usage
     */
-    PetscBool         mdebug = PETSC_FALSE, eachcall = PETSC_FALSE, initializenan = PETSC_FALSE, mlog = PETSC_FALSE;
+    PetscBool         mdebug = PETSC_FALSE, eachcall = PETSC_FALSE, initializenan = PETSC_FALSE, mlog = PETSC_FALSE, mpool = PETSC_FALSE, mnuma = PETSC_FALSE, mdump = PETSC_FALSE, mmemory = PETSC_FALSE;
 
     if (PetscDefined(USE_DEBUG)) {
       mdebug        = PETSC_TRUE;
@@ -405,9 +407,20 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     }
     /* the next line is deprecated */
     ierr = PetscOptionsGetBool(NULL,NULL,"-malloc",&mdebug,NULL);CHKERRQ(ierr);
-    ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_dump",&mdebug,NULL);CHKERRQ(ierr);
-    ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_memory",&mdebug,NULL);CHKERRQ(ierr);
-    if (mdebug) {
+    ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_dump",&mdump,&flg3);CHKERRQ(ierr);
+    if (flg3) mdebug = mdump;
+    ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_memory",&mmemory,&flg3);CHKERRQ(ierr);
+    if (flg3) mdebug = mmemory;
+    /* the pooled and NUMA allocators replace the debugging one that is used by default in debug builds, so they cannot be
+       combined with the options that need it */
+    ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_pool",&mpool,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_numa",&mnuma,NULL);CHKERRQ(ierr);
+    if ((mpool || mnuma) && !petscsetmallocvisited && (flg1 || flg2 || mlog || mdump || mmemory)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"-malloc_%s cannot be used with -malloc_debug, -malloc_test, -malloc_view, -malloc_dump, or -log_view_memory",mpool ? "pool" : "numa");
+    if (mpool && !petscsetmallocvisited) {
+      ierr = PetscSetUsePoolMalloc_Private();CHKERRQ(ierr);
+    } else if (mnuma && !petscsetmallocvisited) {
+      ierr = PetscSetUseNUMAMalloc_Private();CHKERRQ(ierr);
+    } else if (mdebug) {
       ierr = PetscMallocSetDebug(eachcall,initializenan);CHKERRQ(ierr);
     }
     if (mlog) {
@@ -655,6 +668,12 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = PetscOptionsGetReal(NULL,NULL,"-log_threshold",&threshold,&flg1);CHKERRQ(ierr);
     if (flg1) {ierr = PetscLogSetThreshold((PetscLogDouble)threshold,NULL);CHKERRQ(ierr);}
   }
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_buffered",&flg1,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_chrome_trace",&flg2);CHKERRQ(ierr);
+  if ((flg1 || flg2) && flg4 && format == PETSC_VIEWER_ASCII_XML) SETERRQ(comm,PETSC_ERR_SUP,"Cannot use -log_buffered or -log_chrome_trace with -log_view ::ascii_xml");
+  if (flg2)      { ierr = PetscLogChromeTraceBegin();CHKERRQ(ierr); }
+  else if (flg1) { ierr = PetscLogBufferedBegin();CHKERRQ(ierr); }
 #endif
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-saws_options",&PetscOptionsPublish,NULL);CHKERRQ(ierr);
@@ -732,6 +751,8 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -malloc_info: prints total memory usage\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_view <optional filename>: keeps log of all memory allocations, displays in PetscFinalize()\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_debug <true or false>: enables or disables extended checking for memory corruption\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool: use pooled malloc with per-thread free lists of small sizes, required by PetscMallocArenaPush(), incompatible with -malloc_debug\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_numa: bind PetscMalloc() memory to the local NUMA node, -memory_view shows the placement\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_view: dump list of options inputted\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left: dump list of unused options\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left no: don't dump list of unused options\n");CHKERRQ(ierr);
@@ -743,6 +764,9 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -get_total_flops: total flops over all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_view [:filename:[format]]: logging objects and events\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_trace [filename]: prints trace of all PETSc calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_counters: adds memory bandwidth, arithmetic intensity and IPC from hardware counters to -log_view\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_buffered: log events in per-thread buffers aggregated at -log_view\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_chrome_trace [filename]: writes a Chrome trace of all events\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_exclude <list,of,classnames>: exclude given classes from logging\n");CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPE)
     ierr = (*PetscHelpPrintf)(comm," -log_mpe: Also create logfile viewable through Jumpshot\n");CHKERRQ(ierr);
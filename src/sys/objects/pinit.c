@@ -29,6 +29,7 @@ PETSC_INTERN PetscErrorCode PetscFunctionListPrintAll(void);
 PETSC_INTERN PetscErrorCode PetscSequentialPhaseBegin_Private(MPI_Comm,int);
 PETSC_INTERN PetscErrorCode PetscSequentialPhaseEnd_Private(MPI_Comm,int);
 PETSC_INTERN PetscErrorCode PetscCloseHistoryFile(FILE**);
+PETSC_INTERN PetscErrorCode PetscMallocPoolFinalize_Private(void);
 
 /* user may set these BEFORE calling PetscInitialize() */
 MPI_Comm PETSC_COMM_WORLD = MPI_COMM_NULL;
@@ -693,6 +694,8 @@ PetscInt PetscNumOMPThreads;
 .  -malloc_test - like -malloc_dump -malloc_debug, but only active for debugging builds, ignored in optimized build. May want to set in PETSC_OPTIONS environmental variable
 .  -malloc_view - show a list of all allocated memory during PetscFinalize()
 .  -malloc_view_threshold <t> - only list memory allocations of size greater than t with -malloc_view
+.  -malloc_pool - use a pooled malloc with per-thread free lists for small sizes, see PetscMallocArenaCreate()
+.  -malloc_numa - bind the pages of PetscMalloc() to the local NUMA node, -memory_view then shows the memory on each node
 .  -fp_trap - Stops on floating point exceptions
 .  -no_signal_handler - Indicates not to trap error signals
 .  -shared_tmp - indicates /tmp directory is shared by all processors
@@ -710,6 +713,9 @@ PetscInt PetscNumOMPThreads;
         hangs without running in the debugger).  See PetscLogTraceBegin().
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see PetscLogView().
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each method, see PetscLogView().
+.  -log_view_counters - Includes in the summary from -log_view the memory bandwidth, arithmetic intensity and instructions per cycle of each event, measured with the Linux perf_event hardware counters
+.  -log_buffered - Logs events for -log_view in per-thread buffers aggregated lazily, see PetscLogBufferedBegin().
+.  -log_chrome_trace [filename] - Writes the nested events of all processes as a Chrome trace, see PetscLogChromeTraceDump().
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
@@ -1370,6 +1376,10 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscOptionsGetString(NULL,NULL,"-log_all",mname,sizeof(mname),&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsGetString(NULL,NULL,"-log",mname,sizeof(mname),&flg2);CHKERRQ(ierr);
   if (flg1 || flg2) {ierr = PetscLogDump(mname);CHKERRQ(ierr);}
+
+  mname[0] = 0;
+  ierr = PetscOptionsGetString(NULL,NULL,"-log_chrome_trace",mname,sizeof(mname),&flg1);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogChromeTraceDump(mname[0] ? mname : NULL);CHKERRQ(ierr);}
 #endif
 
   ierr = PetscStackDestroy();CHKERRQ(ierr);
@@ -1608,6 +1618,7 @@ PetscErrorCode  PetscFinalize(void)
    memory was not freed.
 
 */
+  ierr = PetscMallocPoolFinalize_Private();CHKERRQ(ierr);
   ierr = PetscMallocClear();CHKERRQ(ierr);
 
   PetscInitializeCalled = PETSC_FALSE;
@@ -0,0 +1,135 @@
+static char help[] = "Tests buffered event logging against the default one, and the hardware counters of each stage.\n\n";
+
+#include <petscsys.h>
+
+static PetscErrorCode Recurse(PetscLogEvent event,PetscInt depth)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogFlops(1.0);CHKERRQ(ierr);
+  if (depth) {ierr = Recurse(event,depth-1);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Logs nouter events[0], each containing ninner events[1] */
+static PetscErrorCode Work(const PetscLogEvent events[],PetscInt nouter,PetscInt ninner)
+{
+  PetscInt       i,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<nouter; i++) {
+    ierr = PetscLogEventBegin(events[0],0,0,0,0);CHKERRQ(ierr);
+    for (j=0; j<ninner; j++) {
+      ierr = PetscLogEventBegin(events[1],0,0,0,0);CHKERRQ(ierr);
+      ierr = PetscLogFlops(2.0);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(events[1],0,0,0,0);CHKERRQ(ierr);
+    }
+    ierr = PetscLogFlops(1.0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(events[0],0,0,0,0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscLogStage      stages[2];
+  PetscLogEvent      events[4];
+  const char         *names[] = {"Outer","Inner","Recursive","Threaded"},*stagenames[] = {"Work","More"};
+  PetscEventPerfInfo info,*stageinfo;
+  PetscStageLog      stageLog;
+  PetscInt           i,s,nerr = 0;
+  PetscBool          threaded = PETSC_FALSE;
+  PetscErrorCode     ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-threaded",&threaded,NULL);CHKERRQ(ierr);
+  if (!PetscLogPLB) {ierr = PetscLogDefaultBegin();CHKERRQ(ierr);}
+  for (s=0; s<2; s++) {ierr = PetscLogStageRegister(stagenames[s],&stages[s]);CHKERRQ(ierr);}
+  for (i=0; i<4; i++) {ierr = PetscLogEventRegister(names[i],PETSC_OBJECT_CLASSID,&events[i]);CHKERRQ(ierr);}
+
+  ierr = PetscLogStagePush(stages[0]);CHKERRQ(ierr);
+  ierr = Work(events,10,3);CHKERRQ(ierr);
+  /* recursive calls are counted once */
+  for (i=0; i<4; i++) {ierr = Recurse(events[2],3);CHKERRQ(ierr);}
+  /* events may overlap without being nested */
+  ierr = PetscLogEventBegin(events[1],0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(events[0],0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(events[1],0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(events[0],0,0,0,0);CHKERRQ(ierr);
+  /* only buffered logging may be used from several threads */
+  if (threaded) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for reduction(+:nerr)
+#endif
+    for (i=0; i<8; i++) {
+      if (PetscLogEventBegin(events[3],0,0,0,0)) nerr++;
+      if (PetscLogEventEnd(events[3],0,0,0,0)) nerr++;
+    }
+    if (nerr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%D errors logging events from threads",nerr);
+  }
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+  /* a second stage with different counts, pushed from within the first one */
+  ierr = PetscLogStagePush(stages[0]);CHKERRQ(ierr);
+  ierr = PetscLogStagePush(stages[1]);CHKERRQ(ierr);
+  ierr = Work(events,2,5);CHKERRQ(ierr);
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  for (s=0; s<2; s++) {
+    stageinfo = &stageLog->stageInfo[stages[s]].perfInfo;
+    for (i=0; i<4; i++) {
+      ierr = PetscLogEventGetPerfInfo(stages[s],events[i],&info);CHKERRQ(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: count %d flops %g\n",stagenames[s],names[i],info.count,info.flops);CHKERRQ(ierr);
+      if (info.count && info.time <= 0.0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: nonpositive time %g\n",stagenames[s],names[i],info.time);CHKERRQ(ierr);}
+      /* the counters of an event are included in those of its stage */
+      if (info.instructions > stageinfo->instructions || info.cycles > stageinfo->cycles) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: more counts than the stage\n",stagenames[s],names[i]);CHKERRQ(ierr);}
+    }
+    if (PetscLogCounters && (stageinfo->instructions <= 0.0 || stageinfo->cycles <= 0.0)) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: instructions %g cycles %g\n",stagenames[s],stageinfo->instructions,stageinfo->cycles);CHKERRQ(ierr);
+    }
+    if (!PetscLogCounters && (stageinfo->instructions != 0.0 || stageinfo->cycles != 0.0)) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: counters recorded without -log_view_counters\n",stagenames[s]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: default
+      requires: define(PETSC_USE_LOG)
+      output_file: output/ex55_1.out
+
+   test:
+      suffix: counters
+      requires: define(PETSC_USE_LOG)
+      output_file: output/ex55_1.out
+      args: -log_view_counters
+
+   test:
+      suffix: buffered
+      requires: define(PETSC_USE_LOG)
+      output_file: output/ex55_1.out
+      args: -log_buffered -log_buffered_size {{5 4096}}
+
+   test:
+      suffix: threaded
+      requires: define(PETSC_USE_LOG)
+      output_file: output/ex55_2.out
+      args: -log_buffered -log_buffered_size 5 -threaded
+
+   test:
+      suffix: trace
+      requires: define(PETSC_USE_LOG)
+      nsize: 2
+      output_file: output/ex55_1.out
+      args: -log_chrome_trace ex55_trace.json -log_view :ex55_view.txt
+
+TEST*/
@@ -0,0 +1,119 @@
+static char help[] = "Tests the pooled and NUMA mallocs and malloc arenas.\n\n";
+
+#include <petscvec.h>
+
+/* fills an array with its indices and checks what was written earlier */
+static PetscErrorCode Fill(PetscInt n,PetscInt *a,PetscBool check)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    if (check && a[i] != i) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Entry %D of an array of length %D is %D",i,n,a[i]);
+    a[i] = i;
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscMallocArena arena;
+  PetscInt         *a[64],*b,i,j,n,nerr = 0;
+  PetscLogDouble   usage;
+  PetscBool        pool,threaded = PETSC_FALSE;
+  Vec              x;
+  PetscReal        norm;
+  PetscErrorCode   ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsHasName(NULL,NULL,"-malloc_pool",&pool);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-threaded",&threaded,NULL);CHKERRQ(ierr);
+
+  /* sizes across all the size classes and beyond, freed in an order different from the allocation */
+  for (i=0; i<64; i++) {
+    n    = 1 + i*i*i/64;
+    ierr = PetscCalloc1(n,&a[i]);CHKERRQ(ierr);
+    for (j=0; j<n; j++) if (a[i][j]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PetscCalloc1() of length %D is not zeroed",n);
+    ierr = Fill(n,a[i],PETSC_FALSE);CHKERRQ(ierr);
+  }
+  for (i=0; i<64; i+=2) {ierr = PetscFree(a[i]);CHKERRQ(ierr);}
+  for (i=1; i<64; i+=2) {
+    n    = 1 + i*i*i/64;
+    ierr = Fill(n,a[i],PETSC_TRUE);CHKERRQ(ierr);
+    ierr = PetscFree(a[i]);CHKERRQ(ierr);
+  }
+
+  /* growing with PetscRealloc() keeps the contents */
+  ierr = PetscMalloc1(1,&b);CHKERRQ(ierr);
+  ierr = Fill(1,b,PETSC_FALSE);CHKERRQ(ierr);
+  for (n=1; n<10000; n*=3) {
+    ierr = PetscRealloc(3*n*sizeof(PetscInt),&b);CHKERRQ(ierr);
+    ierr = Fill(n,b,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = Fill(3*n,b,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(b);CHKERRQ(ierr);
+
+  /* objects created and destroyed in an arena, which is released in a single call */
+  ierr = VecInitializePackage();CHKERRQ(ierr);
+  ierr = PetscMallocArenaCreate(&arena);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(arena);CHKERRQ(ierr);
+  for (i=0; i<10; i++) {
+    ierr = VecCreateSeq(PETSC_COMM_SELF,10+1000*i,&x);CHKERRQ(ierr);
+    ierr = VecSet(x,1.0);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_1,&norm);CHKERRQ(ierr);
+    if (norm != (PetscReal)(10+1000*i)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Wrong norm %g",(double)norm);
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(100,&b);CHKERRQ(ierr);
+  ierr = Fill(100,b,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscRealloc(1000*sizeof(PetscInt),&b);CHKERRQ(ierr);
+  ierr = Fill(100,b,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscFree(b);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  ierr = PetscMallocArenaGetUsage(arena,&usage);CHKERRQ(ierr);
+  if (pool != (PetscBool)(usage > 0)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Arena used %g bytes",usage);
+  ierr = PetscMallocArenaDestroy(&arena);CHKERRQ(ierr);
+
+  /* each thread allocates from its own free lists */
+  if (threaded) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for private(j,b) reduction(+:nerr)
+#endif
+    for (i=0; i<64; i++) {
+      for (j=1; j<1000; j+=7) {
+        if ((*PetscTrMalloc)(j*sizeof(PetscInt),PETSC_FALSE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(void**)&b)) {nerr++; continue;}
+        b[j-1] = i;
+        if (b[j-1] != i) nerr++;
+        if ((*PetscTrFree)(b,__LINE__,PETSC_FUNCTION_NAME,__FILE__)) nerr++;
+      }
+    }
+    if (nerr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%D errors allocating from threads",nerr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Pooled malloc test completed\n");CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: default
+      output_file: output/ex56_1.out
+
+   test:
+      suffix: pool
+      output_file: output/ex56_1.out
+      args: -malloc_pool
+
+   test:
+      suffix: threaded
+      output_file: output/ex56_1.out
+      args: -malloc_pool -threaded
+
+   test:
+      suffix: numa
+      output_file: output/ex56_numa.out
+      args: -malloc_numa -memory_view -threaded
+      filter: egrep "(completed|NUMA node  0|Space bound)" | cut -d: -f1
+
+TEST*/
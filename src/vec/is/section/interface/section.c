@@ -1107,6 +1107,7 @@ PetscErrorCode PetscSectionSetUp(PetscSection s)
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if (s->setup) PetscFunctionReturn(0);
   s->setup = PETSC_TRUE;
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   /* Set offsets and field offsets for all points */
   /*   Assume that all fields have the same chart */
   if (s->perm) {ierr = ISGetIndices(s->perm, &pind);CHKERRQ(ierr);}
@@ -1555,10 +1556,13 @@ PetscErrorCode PetscSectionGetOffset(PetscSection s, PetscInt point, PetscInt *o
 @*/
 PetscErrorCode PetscSectionSetOffset(PetscSection s, PetscInt point, PetscInt offset)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %D should be in [%D, %D)", point, s->pStart, s->pEnd);
   s->atlasOff[point - s->pStart] = offset;
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1616,6 +1620,7 @@ PetscErrorCode PetscSectionSetFieldOffset(PetscSection s, PetscInt point, PetscI
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((field < 0) || (field >= s->numFields)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section field %D should be in [%D, %D)", field, 0, s->numFields);
   ierr = PetscSectionSetOffset(s->field[field], point, offset);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2153,6 +2158,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   s->setup     = PETSC_FALSE;
   s->numFields = 0;
   s->clObj     = NULL;
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2349,6 +2355,7 @@ PetscErrorCode PetscSectionSetConstraintIndices(PetscSection s, PetscInt point,
   if (s->bc) {
     ierr = VecIntSetValuesSection(s->bcIndices, s->bc, point, indices, INSERT_VALUES);CHKERRQ(ierr);
   }
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2411,6 +2418,7 @@ PetscErrorCode PetscSectionSetFieldConstraintIndices(PetscSection s, PetscInt po
   PetscValidHeaderSpecific(s, PETSC_SECTION_CLASSID, 1);
   if ((field < 0) || (field >= s->numFields)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section field %D should be in [%D, %D)", field, 0, s->numFields);
   ierr = PetscSectionSetConstraintIndices(s->field[field], point, indices);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) s);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2850,6 +2858,7 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
   } else SETERRQ(PetscObjectComm(obj), PETSC_ERR_SUP, "Do not support borrowed arrays");
   ierr = PetscMalloc1(clSize, &section->clInvPerm);CHKERRQ(ierr);
   for (i = 0; i < clSize; ++i) section->clInvPerm[section->clPerm[i]] = i;
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -3210,6 +3219,7 @@ PetscErrorCode PetscSectionSetSym(PetscSection section, PetscSectionSym sym)
     ierr = PetscObjectReference((PetscObject) sym);CHKERRQ(ierr);
   }
   section->sym = sym;
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -3258,6 +3268,7 @@ PetscErrorCode PetscSectionSetFieldSym(PetscSection section, PetscInt field, Pet
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   if (field < 0 || field >= section->numFields) SETERRQ2(PetscObjectComm((PetscObject)section),PETSC_ERR_ARG_OUTOFRANGE,"Invalid field number %D (not in [0,%D)", field, section->numFields);
   ierr = PetscSectionSetSym(section->field[field],sym);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) section);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
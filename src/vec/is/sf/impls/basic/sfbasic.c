@@ -129,6 +129,62 @@ PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Basic options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_basic_pipeline","Pack and unpack the message of each neighbor separately, interleaved with the communication","PetscSFSetFromOptions",bas->pipeline,&bas->pipeline,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Can the remote data of the link be packed and unpacked per neighbor rank? We only do it with -sf_basic_pipeline on host data */
+PETSC_STATIC_INLINE PetscBool PetscSFLinkCanPipeline_Basic(PetscSF sf,PetscSFLink link)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+
+  return (bas->pipeline && link->rootmtype == PETSC_MEMTYPE_HOST && link->leafmtype == PETSC_MEMTYPE_HOST) ? PETSC_TRUE : PETSC_FALSE;
+}
+
+/* Pack the remote root data per neighbor and start its send right away, so that the first messages are on the wire
+   while the later ones are still being packed */
+static PetscErrorCode PetscSFLinkPackRootDataAndStartSends_Basic(PetscSF sf,PetscSFLink link,const void *rootdata,MPI_Request *rootreqs)
+{
+  PetscErrorCode ierr;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscInt       r;
+
+  PetscFunctionBegin;
+  for (r=0; r<bas->nrootreqs; r++) {
+    ierr = PetscSFLinkPackRootDataNeighbor(sf,link,r,rootdata);CHKERRQ(ierr);
+    ierr = MPI_Start_isend(bas->ioffset[bas->ndiranks+r+1]-bas->ioffset[bas->ndiranks+r],link->unit,rootreqs+r);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Unpack the message of each remote root rank as soon as it arrives instead of waiting for all of them.
+   The result is the same as with PetscSFLinkUnpackLeafData() since a leaf has at most one root. */
+static PetscErrorCode PetscSFLinkWaitAndUnpackLeafData_Basic(PetscSF sf,PetscSFLink link,void *leafdata,MPI_Op op)
+{
+  PetscErrorCode ierr;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  MPI_Request    *rootreqs = NULL,*leafreqs = NULL;
+  PetscInt       k;
+  PetscMPIInt    r;
+
+  PetscFunctionBegin;
+  ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_ROOT2LEAF,NULL,NULL,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  for (k=0; k<sf->nleafreqs; k++) {
+    ierr = MPI_Waitany(sf->nleafreqs,leafreqs,&r,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    ierr = PetscSFLinkUnpackLeafDataNeighbor(sf,link,r,leafdata,op);CHKERRQ(ierr);
+  }
+  ierr = MPI_Waitall(bas->nrootreqs,rootreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscSFBcastAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,PetscMemType rootmtype,const void *rootdata,PetscMemType leafmtype,void *leafdata,MPI_Op op)
 {
   PetscErrorCode    ierr;
@@ -139,13 +195,17 @@ static PetscErrorCode PetscSFBcastAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,
   PetscFunctionBegin;
   /* Create a communication link, which provides buffers & MPI requests etc */
   ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,PETSCSF_BCAST,&link);CHKERRQ(ierr);
+  link->pipeline = PetscSFLinkCanPipeline_Basic(sf,link);
   /* Get MPI requests from the link. We do not need buffers explicitly since we use persistent MPI */
   ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_ROOT2LEAF,NULL,NULL,&rootreqs,&leafreqs);CHKERRQ(ierr);
   /* Post Irecv for remote */
   ierr = MPI_Startall_irecv(sf->leafbuflen[PETSCSF_REMOTE],unit,sf->nleafreqs,leafreqs);CHKERRQ(ierr);
   /* Pack rootdata and do Isend for remote */
-  ierr = PetscSFLinkPackRootData(sf,link,PETSCSF_REMOTE,rootdata);CHKERRQ(ierr);
-  ierr = MPI_Startall_isend(bas->rootbuflen[PETSCSF_REMOTE],unit,bas->nrootreqs,rootreqs);CHKERRQ(ierr);
+  if (link->pipeline) {ierr = PetscSFLinkPackRootDataAndStartSends_Basic(sf,link,rootdata,rootreqs);CHKERRQ(ierr);}
+  else {
+    ierr = PetscSFLinkPackRootData(sf,link,PETSCSF_REMOTE,rootdata);CHKERRQ(ierr);
+    ierr = MPI_Startall_isend(bas->rootbuflen[PETSCSF_REMOTE],unit,bas->nrootreqs,rootreqs);CHKERRQ(ierr);
+  }
   /* Do local BcastAndOp, which overlaps with the irecv/isend above */
   ierr = PetscSFLinkBcastAndOpLocal(sf,link,rootdata,leafdata,op);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -159,10 +219,13 @@ PETSC_INTERN PetscErrorCode PetscSFBcastAndOpEnd_Basic(PetscSF sf,MPI_Datatype u
   PetscFunctionBegin;
   /* Retrieve the link used in XxxBegin() with root/leafdata as key */
   ierr = PetscSFLinkGetInUse(sf,unit,rootdata,leafdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
-  /* Wait for the completion of mpi */
-  ierr = PetscSFLinkMPIWaitall(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
-  /* Unpack leafdata and reclaim the link */
-  ierr = PetscSFLinkUnpackLeafData(sf,link,PETSCSF_REMOTE,leafdata,op);CHKERRQ(ierr);
+  if (link->pipeline) {ierr = PetscSFLinkWaitAndUnpackLeafData_Basic(sf,link,leafdata,op);CHKERRQ(ierr);}
+  else {
+    /* Wait for the completion of mpi */
+    ierr = PetscSFLinkMPIWaitall(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
+    /* Unpack leafdata */
+    ierr = PetscSFLinkUnpackLeafData(sf,link,PETSCSF_REMOTE,leafdata,op);CHKERRQ(ierr);
+  }
   ierr = PetscSFLinkReclaim(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -177,10 +240,19 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFLeafToRootBegin_Basic(PetscSF sf,MPI_D
 
   PetscFunctionBegin;
   ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,sfop,&link);CHKERRQ(ierr);
+  link->pipeline = PetscSFLinkCanPipeline_Basic(sf,link);
   ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_LEAF2ROOT,NULL,NULL,&rootreqs,&leafreqs);CHKERRQ(ierr);
   ierr = MPI_Startall_irecv(bas->rootbuflen[PETSCSF_REMOTE],unit,bas->nrootreqs,rootreqs);CHKERRQ(ierr);
-  ierr = PetscSFLinkPackLeafData(sf,link,PETSCSF_REMOTE,leafdata);CHKERRQ(ierr);
-  ierr = MPI_Startall_isend(sf->leafbuflen[PETSCSF_REMOTE],unit,sf->nleafreqs,leafreqs);CHKERRQ(ierr);
+  if (link->pipeline) {
+    PetscInt r;
+    for (r=0; r<sf->nleafreqs; r++) {
+      ierr = PetscSFLinkPackLeafDataNeighbor(sf,link,r,leafdata);CHKERRQ(ierr);
+      ierr = MPI_Start_isend(sf->roffset[sf->ndranks+r+1]-sf->roffset[sf->ndranks+r],unit,leafreqs+r);CHKERRQ(ierr);
+    }
+  } else {
+    ierr = PetscSFLinkPackLeafData(sf,link,PETSCSF_REMOTE,leafdata);CHKERRQ(ierr);
+    ierr = MPI_Startall_isend(sf->leafbuflen[PETSCSF_REMOTE],unit,sf->nleafreqs,leafreqs);CHKERRQ(ierr);
+  }
   *out = link;
   PetscFunctionReturn(0);
 }
@@ -241,8 +313,11 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,vo
   ierr = MPI_Startall_irecv(sf->leafbuflen[PETSCSF_REMOTE],unit,sf->nleafreqs,leafreqs);CHKERRQ(ierr);
   ierr = MPI_Startall_isend(bas->rootbuflen[PETSCSF_REMOTE],unit,bas->nrootreqs,rootreqs);CHKERRQ(ierr);
   /* Unpack and insert fetched data into leaves */
-  ierr = PetscSFLinkMPIWaitall(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
-  ierr = PetscSFLinkUnpackLeafData(sf,link,PETSCSF_REMOTE,leafupdate,MPIU_REPLACE);CHKERRQ(ierr);
+  if (link->pipeline) {ierr = PetscSFLinkWaitAndUnpackLeafData_Basic(sf,link,leafupdate,MPIU_REPLACE);CHKERRQ(ierr);}
+  else {
+    ierr = PetscSFLinkMPIWaitall(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
+    ierr = PetscSFLinkUnpackLeafData(sf,link,PETSCSF_REMOTE,leafupdate,MPIU_REPLACE);CHKERRQ(ierr);
+  }
   ierr = PetscSFLinkReclaim(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -385,6 +460,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->Reset                = PetscSFReset_Basic;
   sf->ops->Destroy              = PetscSFDestroy_Basic;
   sf->ops->View                 = PetscSFView_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
   sf->ops->BcastAndOpBegin      = PetscSFBcastAndOpBegin_Basic;
   sf->ops->BcastAndOpEnd        = PetscSFBcastAndOpEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
@@ -20,6 +20,7 @@ typedef struct _n_PetscSFLink* PetscSFLink;
   PetscSFPackOpt   rootpackopt_d[2];/* Copy of rootpackopt[] on device if needed */                                                \
   PetscBool        rootdups[2];     /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */            \
   PetscInt         nrootreqs;       /* Number of MPI reqests */                                                                    \
+  PetscBool        pipeline;        /* Start each send as soon as it is packed and unpack each receive as soon as it arrives */    \
   PetscSFLink      avail;           /* One or more entries per MPI Datatype, lazily constructed */                                 \
   PetscSFLink      inuse            /* Buffers being used for transactions that have not yet completed */
 
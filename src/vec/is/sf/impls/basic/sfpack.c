@@ -1435,6 +1435,76 @@ PetscErrorCode PetscSFLinkFetchRootData(PetscSF sf,PetscSFLink link,PetscSFScope
   PetscFunctionReturn(0);
 }
 
+/* Pack the rootdata sent to the r-th remote leaf rank (i.e., the one of rootreqs[r]) to its segment of the remote rootbuf.
+   Only used when root data and buffers are on host, so that the send can be started right after the pack.
+ */
+PetscErrorCode PetscSFLinkPackRootDataNeighbor(PetscSF sf,PetscSFLink link,PetscInt r,const void *rootdata)
+{
+  PetscErrorCode   ierr;
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
+  const PetscInt   *rootindices = NULL,*rootoffset = bas->ioffset;
+  PetscInt         count,start,disp,i = bas->ndiranks + r;
+  PetscSFPackOpt   opt = NULL;
+
+  PetscFunctionBegin;
+  if (link->rootdirect[PETSCSF_REMOTE]) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSFLinkGetRootPackOptAndIndices(sf,link,PETSC_MEMTYPE_HOST,PETSCSF_REMOTE,&count,&start,&opt,&rootindices);CHKERRQ(ierr);
+  disp  = rootoffset[i] - rootoffset[bas->ndiranks];
+  count = rootoffset[i+1] - rootoffset[i];
+  ierr  = (*link->h_Pack)(link,count,rootindices ? start : start+disp,NULL,rootindices ? rootindices+disp : NULL,rootdata,link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]+disp*link->unitbytes);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Pack the leafdata sent to the r-th remote root rank (i.e., the one of leafreqs[r]) to its segment of the remote leafbuf */
+PetscErrorCode PetscSFLinkPackLeafDataNeighbor(PetscSF sf,PetscSFLink link,PetscInt r,const void *leafdata)
+{
+  PetscErrorCode   ierr;
+  const PetscInt   *leafindices = NULL,*leafoffset = sf->roffset;
+  PetscInt         count,start,disp,i = sf->ndranks + r;
+  PetscSFPackOpt   opt = NULL;
+
+  PetscFunctionBegin;
+  if (link->leafdirect[PETSCSF_REMOTE]) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSFLinkGetLeafPackOptAndIndices(sf,link,PETSC_MEMTYPE_HOST,PETSCSF_REMOTE,&count,&start,&opt,&leafindices);CHKERRQ(ierr);
+  disp  = leafoffset[i] - leafoffset[sf->ndranks];
+  count = leafoffset[i+1] - leafoffset[i];
+  ierr  = (*link->h_Pack)(link,count,leafindices ? start : start+disp,NULL,leafindices ? leafindices+disp : NULL,leafdata,link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]+disp*link->unitbytes);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Unpack the segment of the remote leafbuf received from the r-th remote root rank (i.e., the one of leafreqs[r]) to leafdata.
+   Since a leaf is connected to at most one root, the result does not depend on the order in which the segments are unpacked.
+ */
+PetscErrorCode PetscSFLinkUnpackLeafDataNeighbor(PetscSF sf,PetscSFLink link,PetscInt r,void *leafdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  const PetscInt   *leafindices = NULL,*leafoffset = sf->roffset;
+  PetscInt         count,start,disp,i = sf->ndranks + r;
+  PetscErrorCode   (*UnpackAndOp)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,void*,const void*) = NULL;
+  PetscSFPackOpt   opt = NULL;
+  char             *buf;
+
+  PetscFunctionBegin;
+  if (link->leafdirect[PETSCSF_REMOTE]) PetscFunctionReturn(0);
+  ierr  = PetscLogEventBegin(PETSCSF_Unpack,sf,0,0,0);CHKERRQ(ierr);
+  ierr  = PetscSFLinkGetLeafPackOptAndIndices(sf,link,PETSC_MEMTYPE_HOST,PETSCSF_REMOTE,&count,&start,&opt,&leafindices);CHKERRQ(ierr);
+  disp  = leafoffset[i] - leafoffset[sf->ndranks];
+  count = leafoffset[i+1] - leafoffset[i];
+  start = leafindices ? start : start+disp;
+  if (leafindices) leafindices += disp;
+  buf   = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]+disp*link->unitbytes;
+  ierr  = PetscSFLinkGetUnpackAndOp(link,PETSC_MEMTYPE_HOST,op,sf->leafdups[PETSCSF_REMOTE],&UnpackAndOp);CHKERRQ(ierr);
+  if (UnpackAndOp) {ierr = (*UnpackAndOp)(link,count,start,NULL,leafindices,leafdata,buf);CHKERRQ(ierr);}
+  else {ierr = PetscSFLinkUnpackDataWithMPIReduceLocal(sf,link,count,start,leafindices,leafdata,buf,op);CHKERRQ(ierr);}
+  if (op != MPIU_REPLACE && link->basicunit == MPIU_SCALAR) {ierr = PetscLogFlops(count*link->bs);CHKERRQ(ierr);}
+  ierr  = PetscLogEventEnd(PETSCSF_Unpack,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* Bcast rootdata to leafdata locally (i.e., only for local communication - PETSCSF_LOCAL) */
 PetscErrorCode PetscSFLinkBcastAndOpLocal(PetscSF sf,PetscSFLink link,const void *rootdata,void *leafdata,MPI_Op op)
 {
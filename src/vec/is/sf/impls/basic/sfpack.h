@@ -160,6 +160,7 @@ struct _n_PetscSFLink {
   PetscBool    rootreqsinited[2][2][2];      /* Are root requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][rootdirect_mpi]*/
   PetscBool    leafreqsinited[2][2][2];      /* Are leaf requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi]*/
   MPI_Request  *reqs;                        /* An array of length (nrootreqs+nleafreqs)*8. Pointers in rootreqs[][][] and leafreqs[][][] point here */
+  PetscBool    pipeline;                     /* Pack/unpack the remote data per neighbor rank, interleaved with the MPI requests? Only for data on host */
   PetscSFLink  next;
 };
 
@@ -200,6 +201,11 @@ PETSC_INTERN PetscErrorCode PetscSFLinkUnpackRootData(PetscSF,PetscSFLink,PetscS
 PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafData(PetscSF,PetscSFLink,PetscSFScope,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchRootData (PetscSF,PetscSFLink,PetscSFScope,void*,MPI_Op);
 
+/* Pack/Unpack the remote data of a single neighbor rank, given by its index in the MPI requests of the link */
+PETSC_INTERN PetscErrorCode PetscSFLinkPackRootDataNeighbor  (PetscSF,PetscSFLink,PetscInt,const void*);
+PETSC_INTERN PetscErrorCode PetscSFLinkPackLeafDataNeighbor  (PetscSF,PetscSFLink,PetscInt,const void*);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafDataNeighbor(PetscSF,PetscSFLink,PetscInt,void*,MPI_Op);
+
 PETSC_INTERN PetscErrorCode PetscSFLinkBcastAndOpLocal(PetscSF,PetscSFLink,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkReduceLocal(PetscSF,PetscSFLink,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF,PetscSFLink,void*,const void*,void*,MPI_Op);
@@ -267,6 +267,8 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
    Options Database Keys:
 +  -sf_type               - implementation type, see PetscSFSetType()
 .  -sf_rank_order         - sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise
+.  -sf_basic_pipeline     - with -sf_type basic, pack each outgoing message and start its send separately, and unpack each incoming
+                            message as soon as it arrives, instead of packing and unpacking all messages at once (default: false)
 .  -sf_use_default_stream - Assume callers of SF computed the input root/leafdata with the default cuda stream. SF will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between SF and its caller (default: true).
                             If true, this option only works with -use_cuda_aware_mpi 1.
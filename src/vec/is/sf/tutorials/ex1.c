@@ -599,4 +599,16 @@ int main(int argc,char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_basic_pipeline
+      nsize: 4
+      output_file: output/ex1_10_basic.out
+      args: -sf_type basic -sf_basic_pipeline -test_all -test_bcastop 0 -test_fetchandop 0
+
+   test:
+      suffix: bcastop_basic_pipeline
+      nsize: 4
+      output_file: output/ex1_bcastop_basic.out
+      args: -test_bcastop -sf_type basic -sf_basic_pipeline
+
 TEST*/
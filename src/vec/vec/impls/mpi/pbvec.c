@@ -510,7 +510,12 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
   s->array_allocated = 0;
   if (alloc && !array) {
     PetscInt n = v->map->n+nghost;
+#if defined(PETSC_HAVE_OPENMP)
+    ierr               = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+    VecZeroFirstTouch_Private(n,s->array);
+#else
     ierr               = PetscCalloc1(n,&s->array);CHKERRQ(ierr);
+#endif
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
     s->array_allocated = s->array;
   }
@@ -39,7 +39,11 @@ PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec V)
   s                  = (Vec_Seq*)V->data;
   s->array_allocated = array;
 
+#if defined(PETSC_HAVE_OPENMP)
+  VecZeroFirstTouch_Private(n,array);
+#else
   ierr = VecSet(V,0.0);CHKERRQ(ierr);
+#endif
 #else
   switch (((PetscObject)V)->precision) {
   case PETSC_PRECISION_SINGLE: {
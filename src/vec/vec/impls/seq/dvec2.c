@@ -91,200 +91,75 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
 }
 
 #else
+/*
+   The entries of x are processed in tiles of VEC_SEQ_MDOT_TILE (a multiple of 4) so that a tile of x stays in cache
+   while it is multiplied with all the yin[], instead of streaming x from memory once for every group of 4 vectors.
+   The sums are accumulated in the same order as without tiles. The yin[] are processed in chunks of VEC_SEQ_MDOT_NV
+   vectors so that the pointers to their arrays fit in a buffer on the stack.
+*/
+#define VEC_SEQ_MDOT_TILE 512
+#define VEC_SEQ_MDOT_NV   32
 PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
 {
   PetscErrorCode    ierr;
-  PetscInt          n = xin->map->n,i,j,nv_rem,j_rem;
+  PetscInt          n = xin->map->n,i,j,j_rem = n&0x3,t,tend,c,nc;
   PetscScalar       sum0,sum1,sum2,sum3,x0,x1,x2,x3;
-  const PetscScalar *yy0,*yy1,*yy2,*yy3,*x,*xbase;
-  Vec               *yy;
+  const PetscScalar *yy0,*yy1,*yy2,*yy3,*x,*yy[VEC_SEQ_MDOT_NV];
 
   PetscFunctionBegin;
-  sum0 = 0.;
-  sum1 = 0.;
-  sum2 = 0.;
-
-  i      = nv;
-  nv_rem = nv&0x3;
-  yy     = (Vec*)yin;
-  j      = n;
-  ierr   = VecGetArrayRead(xin,&xbase);CHKERRQ(ierr);
-  x      = xbase;
-
-  switch (nv_rem) {
-  case 3:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-      sum2 += x2*PetscConj(yy2[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-      sum2 += x1*PetscConj(yy2[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-      sum2 += x0*PetscConj(yy2[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      j   -= j_rem;
-      break;
+  if (nv <= 0) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  for (c=0; c<nv; c+=nc, z+=nc) {
+    nc = PetscMin(nv-c,VEC_SEQ_MDOT_NV);
+    for (i=0; i<nc; i++) {ierr = VecGetArrayRead(yin[c+i],&yy[i]);CHKERRQ(ierr);}
+
+    for (i=0; i<nc; i++) {
+      yy0  = yy[i];
+      sum0 = 0.;
+      switch (j_rem) {
+      case 3:
+        sum0 += x[2]*PetscConj(yy0[2]);
+      case 2:
+        sum0 += x[1]*PetscConj(yy0[1]);
+      case 1:
+        sum0 += x[0]*PetscConj(yy0[0]);
+      case 0:
+        break;
+      }
+      z[i] = sum0;
     }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
 
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      sum2 += x0*PetscConj(yy2[0]) + x1*PetscConj(yy2[1]) + x2*PetscConj(yy2[2]) + x3*PetscConj(yy2[3]); yy2+=4;
-      j    -= 4;
+    for (t=j_rem; t<n; t=tend) {
+      tend = PetscMin(t+VEC_SEQ_MDOT_TILE,n);
+      for (i=0; i+3<nc; i+=4) {
+        yy0  = yy[i];   yy1  = yy[i+1]; yy2  = yy[i+2]; yy3  = yy[i+3];
+        sum0 = z[i];    sum1 = z[i+1];  sum2 = z[i+2];  sum3 = z[i+3];
+        for (j=t; j<tend; j+=4) {
+          x0 = x[j];
+          x1 = x[j+1];
+          x2 = x[j+2];
+          x3 = x[j+3];
+
+          sum0 += x0*PetscConj(yy0[j]) + x1*PetscConj(yy0[j+1]) + x2*PetscConj(yy0[j+2]) + x3*PetscConj(yy0[j+3]);
+          sum1 += x0*PetscConj(yy1[j]) + x1*PetscConj(yy1[j+1]) + x2*PetscConj(yy1[j+2]) + x3*PetscConj(yy1[j+3]);
+          sum2 += x0*PetscConj(yy2[j]) + x1*PetscConj(yy2[j+1]) + x2*PetscConj(yy2[j+2]) + x3*PetscConj(yy2[j+3]);
+          sum3 += x0*PetscConj(yy3[j]) + x1*PetscConj(yy3[j+1]) + x2*PetscConj(yy3[j+2]) + x3*PetscConj(yy3[j+3]);
+        }
+        z[i] = sum0; z[i+1] = sum1; z[i+2] = sum2; z[i+3] = sum3;
+      }
+      for (; i<nc; i++) {
+        yy0  = yy[i];
+        sum0 = z[i];
+        for (j=t; j<tend; j+=4) {
+          sum0 += x[j]*PetscConj(yy0[j]) + x[j+1]*PetscConj(yy0[j+1]) + x[j+2]*PetscConj(yy0[j+2]) + x[j+3]*PetscConj(yy0[j+3]);
+        }
+        z[i] = sum0;
+      }
     }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    break;
-  case 2:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      j    -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
 
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    break;
-  case 1:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2 = x[2]; sum0 += x2*PetscConj(yy0[2]);
-    case 2:
-      x1 = x[1]; sum0 += x1*PetscConj(yy0[1]);
-    case 1:
-      x0 = x[0]; sum0 += x0*PetscConj(yy0[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      sum0 += x[0]*PetscConj(yy0[0]) + x[1]*PetscConj(yy0[1])
-            + x[2]*PetscConj(yy0[2]) + x[3]*PetscConj(yy0[3]);
-      yy0  +=4;
-      j    -= 4; x+=4;
-    }
-    z[0] = sum0;
-
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    break;
-  case 0:
-    break;
-  }
-  z  += nv_rem;
-  i  -= nv_rem;
-  yy += nv_rem;
-
-  while (i >0) {
-    sum0 = 0.;
-    sum1 = 0.;
-    sum2 = 0.;
-    sum3 = 0.;
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[3],&yy3);CHKERRQ(ierr);
-
-    j = n;
-    x = xbase;
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-      sum2 += x2*PetscConj(yy2[2]); sum3 += x2*PetscConj(yy3[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-      sum2 += x1*PetscConj(yy2[1]); sum3 += x1*PetscConj(yy3[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-      sum2 += x0*PetscConj(yy2[0]); sum3 += x0*PetscConj(yy3[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      yy3 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      sum2 += x0*PetscConj(yy2[0]) + x1*PetscConj(yy2[1]) + x2*PetscConj(yy2[2]) + x3*PetscConj(yy2[3]); yy2+=4;
-      sum3 += x0*PetscConj(yy3[0]) + x1*PetscConj(yy3[1]) + x2*PetscConj(yy3[2]) + x3*PetscConj(yy3[3]); yy3+=4;
-      j    -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    z[3] = sum3;
-    z   += 4;
-    i   -= 4;
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[3],&yy3);CHKERRQ(ierr);
-    yy  += 4;
+    for (i=0; i<nc; i++) {ierr = VecRestoreArrayRead(yin[c+i],&yy[i]);CHKERRQ(ierr);}
   }
-  ierr = VecRestoreArrayRead(xin,&xbase);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
   ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -553,71 +428,67 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
   PetscFunctionReturn(0);
 }
 
+/*
+   The entries of xin are updated in tiles of VEC_SEQ_MAXPY_TILE so that a tile of xin stays in cache while all the
+   y[] are added to it, instead of streaming xin from memory once for every group of 4 vectors. The y[] are processed
+   in chunks of VEC_SEQ_MAXPY_NV vectors so that the pointers to their arrays fit in a buffer on the stack.
+*/
+#define VEC_SEQ_MAXPY_TILE 512
+#define VEC_SEQ_MAXPY_NV   32
 PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y)
 {
   PetscErrorCode    ierr;
-  PetscInt          n = xin->map->n,j,j_rem;
-  const PetscScalar *yy0,*yy1,*yy2,*yy3;
-  PetscScalar       *xx,alpha0,alpha1,alpha2,alpha3;
+  PetscInt          n = xin->map->n,i,j_rem,t,tn,c,nc;
+  const PetscScalar *yy0,*yy1,*yy2,*yy3,*yy[VEC_SEQ_MAXPY_NV];
+  PetscScalar       *xx,*xt,alpha0,alpha1,alpha2,alpha3;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*xx,*yy0,*yy1,*yy2,*yy3,*alpha)
 #endif
 
   PetscFunctionBegin;
+  if (nv <= 0) PetscFunctionReturn(0);
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
-  switch (j_rem=nv&0x3) {
-  case 3:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha2 = alpha[2];
-    alpha += 3;
-    PetscKernelAXPY3(xx,alpha0,alpha1,alpha2,yy0,yy1,yy2,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    y   += 3;
-    break;
-  case 2:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha +=2;
-    PetscKernelAXPY2(xx,alpha0,alpha1,yy0,yy1,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    y   +=2;
-    break;
-  case 1:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    alpha0 = *alpha++;
-    PetscKernelAXPY(xx,alpha0,yy0,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    y   +=1;
-    break;
-  }
-  for (j=j_rem; j<nv; j+=4) {
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[3],&yy3);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha2 = alpha[2];
-    alpha3 = alpha[3];
-    alpha += 4;
-
-    PetscKernelAXPY4(xx,alpha0,alpha1,alpha2,alpha3,yy0,yy1,yy2,yy3,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[3],&yy3);CHKERRQ(ierr);
-    y   += 4;
+  for (c=0; c<nv; c+=nc, alpha+=nc) {
+    nc    = PetscMin(nv-c,VEC_SEQ_MAXPY_NV);
+    j_rem = nc&0x3;
+    for (i=0; i<nc; i++) {ierr = VecGetArrayRead(y[c+i],&yy[i]);CHKERRQ(ierr);}
+    for (t=0; t<n; t+=VEC_SEQ_MAXPY_TILE) {
+      switch (j_rem) {
+      case 3:
+        xt     = xx+t; tn = PetscMin(VEC_SEQ_MAXPY_TILE,n-t);
+        yy0    = yy[0]+t; yy1 = yy[1]+t; yy2 = yy[2]+t;
+        alpha0 = alpha[0];
+        alpha1 = alpha[1];
+        alpha2 = alpha[2];
+        PetscKernelAXPY3(xt,alpha0,alpha1,alpha2,yy0,yy1,yy2,tn);
+        break;
+      case 2:
+        xt     = xx+t; tn = PetscMin(VEC_SEQ_MAXPY_TILE,n-t);
+        yy0    = yy[0]+t; yy1 = yy[1]+t;
+        alpha0 = alpha[0];
+        alpha1 = alpha[1];
+        PetscKernelAXPY2(xt,alpha0,alpha1,yy0,yy1,tn);
+        break;
+      case 1:
+        xt     = xx+t; tn = PetscMin(VEC_SEQ_MAXPY_TILE,n-t);
+        yy0    = yy[0]+t;
+        alpha0 = alpha[0];
+        PetscKernelAXPY(xt,alpha0,yy0,tn);
+        break;
+      }
+      for (i=j_rem; i<nc; i+=4) {
+        xt     = xx+t; tn = PetscMin(VEC_SEQ_MAXPY_TILE,n-t);
+        yy0    = yy[i]+t; yy1 = yy[i+1]+t; yy2 = yy[i+2]+t; yy3 = yy[i+3]+t;
+        alpha0 = alpha[i];
+        alpha1 = alpha[i+1];
+        alpha2 = alpha[i+2];
+        alpha3 = alpha[i+3];
+        PetscKernelAXPY4(xt,alpha0,alpha1,alpha2,alpha3,yy0,yy1,yy2,yy3,tn);
+      }
+    }
+    for (i=0; i<nc; i++) {ierr = VecRestoreArrayRead(y[c+i],&yy[i]);CHKERRQ(ierr);}
   }
   ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
   PetscFunctionReturn(0);
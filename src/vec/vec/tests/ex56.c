@@ -0,0 +1,86 @@
+static char help[] = "Tests VecMDot(), VecMAXPY() and VecMAXPYMDot() against VecDot() and VecAXPY().\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  Vec            y,z,*x;
+  PetscInt       n = 1203,nv = 7,i,k;
+  PetscScalar    alpha[40],val[40],dot;
+  PetscReal      err,errmax,nrm;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  if (nv > 40) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"At most 40 vectors");
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&y);CHKERRQ(ierr);
+  ierr = VecSetSizes(y,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(y,nv,&x);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rand);CHKERRQ(ierr);
+  for (i=0; i<nv; i++) {
+    ierr     = VecSetRandom(x[i],rand);CHKERRQ(ierr);
+    alpha[i] = -1.0/(i+1);
+  }
+
+  /* every number of vectors, to exercise the remainders of the unrolled kernels */
+  for (k=1; k<=nv; k++) {
+    ierr = VecMDot(y,k,x,val);CHKERRQ(ierr);
+    for (i=0, errmax=0.0; i<k; i++) {
+      ierr   = VecDot(y,x[i],&dot);CHKERRQ(ierr);
+      errmax = PetscMax(errmax,PetscAbsScalar(dot-val[i])/PetscAbsScalar(dot));
+    }
+    if (errmax > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMDot() with %D vectors: relative error %g\n",k,(double)errmax);CHKERRQ(ierr);}
+
+    ierr = VecCopy(y,z);CHKERRQ(ierr);
+    ierr = VecMAXPY(z,k,alpha,x);CHKERRQ(ierr);
+    for (i=0; i<k; i++) {ierr = VecAXPY(z,-alpha[i],x[i]);CHKERRQ(ierr);}
+    ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_INFINITY,&err);CHKERRQ(ierr);
+    if (err > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPY() with %D vectors: error %g\n",k,(double)err);CHKERRQ(ierr);}
+
+    ierr = VecCopy(y,z);CHKERRQ(ierr);
+    ierr = VecMAXPYMDot(z,k,alpha,x,val);CHKERRQ(ierr);
+    for (i=0, errmax=0.0; i<k; i++) {
+      ierr   = VecDot(z,x[i],&dot);CHKERRQ(ierr);
+      errmax = PetscMax(errmax,PetscAbsScalar(dot-val[i])/PetscAbsScalar(dot));
+    }
+    for (i=0; i<k; i++) {ierr = VecAXPY(z,-alpha[i],x[i]);CHKERRQ(ierr);}
+    ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_INFINITY,&err);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    if (errmax > 100*PETSC_MACHINE_EPSILON || err > 100*PETSC_MACHINE_EPSILON*nrm) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() with %D vectors: relative error of the inner products %g, error of the update %g\n",k,(double)errmax,(double)err);CHKERRQ(ierr);
+    }
+  }
+
+  ierr = VecDestroyVecs(nv,&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex56_1.out
+      args: -n 2050 -nv 9
+
+   test:
+      suffix: 3
+      output_file: output/ex56_1.out
+      args: -n 1031 -nv 37
+
+TEST*/
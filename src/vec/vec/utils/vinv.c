@@ -1330,6 +1330,88 @@ PetscErrorCode  VecDotNorm2(Vec s,Vec t,PetscScalar *dp, PetscReal *nm)
   PetscFunctionReturn(0);
 }
 
+/* length of the pieces of the vectors in VecMAXPYMDot(), a piece of y is updated and then reused from cache for the inner products */
+#define VEC_MAXPYMDOT_TILE 512
+
+/*@
+   VecMAXPYMDot - Computes y = y + sum alpha[i] x[i] followed by the inner products of the updated y with the x[i],
+   with a single pass over the entries of the vectors
+
+   Collective on Vec
+
+   Input Parameters:
++  y - one vector
+.  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+-  x - array of vectors
+
+   Output Parameter:
+.  val - array of the inner products y'conj(x[i]) of the updated y
+
+   Level: advanced
+
+   Notes:
+    y cannot be any of the x vectors
+
+    The result is the same as VecMAXPY() followed by VecMDot(), but the vectors are read from memory only once. This
+    is used by KSPGMRESClassicalGramSchmidtFusedOrthogonalization() to apply the first Gram-Schmidt pass and compute
+    the inner products of the second pass together.
+
+.seealso: VecMAXPY(), VecMDot(), VecDotNorm2()
+@*/
+PetscErrorCode  VecMAXPYMDot(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[],PetscScalar val[])
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,j,n,t,tend;
+  PetscScalar       *yy,*work,a,sum;
+  const PetscScalar **xx,*xi;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(y,nv,2);
+  if (!nv) PetscFunctionReturn(0);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors (given %D) cannot be negative",nv);
+  PetscValidScalarPointer(alpha,3);
+  PetscValidPointer(x,4);
+  PetscValidHeaderSpecific(*x,VEC_CLASSID,4);
+  PetscValidScalarPointer(val,5);
+  PetscValidType(y,1);
+  PetscValidType(*x,4);
+  PetscCheckSameTypeAndComm(y,1,*x,4);
+  VecCheckSameSize(y,1,*x,4);
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+
+  ierr = PetscLogEventBegin(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nv,&xx,nv,&work);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(y,&n);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (i=0; i<nv; i++) {
+    ierr    = VecGetArrayRead(x[i],&xx[i]);CHKERRQ(ierr);
+    work[i] = 0.0;
+  }
+  for (t=0; t<n; t=tend) {
+    tend = PetscMin(t+VEC_MAXPYMDOT_TILE,n);
+    for (i=0; i<nv; i++) {
+      a  = alpha[i];
+      xi = xx[i];
+      for (j=t; j<tend; j++) yy[j] += a*xi[j];
+    }
+    for (i=0; i<nv; i++) {
+      sum = work[i];
+      xi  = xx[i];
+      for (j=t; j<tend; j++) sum += yy[j]*PetscConj(xi[j]);
+      work[i] = sum;
+    }
+  }
+  for (i=0; i<nv; i++) {ierr = VecRestoreArrayRead(x[i],&xx[i]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(4.0*nv*n);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,val,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)y));CHKERRQ(ierr);
+  ierr = PetscFree2(xx,work);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecSum - Computes the sum of all the components of a vector.
 